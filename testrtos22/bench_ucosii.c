@@ -0,0 +1,560 @@
+/*************************************************************************
+ * Description:                                                           *
+ * Benchmarks of the kernel services, run by the demo when it is built    *
+ * with DEMO_BENCH defined (see hello_ucosii.c). Times are read with      *
+ * OSCPUTsGet() and printed in its counts, along with OSCPUTsFreq(): they *
+ * are only meaningful with a timestamp timer, or ALT_TIMESTAMP_SYS_CLK.  *
+ *                                                                        *
+ * The benchmarks create their own tasks, at the priorities below         *
+ * BENCH_PRIO, and delete them when done. A benchmark which needs more    *
+ * tasks than OS_MAX_TASKS or OS_LOWEST_PRIO allow is skipped.            *
+ *                                                                        *
+ * The same file is built on the host by "make bench" in                  *
+ * testrtos22_bsp/tests, where the times are in nanoseconds.              *
+ **************************************************************************/
+
+#include <stdio.h>
+#include "includes.h"
+#include "sys/alt_alarm.h"
+#include "sys/alt_irq_profile.h"
+#include "bench_ucosii.h"
+
+#ifndef BENCH_STK_SIZE
+#define BENCH_STK_SIZE 512
+#endif
+
+#define BENCH_MAX_TASKS 60
+
+/* The tasks left to the benchmarks, and their lowest priority */
+
+#define BENCH_FREE_TASKS (OS_MAX_TASKS - OS_N_SYS_TASKS - 1)
+#define BENCH_LAST_PRIO  (OS_LOWEST_PRIO - 2)
+
+static OS_STK bench_stk[BENCH_MAX_TASKS][BENCH_STK_SIZE];
+
+static int bench_fits(int ntasks)
+{
+    return (ntasks <= BENCH_FREE_TASKS) &&
+           (BENCH_PRIO + ntasks <= BENCH_LAST_PRIO);
+}
+
+static void bench_create(void (*task)(void *), void *pdata, int i)
+{
+    INT8U err;
+
+    err = OSTaskCreate(task, pdata, &bench_stk[i][BENCH_STK_SIZE - 1],
+                       BENCH_PRIO + 1 + i);
+    if (err != OS_ERR_NONE)
+    {
+        printf("bench: task %d not created, error %d\n", i, err);
+    }
+}
+
+static void bench_delete(int ntasks)
+{
+    int i;
+
+    for (i = 0; i < ntasks; i++)
+    {
+        (void)OSTaskDel(BENCH_PRIO + 1 + i);
+    }
+}
+
+/*************************************************************************
+ * Tick: the cost of the system clock tick, alt_tick() and the            *
+ * OSTimeTick() it calls, with 5, 10 and 60 tasks delayed and none of     *
+ * them due. The tick is called with interrupts disabled, as in the timer *
+ * interrupt.                                                             *
+ **************************************************************************/
+
+#define BENCH_NTICKS 1000
+
+static void bench_sleeper(void *pdata)
+{
+    for (;;)
+    {
+        OSTimeDly(60000);
+    }
+}
+
+static void bench_tick(int ntasks)
+{
+    alt_irq_context context;
+    INT32U          start;
+    INT32U          cost;
+    INT32U          total = 0;
+    INT32U          max = 0;
+    int             i;
+
+    if (!bench_fits(ntasks))
+    {
+        printf("tick, %2d delayed tasks: skipped, too few tasks\n", ntasks);
+        return;
+    }
+    for (i = 0; i < ntasks; i++)
+    {
+        bench_create(bench_sleeper, NULL, i);
+    }
+    OSTimeDly(1);
+
+    for (i = 0; i < BENCH_NTICKS; i++)
+    {
+        context = alt_irq_disable_all();
+        start = OSCPUTsGet();
+        alt_tick();
+        cost = OSCPUTsGet() - start;
+        alt_irq_enable_all(context);
+        total += cost;
+        if (cost > max)
+        {
+            max = cost;
+        }
+    }
+    printf("tick, %2d delayed tasks: %lu average, %lu max\n", ntasks,
+           (unsigned long)(total / BENCH_NTICKS), (unsigned long)max);
+
+    bench_delete(ntasks);
+}
+
+/*************************************************************************
+ * ISR post: the time interrupts are disabled when an ISR sets the event  *
+ * flags which 5 or 60 tasks wait for, with OS_ISR_POST_DEFERRED_EN off   *
+ * or on. The ISR is run from the benchmark task with interrupts          *
+ * disabled, between OSIntEnter() and OSIntExit(), and the post in it is  *
+ * timed. With ALT_IRQ_PROFILE, the longest section with interrupts      *
+ * disabled anywhere in the kernel during the run is printed too, with    *
+ * its site: it includes the task level work that a deferred post leaves  *
+ * to OS_TaskIntQ(), followed by the profiler's measurements of each      *
+ * site. nios2-elf-addr2line gives the sites.                             *
+ **************************************************************************/
+
+#define BENCH_NPOSTS 200
+
+static OS_FLAG_GRP *bench_flags;
+
+static void bench_flag_waiter(void *pdata)
+{
+    OS_FLAGS flag = (OS_FLAGS)1 << ((int)pdata % OS_FLAGS_NBITS);
+    INT8U    err;
+
+    for (;;)
+    {
+        (void)OSFlagPend(bench_flags, flag, OS_FLAG_WAIT_SET_ANY, 0, &err);
+    }
+}
+
+#ifdef ALT_IRQ_PROFILE
+static void bench_irq_longest(void)
+{
+    alt_irq_profile_site site;
+    alt_u32              max = 0;
+    void                *at = NULL;
+    int                  i;
+
+    for (i = 0; i < ALT_IRQ_PROFILE_SITES; i++)
+    {
+        if ((alt_irq_profile_get(i, &site) == 0) && (site.max > max))
+        {
+            max = site.max;
+            at = site.site;
+        }
+    }
+    printf("  longest interrupts-off section in the kernel: %lu at %p\n",
+           (unsigned long)max, at);
+}
+#endif
+
+static void bench_isr_post(int ntasks)
+{
+    alt_irq_context context;
+    INT32U          start;
+    INT32U          cost;
+    INT32U          total = 0;
+    INT32U          max = 0;
+    INT8U           err;
+    int             i;
+
+    if (!bench_fits(ntasks))
+    {
+        printf("ISR post, %2d waiting tasks: skipped, too few tasks\n", ntasks);
+        return;
+    }
+    bench_flags = OSFlagCreate(0, &err);
+    if (bench_flags == NULL)
+    {
+        printf("ISR post: no event flag group, error %d\n", err);
+        return;
+    }
+    for (i = 0; i < ntasks; i++)
+    {
+        bench_create(bench_flag_waiter, (void *)i, i);
+    }
+    OSTimeDly(1);
+
+#ifdef ALT_IRQ_PROFILE
+    alt_irq_profile_reset();
+#endif
+    for (i = 0; i < BENCH_NPOSTS; i++)
+    {
+        context = alt_irq_disable_all();
+        OSIntEnter();
+        start = OSCPUTsGet();
+        (void)OSFlagPost(bench_flags, (OS_FLAGS)~0, OS_FLAG_SET, &err);
+        cost = OSCPUTsGet() - start;
+        OSIntExit();
+        alt_irq_enable_all(context);
+        total += cost;
+        if (cost > max)
+        {
+            max = cost;
+        }
+
+        /* let the waiters pend again */
+
+        (void)OSFlagPost(bench_flags, (OS_FLAGS)~0, OS_FLAG_CLR, &err);
+        OSTimeDly(1);
+    }
+    printf("ISR post, %2d waiting tasks, %s: %lu average, %lu max\n", ntasks,
+           OS_ISR_POST_DEFERRED_EN ? "deferred" : "direct",
+           (unsigned long)(total / BENCH_NPOSTS), (unsigned long)max);
+#ifdef ALT_IRQ_PROFILE
+    bench_irq_longest();
+    alt_irq_profile_dump();
+#else
+    printf("  longest interrupts-off section in the kernel: "
+           "needs ALT_IRQ_PROFILE\n");
+#endif
+
+    bench_delete(ntasks);
+    (void)OSFlagDel(bench_flags, OS_DEL_ALWAYS, &err);
+}
+
+/*************************************************************************
+ * Pipeline: a producer, a filter and a consumer task pass BENCH_NITEMS   *
+ * messages down the pipeline, in bursts of BENCH_BURST. The consumer,    *
+ * last in the pipeline, has the highest priority, and acknowledges each  *
+ * burst to the producer. The messages go through message queues and      *
+ * semaphores, or through rings signalled with the tasks' own semaphores  *
+ * (OSTaskSemPost()). Each is run with and without preemption thresholds, *
+ * the producer and the filter getting the consumer's priority as their   *
+ * threshold. OSCtxSwCtr counts the context switches.                     *
+ **************************************************************************/
+
+#define BENCH_NITEMS   10000
+#define BENCH_BURST    8
+
+#define BENCH_CONSUMER (BENCH_PRIO + 1)
+#define BENCH_FILTER   (BENCH_PRIO + 2)
+#define BENCH_PRODUCER (BENCH_PRIO + 3)
+
+static int       bench_task_sem;
+static OS_EVENT *bench_go;
+static OS_EVENT *bench_done;
+static OS_EVENT *bench_ack;
+static OS_EVENT *bench_q[2];
+static void     *bench_q_tbl[2][BENCH_BURST];
+static void     *bench_ring[2][BENCH_BURST];
+static INT32U    bench_ring_in[2];
+static INT32U    bench_ring_out[2];
+static INT32U    bench_errors;
+
+/* Stage 0 goes from the producer to the filter, stage 1 to the consumer */
+
+static void bench_put(int stage, void *msg)
+{
+    if (bench_task_sem)
+    {
+        bench_ring[stage][bench_ring_in[stage]++ % BENCH_BURST] = msg;
+        (void)OSTaskSemPost(stage ? BENCH_CONSUMER : BENCH_FILTER);
+    }
+    else
+    {
+        (void)OSQPost(bench_q[stage], msg);
+    }
+}
+
+static void *bench_get(int stage)
+{
+    INT8U err;
+
+    if (bench_task_sem)
+    {
+        OSTaskSemPend(0, &err);
+        return bench_ring[stage][bench_ring_out[stage]++ % BENCH_BURST];
+    }
+    return OSQPend(bench_q[stage], 0, &err);
+}
+
+static void bench_producer(void *pdata)
+{
+    INT8U err;
+    int   i;
+
+    for (;;)
+    {
+        OSSemPend(bench_go, 0, &err);
+        for (i = 0; i < BENCH_NITEMS; i++)
+        {
+            bench_put(0, (void *)i);
+            if ((i + 1) % BENCH_BURST == 0)
+            {
+                if (bench_task_sem)
+                {
+                    OSTaskSemPend(0, &err);
+                }
+                else
+                {
+                    OSSemPend(bench_ack, 0, &err);
+                }
+            }
+        }
+        (void)OSSemPost(bench_done);
+    }
+}
+
+static void bench_filter(void *pdata)
+{
+    for (;;)
+    {
+        bench_put(1, (void *)((int)bench_get(0) + 1));
+    }
+}
+
+static void bench_consumer(void *pdata)
+{
+    int i;
+
+    for (i = 1; ; i++)
+    {
+        if ((int)bench_get(1) != i)
+        {
+            bench_errors++;
+        }
+        if (i % BENCH_BURST == 0)
+        {
+            if (bench_task_sem)
+            {
+                (void)OSTaskSemPost(BENCH_PRODUCER);
+            }
+            else
+            {
+                (void)OSSemPost(bench_ack);
+            }
+        }
+    }
+}
+
+static void bench_pipeline(int task_sem, int thresh)
+{
+    INT32U start;
+    INT32U cost;
+    INT32U nswitches;
+    INT8U  err;
+    int    i;
+
+    if (!bench_fits(3))
+    {
+        printf("pipeline: skipped, too few tasks\n");
+        return;
+    }
+#if OS_TASK_PREEMPT_THRESH_EN == 0
+    if (thresh)
+    {
+        printf("pipeline, thresholds: skipped, OS_TASK_PREEMPT_THRESH_EN is 0\n");
+        return;
+    }
+#endif
+    bench_task_sem = task_sem;
+    bench_errors = 0;
+    bench_go = OSSemCreate(0);
+    bench_done = OSSemCreate(0);
+    bench_ack = OSSemCreate(0);
+    for (i = 0; i < 2; i++)
+    {
+        bench_q[i] = OSQCreate(bench_q_tbl[i], BENCH_BURST);
+        bench_ring_in[i] = 0;
+        bench_ring_out[i] = 0;
+    }
+    bench_create(bench_consumer, NULL, BENCH_CONSUMER - BENCH_PRIO - 1);
+    bench_create(bench_filter, NULL, BENCH_FILTER - BENCH_PRIO - 1);
+    bench_create(bench_producer, NULL, BENCH_PRODUCER - BENCH_PRIO - 1);
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+    if (thresh)
+    {
+        (void)OSTaskPreemptThreshSet(BENCH_FILTER, BENCH_CONSUMER);
+        (void)OSTaskPreemptThreshSet(BENCH_PRODUCER, BENCH_CONSUMER);
+    }
+#endif
+    OSTimeDly(1);
+
+    nswitches = OSCtxSwCtr;
+    start = OSCPUTsGet();
+    (void)OSSemPost(bench_go);
+    OSSemPend(bench_done, 0, &err);
+    cost = OSCPUTsGet() - start;
+    nswitches = OSCtxSwCtr - nswitches;
+
+    printf("pipeline, %s, %s: %lu switches, %lu per item, %s\n",
+           task_sem ? "task semaphores" : "queues",
+           thresh ? "thresholds" : "no thresholds",
+           (unsigned long)nswitches, (unsigned long)(cost / BENCH_NITEMS),
+           bench_errors ? "ERRORS" : "in order");
+
+    bench_delete(3);
+    (void)OSSemDel(bench_go, OS_DEL_ALWAYS, &err);
+    (void)OSSemDel(bench_done, OS_DEL_ALWAYS, &err);
+    (void)OSSemDel(bench_ack, OS_DEL_ALWAYS, &err);
+    for (i = 0; i < 2; i++)
+    {
+        (void)OSQDel(bench_q[i], OS_DEL_ALWAYS, &err);
+    }
+}
+
+/*************************************************************************
+ * Queue batches: a sender task passes BENCH_NITEMS messages to a         *
+ * receiver of higher priority through a message queue, in batches of     *
+ * BENCH_BURST. They are sent and received one at a time, with OSQPost()  *
+ * and OSQPend(), or a batch at a time, with OSQPostMany() and            *
+ * OSQPendMany(). OSCtxSwCtr counts the context switches.                 *
+ **************************************************************************/
+
+#define BENCH_RECEIVER (BENCH_PRIO + 1)
+#define BENCH_SENDER   (BENCH_PRIO + 2)
+
+static int bench_many;
+
+static void bench_sender(void *pdata)
+{
+    void  *msgs[BENCH_BURST];
+    INT8U  err;
+    int    i;
+    int    j;
+
+    for (;;)
+    {
+        OSSemPend(bench_go, 0, &err);
+        for (i = 0; i < BENCH_NITEMS; i += BENCH_BURST)
+        {
+            for (j = 0; j < BENCH_BURST; j++)
+            {
+                msgs[j] = (void *)(i + j);
+            }
+#if OS_Q_MANY_EN > 0
+            if (bench_many)
+            {
+                (void)OSQPostMany(bench_q[0], msgs, BENCH_BURST, &err);
+                continue;
+            }
+#endif
+            for (j = 0; j < BENCH_BURST; j++)
+            {
+                (void)OSQPost(bench_q[0], msgs[j]);
+            }
+        }
+        (void)OSSemPost(bench_done);
+    }
+}
+
+static void bench_receiver(void *pdata)
+{
+    void  *msgs[BENCH_BURST];
+    INT16U n;
+    INT16U j;
+    INT8U  err;
+    int    i;
+
+    for (i = 0; ; )
+    {
+#if OS_Q_MANY_EN > 0
+        if (bench_many)
+        {
+            n = OSQPendMany(bench_q[0], msgs, BENCH_BURST, 0, &err);
+        }
+        else
+#endif
+        {
+            msgs[0] = OSQPend(bench_q[0], 0, &err);
+            n = 1;
+        }
+        for (j = 0; j < n; j++, i++)
+        {
+            if ((int)msgs[j] != i % BENCH_NITEMS)
+            {
+                bench_errors++;
+            }
+        }
+    }
+}
+
+static void bench_queue_batch(int many)
+{
+    INT32U start;
+    INT32U cost;
+    INT32U nswitches;
+    INT8U  err;
+
+    if (!bench_fits(2))
+    {
+        printf("queue batches: skipped, too few tasks\n");
+        return;
+    }
+#if OS_Q_MANY_EN == 0
+    if (many)
+    {
+        printf("queue batches, many: skipped, OS_Q_MANY_EN is 0\n");
+        return;
+    }
+#endif
+    bench_many = many;
+    bench_errors = 0;
+    bench_go = OSSemCreate(0);
+    bench_done = OSSemCreate(0);
+    bench_q[0] = OSQCreate(bench_q_tbl[0], BENCH_BURST);
+    bench_create(bench_receiver, NULL, BENCH_RECEIVER - BENCH_PRIO - 1);
+    bench_create(bench_sender, NULL, BENCH_SENDER - BENCH_PRIO - 1);
+    OSTimeDly(1);
+
+    nswitches = OSCtxSwCtr;
+    start = OSCPUTsGet();
+    (void)OSSemPost(bench_go);
+    OSSemPend(bench_done, 0, &err);
+    cost = OSCPUTsGet() - start;
+    nswitches = OSCtxSwCtr - nswitches;
+
+    printf("queue batches, %s: %lu switches, %lu per item, %s\n",
+           many ? "OSQPostMany/OSQPendMany" : "OSQPost/OSQPend",
+           (unsigned long)nswitches, (unsigned long)(cost / BENCH_NITEMS),
+           bench_errors ? "ERRORS" : "in order");
+
+    bench_delete(2);
+    (void)OSSemDel(bench_go, OS_DEL_ALWAYS, &err);
+    (void)OSSemDel(bench_done, OS_DEL_ALWAYS, &err);
+    (void)OSQDel(bench_q[0], OS_DEL_ALWAYS, &err);
+}
+
+void bench_run(void)
+{
+    INT32U start;
+    INT32U total = 0;
+    int    i;
+
+    for (i = 0; i < BENCH_NTICKS; i++)
+    {
+        start = OSCPUTsGet();
+        total += OSCPUTsGet() - start;
+    }
+    printf("bench: times in counts of %lu Hz, %lu to read the time\n",
+           (unsigned long)OSCPUTsFreq(), (unsigned long)(total / BENCH_NTICKS));
+
+    bench_tick(5);
+    bench_tick(10);
+    bench_tick(60);
+    bench_isr_post(5);
+    bench_isr_post(60);
+    bench_pipeline(0, 0);
+    bench_pipeline(0, 1);
+    bench_pipeline(1, 0);
+    bench_pipeline(1, 1);
+    bench_queue_batch(0);
+    bench_queue_batch(1);
+}
@@ -0,0 +1,25 @@
+#ifndef __BENCH_UCOSII_H__
+#define __BENCH_UCOSII_H__
+
+/*
+ * Kernel benchmarks of the demo, see bench_ucosii.c. bench_run() is called
+ * from a task of priority BENCH_PRIO, the highest of the application, and 
+ * prints its results to stdout.
+ */
+
+#include "includes.h"
+
+#ifndef BENCH_PRIO
+#define BENCH_PRIO 1
+#endif
+
+/* The benchmarks use BENCH_PRIO to OS_LOWEST_PRIO - 2, see bench_fits() */
+
+#if (OS_ISR_POST_DEFERRED_EN > 0) && (OS_TASK_INT_Q_PRIO >= BENCH_PRIO) && \
+    (OS_TASK_INT_Q_PRIO <= OS_LOWEST_PRIO - 2)
+#error "BENCH_PRIO: the benchmarks would use OS_TASK_INT_Q_PRIO"
+#endif
+
+extern void bench_run(void);
+
+#endif /* __BENCH_UCOSII_H__ */
@@ -30,6 +30,9 @@
 #include <stdio.h>
 #include "includes.h"
 #include "altera_avalon_pio_regs.h"
+#ifdef DEMO_BENCH
+#include "bench_ucosii.h"
+#endif
 /* Definition of Task Stacks */
 #define TASK_STACKSIZE 2048
 OS_STK task1_stk[TASK_STACKSIZE];
@@ -40,6 +43,13 @@ OS_STK task2_stk[TASK_STACKSIZE];
 #define TASK1_PRIORITY 1
 #define TASK2_PRIORITY 2
 
+/* OSInit() creates the deferred ISR post task at OS_TASK_INT_Q_PRIO */
+
+#if (OS_ISR_POST_DEFERRED_EN > 0) && \
+    ((OS_TASK_INT_Q_PRIO == TASK1_PRIORITY) || (OS_TASK_INT_Q_PRIO == TASK2_PRIORITY))
+#error "TASK1_PRIORITY and TASK2_PRIORITY must differ from OS_TASK_INT_Q_PRIO"
+#endif
+
 /*Global variables*/
 INT32U time_sec = 0;
 #define SEVEN_SEG_PIO_BASE 0x81020
@@ -80,6 +90,7 @@ void task1(void *pdata)
 {
     INT8U err;
     OS_STK_DATA taskstkcheckdata;
+    OS_PERIOD period;
 
     // check the task satck check option
     err = OSTaskStkChk(TASK1_PRIORITY, &taskstkcheckdata);
@@ -92,11 +103,15 @@ void task1(void *pdata)
     {
         printf("error code for task1 stack check is %d\n", err);
     }
+    OSTimePeriodInit(&period, OS_TICKS_PER_SEC);
     while (1)
     {
         printf("Hello from task1\n");
         foursevensegDisplayAnyNumber(time_sec);
-        OSTimeDlyHMSM(0, 0, 1, 0);
+        if (OSTimePeriodWait(&period) == OS_ERR_TIME_OVERRUN)
+        {
+            printf("Task1 overrun, %lu activations missed\n", period.OSPeriodMissed);
+        }
     }
 }
 /* Prints "Hello World" and sleeps for three seconds */
@@ -104,6 +119,7 @@ void task2(void *pdata)
 {
     INT8U err;
     OS_STK_DATA taskstkcheckdata2;
+    OS_PERIOD period;
     err = OSTaskStkChk(TASK2_PRIORITY, &taskstkcheckdata2);
     if (err == OS_ERR_NONE)
     {
@@ -114,18 +130,35 @@ void task2(void *pdata)
     {
         printf("error code for task2 stack check is %d\n", err);
     }
+    OSTimePeriodInit(&period, 3 * OS_TICKS_PER_SEC);
     while (1)
     {
         INT8U switchValue = readSwitchValue();
         switchValue = switchValue << 4 | 0x0f;
         printf("Switch value is %d\n", switchValue);
-        OSTimeDlyHMSM(0, 0, 3, 0);
+        if (OSTimePeriodWait(&period) == OS_ERR_TIME_OVERRUN)
+        {
+            printf("Task2 overrun, %lu activations missed\n", period.OSPeriodMissed);
+        }
     }
 }
+#ifdef DEMO_BENCH
+/* Runs the kernel benchmarks once, instead of the demo tasks */
+void bench_task(void *pdata)
+{
+    bench_run();
+    OSTaskDel(OS_PRIO_SELF);
+}
+#endif
 /* The main function creates two task and starts multi-tasking */
 int main(void)
 {
     printf("Hello from Nios II!\n");
+#ifdef DEMO_BENCH
+    OSTaskCreate(bench_task, NULL, (void *)&task1_stk[TASK_STACKSIZE - 1], BENCH_PRIO);
+    OSStart();
+    return 0;
+#endif
     OSTaskStkInit(task1, NULL, (void *)&task1_stk[TASK_STACKSIZE - 1], 0);
     OSTaskCreateExt(task1,
                     NULL,
@@ -154,14 +187,6 @@ int main(void)
 void OSTimeTickHook(void)
 {
     static INT32U compteur = 0;
-#if OS_TMR_EN > 0
-    OSTmrCtr++;
-    if (OSTmrCtr >= (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC))
-    {
-        OSTmrCtr = 0;
-        OSTmrSignal();
-    }
-#endif
     if (compteur % OS_TICKS_PER_SEC == 0)
     {
         time_sec++;
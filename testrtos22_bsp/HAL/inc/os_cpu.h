@@ -93,6 +93,58 @@ typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits
 #define  OS_STK_GROWTH        1        /* Stack grows from HIGH to LOW memory */
 #define  OS_TASK_SW           OSCtxSw  
 
+/*
+ * Count leading zeros, used by the scheduler to find the highest priority
+ * task in the ready and event tables. If the Nios II core includes a custom 
+ * instruction computing it, define OS_CPU_CLZ_CI_N to the number of that
+ * custom instruction (e.g. -DOS_CPU_CLZ_CI_N=0 in the BSP CFLAGS); otherwise
+ * uC/OS-II uses the portable OS_CntLeadZeros() in os_core.c. The scheduler 
+ * never passes 0.
+ */
+
+#ifdef   OS_CPU_CLZ_CI_N
+#define  OS_CPU_CNT_LEAD_ZEROS(val) \
+         ((INT8U)__builtin_custom_ini (OS_CPU_CLZ_CI_N, (int)(val)))
+#endif
+
+/*
+ * Tick list. uC/OS-II times each task delay or pend timeout, and the signal
+ * of its timer task, with a tick node that the port keeps in a list sorted
+ * by expiry. Here a node is a HAL alarm, so the kernel shares alt_alarm_list
+ * with the other alarms and the system clock driver sees a single queue.
+ *
+ * OS_CPU_TICK_NODE_INIT() sets up an unlinked node. Its callback is made 
+ * from the tick ISR 'ticks' ticks after OS_CPU_TICK_NODE_INSERT(), once the
+ * node is unlinked; a non-zero return value links it again that many ticks
+ * later. OS_CPU_TICK_NODE_REMAIN() returns the ticks left before a linked 
+ * node's callback, and OS_CPU_TICK_NEXT_DUE() those before the first 
+ * callback of any node (0xffffffff if none). All are used with interrupts
+ * disabled.
+ */
+
+#include "sys/alt_alarm.h"
+
+typedef  alt_alarm  OS_CPU_TICK_NODE;
+
+#define  OS_CPU_TICK_NODE_INIT(pnode, fnct, parg)         \
+         do {                                             \
+             (pnode)->llist.next     = &(pnode)->llist;   \
+             (pnode)->llist.previous = &(pnode)->llist;   \
+             (pnode)->delta          = 0;                 \
+             (pnode)->callback       = (fnct);            \
+             (pnode)->context        = (parg);            \
+         } while (0)
+#define  OS_CPU_TICK_NODE_INSERT(pnode, ticks) \
+         alt_alarm_insert ((pnode), (alt_u32)(ticks))
+#define  OS_CPU_TICK_NODE_REMOVE(pnode) \
+         alt_alarm_remove (pnode)
+#define  OS_CPU_TICK_NODE_LINKED(pnode) \
+         ((pnode)->llist.next != &(pnode)->llist)
+#define  OS_CPU_TICK_NODE_REMAIN(pnode) \
+         ((INT32U)alt_alarm_remain (pnode))
+#define  OS_CPU_TICK_NEXT_DUE() \
+         ((INT32U)alt_alarm_next_due ())
+
 /******************************************************************************************
  *                Disable and Enable Interrupts - 2 methods
  *
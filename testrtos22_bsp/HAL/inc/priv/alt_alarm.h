@@ -35,7 +35,10 @@
 
 /******************************************************************************
 *                                                                             *
-* THIS IS A LIBRARY READ-ONLY SOURCE FILE. DO NOT EDIT.                       *
+* This file differs from the HAL library copy: alarms are kept in a sorted    *
+* delta queue. Regenerating the BSP would restore the library copy, which     *
+* the kernel, the system clock driver and usleep() no longer build against.   *
+* See the note at the top of settings.bsp.                                    *
 *                                                                             *
 ******************************************************************************/
 
@@ -60,14 +63,13 @@ extern "C"
 struct alt_alarm_s
 {
   alt_llist llist;       /* linked list */
-  alt_u32 time;          /* time in system ticks of the callback */
+  alt_u32 delta;         /* system ticks from the previous alarm in the list
+                            (or from now, for the first) to the callback */
   alt_u32 (*callback) (void* context); /* callback function. The return 
                           * value is the period for the next callback; where 
                           * zero indicates that the alarm should be removed 
                           * from the list. 
                           */
-  alt_u8 rollover;       /* set when desired alarm time + current time causes
-                            overflow, to prevent premature alarm */
   void* context;         /* Argument for the callback */
 };
 
@@ -90,10 +92,32 @@ extern alt_u32 _alt_tick_rate;
 
 extern volatile alt_u32 _alt_nticks;
 
-/* The list of registered alarms. */
+/* The list of registered alarms, in the order they are due. */
 
 extern alt_llist alt_alarm_list;
 
+/*
+ * alt_alarm_insert() adds an alarm to alt_alarm_list, "nticks" ticks from
+ * now. It must be called with interrupts disabled.
+ */
+
+extern void alt_alarm_insert (struct alt_alarm_s* alarm, alt_u32 nticks);
+
+/*
+ * alt_alarm_remove() takes an alarm out of alt_alarm_list, if it is there.
+ * It must be called with interrupts disabled.
+ */
+
+extern void alt_alarm_remove (struct alt_alarm_s* alarm);
+
+/*
+ * alt_alarm_remain() returns the number of ticks before the callback of an 
+ * alarm in alt_alarm_list is made, or zero if the alarm is not in the list. 
+ * It must be called with interrupts disabled.
+ */
+
+extern alt_u32 alt_alarm_remain (struct alt_alarm_s* alarm);
+
 #ifdef __cplusplus
 }
 #endif
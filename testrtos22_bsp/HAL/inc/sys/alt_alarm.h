@@ -35,7 +35,10 @@
 
 /******************************************************************************
 *                                                                             *
-* THIS IS A LIBRARY READ-ONLY SOURCE FILE. DO NOT EDIT.                       *
+* This file differs from the HAL library copy: alarms are kept in a sorted    *
+* delta queue. Regenerating the BSP would restore the library copy, which     *
+* the kernel, the system clock driver and usleep() no longer build against.   *
+* See the note at the top of settings.bsp.                                    *
 *                                                                             *
 ******************************************************************************/
 
@@ -119,6 +122,16 @@ static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_nticks (void)
 
 extern void alt_tick (void);
 
+/*
+ * alt_tick_credit() and alt_alarm_next_due() are used by a system clock
+ * driver which is able to skip ticks while the system is idle. The first 
+ * accounts for ticks which elapsed without an interrupt, the second returns
+ * the number of ticks until the next alarm is due (0xffffffff if none).
+ */
+
+extern void    alt_tick_credit (alt_u32 nticks);
+extern alt_u32 alt_alarm_next_due (void);
+
 #ifdef __cplusplus
 }
 #endif
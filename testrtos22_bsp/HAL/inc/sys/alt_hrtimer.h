@@ -0,0 +1,119 @@
+#ifndef __ALT_HRTIMER_H__
+#define __ALT_HRTIMER_H__
+
+/******************************************************************************
+*                                                                             *
+* License Agreement                                                           *
+*                                                                             *
+* Copyright (c) 2004 Altera Corporation, San Jose, California, USA.           *
+* All rights reserved.                                                        *
+*                                                                             *
+* Permission is hereby granted, free of charge, to any person obtaining a     *
+* copy of this software and associated documentation files (the "Software"),  *
+* to deal in the Software without restriction, including without limitation   *
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,    *
+* and/or sell copies of the Software, and to permit persons to whom the       *
+* Software is furnished to do so, subject to the following conditions:        *
+*                                                                             *
+* The above copyright notice and this permission notice shall be included in  *
+* all copies or substantial portions of the Software.                         *
+*                                                                             *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR  *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,    *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER      *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING     *
+* FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER         *
+* DEALINGS IN THE SOFTWARE.                                                   *
+*                                                                             *
+* This agreement shall be governed in all respects by the laws of the State   *
+* of California and by the laws of the United States of America.              *
+*                                                                             *
+* Altera does not recommend, suggest or require that this reference design    *
+* file be used in conjunction or combination with any other product.          *
+******************************************************************************/
+
+
+#include "alt_llist.h"
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * High resolution timers call a function once, at a time given in cycles of
+ * the system clock timer rather than in system clock ticks. They are driven
+ * by the system clock timer itself: its period is shortened as needed for its
+ * next interrupt to occur when the first high resolution timer expires, and 
+ * the periodic tick carries on around it. This requires a system clock timer
+ * with a writeable period and a snapshot register; otherwise 
+ * alt_hrtimer_start() fails.
+ *
+ * The callback is made from the system clock interrupt, with interrupts
+ * disabled, so it should only do what can't wait: e.g. toggle an output, or
+ * post to a semaphore to wake up a task (see usleep()).
+ */
+
+/*
+ * "alt_hrtimer" is a structure type used by applications to register a high
+ * resolution timer. An instance of this type must be passed to 
+ * alt_hrtimer_start(), which initialises it, and remain valid until the 
+ * callback is made or alt_hrtimer_stop() is called.
+ */
+
+typedef struct alt_hrtimer_s alt_hrtimer;
+
+struct alt_hrtimer_s
+{
+  alt_llist llist;                     /* list of timers, by expiry time */
+  alt_u64   expiry;                    /* system clock cycle of the callback */
+  void      (*callback) (void* context);
+  void*     context;                   /* argument for the callback */
+};
+
+/*
+ * alt_hrtimer_start() registers "callback" to be called with "context" once,
+ * "usec" microseconds from now. alt_hrtimer_start_at() does the same at the
+ * system clock cycle "expiry", as returned by alt_hrtimer_now(); a time in the
+ * past gives a callback as soon as possible. Both return 0, or -1 if the
+ * system clock timer can't provide high resolution timers. The timer must not
+ * already be running. Timers expiring on the same cycle are called in the 
+ * order they were started.
+ */
+
+extern int alt_hrtimer_start (alt_hrtimer* timer, 
+                              alt_u32      usec,
+                              void         (*callback) (void* context),
+                              void*        context);
+
+extern int alt_hrtimer_start_at (alt_hrtimer* timer, 
+                                 alt_u64      expiry,
+                                 void         (*callback) (void* context),
+                                 void*        context);
+
+/*
+ * alt_hrtimer_stop() cancels a timer whose callback has not been made yet. 
+ * Calling it once the callback has been made is harmless.
+ */
+
+extern void alt_hrtimer_stop (alt_hrtimer* timer);
+
+/*
+ * alt_hrtimer_now() returns the number of system clock timer cycles since the
+ * system clock was started, and alt_hrtimer_freq() the number of cycles per
+ * second (0 if high resolution timers are not available). The count never
+ * goes backwards, but it misses the few cycles for which the counter stops
+ * each time its period is changed, so it runs slightly slow while timers 
+ * are in use.
+ */
+
+extern alt_u64 alt_hrtimer_now (void);
+extern alt_u32 alt_hrtimer_freq (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALT_HRTIMER_H__ */
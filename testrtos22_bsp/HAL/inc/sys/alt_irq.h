@@ -51,6 +51,8 @@
 #include "alt_types.h"
 #include "system.h"
 
+#include "sys/alt_irq_profile.h"
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -109,6 +111,9 @@ static ALT_INLINE int ALT_ALWAYS_INLINE alt_irq_enabled (void)
  * bit. It returns the previous contents of the CPU status register (IRQ 
  * context) which can be used to restore the status register PIE bit to its 
  * state before this routine was called.
+ *
+ * When ALT_IRQ_PROFILE is defined, the time until interrupts are enabled
+ * again is measured if this call disabled them (see alt_irq_profile.h).
  */
 static ALT_INLINE alt_irq_context ALT_ALWAYS_INLINE 
        alt_irq_disable_all (void)
@@ -118,6 +123,13 @@ static ALT_INLINE alt_irq_context ALT_ALWAYS_INLINE
   NIOS2_READ_STATUS (context);
 
   NIOS2_WRITE_STATUS (context & ~NIOS2_STATUS_PIE_MSK);
+
+#ifdef ALT_IRQ_PROFILE
+  if (context & NIOS2_STATUS_PIE_MSK)
+  {
+    alt_irq_profile_enter ();
+  }
+#endif
   
   return context;
 }
@@ -143,6 +155,13 @@ static ALT_INLINE alt_irq_context ALT_ALWAYS_INLINE
 static ALT_INLINE void ALT_ALWAYS_INLINE 
        alt_irq_enable_all (alt_irq_context context)
 {
+#ifdef ALT_IRQ_PROFILE
+  if (context & NIOS2_STATUS_PIE_MSK)
+  {
+    alt_irq_profile_exit ();
+  }
+#endif
+
 #if (NIOS2_NUM_OF_SHADOW_REG_SETS > 0) || (defined NIOS2_EIC_PRESENT) || \
     (defined NIOS2_MMU_PRESENT) || (defined NIOS2_MPU_PRESENT)
   alt_irq_context status;
@@ -0,0 +1,147 @@
+#ifndef __ALT_IRQ_PROFILE_H__
+#define __ALT_IRQ_PROFILE_H__
+
+/*
+ * Copyright (c) 2003 Altera Corporation, San Jose, California, USA.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * ------------
+ *
+ * Altera does not recommend, suggest or require that this reference design
+ * file be used in conjunction or combination with any other product.
+ */
+
+/*
+ * alt_irq_profile.h is the interface to the interrupt-disabled time profiler.
+ *
+ * The profiler is only built when ALT_IRQ_PROFILE is defined, e.g. by adding
+ * -DALT_IRQ_PROFILE to ALT_CPPFLAGS in public.mk. It then measures, in
+ * OSCPUTsGet() counts, each section where interrupts are disabled:
+ *
+ * - from the outermost alt_irq_disable_all() (and so OS_ENTER_CRITICAL()) to
+ *   the alt_irq_enable_all() that enables interrupts again. The section is
+ *   charged to the code that called alt_irq_disable_all(), identified by its
+ *   address; use nios2-elf-addr2line to turn it into a file and line.
+ *
+ * - each interrupt handler called by alt_irq_handler(), which runs with
+ *   interrupts disabled. The section is charged to the handler's address.
+ *
+ * Each site keeps a count, the total and maximum durations, and a histogram
+ * of durations in powers of two: bucket 0 counts sections of 0 counts,
+ * bucket n those of 2^(n-1) to 2^n - 1 counts, and the last bucket all
+ * longer ones.
+ */
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#ifdef ALT_IRQ_PROFILE
+
+/*
+ * Number of sites that can be recorded. This must be a power of two, since
+ * sites are found by hashing their address.
+ */
+
+#ifndef ALT_IRQ_PROFILE_SITES
+#define ALT_IRQ_PROFILE_SITES   64
+#endif
+
+#if (ALT_IRQ_PROFILE_SITES & (ALT_IRQ_PROFILE_SITES - 1)) != 0
+#error ALT_IRQ_PROFILE_SITES must be a power of two.
+#endif
+
+/*
+ * Number of histogram buckets per site.
+ */
+
+#ifndef ALT_IRQ_PROFILE_BUCKETS
+#define ALT_IRQ_PROFILE_BUCKETS 16
+#endif
+
+#if (ALT_IRQ_PROFILE_BUCKETS < 2) || (ALT_IRQ_PROFILE_BUCKETS > 33)
+#error ALT_IRQ_PROFILE_BUCKETS must be between 2 and 33.
+#endif
+
+/*
+ * The measurements for one site. "site" is 0 for an unused entry.
+ */
+
+typedef struct alt_irq_profile_site_s
+{
+  void*   site;                           /* caller or handler address */
+  alt_u8  isr;                            /* non-zero for a handler    */
+  alt_u32 count;                          /* number of sections        */
+  alt_u32 max;                            /* longest section           */
+  alt_u64 total;                          /* sum of all sections       */
+  alt_u32 hist[ALT_IRQ_PROFILE_BUCKETS];
+} alt_irq_profile_site;
+
+/*
+ * alt_irq_profile_enter() and alt_irq_profile_exit() are called by
+ * alt_irq_disable_all() and alt_irq_enable_all() when they disable and
+ * enable interrupts. They must not be called directly.
+ */
+
+extern void alt_irq_profile_enter (void);
+extern void alt_irq_profile_exit (void);
+
+/*
+ * alt_irq_profile_ts() and alt_irq_profile_isr() are used by
+ * alt_irq_handler() to time each interrupt handler.
+ */
+
+extern alt_u32 alt_irq_profile_ts (void);
+extern void    alt_irq_profile_isr (void* handler, alt_u32 start);
+
+/*
+ * alt_irq_profile_get() copies the measurements of the site stored at
+ * "index" (0 to ALT_IRQ_PROFILE_SITES - 1). It returns -1 if the index is
+ * out of range or if the entry is unused, and 0 otherwise.
+ */
+
+extern int alt_irq_profile_get (int index, alt_irq_profile_site* site);
+
+/*
+ * alt_irq_profile_reset() clears all the measurements, e.g. to leave out
+ * the initialisation of the system.
+ */
+
+extern void alt_irq_profile_reset (void);
+
+/*
+ * alt_irq_profile_dump() prints the measurements of each site to stdout,
+ * followed by the longest section seen and the number of sections that
+ * were lost because the site table was full. It must be called from a task.
+ */
+
+extern void alt_irq_profile_dump (void);
+
+#endif /* ALT_IRQ_PROFILE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALT_IRQ_PROFILE_H__ */
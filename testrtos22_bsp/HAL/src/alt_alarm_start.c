@@ -66,7 +66,6 @@ int alt_alarm_start (alt_alarm* alarm, alt_u32 nticks,
                      void* context)
 {
   alt_irq_context irq_context;
-  alt_u32 current_nticks = 0;
   
   if (alt_ticks_per_second ())
   {
@@ -77,25 +76,16 @@ int alt_alarm_start (alt_alarm* alarm, alt_u32 nticks,
  
       irq_context = alt_irq_disable_all ();
       
-      current_nticks = alt_nticks();
-      
-      alarm->time = nticks + current_nticks + 1; 
-      
       /* 
-       * If the desired alarm time causes a roll-over, set the rollover
-       * flag. This will prevent the subsequent tick event from causing
-       * an alarm too early.
+       * The alarm is due on the "nticks + 1"th tick from now, since the
+       * current tick is already under way.
        */
-      if(alarm->time < current_nticks)
-      {
-        alarm->rollover = 1;
-      }
-      else
+      if (nticks != 0xffffffff)
       {
-        alarm->rollover = 0;
+        nticks++;
       }
     
-      alt_llist_insert (&alt_alarm_list, &alarm->llist);
+      alt_alarm_insert (alarm, nticks);
       alt_irq_enable_all (irq_context);
 
       return 0;
@@ -87,6 +87,9 @@ void alt_irq_handler (void)
   alt_u32 mask;
   alt_u32 i;
 #endif /* ALT_CI_INTERRUPT_VECTOR */
+#ifdef ALT_IRQ_PROFILE
+  alt_u32 start;
+#endif
   
   /*
    * Notify the operating system that we are at interrupt level.
@@ -105,10 +108,16 @@ void alt_irq_handler (void)
   while ((offset = ALT_CI_INTERRUPT_VECTOR) >= 0) {
     struct ALT_IRQ_HANDLER* handler_entry = 
       (struct ALT_IRQ_HANDLER*)(alt_irq_base + offset);
+#ifdef ALT_IRQ_PROFILE
+    start = alt_irq_profile_ts ();
+#endif
 #ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
     handler_entry->handler(handler_entry->context);
 #else
     handler_entry->handler(handler_entry->context, offset >> 3);
+#endif
+#ifdef ALT_IRQ_PROFILE
+    alt_irq_profile_isr ((void*) handler_entry->handler, start);
 #endif
   }
 #else /* ALT_CI_INTERRUPT_VECTOR */
@@ -142,10 +151,16 @@ void alt_irq_handler (void)
     {
       if (active & mask)
       { 
+#ifdef ALT_IRQ_PROFILE
+        start = alt_irq_profile_ts ();
+#endif
 #ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
         alt_irq[i].handler(alt_irq[i].context); 
 #else
         alt_irq[i].handler(alt_irq[i].context, i); 
+#endif
+#ifdef ALT_IRQ_PROFILE
+        alt_irq_profile_isr ((void*) alt_irq[i].handler, start);
 #endif
         break;
       }
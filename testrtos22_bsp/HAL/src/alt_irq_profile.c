@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2003 Altera Corporation, San Jose, California, USA.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * ------------
+ *
+ * Altera does not recommend, suggest or require that this reference design
+ * file be used in conjunction or combination with any other product.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sys/alt_irq.h"
+#include "sys/alt_irq_profile.h"
+
+#include "includes.h"
+
+#ifdef ALT_IRQ_PROFILE
+
+/*
+ * The sites measured so far, found by hashing their address.
+ */
+
+static alt_irq_profile_site alt_irq_profile_tbl[ALT_IRQ_PROFILE_SITES];
+
+/*
+ * The section in progress: who disabled interrupts and when. These are only
+ * accessed with interrupts disabled.
+ */
+
+static void*   alt_irq_profile_caller;
+static alt_u32 alt_irq_profile_start;
+static alt_u8  alt_irq_profile_active;
+
+/*
+ * Number of sections that could not be recorded because the table was full.
+ */
+
+static alt_u32 alt_irq_profile_lost;
+
+/*
+ * alt_irq_profile_record() charges a section of "cycles" counts to "site".
+ * It is called with interrupts disabled.
+ */
+
+static void alt_irq_profile_record (void* site, alt_u8 isr, alt_u32 cycles)
+{
+  alt_irq_profile_site* entry;
+  alt_u32               i;
+  alt_u32               n;
+  alt_u32               bucket;
+
+  i = ((alt_u32) site >> 2) & (ALT_IRQ_PROFILE_SITES - 1);
+
+  for (n = 0; n < ALT_IRQ_PROFILE_SITES; n++)
+  {
+    entry = &alt_irq_profile_tbl[i];
+
+    if (entry->site == site)
+    {
+      break;
+    }
+    if (entry->site == NULL)
+    {
+      entry->site = site;
+      entry->isr  = isr;
+      break;
+    }
+    i = (i + 1) & (ALT_IRQ_PROFILE_SITES - 1);
+  }
+
+  if (n == ALT_IRQ_PROFILE_SITES)
+  {
+    alt_irq_profile_lost++;
+    return;
+  }
+
+  /*
+   * Bucket n holds the sections that need n bits to be counted.
+   */
+
+  for (bucket = 0; (cycles >> bucket) != 0; bucket++)
+  {
+    if (bucket == ALT_IRQ_PROFILE_BUCKETS - 1)
+    {
+      break;
+    }
+  }
+
+  entry->count++;
+  entry->total += cycles;
+  if (cycles > entry->max)
+  {
+    entry->max = cycles;
+  }
+  entry->hist[bucket]++;
+}
+
+/*
+ * alt_irq_profile_ts() returns the current time in the profiling counts.
+ */
+
+alt_u32 alt_irq_profile_ts (void)
+{
+  return OSCPUTsGet ();
+}
+
+/*
+ * alt_irq_profile_enter() is called by alt_irq_disable_all() once interrupts
+ * are disabled. alt_irq_disable_all() is always inlined, so the return
+ * address identifies the code that disabled interrupts.
+ */
+
+void alt_irq_profile_enter (void)
+{
+  alt_irq_profile_caller = __builtin_return_address (0);
+  alt_irq_profile_active = 1;
+  alt_irq_profile_start  = alt_irq_profile_ts ();
+}
+
+/*
+ * alt_irq_profile_exit() is called by alt_irq_enable_all() just before
+ * interrupts are enabled. There is no section in progress if interrupts were
+ * enabled by returning from an exception instead, e.g. when switching to a
+ * task that was preempted by an interrupt.
+ */
+
+void alt_irq_profile_exit (void)
+{
+  alt_u32 cycles;
+
+  cycles = alt_irq_profile_ts () - alt_irq_profile_start;
+
+  if (alt_irq_profile_active)
+  {
+    alt_irq_profile_active = 0;
+    alt_irq_profile_record (alt_irq_profile_caller, 0, cycles);
+  }
+}
+
+/*
+ * alt_irq_profile_isr() is called by alt_irq_handler() when "handler",
+ * called at time "start", returns.
+ */
+
+void alt_irq_profile_isr (void* handler, alt_u32 start)
+{
+  alt_irq_profile_record (handler, 1, alt_irq_profile_ts () - start);
+}
+
+/*
+ * alt_irq_profile_get() copies the measurements of one site.
+ */
+
+int alt_irq_profile_get (int index, alt_irq_profile_site* site)
+{
+  alt_irq_context context;
+  int             ret_code = -1;
+
+  if ((index >= 0) && (index < ALT_IRQ_PROFILE_SITES))
+  {
+    context = alt_irq_disable_all ();
+    if (alt_irq_profile_tbl[index].site != NULL)
+    {
+      *site    = alt_irq_profile_tbl[index];
+      ret_code = 0;
+    }
+    alt_irq_enable_all (context);
+  }
+
+  return ret_code;
+}
+
+/*
+ * alt_irq_profile_reset() clears all the measurements.
+ */
+
+void alt_irq_profile_reset (void)
+{
+  alt_irq_context context;
+
+  context = alt_irq_disable_all ();
+  memset (alt_irq_profile_tbl, 0, sizeof (alt_irq_profile_tbl));
+  alt_irq_profile_lost = 0;
+  alt_irq_enable_all (context);
+}
+
+/*
+ * alt_irq_profile_dump() prints one line per site: its address, whether it
+ * is an interrupt handler, the number of sections, their maximum and average
+ * durations, and the histogram.
+ */
+
+void alt_irq_profile_dump (void)
+{
+  alt_irq_profile_site site;
+  void*                worst_site = NULL;
+  alt_u32              worst = 0;
+  int                  i;
+  int                  j;
+
+  printf ("Interrupts disabled, in counts of %lu Hz\n",
+          (unsigned long) OSCPUTsFreq ());
+  printf ("site       isr      count        max        avg  histogram (2^n)\n");
+
+  for (i = 0; i < ALT_IRQ_PROFILE_SITES; i++)
+  {
+    if (alt_irq_profile_get (i, &site) != 0)
+    {
+      continue;
+    }
+
+    printf ("0x%08lx %3s %10lu %10lu %10lu ",
+            (unsigned long) site.site,
+            site.isr ? "yes" : "no",
+            (unsigned long) site.count,
+            (unsigned long) site.max,
+            (unsigned long) (site.total / site.count));
+    for (j = 0; j < ALT_IRQ_PROFILE_BUCKETS; j++)
+    {
+      printf (" %lu", (unsigned long) site.hist[j]);
+    }
+    printf ("\n");
+
+    if (site.max >= worst)
+    {
+      worst      = site.max;
+      worst_site = site.site;
+    }
+  }
+
+  printf ("Longest: %lu at 0x%08lx, lost: %lu\n",
+          (unsigned long) worst,
+          (unsigned long) worst_site,
+          (unsigned long) alt_irq_profile_lost);
+}
+
+#endif /* ALT_IRQ_PROFILE */
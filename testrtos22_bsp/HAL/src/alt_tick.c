@@ -52,11 +52,64 @@ volatile alt_u32 _alt_nticks = 0;
 
 /*
  * "alt_alarm_list" is the head of a linked list of registered alarms. This is
- * initialised to be an empty list.
+ * initialised to be an empty list. The alarms are kept in the order in which
+ * they are due, and each alarm records the number of ticks between the alarm
+ * before it (or the current tick, for the first alarm) and its own callback.
+ * alt_tick() thus only decrements the first alarm, and the wrap-around of
+ * _alt_nticks needs no special handling.
+ *
+ * With uC/OS-II this is the only tick-driven queue in the system: the kernel
+ * times task delays and pend timeouts with an alarm in each task control 
+ * block, and its timer task is signalled by an alarm of its own.
  */
 
 ALT_LLIST_HEAD(alt_alarm_list);
 
+/*
+ * alt_alarm_insert() adds "alarm" to the list of registered alarms, to be
+ * called "nticks" calls to alt_tick() from now. An alarm due on the same tick
+ * as others is called after them. It is called with interrupts disabled, and
+ * walks the alarms which are due before the new one.
+ */
+
+void alt_alarm_insert (alt_alarm* alarm, alt_u32 nticks)
+{
+  alt_llist* entry = alt_alarm_list.next;
+  alt_alarm* next;
+
+  while (entry != &alt_alarm_list)
+  {
+    next = (alt_alarm*) entry;
+    if (nticks < next->delta)
+    {
+      next->delta -= nticks;
+      break;
+    }
+    nticks -= next->delta;
+    entry   = entry->next;
+  }
+
+  alarm->delta = nticks;
+  alt_llist_insert (entry->previous, &alarm->llist);
+}
+
+/*
+ * alt_alarm_remove() takes "alarm" out of the list of registered alarms. The 
+ * ticks the alarm was waiting for are handed on to the alarm after it. It is
+ * called with interrupts disabled, and does nothing for an alarm which is not
+ * in the list.
+ */
+
+void alt_alarm_remove (alt_alarm* alarm)
+{
+  if ((alarm->llist.next != &alarm->llist) && 
+      (alarm->llist.next != &alt_alarm_list))
+  {
+    ((alt_alarm*) alarm->llist.next)->delta += alarm->delta;
+  }
+  alt_llist_remove (&alarm->llist);
+}
+
 /*
  * alt_alarm_stop() is called to remove an alarm from the list of registered 
  * alarms. Alternatively an alarm can unregister itself by returning zero when 
@@ -68,7 +121,7 @@ void alt_alarm_stop (alt_alarm* alarm)
   alt_irq_context irq_context;
 
   irq_context = alt_irq_disable_all();
-  alt_llist_remove (&alarm->llist);
+  alt_alarm_remove (alarm);
   alt_irq_enable_all (irq_context);
 }
 
@@ -80,14 +133,18 @@ void alt_alarm_stop (alt_alarm* alarm)
  * The return value of the callback function indicates how many ticks are to
  * elapse until the next callback. A return value of zero indicates that the
  * alarm should be deactivated. 
+ *
+ * Only the alarms which are due are examined. Alarms left overdue by
+ * alt_tick_credit() have no ticks left to wait, and are called on this tick
+ * along with the first alarm which had ticks left.
  * 
  * alt_tick() is expected to run at interrupt level.
  */
 
 void alt_tick (void)
 {
-  alt_alarm* next;
-  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
+  alt_llist* entry;
+  alt_alarm* alarm;
 
   alt_u32    next_callback;
 
@@ -95,49 +152,43 @@ void alt_tick (void)
 
   _alt_nticks++;
 
-  /* process the registered callbacks */
+  /* one tick less to wait for the first alarm which was still waiting */
 
-  while (alarm != (alt_alarm*) &alt_alarm_list)
+  for (entry = alt_alarm_list.next; 
+       entry != &alt_alarm_list; 
+       entry = entry->next)
   {
-    next = (alt_alarm*) alarm->llist.next;
+    alarm = (alt_alarm*) entry;
+    if (alarm->delta)
+    {
+      alarm->delta--;
+      break;
+    }
+  }
 
-    /* 
-     * Upon the tick-counter rolling over it is safe to clear the 
-     * roll-over flag; once the flag is cleared this (or subsequnt)
-     * tick events are enabled to generate an alarm event. 
-     */
-    if ((alarm->rollover) && (_alt_nticks == 0))
+  /* process the callbacks which are due */
+
+  while (alt_alarm_list.next != &alt_alarm_list)
+  {
+    alarm = (alt_alarm*) alt_alarm_list.next;
+    if (alarm->delta)
     {
-      alarm->rollover = 0;
+      break;
     }
-    
-    /* if the alarm period has expired, make the callback */    
-    if ((alarm->time <= _alt_nticks) && (alarm->rollover == 0))
+
+    alt_llist_remove (&alarm->llist);
+
+    next_callback = alarm->callback (alarm->context);
+
+    /* 
+     * Reactivate the alarm unless the return value is zero, or unless the
+     * callback has already restarted it. 
+     */
+
+    if ((next_callback != 0) && (alarm->llist.next == &alarm->llist))
     {
-      next_callback = alarm->callback (alarm->context);
-
-      /* deactivate the alarm if the return value is zero */
-
-      if (next_callback == 0)
-      {
-        alt_alarm_stop (alarm);
-      }
-      else
-      {
-        alarm->time += next_callback;
-        
-        /* 
-         * If the desired alarm time causes a roll-over, set the rollover
-         * flag. This will prevent the subsequent tick event from causing
-         * an alarm too early.
-         */
-        if(alarm->time < _alt_nticks)
-        {
-          alarm->rollover = 1;
-        }
-      }
+      alt_alarm_insert (alarm, next_callback);
     }
-    alarm = next;
   }
 
   /* 
@@ -147,3 +198,96 @@ void alt_tick (void)
   ALT_OS_TIME_TICK();
 }
 
+/*
+ * alt_tick_credit() is called by the system clock driver, with interrupts
+ * disabled, when it wakes up after a period in which "nticks" ticks elapsed
+ * without an interrupt. The tick counter is advanced in one step; no alarm
+ * callback is made since the driver never skips past alt_alarm_next_due().
+ * Should an alarm have been started meanwhile and fallen due, it is left 
+ * overdue for alt_tick(). The tick which ends the period is still processed
+ * by alt_tick().
+ */
+
+void alt_tick_credit (alt_u32 nticks)
+{
+  alt_llist* entry;
+  alt_alarm* alarm;
+  alt_u32    left = nticks;
+
+  if (nticks == 0)
+  {
+    return;
+  }
+
+  _alt_nticks += nticks;
+
+  for (entry = alt_alarm_list.next; 
+       (entry != &alt_alarm_list) && left; 
+       entry = entry->next)
+  {
+    alarm = (alt_alarm*) entry;
+    if (alarm->delta > left)
+    {
+      alarm->delta -= left;
+      break;
+    }
+    left        -= alarm->delta;
+    alarm->delta = 0;
+  }
+
+  /*
+   * Update the operating system specific timer facilities.
+   */
+
+  ALT_OS_TIME_CREDIT(nticks);
+}
+
+/*
+ * alt_alarm_remain() returns the number of calls to alt_tick() before the
+ * callback of "alarm" is made: the sum of the deltas up to and including its
+ * own. An alarm which is already due counts as one tick, and zero is returned
+ * for an alarm which is not in the list. It walks the alarms which are due 
+ * before "alarm", and should be called with interrupts disabled.
+ */
+
+alt_u32 alt_alarm_remain (alt_alarm* alarm)
+{
+  alt_llist* entry;
+  alt_u32    nticks = 0;
+
+  if (alarm->llist.next == &alarm->llist)
+  {
+    return 0;
+  }
+
+  for (entry = alt_alarm_list.next; 
+       entry != &alarm->llist; 
+       entry = entry->next)
+  {
+    nticks += ((alt_alarm*) entry)->delta;
+  }
+  nticks += alarm->delta;
+
+  return nticks ? nticks : 1;
+}
+
+/*
+ * alt_alarm_next_due() returns the number of ticks until the first alarm in
+ * the list is due, i.e. the number of calls to alt_tick() before a callback
+ * is made. An alarm which is already due counts as one tick. If no alarm is 
+ * registered, 0xffffffff is returned. It should be called with interrupts 
+ * disabled.
+ */
+
+alt_u32 alt_alarm_next_due (void)
+{
+  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
+
+  if (alarm == (alt_alarm*) &alt_alarm_list)
+  {
+    return 0xffffffff;
+  }
+
+  return alarm->delta ? alarm->delta : 1;
+}
+
@@ -31,6 +31,7 @@
 #include <unistd.h>
 
 #include "sys/alt_alarm.h"
+#include "sys/alt_hrtimer.h"
 #include "priv/alt_busy_sleep.h"
 #include "os/alt_syscall.h"
 
@@ -42,12 +43,68 @@
 
 #define ALT_US (1000000)
 
+/*
+ * Remainders shorter than ALT_USLEEP_BUSY_US microseconds are always spent in
+ * a busy loop, since blocking the thread for them would cost more than it 
+ * gives to other threads.
+ */
+
+#ifndef ALT_USLEEP_BUSY_US
+#define ALT_USLEEP_BUSY_US (20)
+#endif
+
+#if (OS_SEM_EN > 0) && (OS_OBJ_STATIC_EN > 0)
+
+/*
+ * alt_usleep_wake() is the high resolution timer callback used to end a 
+ * sleep. It is called from the system clock interrupt.
+ */
+
+static void alt_usleep_wake (void* context)
+{
+  OSSemPost ((OS_EVENT*) context);
+}
+
+/*
+ * alt_usleep_hr() blocks the current thread for "us" microseconds using a 
+ * high resolution timer. It returns non-zero if the timer is not available,
+ * or if the thread could not block, e.g. because the scheduler is locked. 
+ */
+
+static int alt_usleep_hr (alt_u32 us)
+{
+  OS_EVENT    sem;
+  alt_hrtimer timer;
+  INT8U       err;
+
+  OSSemCreateStatic (&sem, 0);
+
+  if (alt_hrtimer_start (&timer, us, alt_usleep_wake, &sem))
+  {
+    return -1;
+  }
+
+  OSSemPend (&sem, 0, &err);
+
+  if (err != OS_ERR_NONE)
+  {
+    alt_hrtimer_stop (&timer);
+    return -1;
+  }
+
+  return 0;
+}
+
+#endif
+
 /*
  * This implementation of usleep overrides the default provided in the HAL/src
  * directory of the altera_nios2 component. When possible, this
  * implementation uses the uC/OS-II OSTimeDly function to block the current
  * thread, rather than using a busy loop. This allows other threads to execute 
- * while the current thread is sleeping.
+ * while the current thread is sleeping. The part of the delay shorter than a
+ * clock tick is spent blocked on a high resolution timer when one is 
+ * available.
  *
  * ALT_USLEEP is mapped onto the usleep() system call in alt_syscall.h 
  */
@@ -60,6 +117,7 @@ unsigned int ALT_USLEEP (unsigned int us)
 {
   alt_u32 ticks;
   alt_u32 tick_rate;
+  alt_u32 remainder;
 
   /* 
    * If the O/S hasn't started yet, then we delay using a busy loop, rather than
@@ -80,25 +138,39 @@ unsigned int ALT_USLEEP (unsigned int us)
   ticks     = (us/ALT_US)* tick_rate + ((us%ALT_US)*tick_rate)/ALT_US;
 
   /*
-   * OSTimeDly can only delay for a maximum of 0xffff ticks, so if the requested
-   * delay is greater than that, we need to break it down into a number of
-   * seperate delays.
+   * With a 16 bit OS_TICK, OSTimeDly can only delay for a maximum of 0xffff
+   * ticks, so if the requested delay is greater than that, we need to break it
+   * down into a number of seperate delays. A 32 bit OS_TICK holds any delay,
+   * so the task is only woken up once.
    */
 
+#if OS_TICK_NBITS < 32
   while (ticks > 0xffff)
   {
     OSTimeDly(0xffff);
     ticks -= 0xffff;
   }
+#endif
 
-  OSTimeDly ((INT16U) (ticks));
+  OSTimeDly ((OS_TICK) (ticks));
 
   /*
-   * Now delay by the remainder using a busy loop. This is here in order to
-   * provide very short delays of less than one clock tick.
+   * Now delay by the remainder. This is here in order to provide very short
+   * delays of less than one clock tick. The busy loop is used when the 
+   * remainder is too short to be worth blocking for, or when there is no 
+   * high resolution timer.
    */
 
-  alt_busy_sleep (us%(ALT_US/tick_rate));  
+  remainder = us%(ALT_US/tick_rate);
+
+#if (OS_SEM_EN > 0) && (OS_OBJ_STATIC_EN > 0)
+  if ((remainder >= ALT_USLEEP_BUSY_US) && !alt_usleep_hr (remainder))
+  {
+    return 0;
+  }
+#endif
+
+  alt_busy_sleep (remainder);  
 
   return 0;  
 }
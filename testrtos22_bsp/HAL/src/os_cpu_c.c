@@ -20,11 +20,21 @@
 
 #include "system.h"
 
-extern alt_u32 OSStartTsk;                 /* The entry point for all tasks. */
+#if (OS_TASK_PROFILE_EN > 0) || (defined ALT_IRQ_PROFILE)
+#include "sys/alt_alarm.h"
+#include "sys/alt_timestamp.h"
+#endif
+
+#if OS_TICKLESS_EN > 0
+#include "sys/alt_alarm.h"
+#include "altera_avalon_timer.h"
 
-#if OS_TMR_EN > 0
-static  INT16U  OSTmrCtr;
+#if ALT_SYS_CLK_FIXED_PERIOD || !ALT_SYS_CLK_SNAPSHOT
+#error OS_TICKLESS_EN requires a system clock timer with writeable period and snapshot registers.
 #endif
+#endif
+
+extern alt_u32 OSStartTsk;                 /* The entry point for all tasks. */
 
 #ifdef ALT_CPU_EIC_PRESENT
 #error Nios II does not support uC/OS-II if EIC is enabled.
@@ -159,6 +169,23 @@ void OSTaskDelHook (OS_TCB *ptcb)
 */
 void OSTaskSwHook (void)
 {
+#if OS_TASK_PROFILE_EN > 0
+    INT32U  ts;
+    INT32U  cycles;
+
+
+    ts = OSCPUTsGet();
+    if (OSRunning == OS_TRUE) {                 /* Nothing was running before OSStartHighRdy()          */
+        cycles                     = ts - OSTCBCur->OSTCBCyclesStart;
+        OSTCBCur->OSTCBCyclesTot  += cycles;    /* Charge the task switched out                         */
+        cycles                    += OSTCBCur->OSTCBCyclesSlice;
+        if (cycles > OSTCBCur->OSTCBCyclesMax) {
+            OSTCBCur->OSTCBCyclesMax = cycles;  /* Longest run between switch in and switch out         */
+        }
+        OSTCBCur->OSTCBCyclesSlice = 0L;
+    }
+    OSTCBHighRdy->OSTCBCyclesStart = ts;        /* Start charging the task switched in                  */
+#endif
 }
 
 /*
@@ -184,6 +211,8 @@ void OSTaskStatHook (void)
 * Arguments  : none
 *
 * Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*              2) With OS_TICKLESS_EN, the ticks skipped while idle are added to OSTime in one step
+*                 without calling this function (see OSTimeTickCredit()).
 *********************************************************************************************************
 */
 
@@ -197,14 +226,6 @@ void cticks_hook(void);
 
 // void OSTimeTickHook (void)
 // {
-// #if OS_TMR_EN > 0
-//     OSTmrCtr++;
-//     if (OSTmrCtr >= (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)) {
-//         OSTmrCtr = 0;
-//         OSTmrSignal();
-//     }
-// #endif  
-    
 // #ifdef ALT_INICHE
 //     /* Service the Interniche timer */
 //     cticks_hook();
@@ -213,8 +234,8 @@ void cticks_hook(void);
 
 void OSInitHookBegin(void)
 {
-#if OS_TMR_EN > 0
-    OSTmrCtr = 0;
+#if ((OS_TASK_PROFILE_EN > 0) || (defined ALT_IRQ_PROFILE)) && (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+    (void)alt_timestamp_start();
 #endif
 }
 
@@ -231,3 +252,70 @@ void OSTCBInitHook(OS_TCB *ptcb)
 }
 
 #endif
+
+#if (OS_TASK_PROFILE_EN > 0) || (defined ALT_IRQ_PROFILE)
+/*
+*********************************************************************************************************
+*                                         PROFILING TIMESTAMP
+*
+* Description: OSCPUTsGet() returns the free running counter used to profile tasks and ISRs, and the
+*              time interrupts are disabled (ALT_IRQ_PROFILE), and OSCPUTsFreq() its frequency in Hz.  Only
+*              differences between two readings are meaningful; they stay correct when the counter wraps
+*              around.
+*
+*              The timestamp timer (ALT_TIMESTAMP_CLK) is used when the system has one, which gives cycle
+*              resolution.  Otherwise the system clock driver provides the timestamp from the system clock
+*              timer (ALT_TIMESTAMP_SYS_CLK), also with cycle resolution, if the timer has a snapshot
+*              register.  Failing that, the system clock tick count is returned, and task run times are
+*              only known to the tick.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) OSCPUTsGet() is called with interrupts disabled.
+*********************************************************************************************************
+*/
+INT32U OSCPUTsGet (void)
+{
+#if (ALT_TIMESTAMP_CLK_BASE != none_BASE) || ALT_TIMESTAMP_SYS_CLK
+    return ((INT32U)alt_timestamp());
+#else
+    return ((INT32U)alt_nticks());
+#endif
+}
+
+INT32U OSCPUTsFreq (void)
+{
+#if (ALT_TIMESTAMP_CLK_BASE != none_BASE) || ALT_TIMESTAMP_SYS_CLK
+    return ((INT32U)alt_timestamp_freq());
+#else
+    return ((INT32U)alt_ticks_per_second());
+#endif
+}
+#endif
+
+#if OS_TICKLESS_EN > 0
+/*
+*********************************************************************************************************
+*                                          TICKLESS IDLE
+*
+* Description: OSTicklessStretch() is called by the idle task with the number of ticks until the next
+*              HAL alarm is due; task delays, timeouts and the timer task's signal are alarms too.  The
+*              system clock timer is reprogrammed to skip the ticks where nothing is due.
+*              OSTicklessResume() is called before switching away from the idle task, or when an ISR
+*              ends, to account for the ticks elapsed so far and go back to the normal tick.
+*
+* Arguments  : ticks   is the number of ticks until the next alarm is due.
+*
+* Note(s)    : 1) Interrupts are disabled during these calls.
+*********************************************************************************************************
+*/
+void OSTicklessStretch (INT32U ticks)
+{
+    (void)alt_avalon_timer_sc_stretch(ticks);
+}
+
+void OSTicklessResume (void)
+{
+    alt_avalon_timer_sc_resume();
+}
+#endif
@@ -47,15 +47,35 @@
 extern OS_EVENT *alt_envsem;
 extern OS_EVENT *alt_heapsem;
 
+#if OS_OBJ_STATIC_EN > 0
+/*
+ * Storage for the two semaphores, so that they are not taken from the
+ * OSEventTbl[] pool.
+ */
+extern OS_EVENT alt_envsem_ecb;
+extern OS_EVENT alt_heapsem_ecb;
+#endif
+
 /*
  * This header provides definitions for the operating system hooks used by the
  * HAL.
  */
 
 #define ALT_OS_TIME_TICK OSTimeTick
+#if OS_TICKLESS_EN > 0
+#define ALT_OS_TIME_CREDIT OSTimeTickCredit
+#else
+#define ALT_OS_TIME_CREDIT(nticks)
+#endif
+#if OS_OBJ_STATIC_EN > 0
+#define ALT_OS_INIT()    OSInit();                                            \
+                         alt_envsem  = OSSemCreateStatic(&alt_envsem_ecb, 1); \
+                         alt_heapsem = OSSemCreateStatic(&alt_heapsem_ecb, 1)
+#else
 #define ALT_OS_INIT()    OSInit();                     \
                          alt_envsem  = OSSemCreate(1); \
                          alt_heapsem = OSSemCreate(1)
+#endif
 #define ALT_OS_STOP()    OSRunning = OS_FALSE
 #define ALT_OS_INT_ENTER OSIntEnter
 #define ALT_OS_INT_EXIT  OSIntExit
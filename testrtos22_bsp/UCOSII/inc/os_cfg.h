@@ -45,16 +45,70 @@ extern "C"
                                        /* ---------------------- MISCELLANEOUS ----------------------- */
 #define OS_APP_HOOKS_EN           1    /* Application-defined hooks are called from the uC/OS-II hooks */
 #define OS_EVENT_MULTI_EN         1    /* Include code for OSEventPendMulti()                          */
+#define OS_OBJ_STATIC_EN          1    /* Include code for the ...CreateStatic() functions, which take */
+                                       /* ... caller storage; OS_MAX_xxx pools may then be 0           */
+
+                                       /* ------------------- BYTE-STREAM BUFFERS -------------------- */
+#define OS_BUF_EN                 1    /* Enable (1) or Disable (0) code generation for BUFFERS        */
+#define OS_BUF_DEL_EN             1    /*     Include code for OSBufDel()                              */
+#define OS_BUF_QUERY_EN           1    /*     Include code for OSBufQuery()                            */
+
+                                       /* -------------------- DEFERRED ISR POSTS -------------------- */
+#define OS_ISR_POST_DEFERRED_EN   0    /*     Posts from ISRs are queued and applied by a task, so the */
+                                       /*     ... ISR side of a post takes a short, constant time      */
+#define OS_INT_Q_SIZE            16    /*     Number of posts ISRs may defer before the task runs      */
+#define OS_TASK_INT_Q_PRIO        0    /*     Priority of the deferred post task (keep it the highest) */
+                                       /*     ... OSInit() creates it there, so the application must   */
+                                       /*     ... not use that priority (OS_ERR_PRIO_EXIST)            */
+#define OS_TASK_INT_Q_STK_SIZE  512    /*     Deferred post task stack size (# of OS_STK wide entries) */
 
                                        /* -------------------- MESSAGE MAILBOXES --------------------- */
 #define OS_MBOX_PEND_ABORT_EN     1    /*     Include code for OSMboxPendAbort()                       */
 
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
+#define OS_Q_MANY_EN              1    /*     Include code for OSQPendMany() and OSQPostMany()         */
 #define OS_Q_PEND_ABORT_EN        1    /*     Include code for OSQPendAbort()                          */
+#define OS_Q_PRIO_EN              1    /*     Include code for OSQCreatePrio() and OSQPostPrio()       */
+#define OS_Q_PRIO_LVLS            8    /*     Number of message priorities (1 to 32)                   */
+
+                                       /* -------------- MUTUAL EXCLUSION SEMAPHORES ----------------- */
+#define OS_MUTEX_PI_EN            0    /*     Boost a mutex owner to its highest waiter's priority     */
+                                       /*     ... instead of to a reserved PIP (needs OS_SCHED_RR_EN)  */
+
+                                       /* ------------------- READER-WRITER LOCKS -------------------- */
+#define OS_RWLOCK_EN              1    /* Enable (1) or Disable (0) code generation for RW LOCKS       */
+#define OS_RWLOCK_DEL_EN          1    /*     Include code for OSRWLockDel()                           */
+#define OS_RWLOCK_QUERY_EN        1    /*     Include code for OSRWLockQuery()                         */
 
                                        /* ------------------------ SEMAPHORES ------------------------ */
 #define OS_SEM_PEND_ABORT_EN      1    /*    Include code for OSSemPendAbort()                         */
 
+                                       /* --------------------- TASK MANAGEMENT ---------------------- */
+#define OS_SCHED_RR_EN            0    /*     Allow tasks to share a priority, time sliced in turn     */
+#define OS_SCHED_RR_QUANTUM      10    /*     Default time slice of a task, in ticks                   */
+#define OS_TASK_STAT_TS_EN        0    /*     Measure CPU usage from the profiling timestamps, so no   */
+                                       /*     ... calibration is needed (needs OS_TASK_PROFILE_EN)     */
+#define OS_TASK_PREEMPT_THRESH_EN 0    /*     Include code for OSTaskPreemptThreshSet()                */
+#define OS_TASK_SEM_EN            1    /*     Include code for OSTaskSemPost() and OSTaskSemPend()     */
+#define OS_TASK_MSG_EN            1    /*     Include code for OSTaskMsgPost() and OSTaskMsgPend()     */
+
+                                       /* --------------------- TIMER MANAGEMENT --------------------- */
+#define OS_TMR_CFG_WHEEL_LVLS     4    /*     Number of levels of the timer wheel, each level having   */
+                                       /*     ... OS_TMR_CFG_WHEEL_SIZE spokes that many times longer  */
+#define OS_TMR_CFG_CB_TASK_EN     0    /*     Run timer callbacks from a task, outside of the timer    */
+                                       /*     ... lock, and record their lateness and duration         */
+#define OS_TASK_TMR_CB_PRIO       3    /*     Priority of the timer callback task                      */
+#define OS_TASK_TMR_CB_STK_SIZE 512    /*     Callback task stack size (# of OS_STK wide entries)      */
+
+                                       /* --------------------- TIME MANAGEMENT ---------------------- */
+#define OS_TICKLESS_EN            0    /*     Stop the tick interrupt while idle, until the next due   */
+                                       /*     ... delay, timeout or HAL alarm (sys_clk_timer).  The    */
+                                       /*     ... skipped ticks don't call OSTimeTickHook()            */
+#define OS_TICK_NBITS            32    /*     Size in #bits of OS_TICK, the type of all delays and     */
+                                       /*     ... timeouts (16 or 32)                                  */
+#define OS_TIME_DLY_UNTIL_EN      1    /*     Include code for OSTimeDlyUntil() and OSTimePeriod...()  */
+                                       /*     ... (needs OS_TIME_GET_SET_EN)                           */
+
                                                                                                                      
 #include "system.h"
 
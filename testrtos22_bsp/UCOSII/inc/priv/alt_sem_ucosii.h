@@ -68,7 +68,7 @@ static ALT_INLINE int ALT_ALWAYS_INLINE alt_sem_create (OS_EVENT** sem,
  */
 
 static ALT_INLINE int ALT_ALWAYS_INLINE alt_sem_pend (OS_EVENT* sem, 
-                  INT16U timeout)
+                  OS_TICK timeout)
 {
   INT8U err;
   OSSemPend (sem, timeout, &err);
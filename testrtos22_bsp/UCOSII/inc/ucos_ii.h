@@ -70,27 +70,46 @@ extern "C" {
 #define  OS_PRIO_SELF              0xFFu                /* Indicate SELF priority                      */
 
 #if OS_TASK_STAT_EN > 0
-#define  OS_N_SYS_TASKS               2u                /* Number of system tasks                      */
+#define  OS_N_SYS_TASKS_STAT          1u
 #else
-#define  OS_N_SYS_TASKS               1u
+#define  OS_N_SYS_TASKS_STAT          0u
 #endif
 
+#if OS_ISR_POST_DEFERRED_EN > 0
+#define  OS_N_SYS_TASKS_INT_Q         1u
+#else
+#define  OS_N_SYS_TASKS_INT_Q         0u
+#endif
+
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_CB_TASK_EN > 0)
+#define  OS_N_SYS_TASKS_TMR_CB        1u
+#else
+#define  OS_N_SYS_TASKS_TMR_CB        0u
+#endif
+                                                        /* Number of system tasks                      */
+#define  OS_N_SYS_TASKS    (1u + OS_N_SYS_TASKS_STAT + OS_N_SYS_TASKS_INT_Q + OS_N_SYS_TASKS_TMR_CB)
+
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
 
-#if OS_LOWEST_PRIO <= 63
-#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of event table                         */
-#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of ready table                         */
-#else
-#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of event table                         */
-#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of ready table                         */
+#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 32 + 1)  /* Size of event table (32-bit words)          */
+#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 32 + 1)  /* Size of ready table (32-bit words)          */
+                                                        /* Prio p is bit (31 - p % 32) of word p / 32  */
+                                                        /* ... and word y is bit (7 - y) of the group  */
+
+#ifdef   OS_CPU_CNT_LEAD_ZEROS                          /* Use the port's count leading zeros, if any  */
+#define  OS_CntLeadZeros(val)  OS_CPU_CNT_LEAD_ZEROS(val)
 #endif
 
 #define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID          65534u
 #define  OS_TASK_TMR_ID           65533u
+#define  OS_TASK_INT_Q_ID         65532u                /* ... and for the deferred ISR post task      */
+#define  OS_TASK_TMR_CB_ID        65531u                /* ... and for the timer callback task         */
 
-#define  OS_EVENT_EN           (((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0))
+#define  OS_EVENT_EN           (((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))) || \
+                                 (OS_MBOX_EN > 0) || (OS_SEM_EN > 0) || (OS_MUTEX_EN > 0) || \
+                                 (OS_RWLOCK_EN > 0) || (OS_BUF_EN > 0))
 
 #define  OS_TCB_RESERVED        ((OS_TCB *)1)
 
@@ -107,9 +126,16 @@ extern "C" {
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_TASK              0x40u    /* Pending on its own semaphore (with OS_STAT_SEM) or      */
+                                            /* ... message slot (with OS_STAT_MBOX)                    */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_RWLOCK_RD     OS_STAT_SEM   /* Pending on reader-writer lock to read                   */
+#define  OS_STAT_RWLOCK_WR     OS_STAT_MUTEX /* Pending on reader-writer lock to write                  */
+#define  OS_STAT_BUF_GET       OS_STAT_Q     /* Pending on byte-stream buffer for a record              */
+#define  OS_STAT_BUF_PUT       OS_STAT_MBOX  /* Pending on byte-stream buffer for room                  */
+
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | OS_STAT_TASK)
 
 /*
 *********************************************************************************************************
@@ -131,10 +157,20 @@ extern "C" {
 #define  OS_EVENT_TYPE_SEM            3u
 #define  OS_EVENT_TYPE_MUTEX          4u
 #define  OS_EVENT_TYPE_FLAG           5u
+#define  OS_EVENT_TYPE_RWLOCK         6u
+#define  OS_EVENT_TYPE_BUF            7u
 
 #define  OS_TMR_TYPE                100u    /* Used to identify Timers ...                             */
                                             /* ... (Must be different value than OS_EVENT_TYPE_xxx)    */
 
+/*
+*********************************************************************************************************
+*                                       READER-WRITER LOCK OPTIONS
+*********************************************************************************************************
+*/
+#define  OS_RWLOCK_OPT_NONE           0u    /* Waiting readers and writers get the lock in prio. order */
+#define  OS_RWLOCK_OPT_WR_PREF        1u    /* No reader gets the lock while a writer is waiting       */
+
 /*
 *********************************************************************************************************
 *                                         EVENT FLAGS
@@ -203,6 +239,23 @@ extern "C" {
 #define  OS_POST_OPT_FRONT         0x02u    /* Post to highest priority task waiting                   */
 #define  OS_POST_OPT_NO_SCHED      0x04u    /* Do not call the scheduler if this option is selected    */
 
+/*
+*********************************************************************************************************
+*                            DEFERRED ISR POSTS (Values for OSIntQType)
+*********************************************************************************************************
+*/
+#if OS_ISR_POST_DEFERRED_EN > 0
+#define  OS_INT_Q_TYPE_SEM            0u    /* OSSemPost()                                             */
+#define  OS_INT_Q_TYPE_MBOX           1u    /* OSMboxPost()                                            */
+#define  OS_INT_Q_TYPE_MBOX_OPT       2u    /* OSMboxPostOpt()                                         */
+#define  OS_INT_Q_TYPE_Q              3u    /* OSQPost()                                               */
+#define  OS_INT_Q_TYPE_Q_FRONT        4u    /* OSQPostFront()                                          */
+#define  OS_INT_Q_TYPE_Q_OPT          5u    /* OSQPostOpt()                                            */
+#define  OS_INT_Q_TYPE_FLAG           6u    /* OSFlagPost()                                            */
+#define  OS_INT_Q_TYPE_BUF            7u    /* OSBufCommit() and OSBufRelease()                        */
+#define  OS_INT_Q_TYPE_Q_PRIO         8u    /* OSQPostPrio()                                           */
+#endif
+
 /*
 *********************************************************************************************************
 *                                 TASK OPTIONS (see OSTaskCreateExt())
@@ -294,6 +347,8 @@ extern "C" {
 #define OS_ERR_TIME_INVALID_MS       83u
 #define OS_ERR_TIME_ZERO_DLY         84u
 #define OS_ERR_TIME_DLY_ISR          85u
+#define OS_ERR_TIME_PAST             86u
+#define OS_ERR_TIME_OVERRUN          87u
 
 #define OS_ERR_MEM_INVALID_PART      90u
 #define OS_ERR_MEM_INVALID_BLKS      91u
@@ -332,6 +387,19 @@ extern "C" {
 #define OS_ERR_TMR_STOPPED          142u
 #define OS_ERR_TMR_NO_CALLBACK      143u
 
+#define OS_ERR_YIELD_ISR            150u
+#define OS_ERR_YIELD_NONE           151u
+
+#define OS_ERR_INT_Q_FULL           152u
+
+#define OS_ERR_THRESH_INVALID       153u
+
+#define OS_ERR_NOT_RWLOCK_OWNER     154u
+#define OS_ERR_RWLOCK_OVF           155u
+
+#define OS_ERR_BUF_SIZE             156u
+#define OS_ERR_BUF_PTR              157u
+
 /*
 *********************************************************************************************************
 *                                    OLD ERROR CODE NAMES (< V2.84)
@@ -378,6 +446,30 @@ extern "C" {
 #define OS_FLAG_INVALID_OPT          OS_ERR_FLAG_INVALID_OPT
 #define OS_FLAG_GRP_DEPLETED         OS_ERR_FLAG_GRP_DEPLETED
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         DELAYS AND TIMEOUTS
+*********************************************************************************************************
+*/
+
+#if OS_TICK_NBITS == 16                     /* Determine the size of OS_TICK (16 or 32 bits)           */
+typedef  INT16U   OS_TICK;
+#endif
+
+#if OS_TICK_NBITS == 32
+typedef  INT32U   OS_TICK;
+#endif
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+typedef struct os_period {                  /* Periodic activation, see OSTimePeriodWait()             */
+    INT32U        OSPeriodNext;             /* OSTime of the next activation                           */
+    INT32U        OSPeriodTicks;            /* Period, in ticks                                        */
+    INT32U        OSPeriodOverruns;         /* Nbr of activations that started late                    */
+    INT32U        OSPeriodMissed;           /* Nbr of activations skipped because they were overrun    */
+} OS_PERIOD;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -385,17 +477,16 @@ extern "C" {
 *********************************************************************************************************
 */
 
-#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+#if (OS_EVENT_EN) && ((OS_MAX_EVENTS > 0) || (OS_OBJ_STATIC_EN > 0))
 typedef struct os_event {
     INT8U    OSEventType;                    /* Type of event control block (see OS_EVENT_TYPE_xxxx)    */
     void    *OSEventPtr;                     /* Pointer to message or queue structure                   */
     INT16U   OSEventCnt;                     /* Semaphore Count (not used if other EVENT type)          */
-#if OS_LOWEST_PRIO <= 63
     INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT8U    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-#else
-    INT16U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT16U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT32U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+
+#if OS_MUTEX_PI_EN > 0
+    struct os_event *OSEventMutexNext;       /* Next mutex owned by the same task (mutex only)          */
 #endif
 
 #if OS_EVENT_NAME_SIZE > 1
@@ -411,7 +502,7 @@ typedef struct os_event {
 *********************************************************************************************************
 */
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
 
 #if OS_FLAGS_NBITS == 8                     /* Determine the size of OS_FLAGS (8, 16 or 32 bits)       */
 typedef  INT8U    OS_FLAGS;
@@ -430,6 +521,11 @@ typedef struct os_flag_grp {                /* Event Flag Group
     INT8U         OSFlagType;               /* Should be set to OS_EVENT_TYPE_FLAG                     */
     void         *OSFlagWaitList;           /* Pointer to first NODE of task waiting on event flag     */
     OS_FLAGS      OSFlagFlags;              /* 8, 16 or 32 bit flags                                   */
+    OS_FLAGS      OSFlagWaitSet;            /* Flags awaited to be set by the waiting tasks (or more)  */
+#if OS_FLAG_WAIT_CLR_EN > 0
+    OS_FLAGS      OSFlagWaitClr;            /* Flags awaited to be cleared by them (or more)           */
+#endif
+    OS_FLAGS      OSFlagConsumed;           /* Flags changed by consuming since the last walk          */
 #if OS_FLAG_NAME_SIZE > 1
     INT8U         OSFlagName[OS_FLAG_NAME_SIZE];
 #endif
@@ -452,6 +548,33 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #endif
 
 /*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         BYTE-STREAM BUFFERS
+*********************************************************************************************************
+*/
+
+#if OS_BUF_EN > 0
+typedef struct os_buf {                   /* BYTE-STREAM BUFFER CONTROL BLOCK                          */
+    INT8U        *OSBufStart;             /* Pointer to start of storage area (on a 4 byte boundary)   */
+    INT32U        OSBufSize;              /* Size of storage area, in bytes                            */
+    INT32U        OSBufHead;              /* Offset where the next record is reserved                  */
+    INT32U        OSBufOut;               /* Offset of the next record to give to a consumer           */
+    INT32U        OSBufTail;              /* Offset of the oldest record not released yet              */
+    INT32U        OSBufUsed;              /* Number of bytes from OSBufTail to OSBufHead               */
+    INT16U        OSBufEntries;           /* Number of records from OSBufOut to OSBufHead              */
+} OS_BUF;
+
+
+typedef struct os_buf_data {
+    INT32U        OSSize;                 /* Size of storage area, in bytes                            */
+    INT32U        OSUsed;                 /* Number of bytes used by records, headers included         */
+    INT16U        OSEntries;              /* Number of records not yet given to a consumer             */
+    INT32U        OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur          */
+    INT8U         OSEventGrp;             /* Group corresponding to tasks waiting for event to occur   */
+} OS_BUF_DATA;
+#endif
+
 /*
 *********************************************************************************************************
 *                                          MESSAGE MAILBOX DATA
@@ -461,13 +584,8 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #if OS_MBOX_EN > 0
 typedef struct os_mbox_data {
     void   *OSMsg;                         /* Pointer to message in mailbox                            */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
     INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT16U  OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#endif
 } OS_MBOX_DATA;
 #endif
 
@@ -477,7 +595,7 @@ typedef struct os_mbox_data {
 *********************************************************************************************************
 */
 
-#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+#if (OS_MEM_EN > 0) && ((OS_MAX_MEM_PART > 0) || (OS_OBJ_STATIC_EN > 0))
 typedef struct os_mem {                   /* MEMORY CONTROL BLOCK                                      */
     void   *OSMemAddr;                    /* Pointer to beginning of memory partition                  */
     void   *OSMemFreeList;                /* Pointer to list of free memory blocks                     */
@@ -509,13 +627,8 @@ typedef struct os_mem_data {
 
 #if OS_MUTEX_EN > 0
 typedef struct os_mutex_data {
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
     INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
     BOOLEAN OSValue;                        /* Mutex value (OS_FALSE = used, OS_TRUE = available)      */
     INT8U   OSOwnerPrio;                    /* Mutex owner's task priority or 0xFF if no owner         */
     INT8U   OSMutexPIP;                     /* Priority Inheritance Priority or 0xFF if no owner       */
@@ -529,6 +642,14 @@ typedef struct os_mutex_data {
 */
 
 #if OS_Q_EN > 0
+#if OS_Q_PRIO_EN > 0
+typedef struct os_q_msg {               /* ENTRY OF A PRIORITY-ORDERED QUEUE                           */
+    struct os_q_msg  *OSQMsgNext;       /* Next message of the same priority, or next free entry       */
+    void             *OSQMsgPtr;        /* Message                                                     */
+} OS_Q_MSG;
+#endif
+
+
 typedef struct os_q {                   /* QUEUE CONTROL BLOCK                                         */
     struct os_q   *OSQPtr;              /* Link to next queue control block in list of free blocks     */
     void         **OSQStart;            /* Pointer to start of queue data                              */
@@ -537,6 +658,13 @@ typedef struct os_q {                   /* QUEUE CONTROL BLOCK
     void         **OSQOut;              /* Pointer to where next message will be extracted from the Q  */
     INT16U         OSQSize;             /* Size of queue (maximum number of entries)                   */
     INT16U         OSQEntries;          /* Current number of entries in the queue                      */
+#if OS_Q_PRIO_EN > 0
+    OS_Q_MSG      *OSQMsgTbl;           /* Storage of a priority-ordered queue, NULL for a FIFO queue  */
+    OS_Q_MSG      *OSQMsgFree;          /* List of free entries in OSQMsgTbl[]                         */
+    OS_Q_MSG      *OSQMsgHead[OS_Q_PRIO_LVLS];  /* Oldest message of each priority                     */
+    OS_Q_MSG      *OSQMsgTail[OS_Q_PRIO_LVLS];  /* Newest message of each priority                     */
+    INT32U         OSQPrioGrp;          /* Bit (31 - prio) is set when messages of 'prio' are queued   */
+#endif
 } OS_Q;
 
 
@@ -544,16 +672,27 @@ typedef struct os_q_data {
     void          *OSMsg;               /* Pointer to next message to be extracted from queue          */
     INT16U         OSNMsgs;             /* Number of messages in message queue                         */
     INT16U         OSQSize;             /* Size of message queue                                       */
-#if OS_LOWEST_PRIO <= 63
-    INT8U          OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
+    INT32U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
     INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#else
-    INT16U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT16U         OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#endif
 } OS_Q_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                        READER-WRITER LOCK DATA
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_EN > 0
+typedef struct os_rwlock_data {
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
+    INT16U  OSRdCnt;                        /* Number of readers holding the lock                      */
+    INT8U   OSWrPrio;                       /* Priority of the writer holding the lock, 0xFF if none   */
+    INT8U   OSOpt;                          /* OS_RWLOCK_OPT_xxx given when the lock was created       */
+} OS_RWLOCK_DATA;
+#endif
+
 /*
 *********************************************************************************************************
 *                                           SEMAPHORE DATA
@@ -563,13 +702,8 @@ typedef struct os_q_data {
 #if OS_SEM_EN > 0
 typedef struct os_sem_data {
     INT16U  OSCnt;                          /* Semaphore count                                         */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
+    INT32U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
     INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
 } OS_SEM_DATA;
 #endif
 
@@ -586,6 +720,23 @@ typedef struct os_stk_data {
 } OS_STK_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                           TASK PROFILING DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+typedef struct os_profile_data {
+    INT32U  OSCtxSwCtr;                /* Number of times the task was switched in                     */
+    INT32U  OSCyclesTot;               /* Timestamp counts the task ran for in total (wraps around)    */
+    INT32U  OSCyclesMax;               /* Longest time the task ran before being switched out          */
+    INT16U  OSCPUUsage;                /* CPU usage of the task over the last statistics period ...    */
+    INT16U  OSIntCPUUsage;             /* ... and of the ISRs, in 0.01 % units                         */
+    INT32U  OSTsFreq;                  /* Frequency of the timestamp counter (Hz)                      */
+} OS_PROFILE_DATA;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -615,30 +766,55 @@ typedef struct os_tcb {
     OS_EVENT       **OSTCBEventMultiPtr;    /* Pointer to multiple event control blocks                */
 #endif
 
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
+#if ((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))) || (OS_MBOX_EN > 0) || (OS_BUF_EN > 0)
     void            *OSTCBMsg;              /* Message received from OSMboxPost() or OSQPost()         */
 #endif
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if OS_TASK_SEM_EN > 0
+    INT16U           OSTCBSemCtr;           /* Count of the task's own semaphore (OSTaskSemPost())     */
+#endif
+
+#if OS_TASK_MSG_EN > 0
+    void            *OSTCBMsgSlot;          /* Task's own message slot, NULL if empty (OSTaskMsgPost())*/
+#endif
+
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
 #if OS_TASK_DEL_EN > 0
     OS_FLAG_NODE    *OSTCBFlagNode;         /* Pointer to event flag node                              */
 #endif
     OS_FLAGS         OSTCBFlagsRdy;         /* Event flags that made task ready to run                 */
 #endif
 
-    INT16U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
+    OS_TICK          OSTCBDly;              /* Nbr ticks the delay or event timeout was started with,  */
+                                            /* ... non-zero while the task is in the tick list.  The   */
+                                            /* ... ticks left are given by OS_TickListRemain()         */
+    OS_CPU_TICK_NODE OSTCBTickNode;         /* Port's tick list node timing the delay or timeout       */
     INT8U            OSTCBStat;             /* Task      status                                        */
     INT8U            OSTCBStatPend;         /* Task PEND status                                        */
     INT8U            OSTCBPrio;             /* Task priority (0 == highest)                            */
 
     INT8U            OSTCBX;                /* Bit position in group  corresponding to task priority   */
     INT8U            OSTCBY;                /* Index into ready table corresponding to task priority   */
-#if OS_LOWEST_PRIO <= 63
-    INT8U            OSTCBBitX;             /* Bit mask to access bit position in ready table          */
+    INT32U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
     INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#else
-    INT16U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT16U           OSTCBBitY;             /* Bit mask to access bit position in ready group          */
+
+#if OS_SCHED_RR_EN > 0
+    struct os_tcb   *OSTCBPrioNext;         /* Pointer to next     TCB at the same priority (circular) */
+    struct os_tcb   *OSTCBPrioPrev;         /* Pointer to previous TCB at the same priority            */
+    struct os_tcb   *OSTCBRdyNext;          /* Pointer to next     ready TCB at the same priority ...  */
+    struct os_tcb   *OSTCBRdyPrev;          /* ... (circular, both are NULL if the task is not ready)  */
+    INT16U           OSTCBQuantum;          /* Time slice of the task (in ticks)                       */
+    INT16U           OSTCBQuantumCtr;       /* Ticks left in the current time slice                    */
+#endif
+
+#if OS_MUTEX_PI_EN > 0
+    INT8U            OSTCBBasePrio;         /* Priority given by the application, before inheritance   */
+    OS_EVENT        *OSTCBMutexList;        /* List of the mutexes owned by the task                   */
+#endif
+
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+    INT8U            OSTCBPrioThresh;       /* Preemption threshold: only tasks of a higher priority   */
+                                            /* ... than this can preempt the task while it runs        */
 #endif
 
 #if OS_TASK_DEL_EN > 0
@@ -649,6 +825,10 @@ typedef struct os_tcb {
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
     INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
     INT32U           OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
+    INT32U           OSTCBCyclesSlice;      /* Cycles run since switched in, before the last ISR       */
+    INT32U           OSTCBCyclesMax;        /* Longest run between switch in and switch out            */
+    INT32U           OSTCBCyclesPrev;       /* OSTCBCyclesTot at the start of the statistics period    */
+    INT16U           OSTCBCPUUsage;         /* CPU usage over the last statistics period (0.01 %)      */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
 #endif
@@ -676,6 +856,7 @@ typedef  struct  os_tmr {
     void            *OSTmrCallbackArg;                /* Argument to pass to function when timer expires               */
     void            *OSTmrNext;                       /* Double link list pointers                                     */
     void            *OSTmrPrev;
+    void            *OSTmrSpoke;                      /* Timer wheel spoke the timer is linked into (OS_TMR_WHEEL *)   */
     INT32U           OSTmrMatch;                      /* Timer expires when OSTmrTime == OSTmrMatch                    */
     INT32U           OSTmrDly;                        /* Delay time before periodic update starts                      */
     INT32U           OSTmrPeriod;                     /* Period to repeat timer                                        */
@@ -687,6 +868,18 @@ typedef  struct  os_tmr {
                                                       /*     OS_TMR_STATE_UNUSED                                       */
                                                       /*     OS_TMR_STATE_RUNNING                                      */
                                                       /*     OS_TMR_STATE_STOPPED                                      */
+#if OS_TMR_CFG_CB_TASK_EN > 0
+    void            *OSTmrCbNext;                     /* Next timer whose callback the callback task must run          */
+    INT32U           OSTmrCbMatch;                    /* OSTmrMatch of the expiry whose callback is queued             */
+    BOOLEAN          OSTmrCbPend;                     /* The callback is queued and has not started yet                */
+    INT32U           OSTmrCbOvr;                      /* Expiries lost because the callback was still queued           */
+    INT32U           OSTmrCbLate;                     /* Timer ticks from OSTmrMatch to the start of the last callback */
+    INT32U           OSTmrCbLateMax;                  /* ... peak of OSTmrCbLate                                       */
+#if OS_TASK_PROFILE_EN > 0
+    INT32U           OSTmrCbCycles;                   /* Duration of the last callback (OSCPUTsGet() counts)           */
+    INT32U           OSTmrCbCyclesMax;                /* ... peak of OSTmrCbCycles                                     */
+#endif
+#endif
 } OS_TMR;
 
 
@@ -697,6 +890,23 @@ typedef  struct  os_tmr_wheel {
 } OS_TMR_WHEEL;
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        DEFERRED ISR POST QUEUE
+*********************************************************************************************************
+*/
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+typedef struct os_int_q {                 /* POST DEFERRED BY AN ISR                                   */
+    INT8U         OSIntQType;             /* Service to call, see OS_INT_Q_TYPE_xxx                    */
+    INT8U         OSIntQOpt;              /* 'opt' argument of the service, or 'prio' of OSQPostPrio() */
+    void         *OSIntQObj;              /* Pointer to the OS_EVENT or OS_FLAG_GRP posted to          */
+    void         *OSIntQMsg;              /* Message posted (mailboxes and queues)                     */
+    INT32U        OSIntQFlags;            /* Flags posted (event flags)                                */
+} OS_INT_Q;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -726,18 +936,21 @@ OS_EXT  OS_STK            OSTaskStatStk[OS_TASK_STAT_STK_SIZE];      /* Statisti
 
 OS_EXT  INT8U             OSIntNesting;             /* Interrupt nesting level                         */
 
+#if OS_TASK_PROFILE_EN > 0
+OS_EXT  INT32U            OSIntCyclesTot;           /* Cycles spent in ISRs (wraps around)             */
+OS_EXT  INT32U            OSIntCyclesStart;         /* Snapshot of cycle counter at ISR entry          */
+OS_EXT  INT32U            OSIntCyclesPrev;          /* OSIntCyclesTot at start of statistics period    */
+OS_EXT  INT16U            OSIntCPUUsage;            /* ISR CPU usage over last stat. period (0.01 %)   */
+OS_EXT  INT32U            OSProfileTsPrev;          /* Timestamp at start of statistics period         */
+#endif
+
 OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting level                 */
 
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
 OS_EXT  INT8U             OSPrioHighRdy;            /* Priority of highest priority task               */
 
-#if OS_LOWEST_PRIO <= 63
 OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT8U             OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#else
-OS_EXT  INT16U            OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT16U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#endif
+OS_EXT  INT32U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 
 OS_EXT  BOOLEAN           OSRunning;                       /* Flag indicating that kernel is running   */
 
@@ -755,6 +968,19 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if OS_SCHED_RR_EN > 0
+OS_EXT  OS_TCB           *OSRdyList[OS_LOWEST_PRIO + 1];   /* Ready TCB to run next at each priority   */
+#endif
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+OS_EXT  OS_INT_Q          OSIntQTbl[OS_INT_Q_SIZE]; /* Posts deferred by ISRs (circular buffer)        */
+OS_EXT  OS_INT_Q         *OSIntQIn;                 /* Where the next deferred post is inserted        */
+OS_EXT  OS_INT_Q         *OSIntQOut;                /* Next deferred post to apply                     */
+OS_EXT  INT16U            OSIntQCtr;                /* Number of deferred posts not yet applied        */
+OS_EXT  INT16U            OSIntQCtrMax;             /* Peak of OSIntQCtr, to size OS_INT_Q_SIZE        */
+OS_EXT  OS_STK            OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE];     /* Deferred ISR post task stack   */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
@@ -777,18 +1003,34 @@ OS_EXT  volatile  INT32U  OSTime;                   /* Current value of system t
 OS_EXT  INT16U            OSTmrFree;                /* Number of free entries in the timer pool        */
 OS_EXT  INT16U            OSTmrUsed;                /* Number of timers used                           */
 OS_EXT  INT32U            OSTmrTime;                /* Current timer time                              */
+OS_EXT  INT16U            OSTmrRunning;             /* Number of timers linked into the timer wheel    */
+OS_EXT  OS_CPU_TICK_NODE  OSTmrTickNode;            /* Tick list node signaling the timer task         */
 
 OS_EXT  OS_EVENT         *OSTmrSem;                 /* Sem. used to gain exclusive access to timers    */
 OS_EXT  OS_EVENT         *OSTmrSemSignal;           /* Sem. used to signal the update of timers        */
+#if OS_OBJ_STATIC_EN > 0
+OS_EXT  OS_EVENT          OSTmrSemECB;              /* ECBs of the two semaphores above, so that the   */
+OS_EXT  OS_EVENT          OSTmrSemSignalECB;        /* ... timer manager needs none from OSEventTbl[]  */
+#endif
 
+#if OS_TMR_CFG_MAX > 0
 OS_EXT  OS_TMR            OSTmrTbl[OS_TMR_CFG_MAX]; /* Table containing pool of timers                 */
 OS_EXT  OS_TMR           *OSTmrFreeList;            /* Pointer to free list of timers                  */
+#endif
 OS_EXT  OS_STK            OSTmrTaskStk[OS_TASK_TMR_STK_SIZE];
 
-OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_SIZE];
+#if OS_TMR_CFG_CB_TASK_EN > 0
+OS_EXT  OS_EVENT         *OSTmrSemCb;               /* Sem. counting the callbacks to run              */
+#if OS_OBJ_STATIC_EN > 0
+OS_EXT  OS_EVENT          OSTmrSemCbECB;            /* ECB of the semaphore above                      */
+#endif
+OS_EXT  OS_TMR           *OSTmrCbHead;              /* FIFO of expired timers whose callback must run  */
+OS_EXT  OS_TMR           *OSTmrCbTail;
+OS_EXT  OS_STK            OSTmrCbTaskStk[OS_TASK_TMR_CB_STK_SIZE];
 #endif
 
-extern  INT8U   const     OSUnMapTbl[256];          /* Priority->Index    lookup table                 */
+OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_LVLS][OS_TMR_CFG_WHEEL_SIZE];
+#endif
 
 /*$PAGE*/
 /*
@@ -820,10 +1062,62 @@ void          OSEventNameSet          (OS_EVENT        *pevent,
 INT16U        OSEventPendMulti        (OS_EVENT       **pevents_pend,
                                        OS_EVENT       **pevents_rdy,
                                        void           **pmsgs_rdy,
-                                       INT16U           timeout,
+                                       OS_TICK          timeout,
+                                       INT8U           *perr);
+#endif
+
+#endif
+
+/*
+*********************************************************************************************************
+*                                      BYTE-STREAM BUFFER MANAGEMENT
+*********************************************************************************************************
+*/
+#if OS_BUF_EN > 0
+
+#if OS_MAX_EVENTS > 0
+OS_EVENT     *OSBufCreate             (OS_BUF          *pbuf,
+                                       void            *pstorage,
+                                       INT32U           size,
+                                       INT8U           *perr);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT     *OSBufCreateStatic       (OS_EVENT        *pevent,
+                                       OS_BUF          *pbuf,
+                                       void            *pstorage,
+                                       INT32U           size,
+                                       INT8U           *perr);
+#endif
+
+INT8U         OSBufCommit             (OS_EVENT        *pevent,
+                                       void            *pdata,
+                                       INT16U           len);
+
+#if OS_BUF_DEL_EN > 0
+OS_EVENT     *OSBufDel                (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+void         *OSBufGet                (OS_EVENT        *pevent,
+                                       INT16U          *plen,
+                                       OS_TICK          timeout,
                                        INT8U           *perr);
+
+#if OS_BUF_QUERY_EN > 0
+INT8U         OSBufQuery              (OS_EVENT        *pevent,
+                                       OS_BUF_DATA     *p_buf_data);
 #endif
 
+INT8U         OSBufRelease            (OS_EVENT        *pevent,
+                                       void            *pdata);
+
+void         *OSBufReserve            (OS_EVENT        *pevent,
+                                       INT16U           len,
+                                       OS_TICK          timeout,
+                                       INT8U           *perr);
+
 #endif
 
 /*
@@ -832,7 +1126,7 @@ INT16U        OSEventPendMulti        (OS_EVENT       **pevents_pend,
 *********************************************************************************************************
 */
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
 
 #if OS_FLAG_ACCEPT_EN > 0
 OS_FLAGS      OSFlagAccept            (OS_FLAG_GRP     *pgrp,
@@ -841,8 +1135,16 @@ OS_FLAGS      OSFlagAccept            (OS_FLAG_GRP     *pgrp,
                                        INT8U           *perr);
 #endif
 
+#if OS_MAX_FLAGS > 0
 OS_FLAG_GRP  *OSFlagCreate            (OS_FLAGS         flags,
                                       INT8U            *perr);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_FLAG_GRP  *OSFlagCreateStatic      (OS_FLAG_GRP     *pgrp,
+                                       OS_FLAGS         flags,
+                                       INT8U           *perr);
+#endif
 
 #if OS_FLAG_DEL_EN > 0
 OS_FLAG_GRP  *OSFlagDel               (OS_FLAG_GRP     *pgrp,
@@ -863,7 +1165,7 @@ void          OSFlagNameSet           (OS_FLAG_GRP     *pgrp,
 OS_FLAGS      OSFlagPend              (OS_FLAG_GRP     *pgrp,
                                        OS_FLAGS         flags,
                                        INT8U            wait_type,
-                                       INT16U           timeout,
+                                       OS_TICK          timeout,
                                        INT8U           *perr);
 
 OS_FLAGS      OSFlagPendGetFlagsRdy   (void);
@@ -890,7 +1192,14 @@ OS_FLAGS      OSFlagQuery             (OS_FLAG_GRP     *pgrp,
 void         *OSMboxAccept            (OS_EVENT        *pevent);
 #endif
 
+#if OS_MAX_EVENTS > 0
 OS_EVENT     *OSMboxCreate            (void            *pmsg);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT     *OSMboxCreateStatic      (OS_EVENT        *pevent,
+                                       void            *pmsg);
+#endif
 
 #if OS_MBOX_DEL_EN > 0
 OS_EVENT     *OSMboxDel               (OS_EVENT        *pevent,
@@ -899,7 +1208,7 @@ OS_EVENT     *OSMboxDel               (OS_EVENT        *pevent,
 #endif
 
 void         *OSMboxPend              (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       OS_TICK          timeout,
                                        INT8U           *perr);
 
 #if OS_MBOX_PEND_ABORT_EN > 0
@@ -931,12 +1240,22 @@ INT8U         OSMboxQuery             (OS_EVENT        *pevent,
 *********************************************************************************************************
 */
 
-#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+#if (OS_MEM_EN > 0) && ((OS_MAX_MEM_PART > 0) || (OS_OBJ_STATIC_EN > 0))
 
+#if OS_MAX_MEM_PART > 0
 OS_MEM       *OSMemCreate             (void            *addr,
                                        INT32U           nblks,
                                        INT32U           blksize,
                                        INT8U           *perr);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_MEM       *OSMemCreateStatic       (OS_MEM          *pmem,
+                                       void            *addr,
+                                       INT32U           nblks,
+                                       INT32U           blksize,
+                                       INT8U           *perr);
+#endif
 
 void         *OSMemGet                (OS_MEM          *pmem,
                                        INT8U           *perr);
@@ -972,8 +1291,16 @@ BOOLEAN       OSMutexAccept           (OS_EVENT        *pevent,
                                        INT8U           *perr);
 #endif
 
+#if OS_MAX_EVENTS > 0
 OS_EVENT     *OSMutexCreate           (INT8U            prio,
                                        INT8U           *perr);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT     *OSMutexCreateStatic     (OS_EVENT        *pevent,
+                                       INT8U            prio,
+                                       INT8U           *perr);
+#endif
 
 #if OS_MUTEX_DEL_EN > 0
 OS_EVENT     *OSMutexDel              (OS_EVENT        *pevent,
@@ -982,7 +1309,7 @@ OS_EVENT     *OSMutexDel              (OS_EVENT        *pevent,
 #endif
 
 void          OSMutexPend             (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       OS_TICK          timeout,
                                        INT8U           *perr);
 
 INT8U         OSMutexPost             (OS_EVENT        *pevent);
@@ -1001,15 +1328,29 @@ INT8U         OSMutexQuery            (OS_EVENT        *pevent,
 *********************************************************************************************************
 */
 
-#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))
 
 #if OS_Q_ACCEPT_EN > 0
 void         *OSQAccept               (OS_EVENT        *pevent,
                                        INT8U           *perr);
 #endif
 
+#if (OS_MAX_EVENTS > 0) && (OS_MAX_QS > 0)
 OS_EVENT     *OSQCreate               (void           **start,
                                        INT16U           size);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT     *OSQCreateStatic         (OS_EVENT        *pevent,
+                                       OS_Q            *pq,
+                                       void           **start,
+                                       INT16U           size);
+#endif
+
+#if (OS_MAX_EVENTS > 0) && (OS_MAX_QS > 0) && (OS_Q_PRIO_EN > 0)
+OS_EVENT     *OSQCreatePrio           (OS_Q_MSG        *start,
+                                       INT16U           size);
+#endif
 
 #if OS_Q_DEL_EN > 0
 OS_EVENT     *OSQDel                  (OS_EVENT        *pevent,
@@ -1022,7 +1363,7 @@ INT8U         OSQFlush                (OS_EVENT        *pevent);
 #endif
 
 void         *OSQPend                 (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       OS_TICK          timeout,
                                        INT8U           *perr);
 
 #if OS_Q_PEND_ABORT_EN > 0
@@ -1031,6 +1372,14 @@ INT8U         OSQPendAbort            (OS_EVENT        *pevent,
                                        INT8U           *perr);
 #endif
 
+#if OS_Q_MANY_EN > 0
+INT16U        OSQPendMany             (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           nbr,
+                                       OS_TICK          timeout,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_EN > 0
 INT8U         OSQPost                 (OS_EVENT        *pevent,
                                        void            *pmsg);
@@ -1041,12 +1390,25 @@ INT8U         OSQPostFront            (OS_EVENT        *pevent,
                                        void            *pmsg);
 #endif
 
+#if OS_Q_MANY_EN > 0
+INT16U        OSQPostMany             (OS_EVENT        *pevent,
+                                       void           **pmsgs,
+                                       INT16U           nbr,
+                                       INT8U           *perr);
+#endif
+
 #if OS_Q_POST_OPT_EN > 0
 INT8U         OSQPostOpt              (OS_EVENT        *pevent,
                                        void            *pmsg,
                                        INT8U            opt);
 #endif
 
+#if OS_Q_PRIO_EN > 0
+INT8U         OSQPostPrio             (OS_EVENT        *pevent,
+                                       void            *pmsg,
+                                       INT8U            prio);
+#endif
+
 #if OS_Q_QUERY_EN > 0
 INT8U         OSQQuery                (OS_EVENT        *pevent,
                                        OS_Q_DATA       *p_q_data);
@@ -1055,6 +1417,49 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
 #endif
 
 /*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      READER-WRITER LOCK MANAGEMENT
+*********************************************************************************************************
+*/
+#if OS_RWLOCK_EN > 0
+
+#if OS_MAX_EVENTS > 0
+OS_EVENT     *OSRWLockCreate          (INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT     *OSRWLockCreateStatic    (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+#if OS_RWLOCK_DEL_EN > 0
+OS_EVENT     *OSRWLockDel             (OS_EVENT        *pevent,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+#endif
+
+void          OSRWLockPendRd          (OS_EVENT        *pevent,
+                                       OS_TICK          timeout,
+                                       INT8U           *perr);
+
+void          OSRWLockPendWr          (OS_EVENT        *pevent,
+                                       OS_TICK          timeout,
+                                       INT8U           *perr);
+
+INT8U         OSRWLockPostRd          (OS_EVENT        *pevent);
+
+INT8U         OSRWLockPostWr          (OS_EVENT        *pevent);
+
+#if OS_RWLOCK_QUERY_EN > 0
+INT8U         OSRWLockQuery           (OS_EVENT        *pevent,
+                                       OS_RWLOCK_DATA  *p_rwlock_data);
+#endif
+
+#endif
+
 /*
 *********************************************************************************************************
 *                                          SEMAPHORE MANAGEMENT
@@ -1066,7 +1471,14 @@ INT8U         OSQQuery                (OS_EVENT        *pevent,
 INT16U        OSSemAccept             (OS_EVENT        *pevent);
 #endif
 
+#if OS_MAX_EVENTS > 0
 OS_EVENT     *OSSemCreate             (INT16U           cnt);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT     *OSSemCreateStatic       (OS_EVENT        *pevent,
+                                       INT16U           cnt);
+#endif
 
 #if OS_SEM_DEL_EN > 0
 OS_EVENT     *OSSemDel                (OS_EVENT        *pevent,
@@ -1075,7 +1487,7 @@ OS_EVENT     *OSSemDel                (OS_EVENT        *pevent,
 #endif
 
 void          OSSemPend               (OS_EVENT        *pevent,
-                                       INT16U           timeout,
+                                       OS_TICK          timeout,
                                        INT8U           *perr);
 
 #if OS_SEM_PEND_ABORT_EN > 0
@@ -1159,6 +1571,40 @@ INT8U         OSTaskQuery             (INT8U            prio,
                                        OS_TCB          *p_task_data);
 #endif
 
+#if OS_SCHED_RR_EN > 0
+INT8U         OSTaskQuantumSet        (INT8U            prio,
+                                       INT16U           quantum);
+#endif
+
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+INT8U         OSTaskPreemptThreshSet  (INT8U            prio,
+                                       INT8U            thresh);
+#endif
+
+#if OS_TASK_SEM_EN > 0
+void          OSTaskSemPend           (OS_TICK          timeout,
+                                       INT8U           *perr);
+
+INT8U         OSTaskSemPendAbort      (INT8U            prio);
+
+INT8U         OSTaskSemPost           (INT8U            prio);
+#endif
+
+#if OS_TASK_MSG_EN > 0
+void         *OSTaskMsgPend           (OS_TICK          timeout,
+                                       INT8U           *perr);
+
+INT8U         OSTaskMsgPendAbort      (INT8U            prio);
+
+INT8U         OSTaskMsgPost           (INT8U            prio,
+                                       void            *pmsg);
+#endif
+
+#if OS_TASK_PROFILE_EN > 0
+INT8U         OSTaskProfileGet        (INT8U            prio,
+                                       OS_PROFILE_DATA *p_profile_data);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1166,7 +1612,7 @@ INT8U         OSTaskQuery             (INT8U            prio,
 *********************************************************************************************************
 */
 
-void          OSTimeDly               (INT16U           ticks);
+void          OSTimeDly               (OS_TICK          ticks);
 
 #if OS_TIME_DLY_HMSM_EN > 0
 INT8U         OSTimeDlyHMSM           (INT8U            hours,
@@ -1184,8 +1630,21 @@ INT32U        OSTimeGet               (void);
 void          OSTimeSet               (INT32U           ticks);
 #endif
 
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT8U         OSTimeDlyUntil          (INT32U           time);
+
+INT8U         OSTimePeriodInit        (OS_PERIOD       *pperiod,
+                                       INT32U           ticks);
+
+INT8U         OSTimePeriodWait        (OS_PERIOD       *pperiod);
+#endif
+
 void          OSTimeTick              (void);
 
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickCredit        (INT32U           ticks);
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TIMER MANAGEMENT
@@ -1193,6 +1652,7 @@ void          OSTimeTick              (void);
 */
 
 #if OS_TMR_EN > 0
+#if OS_TMR_CFG_MAX > 0
 OS_TMR      *OSTmrCreate              (INT32U           dly,
                                        INT32U           period,
                                        INT8U            opt,
@@ -1200,6 +1660,18 @@ OS_TMR      *OSTmrCreate              (INT32U           dly,
                                        void            *callback_arg,
                                        INT8U           *pname,
                                        INT8U           *perr);
+#endif
+
+#if OS_OBJ_STATIC_EN > 0
+OS_TMR      *OSTmrCreateStatic        (OS_TMR          *ptmr,
+                                       INT32U           dly,
+                                       INT32U           period,
+                                       INT8U            opt,
+                                       OS_TMR_CALLBACK  callback,
+                                       void            *callback_arg,
+                                       INT8U           *pname,
+                                       INT8U           *perr);
+#endif
 
 BOOLEAN      OSTmrDel                 (OS_TMR          *ptmr,
                                        INT8U           *perr);
@@ -1242,6 +1714,10 @@ void          OSSchedLock             (void);
 void          OSSchedUnlock           (void);
 #endif
 
+#if OS_SCHED_RR_EN > 0
+INT8U         OSSchedYield            (void);
+#endif
+
 void          OSStart                 (void);
 
 void          OSStatInit              (void);
@@ -1256,6 +1732,10 @@ INT16U        OSVersion               (void);
 *********************************************************************************************************
 */
 
+#ifndef OS_CPU_CNT_LEAD_ZEROS
+INT8U         OS_CntLeadZeros         (INT32U           val);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 void          OS_Dummy                (void);
 #endif
@@ -1278,14 +1758,46 @@ void          OS_EventTaskRemoveMulti (OS_TCB          *ptcb,
                                        OS_EVENT       **pevents_multi);
 #endif
 
+void          OS_EventFree            (OS_EVENT        *pevent);
+
 void          OS_EventWaitListInit    (OS_EVENT        *pevent);
+
+#if (OS_SCHED_RR_EN > 0)
+OS_TCB       *OS_EventTaskFind        (OS_EVENT        *pevent,
+                                       INT8U            prio,
+                                       OS_TCB          *pexcl);
 #endif
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_RWLOCK_EN > 0) || (OS_BUF_EN > 0)
+OS_TCB       *OS_EventTaskFindStat    (OS_EVENT        *pevent,
+                                       INT8U            msk);
+
+void          OS_EventTaskRdyTCB      (OS_EVENT        *pevent,
+                                       OS_TCB          *ptcb,
+                                       void            *pmsg,
+                                       INT8U            msk,
+                                       INT8U            pend_stat);
+#endif
+#endif
+
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
+void          OS_FlagFree             (OS_FLAG_GRP     *pgrp);
 void          OS_FlagInit             (void);
 void          OS_FlagUnlink           (OS_FLAG_NODE    *pnode);
 #endif
 
+#if (OS_BUF_EN > 0) && (OS_ISR_POST_DEFERRED_EN > 0)
+void          OS_BufWake              (OS_EVENT        *pevent);
+#endif
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+INT8U         OS_IntQPost             (INT8U            type,
+                                       void            *pobj,
+                                       void            *pmsg,
+                                       INT32U           flags,
+                                       INT8U            opt);
+#endif
+
 void          OS_MemClr               (INT8U           *pdest,
                                        INT16U           size);
 
@@ -1293,14 +1805,25 @@ void          OS_MemCopy              (INT8U           *pdest,
                                        INT8U           *psrc,
                                        INT16U           size);
 
-#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+#if (OS_MEM_EN > 0) && ((OS_MAX_MEM_PART > 0) || (OS_OBJ_STATIC_EN > 0))
 void          OS_MemInit              (void);
 #endif
 
 #if OS_Q_EN > 0
+void          OS_QFree                (OS_Q            *pq);
 void          OS_QInit                (void);
 #endif
 
+#if OS_SCHED_RR_EN > 0
+void          OS_PrioListInsert       (OS_TCB          *ptcb);
+
+void          OS_PrioListRemove       (OS_TCB          *ptcb);
+
+void          OS_RdyListInsert        (OS_TCB          *ptcb);
+
+void          OS_RdyListRemove        (OS_TCB          *ptcb);
+#endif
+
 void          OS_Sched                (void);
 
 #if (OS_EVENT_NAME_SIZE > 1) || (OS_FLAG_NAME_SIZE > 1) || (OS_MEM_NAME_SIZE > 1) || (OS_TASK_NAME_SIZE > 1)
@@ -1312,6 +1835,10 @@ INT8U         OS_StrLen               (INT8U           *psrc);
 
 void          OS_TaskIdle             (void            *p_arg);
 
+#if OS_ISR_POST_DEFERRED_EN > 0
+void          OS_TaskIntQ             (void            *p_arg);
+#endif
+
 #if OS_TASK_STAT_EN > 0
 void          OS_TaskStat             (void            *p_arg);
 #endif
@@ -1322,10 +1849,22 @@ void          OS_TaskStkClr           (OS_STK          *pbos,
                                        INT16U           opt);
 #endif
 
+#if (OS_TASK_SEM_EN > 0) || (OS_TASK_MSG_EN > 0)
+void          OS_TaskSigRdy           (OS_TCB          *ptcb,
+                                       INT8U            pend_stat);
+
+void          OS_TaskSigWait          (INT8U            stat,
+                                       OS_TICK          timeout);
+#endif
+
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
 void          OS_TaskStatStkChk       (void);
 #endif
 
+#if (OS_TASK_PROFILE_EN > 0) && (OS_TASK_STAT_EN > 0)
+void          OS_TaskStatProfile      (void);
+#endif
+
 INT8U         OS_TCBInit              (INT8U            prio,
                                        OS_STK          *ptos,
                                        OS_STK          *pbos,
@@ -1334,6 +1873,22 @@ INT8U         OS_TCBInit              (INT8U            prio,
                                        void            *pext,
                                        INT16U           opt);
 
+void          OS_TickListInsert       (OS_TCB          *ptcb,
+                                       OS_TICK          ticks);
+
+void          OS_TickListRemove       (OS_TCB          *ptcb);
+
+OS_TICK       OS_TickListRemain       (OS_TCB          *ptcb);
+
+#if OS_MUTEX_PI_EN > 0
+void          OS_MutexPrioUpdate      (OS_TCB          *ptcb);
+#endif
+
+#if OS_SCHED_RR_EN > 0
+void          OS_TCBPrioSet           (OS_TCB          *ptcb,
+                                       INT8U            prio);
+#endif
+
 #if OS_TMR_EN > 0
 void          OSTmr_Init              (void);
 #endif
@@ -1346,6 +1901,11 @@ void          OSTmr_Init              (void);
 *********************************************************************************************************
 */
 
+#if (OS_TASK_PROFILE_EN > 0) || (defined ALT_IRQ_PROFILE)
+INT32U        OSCPUTsFreq             (void);
+INT32U        OSCPUTsGet              (void);
+#endif
+
 #if OS_DEBUG_EN > 0
 void          OSDebugInit             (void);
 #endif
@@ -1374,6 +1934,11 @@ void          OSTCBInitHook           (OS_TCB          *ptcb);
 void          OSTimeTickHook          (void);
 #endif
 
+#if OS_TICKLESS_EN > 0
+void          OSTicklessResume        (void);
+void          OSTicklessStretch       (INT32U           ticks);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1427,6 +1992,24 @@ void          OSCtxSw                 (void);
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                         BYTE-STREAM BUFFERS
+*********************************************************************************************************
+*/
+
+#ifndef OS_BUF_EN
+#error  "OS_CFG.H, Missing OS_BUF_EN: Enable (1) or Disable (0) code generation for BYTE-STREAM BUFFERS"
+#else
+    #ifndef OS_BUF_DEL_EN
+    #error  "OS_CFG.H, Missing OS_BUF_DEL_EN: Include code for OSBufDel()"
+    #endif
+
+    #ifndef OS_BUF_QUERY_EN
+    #error  "OS_CFG.H, Missing OS_BUF_QUERY_EN: Include code for OSBufQuery()"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                            EVENT FLAGS
@@ -1551,6 +2134,12 @@ void          OSCtxSw                 (void);
     #endif
 #endif
 
+#ifndef OS_MUTEX_PI_EN
+#error  "OS_CFG.H, Missing OS_MUTEX_PI_EN: Boost a mutex owner to its highest waiter's priority instead of a PIP"
+#elif   (OS_MUTEX_PI_EN > 0) && ((OS_MUTEX_EN == 0) || (OS_SCHED_RR_EN == 0))
+#error  "OS_CFG.H, OS_MUTEX_PI_EN requires OS_MUTEX_EN and OS_SCHED_RR_EN, since an owner shares its waiter's priority"
+#endif
+
 /*
 *********************************************************************************************************
 *                                              MESSAGE QUEUES
@@ -1580,6 +2169,10 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_Q_FLUSH_EN: Include code for OSQFlush()"
     #endif
 
+    #ifndef OS_Q_MANY_EN
+    #error  "OS_CFG.H, Missing OS_Q_MANY_EN: Include code for OSQPendMany() and OSQPostMany()"
+    #endif
+
     #ifndef OS_Q_PEND_ABORT_EN
     #error  "OS_CFG.H, Missing OS_Q_PEND_ABORT_EN: Include code for OSQPendAbort()"
     #endif
@@ -1596,11 +2189,41 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_Q_POST_OPT_EN: Include code for OSQPostOpt()"
     #endif
 
+    #ifndef OS_Q_PRIO_EN
+    #error  "OS_CFG.H, Missing OS_Q_PRIO_EN: Include code for OSQCreatePrio() and OSQPostPrio()"
+    #else
+        #ifndef OS_Q_PRIO_LVLS
+        #error  "OS_CFG.H, Missing OS_Q_PRIO_LVLS: Number of message priorities"
+        #else
+            #if     (OS_Q_PRIO_LVLS < 1) || (OS_Q_PRIO_LVLS > 32)
+            #error  "OS_CFG.H, OS_Q_PRIO_LVLS must be between 1 and 32"
+            #endif
+        #endif
+    #endif
+
     #ifndef OS_Q_QUERY_EN
     #error  "OS_CFG.H, Missing OS_Q_QUERY_EN: Include code for OSQQuery()"
     #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                          READER-WRITER LOCKS
+*********************************************************************************************************
+*/
+
+#ifndef OS_RWLOCK_EN
+#error  "OS_CFG.H, Missing OS_RWLOCK_EN: Enable (1) or Disable (0) code generation for READER-WRITER LOCKS"
+#else
+    #ifndef OS_RWLOCK_DEL_EN
+    #error  "OS_CFG.H, Missing OS_RWLOCK_DEL_EN: Include code for OSRWLockDel()"
+    #endif
+
+    #ifndef OS_RWLOCK_QUERY_EN
+    #error  "OS_CFG.H, Missing OS_RWLOCK_QUERY_EN: Include code for OSRWLockQuery()"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                              SEMAPHORES
@@ -1644,9 +2267,11 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H,         OS_MAX_TASKS must be >= 2"
     #endif
 
+    #if     OS_SCHED_RR_EN == 0
     #if     OS_MAX_TASKS >  ((OS_LOWEST_PRIO - OS_N_SYS_TASKS) + 1)
     #error  "OS_CFG.H,         OS_MAX_TASKS must be <= OS_LOWEST_PRIO - OS_N_SYS_TASKS + 1"
     #endif
+    #endif
 
 #endif
 
@@ -1670,6 +2295,14 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_STAT_STK_CHK_EN: Check task stacks from statistics task"
 #endif
 
+#ifndef OS_TASK_STAT_TS_EN
+#error  "OS_CFG.H, Missing OS_TASK_STAT_TS_EN: Measure CPU usage from timestamps instead of the idle counter"
+#else
+    #if     (OS_TASK_STAT_TS_EN > 0) && (OS_TASK_PROFILE_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_STAT_TS_EN requires OS_TASK_PROFILE_EN"
+    #endif
+#endif
+
 #ifndef OS_TASK_CHANGE_PRIO_EN
 #error  "OS_CFG.H, Missing OS_TASK_CHANGE_PRIO_EN: Include code for OSTaskChangePrio()"
 #endif
@@ -1698,6 +2331,32 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_QUERY_EN: Include code for OSTaskQuery()"
 #endif
 
+#ifndef OS_SCHED_RR_EN
+#error  "OS_CFG.H, Missing OS_SCHED_RR_EN: Allow several tasks per priority, time sliced in round robin"
+#else
+    #if     OS_SCHED_RR_EN > 0
+    #ifndef OS_SCHED_RR_QUANTUM
+    #error  "OS_CFG.H, Missing OS_SCHED_RR_QUANTUM: Default time slice of a task (in ticks)"
+    #else
+        #if     OS_SCHED_RR_QUANTUM < 1
+        #error  "OS_CFG.H, OS_SCHED_RR_QUANTUM must be >= 1"
+        #endif
+    #endif
+    #endif
+#endif
+
+#ifndef OS_TASK_PREEMPT_THRESH_EN
+#error  "OS_CFG.H, Missing OS_TASK_PREEMPT_THRESH_EN: Include code for OSTaskPreemptThreshSet()"
+#endif
+
+#ifndef OS_TASK_SEM_EN
+#error  "OS_CFG.H, Missing OS_TASK_SEM_EN: Include code for OSTaskSemPost() and OSTaskSemPend()"
+#endif
+
+#ifndef OS_TASK_MSG_EN
+#error  "OS_CFG.H, Missing OS_TASK_MSG_EN: Include code for OSTaskMsgPost() and OSTaskMsgPend()"
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIME MANAGEMENT
@@ -1720,6 +2379,12 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_GET_SET_EN: Include code for OSTimeGet() and OSTimeSet()"
 #endif
 
+#ifndef OS_TIME_DLY_UNTIL_EN
+#error  "OS_CFG.H, Missing OS_TIME_DLY_UNTIL_EN: Include code for OSTimeDlyUntil() and OSTimePeriodWait()"
+#elif   (OS_TIME_DLY_UNTIL_EN > 0) && (OS_TIME_GET_SET_EN == 0)
+#error  "OS_CFG.H, OS_TIME_DLY_UNTIL_EN requires OS_TIME_GET_SET_EN, since deadlines are kept in OSTime"
+#endif
+
 /*
 *********************************************************************************************************
 *                                             TIMER MANAGEMENT
@@ -1737,8 +2402,8 @@ void          OSCtxSw                 (void);
     #ifndef OS_TMR_CFG_MAX
     #error  "OS_CFG.H, Missing OS_TMR_CFG_MAX: Determines the total number of timers in an application (2 .. 65500)"
     #else
-        #if OS_TMR_CFG_MAX < 2
-        #error  "OS_CFG.H, OS_TMR_CFG_MAX should be between 2 and 65500"
+        #if (OS_TMR_CFG_MAX < 2) && ((OS_TMR_CFG_MAX != 0) || (OS_OBJ_STATIC_EN == 0))
+        #error  "OS_CFG.H, OS_TMR_CFG_MAX should be between 2 and 65500 (or 0 with OS_OBJ_STATIC_EN)"
         #endif
 
         #if OS_TMR_CFG_MAX > 65500
@@ -1756,6 +2421,18 @@ void          OSCtxSw                 (void);
         #if OS_TMR_CFG_WHEEL_SIZE > 1024
         #error  "OS_CFG.H, OS_TMR_CFG_WHEEL_SIZE should be between 2 and 1024"
         #endif
+
+        #if (OS_TMR_CFG_WHEEL_SIZE & (OS_TMR_CFG_WHEEL_SIZE - 1)) != 0
+        #error  "OS_CFG.H, OS_TMR_CFG_WHEEL_SIZE must be a power of 2"
+        #endif
+    #endif
+
+    #ifndef OS_TMR_CFG_WHEEL_LVLS
+    #error  "OS_CFG.H, Missing OS_TMR_CFG_WHEEL_LVLS: Sets the number of levels of the timer wheel (1 .. 8)"
+    #else
+        #if (OS_TMR_CFG_WHEEL_LVLS < 1) || (OS_TMR_CFG_WHEEL_LVLS > 8)
+        #error  "OS_CFG.H, OS_TMR_CFG_WHEEL_LVLS should be between 1 and 8"
+        #endif
     #endif
 
     #ifndef OS_TMR_CFG_NAME_SIZE
@@ -1764,11 +2441,76 @@ void          OSCtxSw                 (void);
 
     #ifndef OS_TMR_CFG_TICKS_PER_SEC
     #error  "OS_CFG.H, Missing OS_TMR_CFG_TICKS_PER_SEC: Determines the rate at which tiem timer management task will run (Hz)"
+    #else
+        #if OS_TMR_CFG_TICKS_PER_SEC > OS_TICKS_PER_SEC
+        #error  "OS_CFG.H, OS_TMR_CFG_TICKS_PER_SEC should not exceed OS_TICKS_PER_SEC, the timer task runs from the tick"
+        #endif
     #endif
 
     #ifndef OS_TASK_TMR_STK_SIZE
     #error  "OS_CFG.H, Missing OS_TASK_TMR_STK_SIZE: Determines the size of the Timer Task's stack"
     #endif
+
+    #ifndef OS_TMR_CFG_CB_TASK_EN
+    #error  "OS_CFG.H, Missing OS_TMR_CFG_CB_TASK_EN: Run timer callbacks from a task, outside of the timer lock"
+    #elif   OS_TMR_CFG_CB_TASK_EN > 0
+        #ifndef OS_TASK_TMR_CB_PRIO
+        #error  "OS_CFG.H, Missing OS_TASK_TMR_CB_PRIO: Priority of the timer callback task"
+        #else
+            #if     OS_TASK_TMR_CB_PRIO >= OS_TASK_STAT_PRIO
+            #error  "OS_CFG.H, OS_TASK_TMR_CB_PRIO must be higher (lower number) than OS_TASK_STAT_PRIO"
+            #endif
+
+            #if     OS_TASK_TMR_CB_PRIO == OS_TASK_TMR_PRIO
+            #error  "OS_CFG.H, OS_TASK_TMR_CB_PRIO must differ from OS_TASK_TMR_PRIO"
+            #endif
+
+            #if     (OS_ISR_POST_DEFERRED_EN > 0) && (OS_TASK_TMR_CB_PRIO == OS_TASK_INT_Q_PRIO)
+            #error  "OS_CFG.H, OS_TASK_TMR_CB_PRIO must differ from OS_TASK_INT_Q_PRIO"
+            #endif
+        #endif
+
+        #ifndef OS_TASK_TMR_CB_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_TMR_CB_STK_SIZE: Timer callback task stack size"
+        #endif
+    #endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           DEFERRED ISR POSTS
+*********************************************************************************************************
+*/
+
+#ifndef OS_ISR_POST_DEFERRED_EN
+#error  "OS_CFG.H, Missing OS_ISR_POST_DEFERRED_EN: Defer posts made from ISRs to the OS_TaskIntQ() task"
+#else
+    #if     OS_ISR_POST_DEFERRED_EN > 0
+        #ifndef OS_INT_Q_SIZE
+        #error  "OS_CFG.H, Missing OS_INT_Q_SIZE: Number of posts that ISRs may defer at once"
+        #else
+            #if     (OS_INT_Q_SIZE < 1) || (OS_INT_Q_SIZE > 65535)
+            #error  "OS_CFG.H, OS_INT_Q_SIZE should be between 1 and 65535"
+            #endif
+        #endif
+
+        #ifndef OS_TASK_INT_Q_PRIO
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_PRIO: Priority of the deferred ISR post task"
+        #else
+            #if     OS_TASK_INT_Q_PRIO >= OS_TASK_STAT_PRIO
+            #error  "OS_CFG.H, OS_TASK_INT_Q_PRIO must be higher (lower number) than OS_TASK_STAT_PRIO"
+            #endif
+
+            #if     (OS_TMR_EN > 0) && (OS_TASK_INT_Q_PRIO == OS_TASK_TMR_PRIO)
+            #error  "OS_CFG.H, OS_TASK_INT_Q_PRIO must differ from OS_TASK_TMR_PRIO"
+            #endif
+        #endif
+
+        #ifndef OS_TASK_INT_Q_STK_SIZE
+        #error  "OS_CFG.H, Missing OS_TASK_INT_Q_STK_SIZE: Deferred ISR post task stack size"
+        #endif
+    #endif
 #endif
 
 
@@ -1821,6 +2563,10 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_EVENT_MULTI_EN: Include code for OSEventPendMulti()"
 #endif
 
+#ifndef OS_OBJ_STATIC_EN
+#error  "OS_CFG.H, Missing OS_OBJ_STATIC_EN: Include code for the ...CreateStatic() functions"
+#endif
+
 
 #ifndef OS_TASK_PROFILE_EN
 #error  "OS_CFG.H, Missing OS_TASK_PROFILE_EN: Include data structure for run-time task profiling"
@@ -1841,6 +2587,25 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TIME_TICK_HOOK_EN: Allows you to include the code for OSTimeTickHook() or not"
 #endif
 
+
+#ifndef OS_TICKLESS_EN
+#error  "OS_CFG.H, Missing OS_TICKLESS_EN: Stop the tick interrupt while the idle task runs"
+#endif
+
+
+#ifndef OS_CPU_TICK_NODE_INSERT
+#error  "OS_CPU.H, Missing OS_CPU_TICK_NODE_INSERT: The port must provide the tick list (OS_CPU_TICK_NODE...)"
+#endif
+
+
+#ifndef OS_TICK_NBITS
+#error  "OS_CFG.H, Missing OS_TICK_NBITS: Determine #bits used for delays and timeouts, MUST be either 16 or 32"
+#else
+    #if     (OS_TICK_NBITS != 16) && (OS_TICK_NBITS != 32)
+    #error  "OS_CFG.H, OS_TICK_NBITS must be either 16 or 32"
+    #endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                         SAFETY CRITICAL USE
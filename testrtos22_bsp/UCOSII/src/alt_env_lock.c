@@ -45,6 +45,10 @@
 
 OS_EVENT *alt_envsem;
 
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT alt_envsem_ecb;
+#endif
+
 #if OS_THREAD_SAFE_NEWLIB
 /* id of the task that is currently manipulating the environment */
 
@@ -0,0 +1,1107 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                      BYTE-STREAM BUFFER MANAGEMENT
+*
+*                              (c) Copyright 1992-2007, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_BUF.C
+* Version : V2.86
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.  
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micrim to properly license 
+* its use in your product. We provide ALL the source code for your convenience and to help you experience 
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a 
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+
+#if OS_BUF_EN > 0
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*
+* Note(s): The storage area is a ring of records.  Each record starts with a 32-bit header holding the
+*          length of its data in the lower 16 bits and its state in the upper 16 bits, followed by the
+*          data, padded to a multiple of 4 bytes.  A record never wraps around the end of the storage
+*          area: if it does not fit at the end, a SKIP header marks the rest of the area as unused and
+*          the record is placed at the start.  A record committed shorter than reserved, while records
+*          reserved after it follow, is followed by a PAD record covering the room it doesn't use.
+*********************************************************************************************************
+*/
+
+#define  OS_BUF_HDR_SIZE             4u
+#define  OS_BUF_REC_SIZE(len)       (OS_BUF_HDR_SIZE + (((INT32U)(len) + 3u) & ~3u))
+#define  OS_BUF_HDR_LEN(hdr)        ((INT16U)((hdr) & 0x0000FFFFL))
+
+#define  OS_BUF_STATE_MSK           0xFFFF0000L
+#define  OS_BUF_STATE_RESERVED      0x00010000L    /* Being written by a producer                      */
+#define  OS_BUF_STATE_COMMITTED     0x00020000L    /* Waiting for a consumer                           */
+#define  OS_BUF_STATE_TAKEN         0x00030000L    /* Being read by a consumer                         */
+#define  OS_BUF_STATE_RELEASED      0x00040000L    /* Done with, freed once the records before it are  */
+#define  OS_BUF_STATE_SKIP          0x00050000L    /* Unused end of the storage area                   */
+#define  OS_BUF_STATE_PAD           0x00060000L    /* Unused room after a record committed shorter     */
+
+/*
+*********************************************************************************************************
+*                                           LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void     *OSBuf_Alloc(OS_BUF *pbuf, INT16U len);
+static  INT32U   *OSBuf_HdrGet(OS_BUF *pbuf, void *pdata);
+static  BOOLEAN   OSBuf_Reclaim(OS_BUF *pbuf);
+static  INT32U   *OSBuf_Take(OS_BUF *pbuf);
+static  BOOLEAN   OSBuf_Wake(OS_EVENT *pevent);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       CREATE A BYTE-STREAM BUFFER
+*
+* Description: This function creates a byte-stream buffer: a ring of variable length records written and
+*              read in place.  A producer reserves room for a record with OSBufReserve(), writes it and
+*              makes it available with OSBufCommit().  A consumer obtains the oldest record with
+*              OSBufGet(), reads it and frees its room with OSBufRelease().
+*
+* Arguments  : pbuf          is a pointer to the buffer control block, supplied by the application.
+*
+*              pstorage      is a pointer to the storage area of the records.  It MUST be aligned on a
+*                            4 byte boundary.
+*
+*              size          is the size of the storage area, in bytes.  It MUST be a multiple of 4.
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a buffer from an ISR
+*                               OS_ERR_PDATA_NULL   if 'pbuf' is a NULL pointer
+*                               OS_ERR_BUF_SIZE     if 'pstorage' or 'size' are not valid
+*                               OS_ERR_PEVENT_NULL  No more event control blocks available.
+*
+* Returns    : != (void *)0  is a pointer to the event control clock (OS_EVENT) associated with the
+*                            created buffer.
+*              == (void *)0  if an error is detected.
+*
+* Note(s)    : 'pbuf' and 'pstorage' MUST remain valid for as long as the buffer is in use.
+*********************************************************************************************************
+*/
+
+#if OS_MAX_EVENTS > 0
+OS_EVENT  *OSBufCreate (OS_BUF *pbuf, void *pstorage, INT32U size, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_EVENT *)0);
+    }
+    if (pbuf == (OS_BUF *)0) {                             /* Validate 'pbuf'                          */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_EVENT *)0);
+    }
+    if ((pstorage == (void *)0) ||                         /* Validate storage area                    */
+        (((INT32U)pstorage & 3u) != 0) ||
+        (size < OS_BUF_HDR_SIZE) ||
+        ((size & 3u) != 0)) {
+        *perr = OS_ERR_BUF_SIZE;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                              /* Get next free event control block        */
+    if (pevent == (OS_EVENT *)0) {                         /* See if an ECB was available              */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEVENT_NULL;                        /* No more event control blocks             */
+        return (pevent);
+    }
+    OSEventFreeList        = (OS_EVENT *)OSEventFreeList->OSEventPtr;   /* Adjust the free list        */
+    OS_EXIT_CRITICAL();
+    pbuf->OSBufStart       = (INT8U *)pstorage;            /* Initialize the buffer, empty             */
+    pbuf->OSBufSize        = size;
+    pbuf->OSBufHead        = 0;
+    pbuf->OSBufOut         = 0;
+    pbuf->OSBufTail        = 0;
+    pbuf->OSBufUsed        = 0;
+    pbuf->OSBufEntries     = 0;
+    pevent->OSEventType    = OS_EVENT_TYPE_BUF;
+    pevent->OSEventCnt     = 0;
+    pevent->OSEventPtr     = (void *)pbuf;                 /* Point to buffer control block            */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              CREATE A BYTE-STREAM BUFFER IN APPLICATION STORAGE
+*
+* Description: This function creates a byte-stream buffer using an event control block supplied by the
+*              application instead of taking one from the OSEventTbl[] pool.
+*
+* Arguments  : pevent        is a pointer to the event control block to use.
+*
+*              pbuf          is a pointer to the buffer control block.
+*
+*              pstorage      is a pointer to the storage area of the records (see OSBufCreate()).
+*
+*              size          is the size of the storage area, in bytes.
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a buffer from an ISR
+*                               OS_ERR_PEVENT_NULL  if 'pevent' is a NULL pointer
+*                               OS_ERR_PDATA_NULL   if 'pbuf' is a NULL pointer
+*                               OS_ERR_BUF_SIZE     if 'pstorage' or 'size' are not valid
+*
+* Returns    : != (void *)0  is 'pevent'
+*              == (void *)0  if an error is detected.
+*
+* Note(s)    : 1) 'pevent', 'pbuf' and 'pstorage' MUST remain valid for as long as the buffer is in use.
+*
+*              2) OSBufDel() does not return 'pevent' to the pool; the application may reuse it once the
+*                 buffer has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT  *OSBufCreateStatic (OS_EVENT *pevent, OS_BUF *pbuf, void *pstorage, INT32U size, INT8U *perr)
+{
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_EVENT *)0);
+    }
+    if (pbuf == (OS_BUF *)0) {                             /* Validate 'pbuf'                          */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((OS_EVENT *)0);
+    }
+    if ((pstorage == (void *)0) ||                         /* Validate storage area                    */
+        (((INT32U)pstorage & 3u) != 0) ||
+        (size < OS_BUF_HDR_SIZE) ||
+        ((size & 3u) != 0)) {
+        *perr = OS_ERR_BUF_SIZE;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_EVENT *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+    pbuf->OSBufStart       = (INT8U *)pstorage;            /* Initialize the buffer, empty             */
+    pbuf->OSBufSize        = size;
+    pbuf->OSBufHead        = 0;
+    pbuf->OSBufOut         = 0;
+    pbuf->OSBufTail        = 0;
+    pbuf->OSBufUsed        = 0;
+    pbuf->OSBufEntries     = 0;
+    pevent->OSEventType    = OS_EVENT_TYPE_BUF;
+    pevent->OSEventCnt     = 0;
+    pevent->OSEventPtr     = (void *)pbuf;                 /* Point to buffer control block            */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       DELETE A BYTE-STREAM BUFFER
+*
+* Description: This function deletes a byte-stream buffer and readies all tasks pending on it.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired buffer.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the buffer ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the buffer even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied
+*                                                    and get OS_ERR_PEND_ABORT.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the buffer was deleted
+*                            OS_ERR_DEL_ISR          If you attempted to delete the buffer from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the buffer
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a buffer
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the buffer was successfully deleted.
+*
+* Note(s)    : 1) This function must be used with care.  Tasks that would normally expect the presence of
+*                 the buffer MUST check the return code of OSBufReserve() and OSBufGet().
+*
+*              2) The records in the buffer are dropped.  Records reserved or obtained before the buffer
+*                 was deleted MUST NOT be committed or released.
+*********************************************************************************************************
+*/
+
+#if OS_BUF_DEL_EN > 0
+OS_EVENT  *OSBufDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
+{
+    BOOLEAN    tasks_waiting;
+    OS_EVENT  *pevent_return;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pevent);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {        /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0) {                         /* See if any tasks waiting on the buffer   */
+        tasks_waiting = OS_TRUE;                           /* Yes                                      */
+    } else {
+        tasks_waiting = OS_FALSE;                          /* No                                       */
+    }
+    switch (opt) {
+        case OS_DEL_NO_PEND:                               /* Delete buffer only if no task waiting    */
+             if (tasks_waiting == OS_FALSE) {
+#if OS_EVENT_NAME_SIZE > 1
+                 pevent->OSEventName[0] = '?';             /* Unknown name                             */
+                 pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+                 pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+                 pevent->OSEventCnt     = 0;
+                 OS_EventFree(pevent);                     /* Return Event Control Block to free list  */
+                 OS_EXIT_CRITICAL();
+                 *perr                  = OS_ERR_NONE;
+                 pevent_return          = (OS_EVENT *)0;   /* Buffer has been deleted                  */
+             } else {
+                 OS_EXIT_CRITICAL();
+                 *perr                  = OS_ERR_TASK_WAITING;
+                 pevent_return          = pevent;
+             }
+             break;
+
+        case OS_DEL_ALWAYS:                                /* Always delete the buffer                 */
+             while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for the buffer   */
+                 (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_BUF_GET | OS_STAT_BUF_PUT,
+                                       OS_STAT_PEND_ABORT);
+             }
+#if OS_EVENT_NAME_SIZE > 1
+             pevent->OSEventName[0] = '?';                 /* Unknown name                             */
+             pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+             pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+             pevent->OSEventCnt     = 0;
+             OS_EventFree(pevent);                         /* Return Event Control Block to free list  */
+             OS_EXIT_CRITICAL();
+             if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
+                 OS_Sched();                               /* Find highest priority task ready to run  */
+             }
+             *perr                  = OS_ERR_NONE;
+             pevent_return          = (OS_EVENT *)0;       /* Buffer has been deleted                  */
+             break;
+
+        default:
+             OS_EXIT_CRITICAL();
+             *perr                  = OS_ERR_INVALID_OPT;
+             pevent_return          = pevent;
+             break;
+    }
+    return (pevent_return);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   RESERVE ROOM FOR A RECORD IN A BUFFER
+*
+* Description: This function reserves room for a record of 'len' bytes, which the caller then writes in
+*              place and makes available to consumers with OSBufCommit().
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired buffer
+*
+*              len           is the length of the record, in bytes.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for room in the buffer up to the amount of time specified by this
+*                            argument.  If you specify 0, however, your task will wait forever for room.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and room was reserved.
+*                            OS_ERR_TIMEOUT      No room was available within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The buffer was deleted while the task was waiting.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a buffer
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_BUF_SIZE     If a record of 'len' bytes can never fit in the buffer
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : != (void *)0  is a pointer to the room reserved, aligned on a 4 byte boundary
+*              == (void *)0  upon error
+*
+* Note(s)    : 1) Records are delivered in the order they were reserved.  A record reserved but not yet
+*                 committed holds back the records reserved after it.
+*
+*              2) Waiting tasks get room in priority order: a task does not get room ahead of a higher
+*                 priority task waiting for a bigger record.
+*********************************************************************************************************
+*/
+
+void  *OSBufReserve (OS_EVENT *pevent, INT16U len, OS_TICK timeout, INT8U *perr)
+{
+    void      *pdata;
+    OS_BUF    *pbuf;
+    OS_TCB    *ptcb;
+    BOOLEAN    rdy;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {   /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    pbuf = (OS_BUF *)pevent->OSEventPtr;              /* Point at buffer control block                 */
+    if (OS_BUF_REC_SIZE(len) > pbuf->OSBufSize) {     /* See if the record can ever fit                */
+        *perr = OS_ERR_BUF_SIZE;
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    ptcb = (OS_TCB *)0;
+    if ((pevent->OSEventGrp != 0) && (OSIntNesting == 0)) {   /* Don't go ahead of a higher prio task  */
+        ptcb = OS_EventTaskFindStat(pevent, OS_STAT_BUF_PUT);
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb->OSTCBPrio > OSTCBCur->OSTCBPrio)) {
+        pdata = OSBuf_Alloc(pbuf, len);
+        if (pdata != (void *)0) {                     /* See if there was room                         */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_NONE;
+            return (pdata);
+        }
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return ((void *)0);
+    }
+    OSTCBCur->OSTCBMsg       = (void *)(INT32U)len;   /* Tell OSBuf_Wake() how much room is needed     */
+    OSTCBCur->OSTCBStat     |= OS_STAT_BUF_PUT;       /* Task will have to pend for room               */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Load timeout into TCB and tick list           */
+    OS_EventTaskWait(pevent);                         /* Suspend task until room or timeout occurs     */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready to run  */
+    OS_ENTER_CRITICAL();
+    rdy = OS_FALSE;
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Room reserved by OSBuf_Wake()                 */
+             pdata =  OSTCBCur->OSTCBMsg;
+            *perr  =  OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             pdata = (void *)0;
+            *perr  =  OS_ERR_PEND_ABORT;              /* Indicate that the buffer was deleted          */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             rdy   =  OSBuf_Wake(pevent);             /* Smaller records held back may now fit         */
+             pdata = (void *)0;
+            *perr  =  OS_ERR_TIMEOUT;                 /* Indicate that we didn't get room within TO    */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    return (pdata);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   MAKE A RECORD AVAILABLE TO CONSUMERS
+*
+* Description: This function completes a record reserved with OSBufReserve().  The record is delivered to
+*              consumers once the records reserved before it are committed as well.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired buffer
+*
+*              pdata         is the pointer returned by OSBufReserve().
+*
+*              len           is the number of bytes actually written, at most the length reserved.  If
+*                            the record is the last one reserved, the room not used is given back.
+*
+* Returns    : OS_ERR_NONE           The call was successful.
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a buffer.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_BUF_PTR        If 'pdata' is not a record reserved in this buffer
+*              OS_ERR_BUF_SIZE       If 'len' is more than the length reserved
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are already
+*                                    deferred (see OS_IntQPost()).  The record is committed, but the
+*                                    tasks waiting for it are readied by the next commit or release.
+*
+* Note(s)    : This function may be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OSBufCommit (OS_EVENT *pevent, void *pdata, INT16U len)
+{
+    OS_BUF    *pbuf;
+    INT32U    *phdr;
+    INT32U     off;
+    INT32U     end;
+#if OS_ISR_POST_DEFERRED_EN == 0
+    BOOLEAN    rdy;
+#endif
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {   /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    pbuf = (OS_BUF *)pevent->OSEventPtr;              /* Point at buffer control block                 */
+    OS_ENTER_CRITICAL();
+    phdr = OSBuf_HdrGet(pbuf, pdata);
+    if ((phdr == (INT32U *)0) || ((*phdr & OS_BUF_STATE_MSK) != OS_BUF_STATE_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_BUF_PTR);
+    }
+    if (len > OS_BUF_HDR_LEN(*phdr)) {                /* Can't write more than reserved                */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_BUF_SIZE);
+    }
+    off = (INT32U)((INT8U *)phdr - pbuf->OSBufStart);
+    end = off + OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr));
+    if (end == pbuf->OSBufSize) {
+        end = 0;
+    }
+    if (end == pbuf->OSBufHead) {                     /* Last record reserved, give back unused room   */
+        pbuf->OSBufHead  = off + OS_BUF_REC_SIZE(len);
+        pbuf->OSBufUsed -= OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr)) - OS_BUF_REC_SIZE(len);
+        if (pbuf->OSBufHead == pbuf->OSBufSize) {
+            pbuf->OSBufHead = 0;
+        }
+    } else if (OS_BUF_REC_SIZE(len) < OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr))) {
+        phdr[OS_BUF_REC_SIZE(len) / 4u] = OS_BUF_STATE_PAD    /* Pad up to the next record             */
+                                        | (OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr)) - OS_BUF_REC_SIZE(len)
+                                           - OS_BUF_HDR_SIZE);
+        pbuf->OSBufEntries++;
+    }
+    *phdr = OS_BUF_STATE_COMMITTED | (INT32U)len;
+    if (pevent->OSEventGrp == 0) {                    /* See if any task is waiting                    */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OS_EXIT_CRITICAL();
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() ready the tasks             */
+        return (OS_IntQPost(OS_INT_Q_TYPE_BUF, (void *)pevent, (void *)0, 0, OS_POST_OPT_NONE));
+    }
+    OS_BufWake(pevent);                               /* Give the record to a waiting consumer         */
+#else
+    rdy = OS_FALSE;
+    while (OSBuf_Wake(pevent) == OS_TRUE) {           /* Give the record to a waiting consumer         */
+        rdy = OS_TRUE;
+    }
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    GET THE OLDEST RECORD FROM A BUFFER
+*
+* Description: This function gives the calling task the oldest committed record, which it reads in place
+*              and hands back with OSBufRelease().
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired buffer
+*
+*              plen          is a pointer to where the length of the record is returned.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a record up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever for a record.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task got a record.
+*                            OS_ERR_TIMEOUT      A record was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The buffer was deleted while the task was waiting.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a buffer
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'plen' is a NULL pointer
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : != (void *)0  is a pointer to the data of the record
+*              == (void *)0  upon error
+*
+* Note(s)    : Several records may be obtained before releasing them.  The room of a record is reused
+*              once it and all the records before it are released.
+*********************************************************************************************************
+*/
+
+void  *OSBufGet (OS_EVENT *pevent, INT16U *plen, OS_TICK timeout, INT8U *perr)
+{
+    void      *pdata;
+    INT32U    *phdr;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((void *)0);
+    }
+    if (plen == (INT16U *)0) {                        /* Validate 'plen'                               */
+        *perr = OS_ERR_PDATA_NULL;
+        return ((void *)0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {   /* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return ((void *)0);
+    }
+    *plen = 0;
+    OS_ENTER_CRITICAL();
+    phdr = OSBuf_Take((OS_BUF *)pevent->OSEventPtr);  /* See if a record is available                  */
+    if (phdr != (INT32U *)0) {
+        OS_EXIT_CRITICAL();
+        *plen = OS_BUF_HDR_LEN(*phdr);
+        *perr = OS_ERR_NONE;
+        return ((void *)(phdr + 1));                  /* Return the record's data                      */
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return ((void *)0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return ((void *)0);
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_BUF_GET;       /* Task will have to pend for a record           */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Load timeout into TCB and tick list           */
+    OS_EventTaskWait(pevent);                         /* Suspend task until record or timeout occurs   */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready to run  */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Record given by OSBuf_Wake()                  */
+             pdata =  OSTCBCur->OSTCBMsg;
+            *plen  =  OS_BUF_HDR_LEN(*((INT32U *)pdata - 1));
+            *perr  =  OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             pdata = (void *)0;
+            *perr  =  OS_ERR_PEND_ABORT;              /* Indicate that the buffer was deleted          */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             pdata = (void *)0;
+            *perr  =  OS_ERR_TIMEOUT;                 /* Indicate that we didn't get a record within TO*/
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                       */
+    OS_EXIT_CRITICAL();
+    return (pdata);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       HAND A RECORD BACK TO A BUFFER
+*
+* Description: This function tells the buffer that the caller is done with a record obtained with
+*              OSBufGet(), so that its room can be reused.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired buffer
+*
+*              pdata         is the pointer returned by OSBufGet().
+*
+* Returns    : OS_ERR_NONE           The call was successful.
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a buffer.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_BUF_PTR        If 'pdata' is not a record obtained from this buffer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are already
+*                                    deferred (see OS_IntQPost()).  The record is released, but the
+*                                    tasks waiting for room are readied by the next commit or release.
+*
+* Note(s)    : This function may be called from an ISR.
+*********************************************************************************************************
+*/
+
+INT8U  OSBufRelease (OS_EVENT *pevent, void *pdata)
+{
+    OS_BUF    *pbuf;
+    INT32U    *phdr;
+#if OS_ISR_POST_DEFERRED_EN == 0
+    BOOLEAN    rdy;
+#endif
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {   /* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    pbuf = (OS_BUF *)pevent->OSEventPtr;              /* Point at buffer control block                 */
+    OS_ENTER_CRITICAL();
+    phdr = OSBuf_HdrGet(pbuf, pdata);
+    if ((phdr == (INT32U *)0) || ((*phdr & OS_BUF_STATE_MSK) != OS_BUF_STATE_TAKEN)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_BUF_PTR);
+    }
+    *phdr = OS_BUF_STATE_RELEASED | (*phdr & ~OS_BUF_STATE_MSK);
+    if ((OSBuf_Reclaim(pbuf) == OS_FALSE) ||          /* See if room was freed ...                     */
+        (pevent->OSEventGrp  == 0)) {                 /* ... and a task is waiting for it              */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OS_EXIT_CRITICAL();
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() ready the tasks             */
+        return (OS_IntQPost(OS_INT_Q_TYPE_BUF, (void *)pevent, (void *)0, 0, OS_POST_OPT_NONE));
+    }
+    OS_BufWake(pevent);                               /* Give the room to waiting producers            */
+#else
+    rdy = OS_FALSE;
+    while (OSBuf_Wake(pevent) == OS_TRUE) {           /* Give the room to waiting producers            */
+        rdy = OS_TRUE;
+    }
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+#endif
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       QUERY A BYTE-STREAM BUFFER
+*
+* Description: This function obtains information about a byte-stream buffer.
+*
+* Arguments  : pevent          is a pointer to the event control block associated with the desired buffer
+*
+*              p_buf_data      is a pointer to a structure that will contain information about the buffer
+*
+* Returns    : OS_ERR_NONE          The call was successful
+*              OS_ERR_PEVENT_NULL   If 'pevent'     is a NULL pointer
+*              OS_ERR_PDATA_NULL    If 'p_buf_data' is a NULL pointer
+*              OS_ERR_EVENT_TYPE    If you are attempting to obtain data from a non buffer.
+*********************************************************************************************************
+*/
+
+#if OS_BUF_QUERY_EN > 0
+INT8U  OSBufQuery (OS_EVENT *pevent, OS_BUF_DATA *p_buf_data)
+{
+    OS_BUF    *pbuf;
+    INT8U      i;
+    INT32U    *psrc;
+    INT32U    *pdest;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (p_buf_data == (OS_BUF_DATA *)0) {                  /* Validate 'p_buf_data'                    */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {        /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    pbuf                      = (OS_BUF *)pevent->OSEventPtr;
+    p_buf_data->OSSize        = pbuf->OSBufSize;
+    p_buf_data->OSUsed        = pbuf->OSBufUsed;
+    p_buf_data->OSEntries     = pbuf->OSBufEntries;
+    p_buf_data->OSEventGrp    = pevent->OSEventGrp;        /* Copy wait list                           */
+    psrc                      = &pevent->OSEventTbl[0];
+    pdest                     = &p_buf_data->OSEventTbl[0];
+    for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
+        *pdest++ = *psrc++;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif                                                     /* OS_BUF_QUERY_EN                          */
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  READY THE TASKS WAITING ON A BUFFER
+*
+* Description: OSBuf_Wake() readies one waiting task: it reserves room for the highest priority waiting
+*              producer if it fits, or else gives the oldest record to the highest priority waiting
+*              consumer.  The producers thus wait behind one that does not fit.  Calling it until it
+*              returns OS_FALSE readies all the tasks that can be.
+*
+*              While OS_ISR_POST_DEFERRED_EN is set, OS_BufWake() does so for the commits and releases,
+*              called by them or, for those made by ISRs, by OS_TaskIntQ().  It readies the tasks one at
+*              a time, with interrupts enabled in between and the scheduler locked.
+*
+* Arguments  : pevent          is a pointer to the event control block of the buffer
+*
+* Returns    : OSBuf_Wake() returns OS_TRUE if a task was readied, OS_FALSE otherwise.
+*
+* Note(s)    : 1) OS_BufWake() is INTERNAL to uC/OS-II and your application should not call it.
+*              2) OSBuf_Wake() assumes that interrupts are disabled.
+*********************************************************************************************************
+*/
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+void  OS_BufWake (OS_EVENT *pevent)
+{
+    BOOLEAN    rdy;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventType != OS_EVENT_TYPE_BUF) {   /* Buffer deleted since the ISR ran              */
+        OS_EXIT_CRITICAL();
+        return;
+    }
+    if (OSLockNesting < 255u) {                       /* No task may pend or delete while we post      */
+        OSLockNesting++;
+    }
+    rdy = OS_FALSE;
+    while (OSBuf_Wake(pevent) == OS_TRUE) {           /* Ready the waiting tasks one at a time ...     */
+        rdy = OS_TRUE;
+        OS_EXIT_CRITICAL();                           /* ... letting interrupts in between: the posts  */
+        OS_ENTER_CRITICAL();                          /* ... of ISRs are deferred                      */
+    }
+    if (OSLockNesting > 0) {                          /* Remove context switch lock                    */
+        OSLockNesting--;
+    }
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+}
+#endif
+
+
+static  BOOLEAN  OSBuf_Wake (OS_EVENT *pevent)
+{
+    OS_BUF    *pbuf;
+    OS_TCB    *ptcb;
+    INT32U    *phdr;
+    void      *pdata;
+
+
+    pbuf = (OS_BUF *)pevent->OSEventPtr;
+    ptcb = OS_EventTaskFindStat(pevent, OS_STAT_BUF_PUT);
+    if (ptcb != (OS_TCB *)0) {                        /* Reserve room for the producers, HPT first     */
+        pdata = OSBuf_Alloc(pbuf, (INT16U)(INT32U)ptcb->OSTCBMsg);
+        if (pdata != (void *)0) {                     /* Else the others wait behind this one          */
+            OS_EventTaskRdyTCB(pevent, ptcb, pdata, OS_STAT_BUF_PUT, OS_STAT_PEND_OK);
+            return (OS_TRUE);
+        }
+    }
+    ptcb = OS_EventTaskFindStat(pevent, OS_STAT_BUF_GET);
+    if (ptcb != (OS_TCB *)0) {                        /* Give the records to the consumers, HPT first  */
+        phdr = OSBuf_Take(pbuf);
+        if (phdr != (INT32U *)0) {
+            OS_EventTaskRdyTCB(pevent, ptcb, (void *)(phdr + 1), OS_STAT_BUF_GET, OS_STAT_PEND_OK);
+            return (OS_TRUE);
+        }
+    }
+    return (OS_FALSE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      RESERVE ROOM FOR A RECORD
+*
+* Description: This function reserves room for a record of 'len' bytes at the head of the ring, wrapping
+*              to the start of the storage area if the record doesn't fit at its end.
+*
+* Arguments  : pbuf            is a pointer to the buffer control block
+*
+*              len             is the length of the record, in bytes
+*
+* Returns    : a pointer to the data of the record, or NULL if there is no room for it
+*
+* Note(s)    : This function assumes that interrupts are disabled.
+*********************************************************************************************************
+*/
+
+static  void  *OSBuf_Alloc (OS_BUF *pbuf, INT16U len)
+{
+    INT32U   need;
+    INT32U  *phdr;
+
+
+    need = OS_BUF_REC_SIZE(len);
+    if (pbuf->OSBufUsed == 0) {                       /* Empty, start over to get the most room        */
+        pbuf->OSBufHead = 0;
+        pbuf->OSBufOut  = 0;
+        pbuf->OSBufTail = 0;
+    }
+    if (pbuf->OSBufHead >= pbuf->OSBufTail) {         /* Free room at the end and before the tail      */
+        if ((pbuf->OSBufUsed != 0) && (pbuf->OSBufHead == pbuf->OSBufTail)) {
+            return ((void *)0);                       /* Full                                          */
+        }
+        if (need > pbuf->OSBufSize - pbuf->OSBufHead) {
+            if (need > pbuf->OSBufTail) {             /* Doesn't fit at the start either               */
+                return ((void *)0);
+            }
+            phdr               = (INT32U *)(pbuf->OSBufStart + pbuf->OSBufHead);
+            *phdr              = OS_BUF_STATE_SKIP;   /* Leave the end unused and wrap                 */
+            pbuf->OSBufUsed   += pbuf->OSBufSize - pbuf->OSBufHead;
+            pbuf->OSBufEntries++;
+            pbuf->OSBufHead    = 0;
+        }
+    } else if (need > pbuf->OSBufTail - pbuf->OSBufHead) {
+        return ((void *)0);                           /* Free room between head and tail too small     */
+    }
+    phdr              = (INT32U *)(pbuf->OSBufStart + pbuf->OSBufHead);
+    *phdr             = OS_BUF_STATE_RESERVED | (INT32U)len;
+    pbuf->OSBufHead  += need;
+    if (pbuf->OSBufHead == pbuf->OSBufSize) {
+        pbuf->OSBufHead = 0;
+    }
+    pbuf->OSBufUsed  += need;
+    pbuf->OSBufEntries++;
+    return ((void *)(phdr + 1));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     TAKE AND RECLAIM RECORDS
+*
+* Description: OSBuf_Take() returns the header of the next record for a consumer if it is committed.
+*              OSBuf_Reclaim() frees the room of the oldest records once they are released.
+*              OSBuf_HdrGet() returns the header of the record whose data is at 'pdata'.
+*
+* Arguments  : pbuf            is a pointer to the buffer control block
+*
+*              pdata           is a pointer to the data of a record
+*
+* Returns    : OSBuf_Take() and OSBuf_HdrGet() return a pointer to the header, or NULL if there is none.
+*              OSBuf_Reclaim() returns OS_TRUE if room was freed, OS_FALSE otherwise.
+*
+* Note(s)    : These functions assume that interrupts are disabled.
+*********************************************************************************************************
+*/
+
+static  INT32U  *OSBuf_Take (OS_BUF *pbuf)
+{
+    INT32U  *phdr;
+
+
+    while (pbuf->OSBufEntries > 0) {
+        phdr = (INT32U *)(pbuf->OSBufStart + pbuf->OSBufOut);
+        switch (*phdr & OS_BUF_STATE_MSK) {
+            case OS_BUF_STATE_SKIP:                   /* Wrap to the start of the storage area         */
+                 pbuf->OSBufOut = 0;
+                 pbuf->OSBufEntries--;
+                 break;
+
+            case OS_BUF_STATE_PAD:                    /* Step over the unused room                     */
+                 pbuf->OSBufOut += OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr));
+                 if (pbuf->OSBufOut == pbuf->OSBufSize) {
+                     pbuf->OSBufOut = 0;
+                 }
+                 pbuf->OSBufEntries--;
+                 break;
+
+            case OS_BUF_STATE_COMMITTED:
+                 *phdr           = OS_BUF_STATE_TAKEN | (*phdr & ~OS_BUF_STATE_MSK);
+                 pbuf->OSBufOut += OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr));
+                 if (pbuf->OSBufOut == pbuf->OSBufSize) {
+                     pbuf->OSBufOut = 0;
+                 }
+                 pbuf->OSBufEntries--;
+                 return (phdr);
+
+            default:                                  /* Oldest record still being written             */
+                 return ((INT32U *)0);
+        }
+    }
+    return ((INT32U *)0);
+}
+
+
+static  BOOLEAN  OSBuf_Reclaim (OS_BUF *pbuf)
+{
+    INT32U   *phdr;
+    INT32U    size;
+    BOOLEAN   freed;
+
+
+    freed = OS_FALSE;
+    while (pbuf->OSBufUsed > 0) {
+        phdr = (INT32U *)(pbuf->OSBufStart + pbuf->OSBufTail);
+        if ((*phdr & OS_BUF_STATE_MSK) == OS_BUF_STATE_SKIP) {
+            if ((pbuf->OSBufOut     == pbuf->OSBufTail) &&    /* Consumers didn't wrap yet, ...        */
+                (pbuf->OSBufEntries >  0)) {              /* ... do it for them                    */
+                pbuf->OSBufOut = 0;
+                pbuf->OSBufEntries--;
+            }
+            size = pbuf->OSBufSize - pbuf->OSBufTail;
+        } else if ((*phdr & OS_BUF_STATE_MSK) == OS_BUF_STATE_PAD) {
+            size = OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr));
+            if ((pbuf->OSBufOut     == pbuf->OSBufTail) &&    /* Consumers didn't step over it, ...    */
+                (pbuf->OSBufEntries >  0)) {              /* ... do it for them                    */
+                pbuf->OSBufOut += size;
+                if (pbuf->OSBufOut == pbuf->OSBufSize) {
+                    pbuf->OSBufOut = 0;
+                }
+                pbuf->OSBufEntries--;
+            }
+        } else if ((*phdr & OS_BUF_STATE_MSK) == OS_BUF_STATE_RELEASED) {
+            size = OS_BUF_REC_SIZE(OS_BUF_HDR_LEN(*phdr));
+        } else {
+            break;                                    /* Oldest record still in use                    */
+        }
+        pbuf->OSBufUsed -= size;
+        pbuf->OSBufTail += size;
+        if (pbuf->OSBufTail == pbuf->OSBufSize) {
+            pbuf->OSBufTail = 0;
+        }
+        freed = OS_TRUE;
+    }
+    return (freed);
+}
+
+
+static  INT32U  *OSBuf_HdrGet (OS_BUF *pbuf, void *pdata)
+{
+    INT8U  *p;
+
+
+    p = (INT8U *)pdata;
+    if ((p <  pbuf->OSBufStart + OS_BUF_HDR_SIZE) ||  /* Must be within the storage area ...           */
+        (p >  pbuf->OSBufStart + pbuf->OSBufSize) ||
+        (((INT32U)(p - pbuf->OSBufStart) & 3u) != 0)) {   /* ... and on a record boundary              */
+        return ((INT32U *)0);
+    }
+    return ((INT32U *)(p - OS_BUF_HDR_SIZE));
+}
+
+#endif                                                     /* OS_BUF_EN                                */
@@ -26,35 +26,6 @@
 #include <ucos_ii.h>
 #endif
 
-/*
-*********************************************************************************************************
-*                                       PRIORITY RESOLUTION TABLE
-*
-* Note: Index into table is bit pattern to resolve highest priority
-*       Indexed value corresponds to highest priority bit position (i.e. 0..7)
-*********************************************************************************************************
-*/
-
-INT8U  const  OSUnMapTbl[256] = {
-    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x00 to 0x0F                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x10 to 0x1F                             */
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x20 to 0x2F                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x30 to 0x3F                             */
-    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x40 to 0x4F                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x50 to 0x5F                             */
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x60 to 0x6F                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x70 to 0x7F                             */
-    7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x80 to 0x8F                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0x90 to 0x9F                             */
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xA0 to 0xAF                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xB0 to 0xBF                             */
-    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xC0 to 0xCF                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xD0 to 0xDF                             */
-    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,       /* 0xE0 to 0xEF                             */
-    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0        /* 0xF0 to 0xFF                             */
-};
-
-/*$PAGE*/
 /*
 *********************************************************************************************************
 *                                       FUNCTION PROTOTYPES
@@ -69,6 +40,10 @@ static  void  OS_InitRdyList(void);
 
 static  void  OS_InitTaskIdle(void);
 
+#if OS_ISR_POST_DEFERRED_EN > 0
+static  void  OS_InitTaskIntQ(void);
+#endif
+
 #if OS_TASK_STAT_EN > 0
 static  void  OS_InitTaskStat(void);
 #endif
@@ -77,6 +52,12 @@ static  void  OS_InitTCBList(void);
 
 static  void  OS_SchedNew(void);
 
+#if (OS_TASK_PROFILE_EN > 0) && (OS_TASK_STAT_EN > 0)
+static  INT16U  OS_TaskStatUsage(INT32U cycles, INT32U period);
+#endif
+
+static  INT32U  OS_TickExpire(void *p_arg);
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -137,6 +118,8 @@ INT8U  OSEventNameGet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_RWLOCK:
+        case OS_EVENT_TYPE_BUF:
              break;
 
         default:
@@ -211,6 +194,8 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
         case OS_EVENT_TYPE_MUTEX:
         case OS_EVENT_TYPE_MBOX:
         case OS_EVENT_TYPE_Q:
+        case OS_EVENT_TYPE_RWLOCK:
+        case OS_EVENT_TYPE_BUF:
              break;
 
         default:
@@ -303,11 +288,11 @@ void  OSEventNameSet (OS_EVENT *pevent, INT8U *pname, INT8U *perr)
 */
 /*$PAGE*/
 #if ((OS_EVENT_EN) && (OS_EVENT_MULTI_EN > 0))
-INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void **pmsgs_rdy, INT16U timeout, INT8U *perr)
+INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void **pmsgs_rdy, OS_TICK timeout, INT8U *perr)
 {
     OS_EVENT  **pevents;
     OS_EVENT   *pevent;
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+#if ((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)))
     OS_Q       *pq;
 #endif
     BOOLEAN     events_rdy;
@@ -351,7 +336,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
             case OS_EVENT_TYPE_MBOX:
                  break;
 #endif
-#if ((OS_Q_EN   > 0) && (OS_MAX_QS > 0))
+#if ((OS_Q_EN   > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)))
             case OS_EVENT_TYPE_Q:
                  break;
 #endif
@@ -415,7 +400,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
                  break;
 #endif
 
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+#if ((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)))
             case OS_EVENT_TYPE_Q:
                  pq = (OS_Q *)pevent->OSEventPtr;
                  if (pq->OSQEntries > 0) {              /* If queue NOT empty;                     ... */
@@ -458,7 +443,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
     OSTCBCur->OSTCBStat     |= events_stat  |           /* Resource not available, ...                 */
                                OS_STAT_MULTI;           /* ... pend on multiple events                 */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;                 /* Store pend timeout in TCB                   */
+    OS_TickListInsert(OSTCBCur, timeout);               /* Store pend timeout in TCB and tick list     */
     OS_EventTaskWaitMulti(pevents_pend);                /* Suspend task until events or timeout occurs */
 
     OS_EXIT_CRITICAL();
@@ -496,7 +481,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
 #endif
 
 #if ((OS_MBOX_EN > 0) ||                 \
-    ((OS_Q_EN    > 0) && (OS_MAX_QS > 0)))
+    ((OS_Q_EN    > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))))
                  case OS_EVENT_TYPE_MBOX:
                  case OS_EVENT_TYPE_Q:
                      *pmsgs_rdy++ = (void *)OSTCBCur->OSTCBMsg;     /* Return received message         */
@@ -563,15 +548,15 @@ void  OSInit (void)
 
     OS_InitEventList();                                          /* Initialize the free list of OS_EVENTs    */
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
     OS_FlagInit();                                               /* Initialize the event flag structures     */
 #endif
 
-#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+#if (OS_MEM_EN > 0) && ((OS_MAX_MEM_PART > 0) || (OS_OBJ_STATIC_EN > 0))
     OS_MemInit();                                                /* Initialize the memory manager            */
 #endif
 
-#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
 
@@ -579,6 +564,9 @@ void  OSInit (void)
 #if OS_TASK_STAT_EN > 0
     OS_InitTaskStat();                                           /* Create the Statistic Task                */
 #endif
+#if OS_ISR_POST_DEFERRED_EN > 0
+    OS_InitTaskIntQ();                                           /* Create the deferred ISR post task        */
+#endif
 
 #if OS_TMR_EN > 0
     OSTmr_Init();                                                /* Initialize the Timer Manager             */
@@ -616,6 +604,10 @@ void  OSInit (void)
 
 void  OSIntEnter (void)
 {
+#if OS_TASK_PROFILE_EN > 0
+    INT32U     ts;
+    INT32U     cycles;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -625,6 +617,15 @@ void  OSIntEnter (void)
         if (OSIntNesting < 255u) {
             OSIntNesting++;                      /* Increment ISR nesting level                        */
         }
+#if OS_TASK_PROFILE_EN > 0
+        if (OSIntNesting == 1) {                 /* Stop charging the interrupted task ...             */
+            ts                          = OSCPUTsGet();
+            cycles                      = ts - OSTCBCur->OSTCBCyclesStart;
+            OSTCBCur->OSTCBCyclesTot   += cycles;
+            OSTCBCur->OSTCBCyclesSlice += cycles;
+            OSIntCyclesStart            = ts;    /* ... and start charging the ISR(s)                  */
+        }
+#endif
         OS_EXIT_CRITICAL();
     }
 }
@@ -650,6 +651,9 @@ void  OSIntEnter (void)
 
 void  OSIntExit (void)
 {
+#if OS_TASK_PROFILE_EN > 0
+    INT32U     ts;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -662,10 +666,25 @@ void  OSIntExit (void)
             OSIntNesting--;
         }
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
+#if OS_TASK_PROFILE_EN > 0
+            ts                         = OSCPUTsGet();     /* Charge the ISR(s) and resume charging    */
+            OSIntCyclesTot            += ts - OSIntCyclesStart;   /* ... the interrupted task          */
+            OSTCBCur->OSTCBCyclesStart = ts;
+#endif
+#if OS_TICKLESS_EN > 0
+            if (OSPrioCur == OS_TASK_IDLE_PRIO) {          /* Leave tickless idle, the ISR may have    */
+                OSTicklessResume();                        /* ... readied a task or started an alarm   */
+            }
+#endif
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
+#if OS_SCHED_RR_EN > 0
+                OSTCBHighRdy  = OSRdyList[OSPrioHighRdy];  /* Tasks may share the priority             */
+                if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy */
+#else
                 if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy */
                     OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                     OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task  */
 #endif
@@ -761,6 +780,54 @@ void  OSSchedUnlock (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 YIELD TO A TASK OF THE SAME PRIORITY
+*
+* Description: This function is called by a task to give up the rest of its time slice to the next ready
+*              task that shares its priority.  The calling task is placed at the end of the ready tasks
+*              at its priority and gets a full time slice the next time it runs.
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE         if another task at the same priority was given the CPU.
+*              OS_ERR_YIELD_ISR    if you called this function from an ISR.
+*              OS_ERR_YIELD_NONE   if no other task is ready at the priority of the calling task.
+*
+* Notes      : 1) Higher priority tasks preempt the tasks of a priority level whether or not they yield.
+*              2) When the scheduler is locked, the order is changed but the switch occurs at
+*                 OSSchedUnlock().
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+INT8U  OSSchedYield (void)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                                /* Can't yield from an ISR                  */
+        return (OS_ERR_YIELD_ISR);
+    }
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBCur;
+    if (ptcb->OSTCBRdyNext == ptcb) {                      /* Alone at this priority?                  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_YIELD_NONE);
+    }
+    ptcb->OSTCBQuantumCtr      = ptcb->OSTCBQuantum;       /* Full slice next time around              */
+    OSRdyList[ptcb->OSTCBPrio] = ptcb->OSTCBRdyNext;       /* Next ready task at this priority runs    */
+    OS_EXIT_CRITICAL();
+    OS_Sched();
+    return (OS_ERR_NONE);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -787,7 +854,11 @@ void  OSStart (void)
     if (OSRunning == OS_FALSE) {
         OS_SchedNew();                               /* Find highest priority's task priority number   */
         OSPrioCur     = OSPrioHighRdy;
+#if OS_SCHED_RR_EN > 0
+        OSTCBHighRdy  = OSRdyList[OSPrioHighRdy];    /* Point to highest priority task ready to run    */
+#else
         OSTCBHighRdy  = OSTCBPrioTbl[OSPrioHighRdy]; /* Point to highest priority task ready to run    */
+#endif
         OSTCBCur      = OSTCBHighRdy;
         OSStartHighRdy();                            /* Execute target specific code to start task     */
     }
@@ -807,6 +878,9 @@ void  OSStart (void)
 *                 CPU Usage (%) = 100 * (1 - ------------)
 *                                            OSIdleCtrMax
 *
+*              With OS_TASK_STAT_TS_EN, the time the idle task runs is measured with the profiling
+*              timestamps instead, and nothing needs to be calibrated: this function returns at once.
+*
 * Arguments  : none
 *
 * Returns    : none
@@ -822,6 +896,11 @@ void  OSStatInit (void)
 
 
 
+#if OS_TASK_STAT_TS_EN > 0
+    OS_ENTER_CRITICAL();
+    OSStatRdy    = OS_TRUE;                      /* Idle time is measured, not estimated               */
+    OS_EXIT_CRITICAL();
+#else
     OSTimeDly(2);                                /* Synchronize with clock tick                        */
     OS_ENTER_CRITICAL();
     OSIdleCtr    = 0L;                           /* Clear idle counter                                 */
@@ -831,6 +910,7 @@ void  OSStatInit (void)
     OSIdleCtrMax = OSIdleCtr;                    /* Store maximum idle counter count in 1/10 second    */
     OSStatRdy    = OS_TRUE;
     OS_EXIT_CRITICAL();
+#endif
 }
 #endif
 /*$PAGE*/
@@ -845,12 +925,18 @@ void  OSStatInit (void)
 * Arguments  : none
 *
 * Returns    : none
+*
+* Note(s)    : 1) Delays and timeouts are not processed here: they are nodes of the port's tick list (see
+*                 OS_TickListInsert()) which the port expires just before it calls this function.  On
+*                 Nios II that is done by alt_tick().
 *********************************************************************************************************
 */
 
 void  OSTimeTick (void)
 {
+#if OS_SCHED_RR_EN > 0
     OS_TCB    *ptcb;
+#endif
 #if OS_TICK_STEP_EN > 0
     BOOLEAN    step;
 #endif
@@ -893,31 +979,63 @@ void  OSTimeTick (void)
             return;
         }
 #endif
-        ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
-        while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
-            OS_ENTER_CRITICAL();
-            if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
-                if (--ptcb->OSTCBDly == 0) {               /* Decrement nbr of ticks to end of delay       */
-                                                           /* Check for timeout                            */
-                    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
-                        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag   */
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout    */
-                    } else {
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
-                    }
-
-                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
-                        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
-                        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-                    }
+#if OS_SCHED_RR_EN > 0
+        OS_ENTER_CRITICAL();                               /* Charge the tick to the running task's slice  */
+        ptcb = OSTCBCur;
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+        if ((ptcb->OSTCBRdyNext    != (OS_TCB *)0) &&      /* Only a ready task is time sliced, and not if */
+            (ptcb->OSTCBPrioThresh >= ptcb->OSTCBPrio)) {  /* ... a threshold holds off its peers          */
+#else
+        if (ptcb->OSTCBRdyNext != (OS_TCB *)0) {           /* Only a ready task is time sliced             */
+#endif
+            if (ptcb->OSTCBQuantumCtr > 1) {
+                ptcb->OSTCBQuantumCtr--;
+            } else {                                       /* Slice used up, the next ready task at the    */
+                ptcb->OSTCBQuantumCtr = ptcb->OSTCBQuantum;/* ... same priority runs when the ISR exits    */
+                if (OSRdyList[ptcb->OSTCBPrio] == ptcb) {
+                    OSRdyList[ptcb->OSTCBPrio] = ptcb->OSTCBRdyNext;
                 }
             }
-            ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
-            OS_EXIT_CRITICAL();
         }
+        OS_EXIT_CRITICAL();
+#endif
     }
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      CREDIT SKIPPED CLOCK TICKS
+*
+* Description: This function is called by the port when the tick interrupt resumes after a tickless idle
+*              period, to account in one step for the ticks that elapsed without an interrupt.  The tick
+*              that ends the period is still processed by OSTimeTick().  Delays and timeouts have already
+*              been credited by the port's tick list (on Nios II, alt_tick_credit()).
+*
+* Arguments  : ticks     is the number of ticks to credit.  The idle task never stretches the period past
+*                        the next due delay or timeout, so no task becomes ready here.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Interrupts are assumed to be disabled when this function is called.
+*              2) OSTimeTickHook() is NOT called for the credited ticks: it is only called for the ticks
+*                 that OSTimeTick() processes.  Calling it once per credited tick would keep interrupts
+*                 disabled for a time that grows with the length of the idle period.  Code that counts
+*                 time in the hook must read OSTimeGet() instead when OS_TICKLESS_EN is enabled.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+void  OSTimeTickCredit (INT32U ticks)
+{
+#if OS_TIME_GET_SET_EN > 0
+    OSTime += ticks;                                       /* Update the 32-bit tick counter in one step   */
+#else
+    ticks   = ticks;                                       /* Prevent compiler warning if not used         */
+#endif
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -938,6 +1056,54 @@ INT16U  OSVersion (void)
     return (OS_VERSION);
 }
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        COUNT LEADING ZEROS
+*
+* Description: This function returns the number of leading zero bits in a 32-bit word.  It is used to find
+*              the highest priority task in the ready list and in event wait lists, since priority 'p' is
+*              bit (31 - p % 32) of word (p / 32).  It is compiled only if the port does not define
+*              OS_CPU_CNT_LEAD_ZEROS() to use an instruction instead (see OS_CPU.H).
+*
+* Arguments  : val     is the word to scan.  It MUST NOT be 0.
+*
+* Returns    : the number of leading zeros (0 to 31), found in 5 steps without any table lookup.
+*
+* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#ifndef OS_CPU_CNT_LEAD_ZEROS
+INT8U  OS_CntLeadZeros (INT32U val)
+{
+    INT8U  nbr;
+
+
+    nbr = 0;
+    if ((val & 0xFFFF0000L) == 0) {                     /* Halve the bits left to scan at each step    */
+        nbr  += 16;
+        val <<= 16;
+    }
+    if ((val & 0xFF000000L) == 0) {
+        nbr  +=  8;
+        val <<=  8;
+    }
+    if ((val & 0xF0000000L) == 0) {
+        nbr  +=  4;
+        val <<=  4;
+    }
+    if ((val & 0xC0000000L) == 0) {
+        nbr  +=  2;
+        val <<=  2;
+    }
+    if ((val & 0x80000000L) == 0) {
+        nbr  +=  1;
+    }
+    return (nbr);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -957,6 +1123,41 @@ void  OS_Dummy (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  RETURN AN EVENT CONTROL BLOCK TO THE POOL
+*
+* Description: This function is called by the ...Del() services to give back an ECB they deleted.  ECBs
+*              taken from OSEventTbl[] go back to the free list; ECBs given to an ...CreateStatic()
+*              service belong to the application and are left alone.
+*
+* Arguments  : pevent   is a pointer to the event control block being deleted
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN)
+void  OS_EventFree (OS_EVENT *pevent)
+{
+#if OS_MAX_EVENTS > 0
+#if OS_OBJ_STATIC_EN > 0
+    if ((pevent <  &OSEventTbl[0]) ||                   /* See if the ECB is outside of the pool       */
+        (pevent >= &OSEventTbl[OS_MAX_EVENTS])) {
+        pevent->OSEventPtr = (void *)0;
+        return;
+    }
+#endif
+    pevent->OSEventPtr = OSEventFreeList;               /* Return Event Control Block to free list     */
+    OSEventFreeList    = pevent;
+#else
+    pevent->OSEventPtr = (void *)0;                     /* No pool, all ECBs belong to the application */
+#endif
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -992,33 +1193,23 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     INT8U    y;
     INT8U    x;
     INT8U    prio;
-#if OS_LOWEST_PRIO > 63
-    INT16U  *ptbl;
-#endif
 
 
-#if OS_LOWEST_PRIO <= 63
-    y    = OSUnMapTbl[pevent->OSEventGrp];              /* Find HPT waiting for message                */
-    x    = OSUnMapTbl[pevent->OSEventTbl[y]];
-    prio = (INT8U)((y << 3) + x);                       /* Find priority of task getting the msg       */
+#if OS_EVENT_TBL_SIZE > 1                               /* Find HPT waiting for message                */
+    y    = OS_CntLeadZeros((INT32U)pevent->OSEventGrp << 24);
 #else
-    if ((pevent->OSEventGrp & 0xFF) != 0) {             /* Find HPT waiting for message                */
-        y = OSUnMapTbl[ pevent->OSEventGrp & 0xFF];
-    } else {
-        y = OSUnMapTbl[(pevent->OSEventGrp >> 8) & 0xFF] + 8;
-    }
-    ptbl = &pevent->OSEventTbl[y];
-    if ((*ptbl & 0xFF) != 0) {
-        x = OSUnMapTbl[*ptbl & 0xFF];
-    } else {
-        x = OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8;
-    }
-    prio = (INT8U)((y << 4) + x);                       /* Find priority of task getting the msg       */
+    y    = 0;                                           /* Only one word in the wait list              */
 #endif
+    x    = OS_CntLeadZeros(pevent->OSEventTbl[y]);
+    prio = (INT8U)((y << 5) + x);                       /* Find priority of task getting the msg       */
 
+#if (OS_SCHED_RR_EN > 0)
+    ptcb                  =  OS_EventTaskFind(pevent, prio, (OS_TCB *)0); /* Tasks may share 'prio'    */
+#else
     ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
-    ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
-#if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
+#endif
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
+#if ((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))) || (OS_MBOX_EN > 0) || (OS_BUF_EN > 0)
     ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
 #else
     pmsg                  =  pmsg;                      /* Prevent compiler warning if not used        */
@@ -1027,8 +1218,12 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     ptcb->OSTCBStatPend   =  pend_stat;                 /* Set pend status of post or abort            */
                                                         /* See if task is ready (could be susp'd)      */
     if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
+#if (OS_SCHED_RR_EN > 0)
+        OS_RdyListInsert(ptcb);                         /* Put task in the ready to run list           */
+#else
         OSRdyGrp         |=  ptcb->OSTCBBitY;           /* Put task in the ready to run list           */
         OSRdyTbl[y]      |=  ptcb->OSTCBBitX;
+#endif
     }
 
     OS_EventTaskRemove(ptcb, pevent);                   /* Remove this task from event   wait list     */
@@ -1060,7 +1255,9 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
 #if (OS_EVENT_EN)
 void  OS_EventTaskWait (OS_EVENT *pevent)
 {
+#if (OS_SCHED_RR_EN == 0)
     INT8U  y;
+#endif
 
 
     OSTCBCur->OSTCBEventPtr               = pevent;                 /* Store ptr to ECB in TCB         */
@@ -1068,11 +1265,15 @@ void  OS_EventTaskWait (OS_EVENT *pevent)
     pevent->OSEventTbl[OSTCBCur->OSTCBY] |= OSTCBCur->OSTCBBitX;    /* Put task in waiting list        */
     pevent->OSEventGrp                   |= OSTCBCur->OSTCBBitY;
 
+#if (OS_SCHED_RR_EN > 0)
+    OS_RdyListRemove(OSTCBCur);                   /* Task no longer ready                              */
+#else
     y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
     OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1096,7 +1297,9 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
 {
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
+#if (OS_SCHED_RR_EN == 0)
     INT8U      y;
+#endif
 
 
     OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;
@@ -1111,11 +1314,15 @@ void  OS_EventTaskWaitMulti (OS_EVENT **pevents_wait)
         pevent = *pevents;
     }
 
+#if (OS_SCHED_RR_EN > 0)
+    OS_RdyListRemove(OSTCBCur);                   /* Task no longer ready                              */
+#else
     y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                              */
     OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;         /* Clear event grp bit if this was only task pending */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1141,6 +1348,11 @@ void  OS_EventTaskRemove (OS_TCB   *ptcb,
     INT8U  y;
 
 
+#if (OS_SCHED_RR_EN > 0)
+    if (OS_EventTaskFind(pevent, ptcb->OSTCBPrio, ptcb) != (OS_TCB *)0) {
+        return;                                         /* Another task at this prio is still waiting  */
+    }
+#endif
     y                       =  ptcb->OSTCBY;
     pevent->OSEventTbl[y]  &= ~ptcb->OSTCBBitX;         /* Remove task from wait list                  */
     if (pevent->OSEventTbl[y] == 0) {
@@ -1170,26 +1382,27 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 {
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
+#if (OS_SCHED_RR_EN == 0)
     INT8U      y;
-#if (OS_LOWEST_PRIO <= 63)
     INT8U      bity;
-    INT8U      bitx;
-#else
-    INT16U     bity;
-    INT16U     bitx;
-#endif
+    INT32U     bitx;
 
 
     y       =  ptcb->OSTCBY;
     bity    =  ptcb->OSTCBBitY;
     bitx    =  ptcb->OSTCBBitX;
+#endif
     pevents =  pevents_multi;
     pevent  = *pevents;
     while (pevent != (OS_EVENT *)0) {                   /* Remove task from all events' wait lists     */
+#if (OS_SCHED_RR_EN > 0)
+        OS_EventTaskRemove(ptcb, pevent);               /* ... unless a task at same prio still waits  */
+#else
         pevent->OSEventTbl[y]  &= ~bitx;
         if (pevent->OSEventTbl[y] == 0) {
             pevent->OSEventGrp &= ~bity;
         }
+#endif
         pevents++;
         pevent = *pevents;
     }
@@ -1212,11 +1425,7 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 #if (OS_EVENT_EN)
 void  OS_EventWaitListInit (OS_EVENT *pevent)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U  *ptbl;
-#else
-    INT16U *ptbl;
-#endif
+    INT32U *ptbl;
     INT8U   i;
 
 
@@ -1231,6 +1440,171 @@ void  OS_EventWaitListInit (OS_EVENT *pevent)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                             FIND A TASK WAITING FOR AN EVENT AT A PRIORITY
+*
+* Description: When tasks share a priority, an event's wait list only tells that SOME task at a priority is
+*              waiting.  This function walks the tasks at that priority to find one waiting for the event.
+*
+* Arguments  : pevent   is a pointer to the event control block.
+*
+*              prio     is the priority to look at.
+*
+*              pexcl    is a pointer to a task to skip, or NULL to consider all the tasks.
+*
+* Returns    : a pointer to the first waiting task found, in the order the tasks joined the priority, or
+*              NULL if no other task at 'prio' waits for 'pevent'.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A task that timed out keeps its place until it runs and removes itself, as it does when
+*                 priorities are unique.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN) && (OS_SCHED_RR_EN > 0)
+OS_TCB  *OS_EventTaskFind (OS_EVENT *pevent, INT8U prio, OS_TCB *pexcl)
+{
+    OS_TCB    *ptcb;
+    OS_TCB    *phead;
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT **pevents;
+#endif
+
+
+    phead = OSTCBPrioTbl[prio];
+    if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED)) {
+        return ((OS_TCB *)0);
+    }
+    ptcb  = phead;
+    do {
+        if ((ptcb != pexcl) &&                          /* Still waiting, or timed out but not run yet */
+            (((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) ||
+             (ptcb->OSTCBStatPend == OS_STAT_PEND_TO))) {
+            if (ptcb->OSTCBEventPtr == pevent) {
+                return (ptcb);
+            }
+#if (OS_EVENT_MULTI_EN > 0)
+            pevents = ptcb->OSTCBEventMultiPtr;
+            if (pevents != (OS_EVENT **)0) {
+                while (*pevents != (OS_EVENT *)0) {
+                    if (*pevents == pevent) {
+                        return (ptcb);
+                    }
+                    pevents++;
+                }
+            }
+#endif
+        }
+        ptcb = ptcb->OSTCBPrioNext;
+    } while (ptcb != phead);
+    return ((OS_TCB *)0);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                      FIND THE HIGHEST PRIORITY TASK WAITING FOR AN EVENT IN A GIVEN WAY
+*
+* Description: Objects such as reader-writer locks and byte-stream buffers have tasks waiting on the same
+*              wait list for different conditions, told apart by a bit of OSTCBStat.  This function
+*              returns the highest priority task waiting with one of the bits in 'msk' set.
+*
+* Arguments  : pevent   is a pointer to the event control block.
+*
+*              msk      is the OSTCBStat bit(s) to look for.
+*
+* Returns    : a pointer to the task found, or NULL if no task waits that way.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*              3) A task that timed out has its OSTCBStat bits cleared and is skipped.
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN) && ((OS_RWLOCK_EN > 0) || (OS_BUF_EN > 0))
+OS_TCB  *OS_EventTaskFindStat (OS_EVENT *pevent, INT8U msk)
+{
+    OS_TCB  *ptcb;
+#if (OS_SCHED_RR_EN > 0)
+    OS_TCB  *phead;
+#endif
+    INT32U   tbl;
+    INT8U    y;
+    INT8U    x;
+
+
+    for (y = 0; y < OS_EVENT_TBL_SIZE; y++) {
+        tbl = pevent->OSEventTbl[y];
+        while (tbl != 0) {                              /* Priorities waiting, highest first           */
+            x     = OS_CntLeadZeros(tbl);
+            tbl  &= ~((INT32U)0x80000000L >> x);
+            ptcb  = OSTCBPrioTbl[(y << 5) + x];
+#if (OS_SCHED_RR_EN > 0)
+            phead = ptcb;                               /* Tasks may share the priority                */
+            do {
+                if ((ptcb->OSTCBEventPtr == pevent) && ((ptcb->OSTCBStat & msk) != 0)) {
+                    return (ptcb);
+                }
+                ptcb = ptcb->OSTCBPrioNext;
+            } while (ptcb != phead);
+#else
+            if ((ptcb->OSTCBEventPtr == pevent) && ((ptcb->OSTCBStat & msk) != 0)) {
+                return (ptcb);
+            }
+#endif
+        }
+    }
+    return ((OS_TCB *)0);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  MAKE A GIVEN WAITING TASK READY TO RUN
+*
+* Description: This function readies a task found by OS_EventTaskFindStat(), as OS_EventTaskRdy() does for
+*              the highest priority task waiting for the event.
+*
+* Arguments  : pevent      is a pointer to the event control block corresponding to the event.
+*
+*              ptcb        is a pointer to the task to ready.
+*
+*              pmsg        is a pointer to a message for the task, if any.
+*
+*              msk         is a mask that is used to clear the status byte of the TCB.
+*
+*              pend_stat   is used to indicate the readied task's pending status (see OS_EventTaskRdy()).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The objects using this function cannot be waited for with OSEventPendMulti().
+*********************************************************************************************************
+*/
+#if (OS_EVENT_EN) && ((OS_RWLOCK_EN > 0) || (OS_BUF_EN > 0))
+void  OS_EventTaskRdyTCB (OS_EVENT *pevent, OS_TCB *ptcb, void *pmsg, INT8U msk, INT8U pend_stat)
+{
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
+#if ((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))) || (OS_MBOX_EN > 0) || (OS_BUF_EN > 0)
+    ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
+#else
+    pmsg                  =  pmsg;                      /* Prevent compiler warning if not used        */
+#endif
+    ptcb->OSTCBStat      &= ~msk;                       /* Clear bit associated with event type        */
+    ptcb->OSTCBStatPend   =  pend_stat;                 /* Set pend status of post or abort            */
+                                                        /* See if task is ready (could be susp'd)      */
+    if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
+#if (OS_SCHED_RR_EN > 0)
+        OS_RdyListInsert(ptcb);                         /* Put task in the ready to run list           */
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;      /* Put task in the ready to run list           */
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+    }
+    OS_EventTaskRemove(ptcb, pevent);                   /* Remove this task from event   wait list     */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                             INITIALIZATION
 *                           INITIALIZE THE FREE LIST OF EVENT CONTROL BLOCKS
 *
@@ -1317,6 +1691,14 @@ static  void  OS_InitMisc (void)
     OSIdleCtrMax  = 0L;
     OSStatRdy     = OS_FALSE;                              /* Statistic task is not ready              */
 #endif
+
+#if OS_TASK_PROFILE_EN > 0
+    OSIntCyclesTot   = 0L;                                 /* Clear the time spent in ISRs             */
+    OSIntCyclesStart = 0L;
+    OSIntCyclesPrev  = 0L;
+    OSIntCPUUsage    = 0;
+    OSProfileTsPrev  = 0L;
+#endif
 }
 /*$PAGE*/
 /*
@@ -1335,11 +1717,7 @@ static  void  OS_InitMisc (void)
 static  void  OS_InitRdyList (void)
 {
     INT8U    i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U   *prdytbl;
-#else
-    INT16U  *prdytbl;
-#endif
+    INT32U  *prdytbl;
 
 
     OSRdyGrp      = 0;                                     /* Clear the ready list                     */
@@ -1347,6 +1725,9 @@ static  void  OS_InitRdyList (void)
     for (i = 0; i < OS_RDY_TBL_SIZE; i++) {
         *prdytbl++ = 0;
     }
+#if OS_SCHED_RR_EN > 0
+    OS_MemClr((INT8U *)&OSRdyList[0], sizeof(OSRdyList));  /* No ready task at any priority            */
+#endif
 
     OSPrioCur     = 0;
     OSPrioHighRdy = 0;
@@ -1424,9 +1805,10 @@ static  void  OS_InitTaskIdle (void)
 /*
 *********************************************************************************************************
 *                                             INITIALIZATION
-*                                      CREATING THE STATISTIC TASK
+*                                  CREATING THE DEFERRED ISR POST TASK
 *
-* Description: This function creates the Statistic Task.
+* Description: This function empties the queue of posts deferred by ISRs and creates the task that
+*              applies them.
 *
 * Arguments  : none
 *
@@ -1434,20 +1816,92 @@ static  void  OS_InitTaskIdle (void)
 *********************************************************************************************************
 */
 
-#if OS_TASK_STAT_EN > 0
-static  void  OS_InitTaskStat (void)
+#if OS_ISR_POST_DEFERRED_EN > 0
+static  void  OS_InitTaskIntQ (void)
 {
 #if OS_TASK_NAME_SIZE > 7
     INT8U  err;
 #endif
 
 
+    OSIntQIn     = &OSIntQTbl[0];                                      /* Nothing deferred yet           */
+    OSIntQOut    = &OSIntQTbl[0];
+    OSIntQCtr    = 0;
+    OSIntQCtrMax = 0;
+
 #if OS_TASK_CREATE_EXT_EN > 0
     #if OS_STK_GROWTH == 1
-    (void)OSTaskCreateExt(OS_TaskStat,
-                          (void *)0,                                   /* No args passed to OS_TaskStat()*/
-                          &OSTaskStatStk[OS_TASK_STAT_STK_SIZE - 1],   /* Set Top-Of-Stack               */
-                          OS_TASK_STAT_PRIO,                           /* One higher than the idle task  */
+    (void)OSTaskCreateExt(OS_TaskIntQ,
+                          (void *)0,                                   /* No args passed to OS_TaskIntQ()*/
+                          &OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE - 1],  /* Set Top-Of-Stack               */
+                          OS_TASK_INT_Q_PRIO,                          /* Should be the highest priority */
+                          OS_TASK_INT_Q_ID,
+                          &OSTaskIntQStk[0],                           /* Set Bottom-Of-Stack            */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                   /* No TCB extension               */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);  /* Enable stack checking + clear  */
+    #else
+    (void)OSTaskCreateExt(OS_TaskIntQ,
+                          (void *)0,                                   /* No args passed to OS_TaskIntQ()*/
+                          &OSTaskIntQStk[0],                           /* Set Top-Of-Stack               */
+                          OS_TASK_INT_Q_PRIO,                          /* Should be the highest priority */
+                          OS_TASK_INT_Q_ID,
+                          &OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE - 1],  /* Set Bottom-Of-Stack            */
+                          OS_TASK_INT_Q_STK_SIZE,
+                          (void *)0,                                   /* No TCB extension               */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);  /* Enable stack checking + clear  */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreate(OS_TaskIntQ,
+                       (void *)0,                                      /* No args passed to OS_TaskIntQ()*/
+                       &OSTaskIntQStk[OS_TASK_INT_Q_STK_SIZE - 1],     /* Set Top-Of-Stack               */
+                       OS_TASK_INT_Q_PRIO);                            /* Should be the highest priority */
+    #else
+    (void)OSTaskCreate(OS_TaskIntQ,
+                       (void *)0,                                      /* No args passed to OS_TaskIntQ()*/
+                       &OSTaskIntQStk[0],                              /* Set Top-Of-Stack               */
+                       OS_TASK_INT_Q_PRIO);                            /* Should be the highest priority */
+    #endif
+#endif
+
+#if OS_TASK_NAME_SIZE > 14
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)"uC/OS-II IntQ", &err);
+#else
+#if OS_TASK_NAME_SIZE > 7
+    OSTaskNameSet(OS_TASK_INT_Q_PRIO, (INT8U *)"OS-IntQ", &err);
+#endif
+#endif
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             INITIALIZATION
+*                                      CREATING THE STATISTIC TASK
+*
+* Description: This function creates the Statistic Task.
+*
+* Arguments  : none
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TASK_STAT_EN > 0
+static  void  OS_InitTaskStat (void)
+{
+#if OS_TASK_NAME_SIZE > 7
+    INT8U  err;
+#endif
+
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OS_TaskStat,
+                          (void *)0,                                   /* No args passed to OS_TaskStat()*/
+                          &OSTaskStatStk[OS_TASK_STAT_STK_SIZE - 1],   /* Set Top-Of-Stack               */
+                          OS_TASK_STAT_PRIO,                           /* One higher than the idle task  */
                           OS_TASK_STAT_ID,
                           &OSTaskStatStk[0],                           /* Set Bottom-Of-Stack            */
                           OS_TASK_STAT_STK_SIZE,
@@ -1532,6 +1986,81 @@ static  void  OS_InitTCBList (void)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                        DEFER A POST MADE BY AN ISR
+*
+* Description: This function is called by OSSemPost(), OSMboxPost(), OSMboxPostOpt(), OSQPost(),
+*              OSQPostFront(), OSQPostOpt() and OSFlagPost() when they are called from an ISR.  Instead of
+*              searching the wait list and readying tasks with interrupts disabled, the post is copied into
+*              OSIntQTbl[] and OS_TaskIntQ() applies it once all ISRs have completed.
+*
+* Arguments  : type     is the service to call (see OS_INT_Q_TYPE_xxx)
+*
+*              pobj     is a pointer to the OS_EVENT or OS_FLAG_GRP posted to
+*
+*              pmsg     is the message to post (mailboxes and queues only)
+*
+*              flags    are the flags to set or clear (event flags only)
+*
+*              opt      is the 'opt' argument of the service, if it has one
+*
+* Returns    : OS_ERR_NONE          The post was queued
+*              OS_ERR_INT_Q_FULL    OS_INT_Q_SIZE posts are already waiting, the post is lost
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The time spent with interrupts disabled does not depend on the number of tasks waiting
+*                 on 'pobj'.  Errors found when the post is applied (e.g. OS_ERR_Q_FULL) are not reported.
+*              3) The task is readied only when the queue goes from empty to not empty.  OS_TaskIntQ()
+*                 only removes itself from the ready list after finding the queue empty, so it is always
+*                 ready when OSIntQCtr is not 0.
+*********************************************************************************************************
+*/
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+INT8U  OS_IntQPost (INT8U type, void *pobj, void *pmsg, INT32U flags, INT8U opt)
+{
+    OS_INT_Q  *pq;
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    if (OSIntQCtr >= OS_INT_Q_SIZE) {            /* Make sure the queue is not full                    */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_INT_Q_FULL);
+    }
+    pq              = OSIntQIn;
+    pq->OSIntQType  = type;                      /* Save the post for OS_TaskIntQ()                    */
+    pq->OSIntQOpt   = opt;
+    pq->OSIntQObj   = pobj;
+    pq->OSIntQMsg   = pmsg;
+    pq->OSIntQFlags = flags;
+    OSIntQIn++;
+    if (OSIntQIn == &OSIntQTbl[OS_INT_Q_SIZE]) { /* Wrap IN ptr if we are at end of queue              */
+        OSIntQIn = &OSIntQTbl[0];
+    }
+    OSIntQCtr++;
+    if (OSIntQCtr > OSIntQCtrMax) {
+        OSIntQCtrMax = OSIntQCtr;
+    }
+    if (OSIntQCtr == 1) {                        /* Ready OS_TaskIntQ(), OSIntExit() will switch to it */
+        ptcb = OSTCBPrioTbl[OS_TASK_INT_Q_PRIO];
+#if OS_SCHED_RR_EN > 0
+        OS_RdyListInsert(ptcb);
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        CLEAR A SECTION OF MEMORY
 *
 * Description: This function is called by other uC/OS-II services to clear a contiguous block of RAM.
@@ -1619,12 +2148,22 @@ void  OS_Sched (void)
     if (OSIntNesting == 0) {                           /* Schedule only if all ISRs done and ...       */
         if (OSLockNesting == 0) {                      /* ... scheduler is not locked                  */
             OS_SchedNew();
+#if OS_SCHED_RR_EN > 0
+            OSTCBHighRdy = OSRdyList[OSPrioHighRdy];   /* Tasks may share the priority                 */
+            if (OSTCBHighRdy != OSTCBCur) {            /* No Ctx Sw if current task is highest rdy     */
+#else
             if (OSPrioHighRdy != OSPrioCur) {          /* No Ctx Sw if current task is highest rdy     */
                 OSTCBHighRdy = OSTCBPrioTbl[OSPrioHighRdy];
+#endif
 #if OS_TASK_PROFILE_EN > 0
                 OSTCBHighRdy->OSTCBCtxSwCtr++;         /* Inc. # of context switches to this task      */
 #endif
                 OSCtxSwCtr++;                          /* Increment context switch counter             */
+#if OS_TICKLESS_EN > 0
+                if (OSPrioCur == OS_TASK_IDLE_PRIO) {  /* Leave tickless idle before switching         */
+                    OSTicklessResume();
+                }
+#endif
                 OS_TASK_SW();                          /* Perform a context switch                     */
             }
         }
@@ -1646,32 +2185,40 @@ void  OS_Sched (void)
 *
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Interrupts are assumed to be disabled when this function is called.
+*              3) While the current task is ready, a task only preempts it if its priority is higher than
+*                 the preemption threshold of the current task (see OSTaskPreemptThreshSet()).
 *********************************************************************************************************
 */
 
 static  void  OS_SchedNew (void)
 {
-#if OS_LOWEST_PRIO <= 63                         /* See if we support up to 64 tasks                   */
-    INT8U   y;
-
-
-    y             = OSUnMapTbl[OSRdyGrp];
-    OSPrioHighRdy = (INT8U)((y << 3) + OSUnMapTbl[OSRdyTbl[y]]);
-#else                                            /* We support up to 256 tasks                         */
     INT8U   y;
-    INT16U *ptbl;
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+    INT8U   thresh;
+#endif
 
 
-    if ((OSRdyGrp & 0xFF) != 0) {
-        y = OSUnMapTbl[OSRdyGrp & 0xFF];
-    } else {
-        y = OSUnMapTbl[(OSRdyGrp >> 8) & 0xFF] + 8;
-    }
-    ptbl = &OSRdyTbl[y];
-    if ((*ptbl & 0xFF) != 0) {
-        OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl & 0xFF)]);
-    } else {
-        OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8);
+#if OS_RDY_TBL_SIZE > 1                          /* See if we support more than 32 tasks               */
+    y             = OS_CntLeadZeros((INT32U)OSRdyGrp << 24);
+#else
+    y             = 0;
+#endif
+    OSPrioHighRdy = (INT8U)((y << 5) + OS_CntLeadZeros(OSRdyTbl[y]));
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+    if (OSRunning == OS_TRUE) {
+#if OS_SCHED_RR_EN > 0
+        if (OSTCBCur->OSTCBRdyNext != (OS_TCB *)0) {     /* Is the current task still ready?              */
+#else
+        if ((OSRdyTbl[OSTCBCur->OSTCBY] & OSTCBCur->OSTCBBitX) != 0) {
+#endif
+            thresh = OSTCBCur->OSTCBPrioThresh;
+            if (thresh > OSTCBCur->OSTCBPrio) {          /* A mutex may have raised its priority          */
+                thresh = OSTCBCur->OSTCBPrio;
+            }
+            if (OSPrioHighRdy >= thresh) {               /* Keep it unless preempted above the threshold  */
+                OSPrioHighRdy = OSTCBCur->OSTCBPrio;
+            }
+        }
     }
 #endif
 }
@@ -1761,6 +2308,8 @@ INT8U  OS_StrLen (INT8U *psrc)
 *                 interrupts.
 *              2) This hook has been added to allow you to do such things as STOP the CPU to conserve
 *                 power.
+*              3) When OS_TICKLESS_EN is enabled, the idle task asks the port to stretch the tick period
+*                 up to the next delay, timeout or alarm that is due (see OSTicklessStretch()).
 *********************************************************************************************************
 */
 
@@ -1776,6 +2325,9 @@ void  OS_TaskIdle (void *p_arg)
     for (;;) {
         OS_ENTER_CRITICAL();
         OSIdleCtr++;
+#if OS_TICKLESS_EN > 0
+        OSTicklessStretch(OS_CPU_TICK_NEXT_DUE());/* Skip the ticks where nothing is due               */
+#endif
         OS_EXIT_CRITICAL();
         OSTaskIdleHook();                        /* Call user definable HOOK                           */
     }
@@ -1783,6 +2335,132 @@ void  OS_TaskIdle (void *p_arg)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                         DEFERRED ISR POST TASK
+*
+* Description: This task is internal to uC/OS-II and applies, in order, the posts that ISRs queued with
+*              OS_IntQPost().  The posts are made at task level, with OSIntNesting at 0.  The services
+*              which may ready several tasks (OSFlagPost(), broadcasts and buffers) then ready them one at
+*              a time, with interrupts enabled in between and the scheduler locked, so that interrupts
+*              are never disabled for a time that depends on the number of waiting tasks.
+*
+* Arguments  : p_arg    this pointer is not used at this time.
+*
+* Returns    : none
+*
+* Notes      : 1) This task should run at the highest priority, OS_TASK_INT_Q_PRIO, so that posts are
+*                 applied as soon as the last nested ISR completes.  Posts made while the scheduler is
+*                 locked are applied when it is unlocked.
+*              2) When the queue is empty the task takes itself out of the ready list without pending on
+*                 anything.  OS_IntQPost() readies it again.  Do not suspend, delay or delete this task.
+*********************************************************************************************************
+*/
+
+#if OS_ISR_POST_DEFERRED_EN > 0
+void  OS_TaskIntQ (void *p_arg)
+{
+    OS_INT_Q  *pq;
+#if OS_SCHED_RR_EN == 0
+    INT8U      y;
+#endif
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
+    INT8U      err;
+#endif
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+    for (;;) {
+        OS_ENTER_CRITICAL();
+        if (OSIntQCtr == 0) {                    /* Nothing to post, wait for OS_IntQPost()            */
+#if OS_SCHED_RR_EN > 0
+            OS_RdyListRemove(OSTCBCur);
+#else
+            y             =  OSTCBCur->OSTCBY;
+            OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
+            if (OSRdyTbl[y] == 0) {
+                OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+            }
+#endif
+            OS_EXIT_CRITICAL();
+            OS_Sched();
+            continue;
+        }
+        pq = OSIntQOut;                          /* Only this task moves OUT, the entry stays valid    */
+        OS_EXIT_CRITICAL();
+        switch (pq->OSIntQType) {
+#if OS_SEM_EN > 0
+            case OS_INT_Q_TYPE_SEM:
+                 (void)OSSemPost((OS_EVENT *)pq->OSIntQObj);
+                 break;
+#endif
+
+#if (OS_MBOX_EN > 0) && (OS_MBOX_POST_EN > 0)
+            case OS_INT_Q_TYPE_MBOX:
+                 (void)OSMboxPost((OS_EVENT *)pq->OSIntQObj, pq->OSIntQMsg);
+                 break;
+#endif
+
+#if (OS_MBOX_EN > 0) && (OS_MBOX_POST_OPT_EN > 0)
+            case OS_INT_Q_TYPE_MBOX_OPT:
+                 (void)OSMboxPostOpt((OS_EVENT *)pq->OSIntQObj, pq->OSIntQMsg, pq->OSIntQOpt);
+                 break;
+#endif
+
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)) && (OS_Q_POST_EN > 0)
+            case OS_INT_Q_TYPE_Q:
+                 (void)OSQPost((OS_EVENT *)pq->OSIntQObj, pq->OSIntQMsg);
+                 break;
+#endif
+
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)) && (OS_Q_POST_FRONT_EN > 0)
+            case OS_INT_Q_TYPE_Q_FRONT:
+                 (void)OSQPostFront((OS_EVENT *)pq->OSIntQObj, pq->OSIntQMsg);
+                 break;
+#endif
+
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)) && (OS_Q_POST_OPT_EN > 0)
+            case OS_INT_Q_TYPE_Q_OPT:
+                 (void)OSQPostOpt((OS_EVENT *)pq->OSIntQObj, pq->OSIntQMsg, pq->OSIntQOpt);
+                 break;
+#endif
+
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0)) && (OS_Q_PRIO_EN > 0)
+            case OS_INT_Q_TYPE_Q_PRIO:
+                 (void)OSQPostPrio((OS_EVENT *)pq->OSIntQObj, pq->OSIntQMsg, pq->OSIntQOpt);
+                 break;
+#endif
+
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
+            case OS_INT_Q_TYPE_FLAG:
+                 (void)OSFlagPost((OS_FLAG_GRP *)pq->OSIntQObj, (OS_FLAGS)pq->OSIntQFlags, pq->OSIntQOpt, &err);
+                 break;
+#endif
+
+#if OS_BUF_EN > 0
+            case OS_INT_Q_TYPE_BUF:
+                 OS_BufWake((OS_EVENT *)pq->OSIntQObj);
+                 break;
+#endif
+
+            default:
+                 break;
+        }
+        OS_ENTER_CRITICAL();
+        OSIntQOut++;                             /* Free the entry                                     */
+        if (OSIntQOut == &OSIntQTbl[OS_INT_Q_SIZE]) {
+            OSIntQOut = &OSIntQTbl[0];
+        }
+        OSIntQCtr--;
+        OS_EXIT_CRITICAL();
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            STATISTICS TASK
 *
 * Description: This task is internal to uC/OS-II and is used to compute some statistics about the
@@ -1793,6 +2471,9 @@ void  OS_TaskIdle (void *p_arg)
 *                 OSCPUUsage = 100 * (1 - ------------)     (units are in %)
 *                                         OSIdleCtrMax
 *
+*              or, with OS_TASK_STAT_TS_EN, from the share of the CPU the idle task used as measured by
+*              OS_TaskStatProfile().
+*
 * Arguments  : parg     this pointer is not used at this time.
 *
 * Returns    : none
@@ -1801,7 +2482,7 @@ void  OS_TaskIdle (void *p_arg)
 *                 next higher priority, OS_TASK_IDLE_PRIO-1.
 *              2) You can disable this task by setting the configuration #define OS_TASK_STAT_EN to 0.
 *              3) You MUST have at least a delay of 2/10 seconds to allow for the system to establish the
-*                 maximum value for the idle counter.
+*                 maximum value for the idle counter.  This does not apply with OS_TASK_STAT_TS_EN.
 *********************************************************************************************************
 */
 
@@ -1815,6 +2496,7 @@ void  OS_TaskStat (void *p_arg)
 
 
     (void)p_arg;                                 /* Prevent compiler warning for not using 'p_arg'     */
+#if OS_TASK_STAT_TS_EN == 0
     while (OSStatRdy == OS_FALSE) {
         OSTimeDly(2 * OS_TICKS_PER_SEC / 10);    /* Wait until statistic task is ready                 */
     }
@@ -1823,12 +2505,24 @@ void  OS_TaskStat (void *p_arg)
         OSCPUUsage = 0;
         (void)OSTaskSuspend(OS_PRIO_SELF);
     }
+#endif
+#if OS_TASK_PROFILE_EN > 0
+    OS_TaskStatProfile();                        /* Start the first profiling period ...               */
+    OSTimeDly(OS_TICKS_PER_SEC / 10);            /* ... and let it run before computing any usage      */
+#endif
     for (;;) {
         OS_ENTER_CRITICAL();
         OSIdleCtrRun = OSIdleCtr;                /* Obtain the of the idle counter for the past second */
         OSIdleCtr    = 0L;                       /* Reset the idle counter for the next second         */
         OS_EXIT_CRITICAL();
+#if OS_TASK_PROFILE_EN > 0
+        OS_TaskStatProfile();                    /* Compute the CPU usage of each task and of ISRs     */
+#endif
+#if OS_TASK_STAT_TS_EN > 0                       /* CPU usage is what the idle task did not use        */
+        OSCPUUsage   = (INT8U)(100 - (OSTCBPrioTbl[OS_TASK_IDLE_PRIO]->OSTCBCPUUsage + 50) / 100);
+#else
         OSCPUUsage   = (INT8U)(100L - OSIdleCtrRun / OSIdleCtrMax);
+#endif
         OSTaskStatHook();                        /* Invoke user definable hook                         */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
         OS_TaskStatStkChk();                     /* Check the stacks for each task                     */
@@ -1882,6 +2576,85 @@ void  OS_TaskStatStkChk (void)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                       CPU USAGE OF EACH TASK
+*
+* Description: This function is called by OS_TaskStat() to compute, from the cycles counted by
+*              OSTaskSwHook(), OSIntEnter() and OSIntExit(), the share of the CPU each task and the ISRs
+*              used since the previous call.  The results are read with OSTaskProfileGet().
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) The cycle counts are 32 bits wide, so the statistics period must be shorter than 2^32
+*                 periods of the timestamp counter (86 seconds at 50 MHz).
+*********************************************************************************************************
+*/
+
+#if (OS_TASK_PROFILE_EN > 0) && (OS_TASK_STAT_EN > 0)
+void  OS_TaskStatProfile (void)
+{
+    OS_TCB    *ptcb;
+    INT32U     ts;
+    INT32U     cycles;
+    INT32U     period;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    ts                          = OSCPUTsGet();
+    cycles                      = ts - OSTCBCur->OSTCBCyclesStart;
+    OSTCBCur->OSTCBCyclesTot   += cycles;        /* Bring the running task up to date                  */
+    OSTCBCur->OSTCBCyclesSlice += cycles;
+    OSTCBCur->OSTCBCyclesStart  = ts;
+    period                      = ts - OSProfileTsPrev;
+    OSProfileTsPrev             = ts;
+    OSIntCPUUsage               = OS_TaskStatUsage(OSIntCyclesTot - OSIntCyclesPrev, period);
+    OSIntCyclesPrev             = OSIntCyclesTot;
+    ptcb                        = OSTCBList;
+    while (ptcb != (OS_TCB *)0) {
+        ptcb->OSTCBCPUUsage     = OS_TaskStatUsage(ptcb->OSTCBCyclesTot - ptcb->OSTCBCyclesPrev, period);
+        ptcb->OSTCBCyclesPrev   = ptcb->OSTCBCyclesTot;
+        ptcb                    = ptcb->OSTCBNext;
+    }
+    OS_EXIT_CRITICAL();
+}
+
+/*
+*********************************************************************************************************
+*                                    CYCLES TO CPU USAGE (0.01 % UNITS)
+*********************************************************************************************************
+*/
+
+static  INT16U  OS_TaskStatUsage (INT32U cycles, INT32U period)
+{
+    INT32U  usage;
+
+
+    if (period == 0L) {
+        return (0);
+    }
+    if (cycles >= period) {
+        return (10000);
+    }
+    if (period > (0xFFFFFFFFL / 10000L)) {       /* Avoid overflowing 'cycles * 10000'                 */
+        usage = cycles / (period / 10000L);
+        if (usage > 10000L) {
+            usage = 10000L;
+        }
+    } else {
+        usage = cycles * 10000L / period;
+    }
+    return ((INT16U)usage);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            INITIALIZE TCB
 *
 * Description: This function is internal to uC/OS-II and is used to initialize a Task Control Block when
@@ -1942,6 +2715,7 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBStat          = OS_STAT_RDY;            /* Task is ready to run                     */
         ptcb->OSTCBStatPend      = OS_STAT_PEND_OK;        /* Clear pend status                        */
         ptcb->OSTCBDly           = 0;                      /* Task is not delayed                      */
+        OS_CPU_TICK_NODE_INIT(&ptcb->OSTCBTickNode, OS_TickExpire, (void *)ptcb);
 
 #if OS_TASK_CREATE_EXT_EN > 0
         ptcb->OSTCBExtPtr        = pext;                   /* Store pointer to TCB extension           */
@@ -1961,16 +2735,35 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
-#if OS_LOWEST_PRIO <= 63
-        ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U)(prio & 0x07);
-        ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT8U)(1 << ptcb->OSTCBX);
-#else
-        ptcb->OSTCBY             = (INT8U)((prio >> 4) & 0xFF); /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U) (prio & 0x0F);
-        ptcb->OSTCBBitY          = (INT16U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT16U)(1 << ptcb->OSTCBX);
+        ptcb->OSTCBY             = (INT8U)(prio >> 5);          /* Pre-compute X, Y, BitX and BitY     */
+        ptcb->OSTCBX             = (INT8U)(prio & 0x1F);
+        ptcb->OSTCBBitY          = (INT8U)(0x80 >> ptcb->OSTCBY);
+        ptcb->OSTCBBitX          = (INT32U)0x80000000L >> ptcb->OSTCBX;
+
+#if OS_MUTEX_PI_EN > 0
+        ptcb->OSTCBBasePrio      = prio;                   /* No priority inherited ...                */
+        ptcb->OSTCBMutexList     = (OS_EVENT *)0;          /* ... as the task owns no mutex            */
+#endif
+
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+        ptcb->OSTCBPrioThresh    = prio;                   /* No preemption threshold                  */
+#endif
+
+#if OS_TASK_SEM_EN > 0
+        ptcb->OSTCBSemCtr        = 0;                      /* Own semaphore not signaled yet           */
+#endif
+
+#if OS_TASK_MSG_EN > 0
+        ptcb->OSTCBMsgSlot       = (void *)0;              /* Own message slot is empty                */
+#endif
+
+#if OS_SCHED_RR_EN > 0
+        ptcb->OSTCBPrioNext      = (OS_TCB *)0;            /* Not linked at its priority yet           */
+        ptcb->OSTCBPrioPrev      = (OS_TCB *)0;
+        ptcb->OSTCBRdyNext       = (OS_TCB *)0;
+        ptcb->OSTCBRdyPrev       = (OS_TCB *)0;
+        ptcb->OSTCBQuantum       = OS_SCHED_RR_QUANTUM;    /* Default time slice                       */
+        ptcb->OSTCBQuantumCtr    = OS_SCHED_RR_QUANTUM;
 #endif
 
 #if (OS_EVENT_EN)
@@ -1980,11 +2773,11 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
 #endif
 #endif
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0) && (OS_TASK_DEL_EN > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0)) && (OS_TASK_DEL_EN > 0)
         ptcb->OSTCBFlagNode  = (OS_FLAG_NODE *)0;          /* Task is not pending on an event flag     */
 #endif
 
-#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
+#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))) || (OS_BUF_EN > 0)
         ptcb->OSTCBMsg       = (void *)0;                  /* No message received                      */
 #endif
 
@@ -1992,6 +2785,10 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBCtxSwCtr    = 0L;                       /* Initialize profiling variables           */
         ptcb->OSTCBCyclesStart = 0L;
         ptcb->OSTCBCyclesTot   = 0L;
+        ptcb->OSTCBCyclesSlice = 0L;
+        ptcb->OSTCBCyclesMax   = 0L;
+        ptcb->OSTCBCyclesPrev  = 0L;
+        ptcb->OSTCBCPUUsage    = 0;
         ptcb->OSTCBStkBase     = (OS_STK *)0;
         ptcb->OSTCBStkUsed     = 0L;
 #endif
@@ -2006,15 +2803,23 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTaskCreateHook(ptcb);                            /* Call user defined hook                   */
 
         OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+        OS_PrioListInsert(ptcb);                           /* Join the tasks at this priority          */
+#else
         OSTCBPrioTbl[prio] = ptcb;
+#endif
         ptcb->OSTCBNext    = OSTCBList;                    /* Link into TCB chain                      */
         ptcb->OSTCBPrev    = (OS_TCB *)0;
         if (OSTCBList != (OS_TCB *)0) {
             OSTCBList->OSTCBPrev = ptcb;
         }
         OSTCBList               = ptcb;
+#if OS_SCHED_RR_EN > 0
+        OS_RdyListInsert(ptcb);                            /* Make task ready to run                   */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
@@ -2022,3 +2827,371 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
     OS_EXIT_CRITICAL();
     return (OS_ERR_TASK_NO_MORE_TCB);
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  INSERT A TASK IN THE TICK (DELAY) LIST
+*
+* Description: This function is called to start timing a delay or a pend timeout for a task.  The delay
+*              is timed by the tick node embedded in the TCB, which the port keeps in its tick list (see
+*              OS_CPU_TICK_NODE in OS_CPU.H).  On Nios II the node is a HAL alarm, so delays, timeouts,
+*              HAL alarms and the timer task's signal all share alt_alarm_list: a single delta list
+*              sorted by expiry where alt_tick() only decrements the head.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task to delay.
+*
+*              ticks         is the number of ticks to wait.  A value of 0 means 'no delay' and the task is
+*                            not placed in the list.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) This function assumes that interrupts are disabled.
+*              3) The task MUST NOT already be in the tick list.
+*              4) No tick is added: the task is made ready by the 'ticks'th tick, as OSTimeDly() has
+*                 always done.
+*              5) OSTCBDly keeps 'ticks' until the delay ends.  See OS_TickListRemain() for the ticks left.
+*********************************************************************************************************
+*/
+
+void  OS_TickListInsert (OS_TCB *ptcb, OS_TICK ticks)
+{
+    if (ticks == 0) {
+        return;
+    }
+    ptcb->OSTCBDly = ticks;
+    OS_CPU_TICK_NODE_INSERT(&ptcb->OSTCBTickNode, ticks);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  REMOVE A TASK FROM THE TICK (DELAY) LIST
+*
+* Description: This function is called to stop timing a delay or a pend timeout, either because the event
+*              occurred or because the task is resumed or deleted.  The ticks left for the task are handed
+*              over to the next node of the tick list so that later expiries are unchanged.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.  Nothing is done if the task is not
+*                            delayed (i.e. OSTCBDly is 0).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) This function assumes that interrupts are disabled.
+*              3) OSTCBDly is cleared on return.
+*********************************************************************************************************
+*/
+
+void  OS_TickListRemove (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBDly == 0) {                          /* Task is not in the tick list                */
+        return;
+    }
+    OS_CPU_TICK_NODE_REMOVE(&ptcb->OSTCBTickNode);
+    ptcb->OSTCBDly = 0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 GET THE TICKS LEFT BEFORE A DELAY EXPIRES
+*
+* Description: This function returns the number of ticks left before the delay or pend timeout of a task
+*              expires.  OSTCBDly only records the delay as it was started, since the tick list rather
+*              than the TCB counts it down.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : the number of ticks left, at least 1 while the task is in the tick list, or
+*              0             if the task is not delayed.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) This function assumes that interrupts are disabled.
+*              3) The port walks the tick list up to the task, so the time taken grows with the number
+*                 of earlier entries.
+*********************************************************************************************************
+*/
+
+OS_TICK  OS_TickListRemain (OS_TCB *ptcb)
+{
+    if (ptcb->OSTCBDly == 0) {                          /* Task is not in the tick list                */
+        return (0);
+    }
+    return ((OS_TICK)OS_CPU_TICK_NODE_REMAIN(&ptcb->OSTCBTickNode));
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     EXPIRE A DELAY OR A TIMEOUT
+*
+* Description: This function is the callback of the tick node in each TCB.  It is called by the port from
+*              the tick ISR, once the node has been taken out of the tick list, and makes the task ready
+*              unless it is suspended.  A task that was pending is told that its wait timed out.
+*
+* Arguments  : p_arg         is a pointer to the TCB of the task.
+*
+* Returns    : 0             the alarm stays stopped, or
+*              1             when the expiry must wait for the next tick, while uC/OS-View is stepping
+*                            ticks or before OSStart().  The port then links the node again.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+static  INT32U  OS_TickExpire (void *p_arg)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSRunning != OS_TRUE) {
+        return (1);
+    }
+#if OS_TICK_STEP_EN > 0
+    if (OSTickStepState == OS_TICK_STEP_WAIT) {            /* Waiting for uC/OS-View to step the tick      */
+        return (1);
+    }
+#endif
+    ptcb = (OS_TCB *)p_arg;
+    OS_ENTER_CRITICAL();
+    ptcb->OSTCBDly = 0;                                    /* Node was unlinked by the port                */
+                                                           /* Check for timeout                            */
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;      /* Yes, Clear status flag                       */
+        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;             /* Indicate PEND timeout                        */
+    } else {
+        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+    }
+
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
+#if OS_SCHED_RR_EN > 0
+        OS_RdyListInsert(ptcb);                            /* No,  Make ready                              */
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;         /* No,  Make ready                              */
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+    }
+    OS_EXIT_CRITICAL();
+    return (0);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  LINK A TASK AMONG THE TASKS OF ITS PRIORITY
+*
+* Description: When OS_SCHED_RR_EN is enabled, the tasks that share a priority are linked in a circular list
+*              and OSTCBPrioTbl[] points to the first one.  That task is the one the functions taking a
+*              priority as argument (OSTaskSuspend(), OSTaskDel() ...) act on.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.  Its OSTCBPrio MUST be set.
+*
+* Returns    : none
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-II and your application should not call them.
+*              2) These functions assume that interrupts are disabled.
+*              3) An entry reserved with OS_TCB_RESERVED (task being created or mutex PIP) is replaced by
+*                 the task.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OS_PrioListInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *phead;
+
+
+    phead = OSTCBPrioTbl[ptcb->OSTCBPrio];
+    if ((phead == (OS_TCB *)0) || (phead == OS_TCB_RESERVED)) {
+        ptcb->OSTCBPrioNext = ptcb;                     /* First task at this priority                 */
+        ptcb->OSTCBPrioPrev = ptcb;
+        OSTCBPrioTbl[ptcb->OSTCBPrio] = ptcb;
+    } else {
+        ptcb->OSTCBPrioNext = phead;                    /* Append after the last task                  */
+        ptcb->OSTCBPrioPrev = phead->OSTCBPrioPrev;
+        phead->OSTCBPrioPrev->OSTCBPrioNext = ptcb;
+        phead->OSTCBPrioPrev                = ptcb;
+    }
+}
+
+
+void  OS_PrioListRemove (OS_TCB *ptcb)
+{
+    INT8U  prio;
+
+
+    prio = ptcb->OSTCBPrio;
+    if (ptcb->OSTCBPrioNext == ptcb) {                  /* Last task at this priority                  */
+        OSTCBPrioTbl[prio] = (OS_TCB *)0;
+    } else {
+        ptcb->OSTCBPrioPrev->OSTCBPrioNext = ptcb->OSTCBPrioNext;
+        ptcb->OSTCBPrioNext->OSTCBPrioPrev = ptcb->OSTCBPrioPrev;
+        if (OSTCBPrioTbl[prio] == ptcb) {               /* Next task now answers for this priority     */
+            OSTCBPrioTbl[prio] = ptcb->OSTCBPrioNext;
+        }
+    }
+    ptcb->OSTCBPrioNext = (OS_TCB *)0;
+    ptcb->OSTCBPrioPrev = (OS_TCB *)0;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    MAKE A TASK READY / NOT READY TO RUN
+*
+* Description: When OS_SCHED_RR_EN is enabled, the ready tasks of a priority are linked in a circular list.
+*              OSRdyList[] points to the one to run next and the priority's bit in OSRdyTbl[] is set as long
+*              as the list is not empty.  A task made ready goes after the other ready tasks of its priority
+*              with a full time slice.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+* Returns    : none
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-II and your application should not call them.
+*              2) These functions assume that interrupts are disabled.
+*              3) Making ready a task that is already ready, or the reverse, does nothing, the same as
+*                 setting or clearing its bit twice.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OS_RdyListInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *phead;
+
+
+    if (ptcb->OSTCBRdyNext != (OS_TCB *)0) {            /* Already ready                               */
+        return;
+    }
+    ptcb->OSTCBQuantumCtr = ptcb->OSTCBQuantum;
+    phead = OSRdyList[ptcb->OSTCBPrio];
+    if (phead == (OS_TCB *)0) {                         /* First ready task at this priority           */
+        ptcb->OSTCBRdyNext          = ptcb;
+        ptcb->OSTCBRdyPrev          = ptcb;
+        OSRdyList[ptcb->OSTCBPrio]  = ptcb;
+        OSRdyGrp                   |= ptcb->OSTCBBitY;
+        OSRdyTbl[ptcb->OSTCBY]     |= ptcb->OSTCBBitX;
+    } else {
+        ptcb->OSTCBRdyNext          = phead;            /* Runs after the other ready tasks            */
+        ptcb->OSTCBRdyPrev          = phead->OSTCBRdyPrev;
+        phead->OSTCBRdyPrev->OSTCBRdyNext = ptcb;
+        phead->OSTCBRdyPrev               = ptcb;
+    }
+}
+
+
+void  OS_RdyListRemove (OS_TCB *ptcb)
+{
+    INT8U  prio;
+    INT8U  y;
+
+
+    if (ptcb->OSTCBRdyNext == (OS_TCB *)0) {            /* Not ready                                   */
+        return;
+    }
+    prio = ptcb->OSTCBPrio;
+    if (ptcb->OSTCBRdyNext == ptcb) {                   /* Last ready task at this priority            */
+        OSRdyList[prio] = (OS_TCB *)0;
+        y               = ptcb->OSTCBY;
+        OSRdyTbl[y]    &= ~ptcb->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp   &= ~ptcb->OSTCBBitY;
+        }
+    } else {
+        ptcb->OSTCBRdyPrev->OSTCBRdyNext = ptcb->OSTCBRdyNext;
+        ptcb->OSTCBRdyNext->OSTCBRdyPrev = ptcb->OSTCBRdyPrev;
+        if (OSRdyList[prio] == ptcb) {                  /* Next ready task runs in its place           */
+            OSRdyList[prio] = ptcb->OSTCBRdyNext;
+        }
+    }
+    ptcb->OSTCBRdyNext = (OS_TCB *)0;
+    ptcb->OSTCBRdyPrev = (OS_TCB *)0;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       MOVE A TASK TO A NEW PRIORITY
+*
+* Description: This function is called by OSTaskChangePrio() and by the mutex code when OS_SCHED_RR_EN is
+*              enabled, to move a task to another priority while keeping its state: a ready task stays
+*              ready, a waiting task stays in the event wait list(s) and a delayed task stays delayed.
+*
+* Arguments  : ptcb          is a pointer to the TCB of the task.
+*
+*              prio          is the new priority.  Other tasks may already run at this priority.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) This function assumes that interrupts are disabled.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+void  OS_TCBPrioSet (OS_TCB *ptcb, INT8U prio)
+{
+    BOOLEAN     rdy;
+#if (OS_EVENT_EN)
+    BOOLEAN     pend;
+    OS_EVENT   *pevent;
+#if (OS_EVENT_MULTI_EN > 0)
+    OS_EVENT  **pevents;
+#endif
+#endif
+
+
+    rdy = (BOOLEAN)(ptcb->OSTCBRdyNext != (OS_TCB *)0);
+    OS_RdyListRemove(ptcb);
+#if (OS_EVENT_EN)
+    pend   = (BOOLEAN)((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY);
+    pevent = ptcb->OSTCBEventPtr;
+    if (pevent != (OS_EVENT *)0) {                      /* Leave wait list at the old priority         */
+        OS_EventTaskRemove(ptcb, pevent);
+    }
+#if (OS_EVENT_MULTI_EN > 0)
+    if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {
+        OS_EventTaskRemoveMulti(ptcb, ptcb->OSTCBEventMultiPtr);
+    }
+#endif
+#endif
+    OS_PrioListRemove(ptcb);
+
+    ptcb->OSTCBPrio = prio;                             /* Compute new X, Y, BitX and BitY             */
+    ptcb->OSTCBY    = (INT8U)(prio >> 5);
+    ptcb->OSTCBX    = (INT8U)(prio & 0x1F);
+    ptcb->OSTCBBitY = (INT8U)(0x80 >> ptcb->OSTCBY);
+    ptcb->OSTCBBitX = (INT32U)0x80000000L >> ptcb->OSTCBX;
+
+    OS_PrioListInsert(ptcb);
+#if (OS_EVENT_EN)
+    if (pend == OS_TRUE) {                              /* Wait at the new priority                    */
+        if (pevent != (OS_EVENT *)0) {
+            pevent->OSEventGrp               |= ptcb->OSTCBBitY;
+            pevent->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        }
+#if (OS_EVENT_MULTI_EN > 0)
+        pevents = ptcb->OSTCBEventMultiPtr;
+        if (pevents != (OS_EVENT **)0) {
+            while (*pevents != (OS_EVENT *)0) {
+                (*pevents)->OSEventGrp               |= ptcb->OSTCBBitY;
+                (*pevents)->OSEventTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+                pevents++;
+            }
+        }
+#endif
+    }
+#endif
+    if (rdy == OS_TRUE) {
+        OS_RdyListInsert(ptcb);
+    }
+}
+#endif
@@ -33,23 +33,28 @@ INT16U  const  OSDebugEn           = OS_DEBUG_EN;               /* Debug constan
 
 #if OS_DEBUG_EN > 0
 
+INT16U  const  OSBufEn             = OS_BUF_EN;
+
 INT32U  const  OSEndiannessTest    = 0x12345678L;               /* Variable to test CPU endianness     */
 
 INT16U  const  OSEventEn           = OS_EVENT_EN;
 INT16U  const  OSEventMax          = OS_MAX_EVENTS;             /* Number of event control blocks      */
 INT16U  const  OSEventNameSize     = OS_EVENT_NAME_SIZE;        /* Size (in bytes) of event names      */
-#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+#if (OS_EVENT_EN) && ((OS_MAX_EVENTS > 0) || (OS_OBJ_STATIC_EN > 0))
 INT16U  const  OSEventSize         = sizeof(OS_EVENT);          /* Size in Bytes of OS_EVENT           */
-INT16U  const  OSEventTblSize      = sizeof(OSEventTbl);        /* Size of OSEventTbl[] in bytes       */
 #else
 INT16U  const  OSEventSize         = 0;
+#endif
+#if (OS_EVENT_EN) && (OS_MAX_EVENTS > 0)
+INT16U  const  OSEventTblSize      = sizeof(OSEventTbl);        /* Size of OSEventTbl[] in bytes       */
+#else
 INT16U  const  OSEventTblSize      = 0;
 #endif
 INT16U  const  OSEventMultiEn      = OS_EVENT_MULTI_EN;
 
 
 INT16U  const  OSFlagEn            = OS_FLAG_EN;
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
 INT16U  const  OSFlagGrpSize       = sizeof(OS_FLAG_GRP);       /* Size in Bytes of OS_FLAG_GRP        */
 INT16U  const  OSFlagNodeSize      = sizeof(OS_FLAG_NODE);      /* Size in Bytes of OS_FLAG_NODE       */
 INT16U  const  OSFlagWidth         = sizeof(OS_FLAGS);          /* Width (in bytes) of OS_FLAGS        */
@@ -68,26 +73,36 @@ INT16U  const  OSMboxEn            = OS_MBOX_EN;
 INT16U  const  OSMemEn             = OS_MEM_EN;
 INT16U  const  OSMemMax            = OS_MAX_MEM_PART;           /* Number of memory partitions         */
 INT16U  const  OSMemNameSize       = OS_MEM_NAME_SIZE;          /* Size (in bytes) of partition names  */
-#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+#if (OS_MEM_EN > 0) && ((OS_MAX_MEM_PART > 0) || (OS_OBJ_STATIC_EN > 0))
 INT16U  const  OSMemSize           = sizeof(OS_MEM);            /* Mem. Partition header sine (bytes)  */
-INT16U  const  OSMemTblSize        = sizeof(OSMemTbl);
 #else
 INT16U  const  OSMemSize           = 0;
+#endif
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+INT16U  const  OSMemTblSize        = sizeof(OSMemTbl);
+#else
 INT16U  const  OSMemTblSize        = 0;
 #endif
 INT16U  const  OSMutexEn           = OS_MUTEX_EN;
+INT16U  const  OSMutexPIEn         = OS_MUTEX_PI_EN;            /* Priority inheritance instead of PIP */
+
+INT16U  const  OSObjStaticEn       = OS_OBJ_STATIC_EN;
 
 INT16U  const  OSPtrSize           = sizeof(void *);            /* Size in Bytes of a pointer          */
 
 INT16U  const  OSQEn               = OS_Q_EN;
 INT16U  const  OSQMax              = OS_MAX_QS;                 /* Number of queues                    */
-#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+INT16U  const  OSQPrioEn           = OS_Q_PRIO_EN;
+INT16U  const  OSQPrioLvls         = OS_Q_PRIO_LVLS;            /* Number of message priorities        */
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))
 INT16U  const  OSQSize             = sizeof(OS_Q);              /* Size in bytes of OS_Q structure     */
 #else
 INT16U  const  OSQSize             = 0;
 #endif
 
-INT16U  const  OSRdyTblSize        = OS_RDY_TBL_SIZE;           /* Number of bytes in the ready table  */
+INT16U  const  OSRdyTblSize        = sizeof(OSRdyTbl);          /* Number of bytes in the ready table  */
+
+INT16U  const  OSRWLockEn          = OS_RWLOCK_EN;
 
 INT16U  const  OSSemEn             = OS_SEM_EN;
 
@@ -108,6 +123,7 @@ INT16U  const  OSTaskSwHookEn      = OS_TASK_SW_HOOK_EN;
 INT16U  const  OSTCBPrioTblMax     = OS_LOWEST_PRIO + 1;        /* Number of entries in OSTCBPrioTbl[] */
 INT16U  const  OSTCBSize           = sizeof(OS_TCB);            /* Size in Bytes of OS_TCB             */
 INT16U  const  OSTicksPerSec       = OS_TICKS_PER_SEC;
+INT16U  const  OSTickWidth         = sizeof(OS_TICK);           /* Width (in bytes) of OS_TICK         */
 INT16U  const  OSTimeTickHookEn    = OS_TIME_TICK_HOOK_EN;
 INT16U  const  OSVersionNbr        = OS_VERSION;
 
@@ -115,19 +131,24 @@ INT16U  const  OSTmrEn             = OS_TMR_EN;
 INT16U  const  OSTmrCfgMax         = OS_TMR_CFG_MAX;
 INT16U  const  OSTmrCfgNameSize    = OS_TMR_CFG_NAME_SIZE;
 INT16U  const  OSTmrCfgWheelSize   = OS_TMR_CFG_WHEEL_SIZE;
+INT16U  const  OSTmrCfgWheelLvls   = OS_TMR_CFG_WHEEL_LVLS;
+INT16U  const  OSTmrCfgCbTaskEn    = OS_TMR_CFG_CB_TASK_EN;
 INT16U  const  OSTmrCfgTicksPerSec = OS_TMR_CFG_TICKS_PER_SEC;
 
-#if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
+#if OS_TMR_EN > 0
 INT16U  const  OSTmrSize           = sizeof(OS_TMR);
-INT16U  const  OSTmrTblSize        = sizeof(OSTmrTbl);
 INT16U  const  OSTmrWheelSize      = sizeof(OS_TMR_WHEEL);
 INT16U  const  OSTmrWheelTblSize   = sizeof(OSTmrWheelTbl);
 #else
 INT16U  const  OSTmrSize           = 0;
-INT16U  const  OSTmrTblSize        = 0;
 INT16U  const  OSTmrWheelSize      = 0;
 INT16U  const  OSTmrWheelTblSize   = 0;
 #endif
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
+INT16U  const  OSTmrTblSize        = sizeof(OSTmrTbl);
+#else
+INT16U  const  OSTmrTblSize        = 0;
+#endif
 
 #endif
 
@@ -170,16 +191,20 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
 #if OS_TIME_GET_SET_EN > 0   
                           + sizeof(OSTime)
 #endif
-#if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
+#if OS_TMR_EN > 0
                           + sizeof(OSTmrFree)
                           + sizeof(OSTmrUsed)
                           + sizeof(OSTmrTime)
+                          + sizeof(OSTmrRunning)
+                          + sizeof(OSTmrTickNode)
                           + sizeof(OSTmrSem)
                           + sizeof(OSTmrSemSignal)
-                          + sizeof(OSTmrTbl)
-                          + sizeof(OSTmrFreeList)
                           + sizeof(OSTmrTaskStk)
                           + sizeof(OSTmrWheelTbl)
+#endif
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
+                          + sizeof(OSTmrTbl)
+                          + sizeof(OSTmrFreeList)
 #endif
                           + sizeof(OSIntNesting)
                           + sizeof(OSLockNesting)
@@ -227,6 +252,8 @@ void  OSDebugInit (void)
     void  *ptemp;
 
     
+    ptemp = (void *)&OSBufEn;
+
     ptemp = (void *)&OSDebugEn;
 
     ptemp = (void *)&OSEndiannessTest;
@@ -256,15 +283,20 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSMemTblSize;
 
     ptemp = (void *)&OSMutexEn;
+    ptemp = (void *)&OSMutexPIEn;
 
     ptemp = (void *)&OSPtrSize;
 
     ptemp = (void *)&OSQEn;
     ptemp = (void *)&OSQMax;
+    ptemp = (void *)&OSQPrioEn;
+    ptemp = (void *)&OSQPrioLvls;
     ptemp = (void *)&OSQSize;
 
     ptemp = (void *)&OSRdyTblSize;
 
+    ptemp = (void *)&OSRWLockEn;
+
     ptemp = (void *)&OSSemEn;
 
     ptemp = (void *)&OSStkWidth;
@@ -285,16 +317,21 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSTCBSize;
 
     ptemp = (void *)&OSTicksPerSec;
+    ptemp = (void *)&OSTickWidth;
     ptemp = (void *)&OSTimeTickHookEn;
 
 #if OS_TMR_EN > 0
+#if OS_TMR_CFG_MAX > 0
     ptemp = (void *)&OSTmrTbl[0];
+#endif
     ptemp = (void *)&OSTmrWheelTbl[0];
     
     ptemp = (void *)&OSTmrEn;
     ptemp = (void *)&OSTmrCfgMax;
     ptemp = (void *)&OSTmrCfgNameSize;
     ptemp = (void *)&OSTmrCfgWheelSize;
+    ptemp = (void *)&OSTmrCfgWheelLvls;
+    ptemp = (void *)&OSTmrCfgCbTaskEn;
     ptemp = (void *)&OSTmrCfgTicksPerSec;
     ptemp = (void *)&OSTmrSize;
     ptemp = (void *)&OSTmrTblSize;
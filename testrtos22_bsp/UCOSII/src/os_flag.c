@@ -25,14 +25,14 @@
 #include <ucos_ii.h>
 #endif
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
 /*
 *********************************************************************************************************
 *                                            LOCAL PROTOTYPES
 *********************************************************************************************************
 */
 
-static  void     OS_FlagBlock(OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT16U timeout);
+static  void     OS_FlagBlock(OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, OS_TICK timeout);
 static  BOOLEAN  OS_FlagTaskRdy(OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy);
 
 /*$PAGE*/
@@ -129,6 +129,7 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT8
              if (flags_rdy == flags) {                     /* Must match ALL the bits that we want     */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags &= ~flags_rdy;      /* Clear ONLY the flags that we wanted      */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
              } else {
                  *perr = OS_ERR_FLAG_NOT_RDY;
@@ -141,6 +142,7 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT8
              if (flags_rdy != (OS_FLAGS)0) {               /* See if any flag set                      */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags &= ~flags_rdy;      /* Clear ONLY the flags that we got         */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
              } else {
                  *perr = OS_ERR_FLAG_NOT_RDY;
@@ -154,6 +156,7 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT8
              if (flags_rdy == flags) {                     /* Must match ALL the bits that we want     */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags |= flags_rdy;       /* Set ONLY the flags that we wanted        */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
              } else {
                  *perr = OS_ERR_FLAG_NOT_RDY;
@@ -166,6 +169,7 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT8
              if (flags_rdy != (OS_FLAGS)0) {               /* See if any flag cleared                  */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags |= flags_rdy;       /* Set ONLY the flags that we got           */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
              } else {
                  *perr = OS_ERR_FLAG_NOT_RDY;
@@ -205,6 +209,7 @@ OS_FLAGS  OSFlagAccept (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT8
 *********************************************************************************************************
 */
 
+#if OS_MAX_FLAGS > 0
 OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS flags, INT8U *perr)
 {
     OS_FLAG_GRP *pgrp;
@@ -231,6 +236,11 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS flags, INT8U *perr)
         pgrp->OSFlagType     = OS_EVENT_TYPE_FLAG;  /* Set to event flag group type                    */
         pgrp->OSFlagFlags    = flags;               /* Set to desired initial value                    */
         pgrp->OSFlagWaitList = (void *)0;           /* Clear list of tasks waiting on flags            */
+        pgrp->OSFlagWaitSet  = (OS_FLAGS)0;
+#if OS_FLAG_WAIT_CLR_EN > 0
+        pgrp->OSFlagWaitClr  = (OS_FLAGS)0;
+#endif
+        pgrp->OSFlagConsumed = (OS_FLAGS)0;
 #if OS_FLAG_NAME_SIZE > 1
         pgrp->OSFlagName[0]  = '?';
         pgrp->OSFlagName[1]  = OS_ASCII_NUL;
@@ -243,6 +253,77 @@ OS_FLAG_GRP  *OSFlagCreate (OS_FLAGS flags, INT8U *perr)
     }
     return (pgrp);                                  /* Return pointer to event flag group              */
 }
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              CREATE AN EVENT FLAG IN APPLICATION STORAGE
+*
+* Description: This function is called to create an event flag group in storage supplied by the
+*              application instead of taking it from the OSFlagTbl[] pool.
+*
+* Arguments  : pgrp          is a pointer to the event flag group to initialize.
+*
+*              flags         Contains the initial value to store in the event flag group.
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE               if the call was successful.
+*                               OS_ERR_CREATE_ISR         if you attempted to create an Event Flag from an
+*                                                         ISR.
+*                               OS_ERR_FLAG_INVALID_PGRP  if 'pgrp' is a NULL pointer.
+*
+* Returns    : 'pgrp', or a NULL pointer if an error was detected.
+*
+* Called from: Task ONLY
+*
+* Notes      : 1) 'pgrp' MUST remain valid for as long as the group is in use and MUST NOT already be in
+*                 use by another kernel object.
+*              2) OSFlagDel() does not return 'pgrp' to the pool; the application may reuse it once the
+*                 group has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_FLAG_GRP  *OSFlagCreateStatic (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                         /* Allocate storage for CPU status register        */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                       /* Validate 'perr'                                 */
+        return ((OS_FLAG_GRP *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                         /* See if called from ISR ...                      */
+        *perr = OS_ERR_CREATE_ISR;                  /* ... can't CREATE from an ISR                    */
+        return ((OS_FLAG_GRP *)0);
+    }
+    if (pgrp == (OS_FLAG_GRP *)0) {                 /* Validate 'pgrp'                                 */
+        *perr = OS_ERR_FLAG_INVALID_PGRP;
+        return ((OS_FLAG_GRP *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pgrp->OSFlagType     = OS_EVENT_TYPE_FLAG;      /* Set to event flag group type                    */
+    pgrp->OSFlagFlags    = flags;                   /* Set to desired initial value                    */
+    pgrp->OSFlagWaitList = (void *)0;               /* Clear list of tasks waiting on flags            */
+    pgrp->OSFlagWaitSet  = (OS_FLAGS)0;
+#if OS_FLAG_WAIT_CLR_EN > 0
+    pgrp->OSFlagWaitClr  = (OS_FLAGS)0;
+#endif
+    pgrp->OSFlagConsumed = (OS_FLAGS)0;
+#if OS_FLAG_NAME_SIZE > 1
+    pgrp->OSFlagName[0]  = '?';
+    pgrp->OSFlagName[1]  = OS_ASCII_NUL;
+#endif
+    OS_EXIT_CRITICAL();
+    *perr                = OS_ERR_NONE;
+    return (pgrp);                                  /* Return pointer to event flag group              */
+}
+#endif
 
 /*$PAGE*/
 /*
@@ -324,9 +405,8 @@ OS_FLAG_GRP  *OSFlagDel (OS_FLAG_GRP *pgrp, INT8U opt, INT8U *perr)
                  pgrp->OSFlagName[1]  = OS_ASCII_NUL;
 #endif
                  pgrp->OSFlagType     = OS_EVENT_TYPE_UNUSED;
-                 pgrp->OSFlagWaitList = (void *)OSFlagFreeList; /* Return group to free list           */
                  pgrp->OSFlagFlags    = (OS_FLAGS)0;
-                 OSFlagFreeList       = pgrp;
+                 OS_FlagFree(pgrp);                        /* Return group to free list                */
                  OS_EXIT_CRITICAL();
                  *perr                = OS_ERR_NONE;
                  pgrp_return          = (OS_FLAG_GRP *)0;  /* Event Flag Group has been deleted        */
@@ -348,9 +428,8 @@ OS_FLAG_GRP  *OSFlagDel (OS_FLAG_GRP *pgrp, INT8U opt, INT8U *perr)
              pgrp->OSFlagName[1]  = OS_ASCII_NUL;
 #endif
              pgrp->OSFlagType     = OS_EVENT_TYPE_UNUSED;
-             pgrp->OSFlagWaitList = (void *)OSFlagFreeList;/* Return group to free list                */
              pgrp->OSFlagFlags    = (OS_FLAGS)0;
-             OSFlagFreeList       = pgrp;
+             OS_FlagFree(pgrp);                            /* Return group to free list                */
              OS_EXIT_CRITICAL();
              if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
                  OS_Sched();                               /* Find highest priority task ready to run  */
@@ -557,7 +636,7 @@ void  OSFlagNameSet (OS_FLAG_GRP *pgrp, INT8U *pname, INT8U *perr)
 *********************************************************************************************************
 */
 
-OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U timeout, INT8U *perr)
+OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, OS_TICK timeout, INT8U *perr)
 {
     OS_FLAG_NODE  node;
     OS_FLAGS      flags_rdy;
@@ -606,6 +685,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
              if (flags_rdy == flags) {                     /* Must match ALL the bits that we want     */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags &= ~flags_rdy;      /* Clear ONLY the flags that we wanted      */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
                  OSTCBCur->OSTCBFlagsRdy = flags_rdy;      /* Save flags that were ready               */
                  OS_EXIT_CRITICAL();                       /* Yes, condition met, return to caller     */
@@ -622,6 +702,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
              if (flags_rdy != (OS_FLAGS)0) {               /* See if any flag set                      */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags &= ~flags_rdy;      /* Clear ONLY the flags that we got         */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
                  OSTCBCur->OSTCBFlagsRdy = flags_rdy;      /* Save flags that were ready               */
                  OS_EXIT_CRITICAL();                       /* Yes, condition met, return to caller     */
@@ -639,6 +720,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
              if (flags_rdy == flags) {                     /* Must match ALL the bits that we want     */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags |= flags_rdy;       /* Set ONLY the flags that we wanted        */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
                  OSTCBCur->OSTCBFlagsRdy = flags_rdy;      /* Save flags that were ready               */
                  OS_EXIT_CRITICAL();                       /* Yes, condition met, return to caller     */
@@ -655,6 +737,7 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
              if (flags_rdy != (OS_FLAGS)0) {               /* See if any flag cleared                  */
                  if (consume == OS_TRUE) {                 /* See if we need to consume the flags      */
                      pgrp->OSFlagFlags |= flags_rdy;       /* Set ONLY the flags that we got           */
+                     pgrp->OSFlagConsumed |= flags_rdy;    /* The next post must check the waiters  */
                  }
                  OSTCBCur->OSTCBFlagsRdy = flags_rdy;      /* Save flags that were ready               */
                  OS_EXIT_CRITICAL();                       /* Yes, condition met, return to caller     */
@@ -701,12 +784,14 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U wait_type, INT16U
             case OS_FLAG_WAIT_SET_ALL:
             case OS_FLAG_WAIT_SET_ANY:                     /* Clear ONLY the flags we got              */
                  pgrp->OSFlagFlags &= ~flags_rdy;
+                 pgrp->OSFlagConsumed |= flags_rdy;
                  break;
 
 #if OS_FLAG_WAIT_CLR_EN > 0
             case OS_FLAG_WAIT_CLR_ALL:
             case OS_FLAG_WAIT_CLR_ANY:                     /* Set   ONLY the flags we got              */
                  pgrp->OSFlagFlags |=  flags_rdy;
+                 pgrp->OSFlagConsumed |= flags_rdy;
                  break;
 #endif
             default:
@@ -781,15 +866,22 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (void)
 *                            OS_ERR_FLAG_INVALID_PGRP   You passed a NULL pointer
 *                            OS_ERR_EVENT_TYPE          You are not pointing to an event flag group
 *                            OS_ERR_FLAG_INVALID_OPT    You specified an invalid option
+*                            OS_ERR_INT_Q_FULL          Called from an ISR while OS_INT_Q_SIZE posts are
+*                                                       already deferred (see OS_IntQPost())
 *
-* Returns    : the new value of the event flags bits that are still set.
+* Returns    : the new value of the event flags bits that are still set.  When the post is deferred
+*              (OS_ISR_POST_DEFERRED_EN), the value of the flags before the post is applied.
 *
 * Called From: Task or ISR
 *
 * WARNING(s) : 1) The execution time of this function depends on the number of tasks waiting on the event
-*                 flag group.
+*                 flag group, unless no waiting task waits for a flag that the post changes (e.g. the flags
+*                 are already in the state posted) and no flag was consumed since the list was last looked
+*                 at: the wait list is then not looked at.
 *              2) The amount of time interrupts are DISABLED depends on the number of tasks waiting on
-*                 the event flag group.
+*                 the event flag group, with the same exception, unless OS_ISR_POST_DEFERRED_EN is set.
+*                 The waiting tasks are then looked at one at a time, with interrupts enabled in between
+*                 and the scheduler locked, so that interrupts are disabled for a short, constant time.
 *********************************************************************************************************
 */
 OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
@@ -798,6 +890,11 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
     BOOLEAN       sched;
     OS_FLAGS      flags_cur;
     OS_FLAGS      flags_rdy;
+    OS_FLAGS      flags_chg;
+    OS_FLAGS      wait_set;
+#if OS_FLAG_WAIT_CLR_EN > 0
+    OS_FLAGS      wait_clr;
+#endif
     BOOLEAN       rdy;
 #if OS_CRITICAL_METHOD == 3                          /* Allocate storage for CPU status register       */
     OS_CPU_SR     cpu_sr = 0;
@@ -818,14 +915,30 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
         *perr = OS_ERR_EVENT_TYPE;
         return ((OS_FLAGS)0);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                          /* Let OS_TaskIntQ() post once ISRs are done      */
+        if ((opt != OS_FLAG_CLR) && (opt != OS_FLAG_SET)) {
+            *perr = OS_ERR_FLAG_INVALID_OPT;
+            return ((OS_FLAGS)0);
+        }
+        *perr = OS_IntQPost(OS_INT_Q_TYPE_FLAG, (void *)pgrp, (void *)0, (INT32U)flags, opt);
+        return (pgrp->OSFlagFlags);                  /* Flags before the deferred post is applied      */
+    }
+#endif
 /*$PAGE*/
     OS_ENTER_CRITICAL();
     switch (opt) {
-        case OS_FLAG_CLR:
+        case OS_FLAG_CLR:                            /* Flags awaited to be 0 that go from 1 to 0      */
+#if OS_FLAG_WAIT_CLR_EN > 0
+             flags_chg          = (OS_FLAGS)(pgrp->OSFlagFlags & flags & pgrp->OSFlagWaitClr);
+#else
+             flags_chg          = (OS_FLAGS)0;
+#endif
              pgrp->OSFlagFlags &= ~flags;            /* Clear the flags specified in the group         */
              break;
 
-        case OS_FLAG_SET:
+        case OS_FLAG_SET:                            /* Flags awaited to be 1 that go from 0 to 1      */
+             flags_chg          = (OS_FLAGS)(~pgrp->OSFlagFlags & flags & pgrp->OSFlagWaitSet);
              pgrp->OSFlagFlags |=  flags;            /* Set   the flags specified in the group         */
              break;
 
@@ -834,57 +947,81 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP *pgrp, OS_FLAGS flags, INT8U opt, INT8U *perr)
              *perr = OS_ERR_FLAG_INVALID_OPT;
              return ((OS_FLAGS)0);
     }
-    sched = OS_FALSE;                                /* Indicate that we don't need rescheduling       */
-    pnode = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
-    while (pnode != (OS_FLAG_NODE *)0) {             /* Go through all tasks waiting on event flag(s)  */
-        switch (pnode->OSFlagNodeWaitType) {
-            case OS_FLAG_WAIT_SET_ALL:               /* See if all req. flags are set for current node */
-                 flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
-                 if (flags_rdy == pnode->OSFlagNodeFlags) {
-                     rdy = OS_FlagTaskRdy(pnode, flags_rdy);  /* Make task RTR, event(s) Rx'd          */
-                     if (rdy == OS_TRUE) {
-                         sched = OS_TRUE;                     /* When done we will reschedule          */
-                     }
-                 }
-                 break;
-
-            case OS_FLAG_WAIT_SET_ANY:               /* See if any flag set                            */
-                 flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
-                 if (flags_rdy != (OS_FLAGS)0) {
-                     rdy = OS_FlagTaskRdy(pnode, flags_rdy);  /* Make task RTR, event(s) Rx'd          */
-                     if (rdy == OS_TRUE) {
-                         sched = OS_TRUE;                     /* When done we will reschedule          */
-                     }
-                 }
-                 break;
-
+    sched      = OS_FALSE;                           /* Indicate that we don't need rescheduling       */
+    flags_chg |= pgrp->OSFlagConsumed;               /* Consuming may have satisfied other waiters     */
+    if (flags_chg != (OS_FLAGS)0) {                  /* No waiter can be readied if none changed       */
+        pgrp->OSFlagConsumed = (OS_FLAGS)0;
+        wait_set = (OS_FLAGS)0;                      /* Rebuild the flags awaited by the others        */
 #if OS_FLAG_WAIT_CLR_EN > 0
-            case OS_FLAG_WAIT_CLR_ALL:               /* See if all req. flags are set for current node */
-                 flags_rdy = (OS_FLAGS)(~pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
-                 if (flags_rdy == pnode->OSFlagNodeFlags) {
-                     rdy = OS_FlagTaskRdy(pnode, flags_rdy);  /* Make task RTR, event(s) Rx'd          */
-                     if (rdy == OS_TRUE) {
-                         sched = OS_TRUE;                     /* When done we will reschedule          */
-                     }
-                 }
-                 break;
+        wait_clr = (OS_FLAGS)0;
+#endif
+        pnode    = (OS_FLAG_NODE *)pgrp->OSFlagWaitList;
+#if OS_ISR_POST_DEFERRED_EN > 0
+        if (OSLockNesting < 255u) {                  /* No task may change the list while we walk it   */
+            OSLockNesting++;
+        }
+        sched    = OS_TRUE;                          /* ISRs may ready tasks during the walk           */
+#endif
+        while (pnode != (OS_FLAG_NODE *)0) {         /* Go through all tasks waiting on event flag(s)  */
+            switch (pnode->OSFlagNodeWaitType) {
+                case OS_FLAG_WAIT_SET_ALL:           /* See if all req. flags are set for current node */
+                     flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
+                     rdy       = (BOOLEAN)(flags_rdy == pnode->OSFlagNodeFlags);
+                     break;
+
+                case OS_FLAG_WAIT_SET_ANY:           /* See if any flag set                            */
+                     flags_rdy = (OS_FLAGS)(pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
+                     rdy       = (BOOLEAN)(flags_rdy != (OS_FLAGS)0);
+                     break;
 
-            case OS_FLAG_WAIT_CLR_ANY:               /* See if any flag set                            */
-                 flags_rdy = (OS_FLAGS)(~pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
-                 if (flags_rdy != (OS_FLAGS)0) {
-                     rdy = OS_FlagTaskRdy(pnode, flags_rdy);  /* Make task RTR, event(s) Rx'd          */
-                     if (rdy == OS_TRUE) {
-                         sched = OS_TRUE;                     /* When done we will reschedule          */
+#if OS_FLAG_WAIT_CLR_EN > 0
+                case OS_FLAG_WAIT_CLR_ALL:           /* See if all req. flags are clr for current node */
+                     flags_rdy = (OS_FLAGS)(~pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
+                     rdy       = (BOOLEAN)(flags_rdy == pnode->OSFlagNodeFlags);
+                     break;
+
+                case OS_FLAG_WAIT_CLR_ANY:           /* See if any flag clr                            */
+                     flags_rdy = (OS_FLAGS)(~pgrp->OSFlagFlags & pnode->OSFlagNodeFlags);
+                     rdy       = (BOOLEAN)(flags_rdy != (OS_FLAGS)0);
+                     break;
+#endif
+                default:
+#if OS_ISR_POST_DEFERRED_EN > 0
+                     if (OSLockNesting > 0) {
+                         OSLockNesting--;
                      }
-                 }
-                 break;
 #endif
-            default:
-                 OS_EXIT_CRITICAL();
-                 *perr = OS_ERR_FLAG_WAIT_TYPE;
-                 return ((OS_FLAGS)0);
+                     OS_EXIT_CRITICAL();
+                     *perr = OS_ERR_FLAG_WAIT_TYPE;
+                     return ((OS_FLAGS)0);
+            }
+            if (rdy == OS_TRUE) {
+                if (OS_FlagTaskRdy(pnode, flags_rdy) == OS_TRUE) {  /* Make task RTR, event(s) Rx'd    */
+                    sched = OS_TRUE;                 /* When done we will reschedule                   */
+                }
+#if OS_FLAG_WAIT_CLR_EN > 0
+            } else if ((pnode->OSFlagNodeWaitType == OS_FLAG_WAIT_CLR_ALL) ||
+                       (pnode->OSFlagNodeWaitType == OS_FLAG_WAIT_CLR_ANY)) {
+                wait_clr |= pnode->OSFlagNodeFlags;
+#endif
+            } else {
+                wait_set |= pnode->OSFlagNodeFlags;
+            }
+            pnode = (OS_FLAG_NODE *)pnode->OSFlagNodeNext; /* Point to next task waiting for flag(s)   */
+#if OS_ISR_POST_DEFERRED_EN > 0
+            OS_EXIT_CRITICAL();                      /* Let interrupts in between two waiters: the     */
+            OS_ENTER_CRITICAL();                     /* ... posts of ISRs are deferred                 */
+#endif
         }
-        pnode = (OS_FLAG_NODE *)pnode->OSFlagNodeNext; /* Point to next task waiting for event flag(s) */
+#if OS_ISR_POST_DEFERRED_EN > 0
+        if (OSLockNesting > 0) {                     /* Remove context switch lock                     */
+            OSLockNesting--;
+        }
+#endif
+        pgrp->OSFlagWaitSet = wait_set;
+#if OS_FLAG_WAIT_CLR_EN > 0
+        pgrp->OSFlagWaitClr = wait_clr;
+#endif
     }
     OS_EXIT_CRITICAL();
     if (sched == OS_TRUE) {
@@ -985,19 +1122,31 @@ OS_FLAGS  OSFlagQuery (OS_FLAG_GRP *pgrp, INT8U *perr)
 *********************************************************************************************************
 */
 
-static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, INT16U timeout)
+static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS flags, INT8U wait_type, OS_TICK timeout)
 {
     OS_FLAG_NODE  *pnode_next;
+#if OS_SCHED_RR_EN == 0
     INT8U          y;
+#endif
 
 
     OSTCBCur->OSTCBStat      |= OS_STAT_FLAG;
     OSTCBCur->OSTCBStatPend   = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly        = timeout;              /* Store timeout in task's TCB                   */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store timeout in task's TCB and tick list     */
 #if OS_TASK_DEL_EN > 0
     OSTCBCur->OSTCBFlagNode   = pnode;                /* TCB to link to node                           */
 #endif
     pnode->OSFlagNodeFlags    = flags;                /* Save the flags that we need to wait for       */
+#if OS_FLAG_WAIT_CLR_EN > 0
+    if ((wait_type == OS_FLAG_WAIT_CLR_ALL) ||        /* Flags a post must change to ready the task    */
+        (wait_type == OS_FLAG_WAIT_CLR_ANY)) {
+        pgrp->OSFlagWaitClr |= flags;
+    } else {
+        pgrp->OSFlagWaitSet |= flags;
+    }
+#else
+    pgrp->OSFlagWaitSet      |= flags;                /* Flags a post must change to ready the task    */
+#endif
     pnode->OSFlagNodeWaitType = wait_type;            /* Save the type of wait we are doing            */
     pnode->OSFlagNodeTCB      = (void *)OSTCBCur;     /* Link to task's TCB                            */
     pnode->OSFlagNodeNext     = pgrp->OSFlagWaitList; /* Add node at beginning of event flag wait list */
@@ -1009,11 +1158,50 @@ static  void  OS_FlagBlock (OS_FLAG_GRP *pgrp, OS_FLAG_NODE *pnode, OS_FLAGS fla
     }
     pgrp->OSFlagWaitList = (void *)pnode;
 
+#if OS_SCHED_RR_EN > 0
+    OS_RdyListRemove(OSTCBCur);                       /* Suspend current task until flag(s) received   */
+#else
     y            =  OSTCBCur->OSTCBY;                 /* Suspend current task until flag(s) received   */
     OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
     if (OSRdyTbl[y] == 0x00) {
         OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
     }
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                             RETURN AN EVENT FLAG GROUP TO THE POOL
+*
+* Description: This function is called by OSFlagDel() to release a deleted event flag group.  Groups
+*              supplied by the application through OSFlagCreateStatic() are not part of OSFlagTbl[] and
+*              are only marked as unused.
+*
+* Arguments  : pgrp          is a pointer to the event flag group to release.
+*
+* Returns    : none
+*
+* WARNING    : You MUST NOT call this function from your code.  This is an INTERNAL function to uC/OS-II.
+*              Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_FlagFree (OS_FLAG_GRP *pgrp)
+{
+#if OS_MAX_FLAGS > 0
+#if OS_OBJ_STATIC_EN > 0
+    if ((pgrp <  &OSFlagTbl[0]) ||                  /* See if the group is outside of the pool         */
+        (pgrp >= &OSFlagTbl[OS_MAX_FLAGS])) {
+        pgrp->OSFlagWaitList = (void *)0;
+        return;
+    }
+#endif
+    pgrp->OSFlagWaitList = (void *)OSFlagFreeList;  /* Return group to free list                       */
+    OSFlagFreeList       = pgrp;
+#else
+    pgrp->OSFlagWaitList = (void *)0;               /* No pool, all groups belong to the application   */
+#endif
 }
 
 /*$PAGE*/
@@ -1039,6 +1227,11 @@ void  OS_FlagInit (void)
     OSFlagFreeList->OSFlagType     = OS_EVENT_TYPE_UNUSED;
     OSFlagFreeList->OSFlagWaitList = (void *)0;
     OSFlagFreeList->OSFlagFlags    = (OS_FLAGS)0;
+    OSFlagFreeList->OSFlagWaitSet  = (OS_FLAGS)0;
+#if OS_FLAG_WAIT_CLR_EN > 0
+    OSFlagFreeList->OSFlagWaitClr  = (OS_FLAGS)0;
+#endif
+    OSFlagFreeList->OSFlagConsumed = (OS_FLAGS)0;
 #if OS_FLAG_NAME_SIZE > 1
     OSFlagFreeList->OSFlagName[0]  = '?';
     OSFlagFreeList->OSFlagName[1]  = OS_ASCII_NUL;
@@ -1105,13 +1298,17 @@ static  BOOLEAN  OS_FlagTaskRdy (OS_FLAG_NODE *pnode, OS_FLAGS flags_rdy)
 
 
     ptcb                 = (OS_TCB *)pnode->OSFlagNodeTCB; /* Point to TCB of waiting task             */
-    ptcb->OSTCBDly       = 0;
+    OS_TickListRemove(ptcb);
     ptcb->OSTCBFlagsRdy  = flags_rdy;
     ptcb->OSTCBStat     &= ~(INT8U)OS_STAT_FLAG;
     ptcb->OSTCBStatPend  = OS_STAT_PEND_OK;
     if (ptcb->OSTCBStat == OS_STAT_RDY) {                  /* Task now ready?                          */
+#if OS_SCHED_RR_EN > 0
+        OS_RdyListInsert(ptcb);                            /* Put task into ready list                 */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Put task into ready list                 */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         sched                   = OS_TRUE;
     } else {
         sched                   = OS_FALSE;
@@ -1159,6 +1356,11 @@ void  OS_FlagUnlink (OS_FLAG_NODE *pnode)
         pgrp->OSFlagWaitList = (void *)pnode_next;              /*      Update list for new 1st node   */
         if (pnode_next != (OS_FLAG_NODE *)0) {
             pnode_next->OSFlagNodePrev = (OS_FLAG_NODE *)0;     /*      Link new 1st node PREV to NULL */
+        } else {
+            pgrp->OSFlagWaitSet = (OS_FLAGS)0;                  /*      Nobody waits on any flag now   */
+#if OS_FLAG_WAIT_CLR_EN > 0
+            pgrp->OSFlagWaitClr = (OS_FLAGS)0;
+#endif
         }
     } else {                                                    /* No,  A node somewhere in the list   */
         pnode_prev->OSFlagNodeNext = pnode_next;                /*      Link around the node to unlink */
@@ -85,6 +85,7 @@ void  *OSMboxAccept (OS_EVENT *pevent)
 *********************************************************************************************************
 */
 
+#if OS_MAX_EVENTS > 0
 OS_EVENT  *OSMboxCreate (void *pmsg)
 {
     OS_EVENT  *pevent;
@@ -115,6 +116,50 @@ OS_EVENT  *OSMboxCreate (void *pmsg)
     }
     return (pevent);                             /* Return pointer to event control block              */
 }
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              CREATE A MESSAGE MAILBOX IN APPLICATION STORAGE
+*
+* Description: This function creates a message mailbox using an event control block supplied by the
+*              application instead of taking one from the OSEventTbl[] pool.
+*
+* Arguments  : pevent        is a pointer to the event control block to use.
+*
+*              pmsg          is a pointer to a message that you wish to deposit in the mailbox (see
+*                            OSMboxCreate()).
+*
+* Returns    : != (OS_EVENT *)0  is 'pevent'
+*              == (OS_EVENT *)0  if 'pevent' is NULL or if called from an ISR
+*
+* Notes      : 1) 'pevent' MUST remain valid for as long as the mailbox is in use and MUST NOT already
+*                 be in use by another kernel object.
+*              2) OSMboxDel() does not return 'pevent' to the pool; the application may reuse it once
+*                 the mailbox has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT  *OSMboxCreateStatic (OS_EVENT *pevent, void *pmsg)
+{
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        return ((OS_EVENT *)0);
+    }
+    pevent->OSEventType    = OS_EVENT_TYPE_MBOX;
+    pevent->OSEventCnt     = 0;
+    pevent->OSEventPtr     = pmsg;               /* Deposit message in event control block             */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);
+    return (pevent);                             /* Return pointer to event control block              */
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -194,9 +239,8 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
                  pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
                  pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
-                 pevent->OSEventPtr  = OSEventFreeList;    /* Return Event Control Block to free list  */
                  pevent->OSEventCnt  = 0;
-                 OSEventFreeList     = pevent;             /* Get next free event control block        */
+                 OS_EventFree(pevent);                     /* Return Event Control Block to free list  */
                  OS_EXIT_CRITICAL();
                  *perr               = OS_ERR_NONE;
                  pevent_return       = (OS_EVENT *)0;      /* Mailbox has been deleted                 */
@@ -216,9 +260,8 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
-             pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
              pevent->OSEventCnt     = 0;
-             OSEventFreeList        = pevent;              /* Get next free event control block        */
+             OS_EventFree(pevent);                         /* Return Event Control Block to free list  */
              OS_EXIT_CRITICAL();
              if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
                  OS_Sched();                               /* Find highest priority task ready to run  */
@@ -271,7 +314,7 @@ OS_EVENT  *OSMboxDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *********************************************************************************************************
 */
 /*$PAGE*/
-void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  *OSMboxPend (OS_EVENT *pevent, OS_TICK timeout, INT8U *perr)
 {
     void      *pmsg;
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
@@ -311,7 +354,7 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_MBOX;          /* Message not available, task will pend         */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Load timeout in TCB and tick list             */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready to run  */
@@ -446,6 +489,8 @@ INT8U  OSMboxPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *              OS_ERR_EVENT_TYPE    If you are attempting to post to a non mailbox.
 *              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer
 *              OS_ERR_POST_NULL_PTR If you are attempting to post a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while OS_INT_Q_SIZE posts are
+*                                   already deferred (see OS_IntQPost())
 *
 * Note(s)    : 1) HPT means Highest Priority Task
 *********************************************************************************************************
@@ -471,6 +516,11 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
     if (pevent->OSEventType != OS_EVENT_TYPE_MBOX) {  /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() post once ISRs are done     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_MBOX, (void *)pevent, pmsg, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
                                                       /* Ready HPT waiting on event                    */
@@ -514,11 +564,15 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
 *              OS_ERR_EVENT_TYPE    If you are attempting to post to a non mailbox.
 *              OS_ERR_PEVENT_NULL   If 'pevent' is a NULL pointer
 *              OS_ERR_POST_NULL_PTR If you are attempting to post a NULL pointer
+*              OS_ERR_INT_Q_FULL    If called from an ISR while OS_INT_Q_SIZE posts are
+*                                   already deferred (see OS_IntQPost())
 *
 * Note(s)    : 1) HPT means Highest Priority Task
 *
 * Warning    : Interrupts can be disabled for a long time if you do a 'broadcast'.  In fact, the
 *              interrupt disable time is proportional to the number of tasks waiting on the mailbox.
+*              With OS_ISR_POST_DEFERRED_EN, the waiting tasks are readied one at a time instead, with
+*              interrupts enabled in between and the scheduler locked.
 *********************************************************************************************************
 */
 
@@ -542,12 +596,31 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
     if (pevent->OSEventType != OS_EVENT_TYPE_MBOX) {  /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() post once ISRs are done     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_MBOX_OPT, (void *)pevent, pmsg, 0, opt));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
+#if OS_ISR_POST_DEFERRED_EN > 0
+            if (OSLockNesting < 255u) {               /* No task may pend while we post                */
+                OSLockNesting++;
+            }
+#endif
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on mailbox     */
                 (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_MBOX, OS_STAT_PEND_OK);
+#if OS_ISR_POST_DEFERRED_EN > 0
+                OS_EXIT_CRITICAL();                   /* Let interrupts in between two waiters: the    */
+                OS_ENTER_CRITICAL();                  /* ... posts of ISRs are deferred                */
+#endif
+            }
+#if OS_ISR_POST_DEFERRED_EN > 0
+            if (OSLockNesting > 0) {                  /* Remove context switch lock                    */
+                OSLockNesting--;
             }
+#endif
         } else {                                      /* No,  Post to HPT waiting on mbox              */
             (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_MBOX, OS_STAT_PEND_OK);
         }
@@ -590,13 +663,8 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
 INT8U  OSMboxQuery (OS_EVENT *pevent, OS_MBOX_DATA *p_mbox_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    INT32U    *psrc;
+    INT32U    *pdest;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
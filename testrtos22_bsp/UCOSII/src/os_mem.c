@@ -25,7 +25,7 @@
 #include <ucos_ii.h>
 #endif
 
-#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
+#if (OS_MEM_EN > 0) && ((OS_MAX_MEM_PART > 0) || (OS_OBJ_STATIC_EN > 0))
 /*
 *********************************************************************************************************
 *                                        CREATE A MEMORY PARTITION
@@ -56,6 +56,7 @@
 *********************************************************************************************************
 */
 
+#if OS_MAX_MEM_PART > 0
 OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
 {
     OS_MEM    *pmem;
@@ -100,11 +101,11 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
         return ((OS_MEM *)0);
     }
     plink = (void **)addr;                            /* Create linked list of free memory blocks      */
-    pblk  = (INT8U *)((INT32U)addr + blksize);
+    pblk  = (INT8U *)addr + blksize;
     for (i = 0; i < (nblks - 1); i++) {
        *plink = (void *)pblk;                         /* Save pointer to NEXT block in CURRENT block   */
         plink = (void **)pblk;                        /* Position to  NEXT      block                  */
-        pblk  = (INT8U *)((INT32U)pblk + blksize);    /* Point to the FOLLOWING block                  */
+        pblk += blksize;                              /* Point to the FOLLOWING block                  */
     }
     *plink              = (void *)0;                  /* Last memory block points to NULL              */
     pmem->OSMemAddr     = addr;                       /* Store start address of memory partition       */
@@ -115,6 +116,98 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
     *perr               = OS_ERR_NONE;
     return (pmem);
 }
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              CREATE A MEMORY PARTITION IN APPLICATION STORAGE
+*
+* Description : Create a fixed-sized memory partition using a partition control block supplied by the
+*               application instead of taking one from the OSMemTbl[] pool.
+*
+* Arguments   : pmem     is a pointer to the memory partition control block to use.
+*
+*               addr     is the starting address of the memory partition
+*
+*               nblks    is the number of memory blocks to create from the partition.
+*
+*               blksize  is the size (in bytes) of each block in the memory partition.
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE              if the memory partition has been created correctly.
+*                        OS_ERR_MEM_INVALID_PMEM  if 'pmem' is a NULL pointer
+*                        OS_ERR_MEM_INVALID_ADDR  if you are specifying an invalid address for the memory
+*                                                 storage of the partition or, the block does not align
+*                                                 on a pointer boundary
+*                        OS_ERR_MEM_INVALID_BLKS  user specified an invalid number of blocks (must be >= 2)
+*                        OS_ERR_MEM_INVALID_SIZE  user specified an invalid block size
+*                                                   - must be greater than the size of a pointer
+*                                                   - must be able to hold an integral number of pointers
+* Returns    : != (OS_MEM *)0  is 'pmem'
+*              == (OS_MEM *)0  if the partition was not created because of invalid arguments.
+*
+* Note(s)    : 'pmem' MUST remain valid for as long as the partition is in use and MUST NOT already be in
+*              use by another partition.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_MEM  *OSMemCreateStatic (OS_MEM *pmem, void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
+{
+    INT8U     *pblk;
+    void     **plink;
+    INT32U     i;
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_MEM *)0);
+    }
+    if (pmem == (OS_MEM *)0) {                        /* Must pass a valid partition control block     */
+        *perr = OS_ERR_MEM_INVALID_PMEM;
+        return ((OS_MEM *)0);
+    }
+    if (addr == (void *)0) {                          /* Must pass a valid address for the memory part.*/
+        *perr = OS_ERR_MEM_INVALID_ADDR;
+        return ((OS_MEM *)0);
+    }
+    if (((INT32U)addr & (sizeof(void *) - 1)) != 0){  /* Must be pointer size aligned                  */
+        *perr = OS_ERR_MEM_INVALID_ADDR;
+        return ((OS_MEM *)0);
+    }
+    if (nblks < 2) {                                  /* Must have at least 2 blocks per partition     */
+        *perr = OS_ERR_MEM_INVALID_BLKS;
+        return ((OS_MEM *)0);
+    }
+    if (blksize < sizeof(void *)) {                   /* Must contain space for at least a pointer     */
+        *perr = OS_ERR_MEM_INVALID_SIZE;
+        return ((OS_MEM *)0);
+    }
+#endif
+    plink = (void **)addr;                            /* Create linked list of free memory blocks      */
+    pblk  = (INT8U *)addr + blksize;
+    for (i = 0; i < (nblks - 1); i++) {
+       *plink = (void *)pblk;                         /* Save pointer to NEXT block in CURRENT block   */
+        plink = (void **)pblk;                        /* Position to  NEXT      block                  */
+        pblk += blksize;                              /* Point to the FOLLOWING block                  */
+    }
+    *plink              = (void *)0;                  /* Last memory block points to NULL              */
+    pmem->OSMemAddr     = addr;                       /* Store start address of memory partition       */
+    pmem->OSMemFreeList = addr;                       /* Initialize pointer to pool of free blocks     */
+    pmem->OSMemNFree    = nblks;                      /* Store number of free blocks in MCB            */
+    pmem->OSMemNBlks    = nblks;
+    pmem->OSMemBlkSize  = blksize;                    /* Store block size of each memory blocks        */
+#if OS_MEM_NAME_SIZE > 1
+    pmem->OSMemName[0]  = '?';                        /* Unknown name                                  */
+    pmem->OSMemName[1]  = OS_ASCII_NUL;
+#endif
+    *perr               = OS_ERR_NONE;
+    return (pmem);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -38,13 +38,21 @@
 
 #define  OS_MUTEX_AVAILABLE      ((INT16U)0x00FFu)
 
+#define  OS_MUTEX_NO_PIP         ((INT16U)0xFF00u)         /* Upper 8 bits when priorities are inherited */
+
 /*
 *********************************************************************************************************
 *                                            LOCAL CONSTANTS
 *********************************************************************************************************
 */
 
-static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
+#if OS_MUTEX_PI_EN > 0
+static  void   OSMutex_Own(OS_EVENT *pevent, OS_TCB *ptcb);
+static  void   OSMutex_Disown(OS_EVENT *pevent);
+static  INT8U  OSMutex_PrioGet(OS_TCB *ptcb);
+#else
+static  void   OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
+#endif
 
 /*$PAGE*/
 /*
@@ -68,7 +76,8 @@ static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
 *                                                number) than ALL the tasks that compete for the Mutex.
 *                                                Unfortunately, this is something that could not be
 *                                                detected when the Mutex is created because we don't know
-*                                                what tasks will be using the Mutex.
+*                                                what tasks will be using the Mutex.  Never returned when
+*                                                OS_MUTEX_PI_EN is enabled, as there is no PIP.
 *
 * Returns    : == OS_TRUE    if the resource is available, the mutual exclusion semaphore is acquired
 *              == OS_FALSE   a) if the resource is not available
@@ -83,7 +92,9 @@ static  void  OSMutex_RdyAtPrio(OS_TCB *ptcb, INT8U prio);
 #if OS_MUTEX_ACCEPT_EN > 0
 BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
 {
+#if OS_MUTEX_PI_EN == 0
     INT8U      pip;                                    /* Priority Inheritance Priority (PIP)          */
+#endif
 #if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -108,6 +119,16 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
         return (OS_FALSE);
     }
     OS_ENTER_CRITICAL();                               /* Get value (0 or 1) of Mutex                  */
+#if OS_MUTEX_PI_EN > 0
+    if ((pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+        pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;   /*      Mask off LSByte (Acquire Mutex)         */
+        pevent->OSEventCnt |= OSTCBCur->OSTCBBasePrio; /*      Save current task priority in LSByte    */
+        OSMutex_Own(pevent, OSTCBCur);                 /*      Link TCB of task owning Mutex           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (OS_TRUE);
+    }
+#else
     pip = (INT8U)(pevent->OSEventCnt >> 8);            /* Get PIP from mutex                           */
     if ((pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;   /*      Mask off LSByte (Acquire Mutex)         */
@@ -122,6 +143,7 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
         }
         return (OS_TRUE);
     }
+#endif
     OS_EXIT_CRITICAL();
     *perr = OS_ERR_NONE;
     return (OS_FALSE);
@@ -160,9 +182,14 @@ BOOLEAN  OSMutexAccept (OS_EVENT *pevent, INT8U *perr)
 *
 *              2) The MOST  significant 8 bits of '.OSEventCnt' are used to hold the priority number
 *                 to use to reduce priority inversion.
+*
+*              3) When OS_MUTEX_PI_EN is enabled, 'prio' is not used and no priority is reserved.  The
+*                 owner of the mutex is instead raised to the priority of the highest priority task
+*                 waiting for it, and the MOST significant 8 bits of '.OSEventCnt' hold 0xFF.
 *********************************************************************************************************
 */
 
+#if OS_MAX_EVENTS > 0
 OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
 {
     OS_EVENT  *pevent;
@@ -176,25 +203,31 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
     if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
         return ((OS_EVENT *)0);
     }
+#if OS_MUTEX_PI_EN == 0
     if (prio >= OS_LOWEST_PRIO) {                          /* Validate PIP                             */
         *perr = OS_ERR_PRIO_INVALID;
         return ((OS_EVENT *)0);
     }
+#endif
 #endif
     if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
         *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE mutex from an ISR       */
         return ((OS_EVENT *)0);
     }
     OS_ENTER_CRITICAL();
+#if OS_MUTEX_PI_EN == 0
     if (OSTCBPrioTbl[prio] != (OS_TCB *)0) {               /* Mutex priority must not already exist    */
         OS_EXIT_CRITICAL();                                /* Task already exist at priority ...       */
         *perr = OS_ERR_PRIO_EXIST;                         /* ... inheritance priority                 */
         return ((OS_EVENT *)0);
     }
     OSTCBPrioTbl[prio] = OS_TCB_RESERVED;                  /* Reserve the table entry                  */
+#endif
     pevent             = OSEventFreeList;                  /* Get next free event control block        */
     if (pevent == (OS_EVENT *)0) {                         /* See if an ECB was available              */
+#if OS_MUTEX_PI_EN == 0
         OSTCBPrioTbl[prio] = (OS_TCB *)0;                  /* No, Release the table entry              */
+#endif
         OS_EXIT_CRITICAL();
         *perr              = OS_ERR_PEVENT_NULL;           /* No more event control blocks             */
         return (pevent);
@@ -202,7 +235,13 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
     OSEventFreeList        = (OS_EVENT *)OSEventFreeList->OSEventPtr;   /* Adjust the free list        */
     OS_EXIT_CRITICAL();
     pevent->OSEventType    = OS_EVENT_TYPE_MUTEX;
+#if OS_MUTEX_PI_EN > 0
+    prio                   = prio;                         /* Prevent compiler warning, no PIP is used */
+    pevent->OSEventCnt     = OS_MUTEX_NO_PIP | OS_MUTEX_AVAILABLE;      /* Resource is available       */
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+#else
     pevent->OSEventCnt     = (INT16U)((INT16U)prio << 8) | OS_MUTEX_AVAILABLE; /* Resource is avail.   */
+#endif
     pevent->OSEventPtr     = (void *)0;                                 /* No task owning the mutex    */
 #if OS_EVENT_NAME_SIZE > 1
     pevent->OSEventName[0] = '?';
@@ -212,6 +251,96 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
     *perr                  = OS_ERR_NONE;
     return (pevent);
 }
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                       CREATE A MUTUAL EXCLUSION SEMAPHORE IN APPLICATION STORAGE
+*
+* Description: This function creates a mutual exclusion semaphore using an event control block supplied
+*              by the application instead of taking one from the OSEventTbl[] pool.
+*
+* Arguments  : pevent        is a pointer to the event control block to use.
+*
+*              prio          is the priority to use when accessing the mutual exclusion semaphore (see
+*                            OSMutexCreate(), not used when OS_MUTEX_PI_EN is enabled).
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a MUTEX from an ISR
+*                               OS_ERR_PRIO_EXIST   if a task at the priority inheritance priority
+*                                                   already exist.
+*                               OS_ERR_PEVENT_NULL  if 'pevent' is a NULL pointer.
+*                               OS_ERR_PRIO_INVALID if the priority you specify is higher that the
+*                                                   maximum allowed (i.e. > OS_LOWEST_PRIO)
+*
+* Returns    : != (void *)0  is 'pevent'
+*              == (void *)0  if an error is detected.
+*
+* Note(s)    : 1) 'pevent' MUST remain valid for as long as the mutex is in use and MUST NOT already be
+*                 in use by another kernel object.
+*
+*              2) OSMutexDel() does not return 'pevent' to the pool; the application may reuse it once
+*                 the mutex has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT  *OSMutexCreateStatic (OS_EVENT *pevent, INT8U prio, INT8U *perr)
+{
+#if (OS_CRITICAL_METHOD == 3) && (OS_MUTEX_PI_EN == 0)    /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_EVENT *)0);
+    }
+#if OS_MUTEX_PI_EN == 0
+    if (prio >= OS_LOWEST_PRIO) {                          /* Validate PIP                             */
+        *perr = OS_ERR_PRIO_INVALID;
+        return ((OS_EVENT *)0);
+    }
+#endif
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE mutex from an ISR       */
+        return ((OS_EVENT *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+#if OS_MUTEX_PI_EN > 0
+    prio                   = prio;                         /* Prevent compiler warning, no PIP is used */
+    pevent->OSEventType    = OS_EVENT_TYPE_MUTEX;
+    pevent->OSEventCnt     = OS_MUTEX_NO_PIP | OS_MUTEX_AVAILABLE;      /* Resource is available       */
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+#else
+    OS_ENTER_CRITICAL();
+    if (OSTCBPrioTbl[prio] != (OS_TCB *)0) {               /* Mutex priority must not already exist    */
+        OS_EXIT_CRITICAL();                                /* Task already exist at priority ...       */
+        *perr = OS_ERR_PRIO_EXIST;                         /* ... inheritance priority                 */
+        return ((OS_EVENT *)0);
+    }
+    OSTCBPrioTbl[prio] = OS_TCB_RESERVED;                  /* Reserve the table entry                  */
+    OS_EXIT_CRITICAL();
+    pevent->OSEventType    = OS_EVENT_TYPE_MUTEX;
+    pevent->OSEventCnt     = (INT16U)((INT16U)prio << 8) | OS_MUTEX_AVAILABLE; /* Resource is avail.   */
+#endif
+    pevent->OSEventPtr     = (void *)0;                                 /* No task owning the mutex    */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+#endif
 
 /*$PAGE*/
 /*
@@ -250,7 +379,9 @@ OS_EVENT  *OSMutexCreate (INT8U prio, INT8U *perr)
 *              4) IMPORTANT: In the 'OS_DEL_ALWAYS' case, we assume that the owner of the Mutex (if there
 *                            is one) is ready-to-run and is thus NOT pending on another kernel object or
 *                            has delayed itself.  In other words, if a task owns the mutex being deleted,
-*                            that task will be made ready-to-run at its original priority.
+*                            that task will be made ready-to-run at its original priority.  This does not
+*                            apply when OS_MUTEX_PI_EN is enabled: the owner keeps its state and only
+*                            loses the priority it inherited through this mutex.
 *********************************************************************************************************
 */
 
@@ -259,9 +390,13 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 {
     BOOLEAN    tasks_waiting;
     OS_EVENT  *pevent_return;
+#if OS_MUTEX_PI_EN > 0
+    OS_TCB    *ptcb;
+#else
     INT8U      pip;                                        /* Priority inheritance priority            */
     INT8U      prio;
     OS_TCB    *ptcb;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -298,12 +433,17 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
                  pevent->OSEventName[0] = '?';             /* Unknown name                             */
                  pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
+#if OS_MUTEX_PI_EN > 0
+                 if (pevent->OSEventPtr != (void *)0) {    /* Unlink the mutex from its owner          */
+                     OSMutex_Disown(pevent);
+                 }
+#else
                  pip                 = (INT8U)(pevent->OSEventCnt >> 8);
                  OSTCBPrioTbl[pip]   = (OS_TCB *)0;        /* Free up the PIP                          */
+#endif
                  pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
-                 pevent->OSEventPtr  = OSEventFreeList;    /* Return Event Control Block to free list  */
                  pevent->OSEventCnt  = 0;
-                 OSEventFreeList     = pevent;
+                 OS_EventFree(pevent);                     /* Return Event Control Block to free list  */
                  OS_EXIT_CRITICAL();
                  *perr               = OS_ERR_NONE;
                  pevent_return       = (OS_EVENT *)0;      /* Mutex has been deleted                   */
@@ -315,6 +455,16 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              break;
 
         case OS_DEL_ALWAYS:                                /* ALWAYS DELETE THE MUTEX ---------------- */
+#if OS_MUTEX_PI_EN > 0
+             while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for mutex        */
+                 (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
+             }
+             ptcb = (OS_TCB *)pevent->OSEventPtr;
+             if (ptcb != (OS_TCB *)0) {                    /* See if any task owns the mutex           */
+                 OSMutex_Disown(pevent);                   /* Yes, drop what it inherited from it      */
+                 OS_MutexPrioUpdate(ptcb);
+             }
+#else
              pip  = (INT8U)(pevent->OSEventCnt >> 8);                     /* Get PIP of mutex          */
              prio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* Get owner's original prio */
              ptcb = (OS_TCB *)pevent->OSEventPtr;
@@ -326,16 +476,18 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for mutex        */
                  (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
              }
+#endif
 #if OS_EVENT_NAME_SIZE > 1
              pevent->OSEventName[0] = '?';                 /* Unknown name                             */
              pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
+#if OS_MUTEX_PI_EN == 0
              pip                 = (INT8U)(pevent->OSEventCnt >> 8);
              OSTCBPrioTbl[pip]   = (OS_TCB *)0;            /* Free up the PIP                          */
+#endif
              pevent->OSEventType = OS_EVENT_TYPE_UNUSED;
-             pevent->OSEventPtr  = OSEventFreeList;        /* Return Event Control Block to free list  */
              pevent->OSEventCnt  = 0;
-             OSEventFreeList     = pevent;                 /* Get next free event control block        */
+             OS_EventFree(pevent);                         /* Return Event Control Block to free list  */
              OS_EXIT_CRITICAL();
              if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
                  OS_Sched();                               /* Find highest priority task ready to run  */
@@ -392,17 +544,26 @@ OS_EVENT  *OSMutexDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 * Note(s)    : 1) The task that owns the Mutex MUST NOT pend on any other event while it owns the mutex.
 *
 *              2) You MUST NOT change the priority of the task that owns the mutex
+*
+*              3) When OS_MUTEX_PI_EN is enabled, notes 1) and 2) are lifted for mutexes: the owner is
+*                 raised to the priority of the waiting task if that one is higher, and so is in turn the
+*                 owner of the mutex it waits for, along the whole chain.  The owner may also wait for
+*                 other events and have its priority changed.
 *********************************************************************************************************
 */
 
-void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  OSMutexPend (OS_EVENT *pevent, OS_TICK timeout, INT8U *perr)
 {
+#if OS_MUTEX_PI_EN == 0
     INT8U      pip;                                        /* Priority Inheritance Priority (PIP)      */
     INT8U      mprio;                                      /* Mutex owner priority                     */
-    BOOLEAN    rdy;                                        /* Flag indicating task was ready           */
     OS_TCB    *ptcb;
+#endif
+#if OS_SCHED_RR_EN == 0
+    BOOLEAN    rdy;                                        /* Flag indicating task was ready           */
     OS_EVENT  *pevent2;
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -432,6 +593,22 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
 /*$PAGE*/
     OS_ENTER_CRITICAL();
+#if OS_MUTEX_PI_EN > 0
+                                                           /* Is Mutex available?                      */
+    if ((INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
+        pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;       /* Yes, Acquire the resource                */
+        pevent->OSEventCnt |= OSTCBCur->OSTCBBasePrio;     /*      Save priority of owning task        */
+        OSMutex_Own(pevent, OSTCBCur);                     /*      Link mutex and owning task's OS_TCB */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return;
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store timeout in current task's TCB           */
+    OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
+    OS_MutexPrioUpdate((OS_TCB *)pevent->OSEventPtr); /* Owner(s) inherit current task's priority      */
+#else
     pip = (INT8U)(pevent->OSEventCnt >> 8);                /* Get PIP from mutex                       */
                                                            /* Is Mutex available?                      */
     if ((INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8) == OS_MUTEX_AVAILABLE) {
@@ -451,6 +628,9 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     ptcb  = (OS_TCB *)(pevent->OSEventPtr);                       /*     Point to TCB of mutex owner   */
     if (ptcb->OSTCBPrio > pip) {                                  /*     Need to promote prio of owner?*/
         if (mprio > OSTCBCur->OSTCBPrio) {
+#if OS_SCHED_RR_EN > 0
+            OS_TCBPrioSet(ptcb, pip);                      /* Change owner task prio to PIP            */
+#else
             y = ptcb->OSTCBY;
             if ((OSRdyTbl[y] & ptcb->OSTCBBitX) != 0) {           /*     See if mutex owner is ready   */
                 OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                  /*     Yes, Remove owner from Rdy ...*/
@@ -468,17 +648,10 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                 rdy = OS_FALSE;                            /* No                                       */
             }
             ptcb->OSTCBPrio = pip;                         /* Change owner task prio to PIP            */
-#if OS_LOWEST_PRIO <= 63
-            ptcb->OSTCBY    = (INT8U)( ptcb->OSTCBPrio >> 3);
-            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x07);
-            ptcb->OSTCBBitY = (INT8U)(1 << ptcb->OSTCBY);
-            ptcb->OSTCBBitX = (INT8U)(1 << ptcb->OSTCBX);
-#else
-            ptcb->OSTCBY    = (INT8U)((ptcb->OSTCBPrio >> 4) & 0xFF);
-            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x0F);
-            ptcb->OSTCBBitY = (INT16U)(1 << ptcb->OSTCBY);
-            ptcb->OSTCBBitX = (INT16U)(1 << ptcb->OSTCBX);
-#endif
+            ptcb->OSTCBY    = (INT8U)( ptcb->OSTCBPrio >> 5);
+            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x1F);
+            ptcb->OSTCBBitY = (INT8U)(0x80 >> ptcb->OSTCBY);
+            ptcb->OSTCBBitX = (INT32U)0x80000000L >> ptcb->OSTCBX;
             if (rdy == OS_TRUE) {                          /* If task was ready at owner's priority ...*/
                 OSRdyGrp               |= ptcb->OSTCBBitY; /* ... make it ready at new priority.       */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
@@ -490,12 +663,14 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                 }
             }
             OSTCBPrioTbl[pip] = ptcb;
+#endif
         }
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store timeout in current task's TCB           */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
+#endif
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
     OS_ENTER_CRITICAL();
@@ -506,11 +681,17 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
 
         case OS_STAT_PEND_ABORT:
              *perr = OS_ERR_PEND_ABORT;               /* Indicate that we aborted getting mutex        */
+#if OS_MUTEX_PI_EN > 0
+             OS_MutexPrioUpdate((OS_TCB *)pevent->OSEventPtr);  /* Owner(s) may inherit less now      */
+#endif
              break;
              
         case OS_STAT_PEND_TO:
         default:
              OS_EventTaskRemove(OSTCBCur, pevent);
+#if OS_MUTEX_PI_EN > 0
+             OS_MutexPrioUpdate((OS_TCB *)pevent->OSEventPtr);  /* Owner(s) may inherit less now      */
+#endif
              *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get mutex within TO   */
              break;
     }
@@ -544,13 +725,23 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
 *                                      Unfortunately, this is something that could not be
 *                                      detected when the Mutex is created because we don't know
 *                                      what tasks will be using the Mutex.
+*
+* Note(s)    : 1) When OS_MUTEX_PI_EN is enabled, the posting task drops the priority it inherited through
+*                 this mutex but keeps what it inherits through the other mutexes it still owns, and the
+*                 new owner inherits from the tasks still waiting.
 *********************************************************************************************************
 */
 
 INT8U  OSMutexPost (OS_EVENT *pevent)
 {
+#if OS_MUTEX_PI_EN == 0
     INT8U      pip;                                   /* Priority inheritance priority                 */
+#endif
     INT8U      prio;
+#if OS_SCHED_RR_EN > 0
+    OS_TCB    *ptcb;
+    INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -569,6 +760,34 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+#if OS_MUTEX_PI_EN > 0
+    if (OSTCBCur != (OS_TCB *)pevent->OSEventPtr) {   /* See if posting task owns the MUTEX            */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NOT_MUTEX_OWNER);
+    }
+    OSMutex_Disown(pevent);                           /* Unlink the mutex from the posting task        */
+    if (pevent->OSEventGrp != 0) {                    /* Any task waiting for the mutex?               */
+                                                      /* Yes, Make HPT waiting for mutex ready         */
+#if OS_EVENT_TBL_SIZE > 1                             /*      Find the task that will be readied ...   */
+        y                   = OS_CntLeadZeros((INT32U)pevent->OSEventGrp << 24);
+#else
+        y                   = 0;
+#endif
+        prio                = (INT8U)((y << 5) + OS_CntLeadZeros(pevent->OSEventTbl[y]));
+        ptcb                = OS_EventTaskFind(pevent, prio, (OS_TCB *)0);
+        (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
+        pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;  /*      Save priority of mutex's new owner       */
+        pevent->OSEventCnt |= ptcb->OSTCBBasePrio;
+        OSMutex_Own(pevent, ptcb);                    /*      Link to new mutex owner's OS_TCB         */
+        OS_MutexPrioUpdate(ptcb);                     /*      New owner inherits from the others       */
+    } else {
+        pevent->OSEventCnt |= OS_MUTEX_AVAILABLE;     /* No,  Mutex is now available                   */
+    }
+    OS_MutexPrioUpdate(OSTCBCur);                     /* Drop what was inherited through the mutex     */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find highest priority task ready to run       */
+    return (OS_ERR_NONE);
+#else
     pip  = (INT8U)(pevent->OSEventCnt >> 8);          /* Get priority inheritance priority of mutex    */
     prio = (INT8U)(pevent->OSEventCnt & OS_MUTEX_KEEP_LOWER_8);  /* Get owner's original priority      */
     if (OSTCBCur != (OS_TCB *)pevent->OSEventPtr) {   /* See if posting task owns the MUTEX            */
@@ -581,10 +800,23 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
     OSTCBPrioTbl[pip] = OS_TCB_RESERVED;              /* Reserve table entry                           */
     if (pevent->OSEventGrp != 0) {                    /* Any task waiting for the mutex?               */
                                                       /* Yes, Make HPT waiting for mutex ready         */
+#if OS_SCHED_RR_EN > 0                                /*      Find the task that will be readied ...   */
+#if OS_EVENT_TBL_SIZE > 1                             /*      ... as tasks may share its priority      */
+        y                   = OS_CntLeadZeros((INT32U)pevent->OSEventGrp << 24);
+#else
+        y                   = 0;
+#endif
+        prio                = (INT8U)((y << 5) + OS_CntLeadZeros(pevent->OSEventTbl[y]));
+        ptcb                = OS_EventTaskFind(pevent, prio, (OS_TCB *)0);
+#endif
         prio                = OS_EventTaskRdy(pevent, (void *)0, OS_STAT_MUTEX, OS_STAT_PEND_OK);
         pevent->OSEventCnt &= OS_MUTEX_KEEP_UPPER_8;  /*      Save priority of mutex's new owner       */
         pevent->OSEventCnt |= prio;
+#if OS_SCHED_RR_EN > 0
+        pevent->OSEventPtr  = ptcb;                   /*      Link to new mutex owner's OS_TCB         */
+#else
         pevent->OSEventPtr  = OSTCBPrioTbl[prio];     /*      Link to new mutex owner's OS_TCB         */
+#endif
         if (prio <= pip) {                            /*      PIP 'must' have a SMALLER prio ...       */
             OS_EXIT_CRITICAL();                       /*      ... than current task!                   */
             OS_Sched();                               /*      Find highest priority task ready to run  */
@@ -599,6 +831,7 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
     pevent->OSEventPtr  = (void *)0;
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
+#endif
 }
 /*$PAGE*/
 /*
@@ -623,13 +856,8 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
 INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    INT32U    *psrc;
+    INT32U    *pdest;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -669,6 +897,139 @@ INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 }
 #endif                                                     /* OS_MUTEX_QUERY_EN                        */
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 UPDATE THE PRIORITY INHERITED BY A TASK
+*
+* Description: This function is called when a task may have to inherit a different priority: a task
+*              started or stopped waiting for a mutex it owns, it released a mutex or its priority was
+*              changed.  The task runs at the highest of its own priority and the priorities of the tasks
+*              waiting for the mutexes it owns.  If its priority changes while it waits for a mutex
+*              itself, the owner of that mutex is updated in turn, and so on along the chain of owners.
+*
+* Arguments  : ptcb            is a pointer to the OS_TCB of the task.  Nothing is done if NULL.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) This function assumes that interrupts are disabled.
+*              3) The chain ends as soon as a priority is unchanged, which also bounds it if tasks are
+*                 deadlocked waiting for each other's mutexes.
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_PI_EN > 0
+void  OS_MutexPrioUpdate (OS_TCB *ptcb)
+{
+    OS_EVENT  *pevent;
+    INT8U      prio;
+
+
+    while (ptcb != (OS_TCB *)0) {
+        prio = OSMutex_PrioGet(ptcb);
+        if (prio == ptcb->OSTCBPrio) {                     /* Unchanged, so are the owners down chain  */
+            break;
+        }
+        OS_TCBPrioSet(ptcb, prio);                         /* Move task, keeping its state             */
+        pevent = ptcb->OSTCBEventPtr;
+        if (((ptcb->OSTCBStat & OS_STAT_MUTEX) != OS_STAT_RDY) && (pevent != (OS_EVENT *)0)) {
+            ptcb = (OS_TCB *)pevent->OSEventPtr;           /* Task waits for a mutex, update its owner */
+        } else {
+            ptcb = (OS_TCB *)0;
+        }
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 LINK / UNLINK A MUTEX AND ITS OWNER
+*
+* Description: When OS_MUTEX_PI_EN is enabled, the mutexes owned by a task are linked in a list starting
+*              at '.OSTCBMutexList', through '.OSEventMutexNext'.  OSMutex_Own() makes 'ptcb' the owner of
+*              the mutex and OSMutex_Disown() leaves it without owner.
+*
+* Arguments  : pevent          is a pointer to the event control block of the mutex
+*
+*              ptcb            is a pointer to the OS_TCB of the new owner
+*
+* Returns    : none
+*
+* Note(s)    : These functions do not change the priority of the tasks.
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_PI_EN > 0
+static  void  OSMutex_Own (OS_EVENT *pevent, OS_TCB *ptcb)
+{
+    pevent->OSEventPtr       = (void *)ptcb;
+    pevent->OSEventMutexNext = ptcb->OSTCBMutexList;
+    ptcb->OSTCBMutexList     = pevent;
+}
+
+
+static  void  OSMutex_Disown (OS_EVENT *pevent)
+{
+    OS_EVENT  **ppevent;
+
+
+    ppevent = &((OS_TCB *)pevent->OSEventPtr)->OSTCBMutexList;
+    while ((*ppevent != (OS_EVENT *)0) && (*ppevent != pevent)) {
+        ppevent = &(*ppevent)->OSEventMutexNext;
+    }
+    if (*ppevent != (OS_EVENT *)0) {
+        *ppevent = pevent->OSEventMutexNext;
+    }
+    pevent->OSEventMutexNext = (OS_EVENT *)0;
+    pevent->OSEventPtr       = (void *)0;
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                FIND THE PRIORITY A TASK INHERITS
+*
+* Description: This function returns the priority a task must run at: the highest of its own priority
+*              and the priorities of the tasks waiting for the mutexes it owns.
+*
+* Arguments  : ptcb            is a pointer to the OS_TCB of the task
+*
+* Returns    : the priority
+*********************************************************************************************************
+*/
+
+#if OS_MUTEX_PI_EN > 0
+static  INT8U  OSMutex_PrioGet (OS_TCB *ptcb)
+{
+    OS_EVENT  *pevent;
+    INT8U      prio;
+    INT8U      wprio;
+    INT8U      y;
+
+
+    prio   = ptcb->OSTCBBasePrio;
+    pevent = ptcb->OSTCBMutexList;
+    while (pevent != (OS_EVENT *)0) {
+        if (pevent->OSEventGrp != 0) {                     /* Find HPT waiting for this mutex          */
+#if OS_EVENT_TBL_SIZE > 1
+            y     = OS_CntLeadZeros((INT32U)pevent->OSEventGrp << 24);
+#else
+            y     = 0;
+#endif
+            wprio = (INT8U)((y << 5) + OS_CntLeadZeros(pevent->OSEventTbl[y]));
+            if (wprio < prio) {
+                prio = wprio;
+            }
+        }
+        pevent = pevent->OSEventMutexNext;
+    }
+    return (prio);
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -684,8 +1045,12 @@ INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 *********************************************************************************************************
 */
 
+#if OS_MUTEX_PI_EN == 0
 static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
 {
+#if OS_SCHED_RR_EN > 0
+    OS_TCBPrioSet(ptcb, prio);                             /* Make task ready at original priority     */
+#else
     INT8U   y;
 
 
@@ -695,21 +1060,16 @@ static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
     ptcb->OSTCBPrio         = prio;
-#if OS_LOWEST_PRIO <= 63
-    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)3) & (INT8U)0x07);
-    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x07);
-    ptcb->OSTCBBitY         = (INT8U)(1 << ptcb->OSTCBY);
-    ptcb->OSTCBBitX         = (INT8U)(1 << ptcb->OSTCBX);
-#else
-    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)4) & (INT8U)0x0F);
-    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x0F);
-    ptcb->OSTCBBitY         = (INT16U)(1 << ptcb->OSTCBY);
-    ptcb->OSTCBBitX         = (INT16U)(1 << ptcb->OSTCBX);
-#endif
+    ptcb->OSTCBY            = (INT8U)(prio >> (INT8U)5);
+    ptcb->OSTCBX            = (INT8U)(prio & (INT8U)0x1F);
+    ptcb->OSTCBBitY         = (INT8U)(0x80 >> ptcb->OSTCBY);
+    ptcb->OSTCBBitX         = (INT32U)0x80000000L >> ptcb->OSTCBX;
     OSRdyGrp               |= ptcb->OSTCBBitY;             /* Make task ready at original priority     */
     OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
     OSTCBPrioTbl[prio]      = ptcb;
+#endif
 }
+#endif
 
 
 #endif                                                     /* OS_MUTEX_EN                              */
@@ -25,7 +25,36 @@
 #include <ucos_ii.h>
 #endif
 
-#if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
+#if (OS_Q_EN > 0) && ((OS_MAX_QS > 0) || (OS_OBJ_STATIC_EN > 0))
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+#if OS_Q_PRIO_EN > 0
+#define  OS_Q_PRIO_LOWEST     (OS_Q_PRIO_LVLS - 1u)  /* Priority of OSQPost() messages in a prio. queue  */
+#else
+#define  OS_Q_PRIO_LOWEST      0u
+#endif
+
+/*
+*********************************************************************************************************
+*                                           LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void     *OSQ_Get(OS_Q *pq);
+
+#if (OS_Q_POST_EN > 0) || (OS_Q_POST_OPT_EN > 0) || (OS_Q_MANY_EN > 0) || (OS_Q_PRIO_EN > 0)
+static  void      OSQ_Put(OS_Q *pq, void *pmsg, INT8U prio);
+#endif
+
+#if (OS_Q_POST_FRONT_EN > 0) || (OS_Q_POST_OPT_EN > 0)
+static  void      OSQ_PutFront(OS_Q *pq, void *pmsg);
+#endif
+
+/*$PAGE*/
 /*
 *********************************************************************************************************
 *                                      ACCEPT MESSAGE FROM QUEUE
@@ -84,11 +113,7 @@ void  *OSQAccept (OS_EVENT *pevent, INT8U *perr)
     OS_ENTER_CRITICAL();
     pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
     if (pq->OSQEntries > 0) {                    /* See if any messages in the queue                   */
-        pmsg = *pq->OSQOut++;                    /* Yes, extract oldest message from the queue         */
-        pq->OSQEntries--;                        /* Update the number of entries in the queue          */
-        if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
-            pq->OSQOut = pq->OSQStart;
-        }
+        pmsg = OSQ_Get(pq);                      /* Yes, extract next message from the queue           */
         *perr = OS_ERR_NONE;
     } else {
         *perr = OS_ERR_Q_EMPTY;
@@ -118,6 +143,7 @@ void  *OSQAccept (OS_EVENT *pevent, INT8U *perr)
 *********************************************************************************************************
 */
 
+#if (OS_MAX_EVENTS > 0) && (OS_MAX_QS > 0)
 OS_EVENT  *OSQCreate (void **start, INT16U size)
 {
     OS_EVENT  *pevent;
@@ -149,6 +175,175 @@ OS_EVENT  *OSQCreate (void **start, INT16U size)
             pq->OSQOut             = start;
             pq->OSQSize            = size;
             pq->OSQEntries         = 0;
+#if OS_Q_PRIO_EN > 0
+            pq->OSQMsgTbl          = (OS_Q_MSG *)0;       /*      Not priority-ordered                 */
+            pq->OSQPrioGrp         = 0;
+#endif
+            pevent->OSEventType    = OS_EVENT_TYPE_Q;
+            pevent->OSEventCnt     = 0;
+            pevent->OSEventPtr     = pq;
+#if OS_EVENT_NAME_SIZE > 1
+            pevent->OSEventName[0] = '?';                  /* Unknown name                             */
+            pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+            OS_EventWaitListInit(pevent);                 /*      Initalize the wait list              */
+        } else {
+            OS_EventFree(pevent);                         /* No,  Return event control block on error  */
+            OS_EXIT_CRITICAL();
+            pevent = (OS_EVENT *)0;
+        }
+    }
+    return (pevent);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                             CREATE A MESSAGE QUEUE IN APPLICATION STORAGE
+*
+* Description: This function creates a message queue using an event control block and a queue control
+*              block supplied by the application instead of taking them from the OSEventTbl[] and
+*              OSQTbl[] pools.
+*
+* Arguments  : pevent        is a pointer to the event control block to use.
+*
+*              pq            is a pointer to the queue control block to use.
+*
+*              start         is a pointer to the base address of the message queue storage area.  The
+*                            storage area MUST be declared as an array of pointers to 'void' as follows
+*
+*                            void *MessageStorage[size]
+*
+*              size          is the number of elements in the storage area
+*
+* Returns    : != (OS_EVENT *)0  is 'pevent'
+*              == (OS_EVENT *)0  if 'pevent' or 'pq' is NULL or if called from an ISR
+*
+* Notes      : 1) 'pevent' and 'pq' MUST remain valid for as long as the queue is in use and MUST NOT
+*                 already be in use by another kernel object.
+*              2) OSQDel() does not return 'pevent' or 'pq' to the pools; the application may reuse
+*                 them once the queue has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT  *OSQCreateStatic (OS_EVENT *pevent, OS_Q *pq, void **start, INT16U size)
+{
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        return ((OS_EVENT *)0);
+    }
+    if (pq == (OS_Q *)0) {                       /* Validate 'pq'                                      */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pq->OSQPtr             = (OS_Q *)0;
+    pq->OSQStart           = start;              /* Initialize the queue                               */
+    pq->OSQEnd             = &start[size];
+    pq->OSQIn              = start;
+    pq->OSQOut             = start;
+    pq->OSQSize            = size;
+    pq->OSQEntries         = 0;
+#if OS_Q_PRIO_EN > 0
+    pq->OSQMsgTbl          = (OS_Q_MSG *)0;      /* Not priority-ordered                               */
+    pq->OSQPrioGrp         = 0;
+#endif
+    pevent->OSEventType    = OS_EVENT_TYPE_Q;
+    pevent->OSEventCnt     = 0;
+    pevent->OSEventPtr     = pq;
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                /* Unknown name                                       */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                /* Initalize the wait list                            */
+    OS_EXIT_CRITICAL();
+    return (pevent);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  CREATE A PRIORITY-ORDERED MESSAGE QUEUE
+*
+* Description: This function creates a message queue in which each message carries a priority, from 0
+*              (the highest) to OS_Q_PRIO_LVLS - 1 (the lowest).  OSQPend(), OSQPendMany() and OSQAccept()
+*              return the messages of the highest priority first and, within a priority, the oldest
+*              first.  Messages are posted with a priority by OSQPostPrio().
+*
+* Arguments  : start         is a pointer to the base address of the message queue storage area.  The
+*                            storage area MUST be declared as an array of OS_Q_MSG as follows
+*
+*                            OS_Q_MSG  MessageStorage[size]
+*
+*              size          is the number of elements in the storage area
+*
+* Returns    : != (OS_EVENT *)0  is a pointer to the event control clock (OS_EVENT) associated with the
+*                                created queue
+*              == (OS_EVENT *)0  if no event control blocks were available or an error was detected
+*
+* Note(s)    : 1) The messages of each priority are kept in their own list, so posting and extracting
+*                 a message take a constant time whatever the number of messages queued.
+*              2) OSQPost() and OSQPostMany() post with the lowest priority, OSQPostFront() in front of
+*                 the messages of the highest priority.  OSQPostOpt() does either, depending on
+*                 OS_POST_OPT_FRONT.
+*********************************************************************************************************
+*/
+
+#if (OS_MAX_EVENTS > 0) && (OS_MAX_QS > 0) && (OS_Q_PRIO_EN > 0)
+OS_EVENT  *OSQCreatePrio (OS_Q_MSG *start, INT16U size)
+{
+    OS_EVENT  *pevent;
+    OS_Q      *pq;
+    INT16U     i;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        return ((OS_EVENT *)0);                  /* ... can't CREATE from an ISR                       */
+    }
+    if ((start == (OS_Q_MSG *)0) || (size == 0)) {   /* Validate the storage area                      */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                    /* Get next free event control block                  */
+    if (OSEventFreeList != (OS_EVENT *)0) {      /* See if pool of free ECB pool was empty             */
+        OSEventFreeList = (OS_EVENT *)OSEventFreeList->OSEventPtr;
+    }
+    OS_EXIT_CRITICAL();
+    if (pevent != (OS_EVENT *)0) {               /* See if we have an event control block              */
+        OS_ENTER_CRITICAL();
+        pq = OSQFreeList;                        /* Get a free queue control block                     */
+        if (pq != (OS_Q *)0) {                   /* Were we able to get a queue control block ?        */
+            OSQFreeList            = OSQFreeList->OSQPtr; /* Yes, Adjust free list pointer to next free*/
+            OS_EXIT_CRITICAL();
+            for (i = 0; i < (size - 1); i++) {            /*      Chain the entries in the free list   */
+                start[i].OSQMsgNext = &start[i + 1];
+            }
+            start[size - 1].OSQMsgNext = (OS_Q_MSG *)0;
+            for (i = 0; i < OS_Q_PRIO_LVLS; i++) {        /*      No message of any priority yet       */
+                pq->OSQMsgHead[i] = (OS_Q_MSG *)0;
+                pq->OSQMsgTail[i] = (OS_Q_MSG *)0;
+            }
+            pq->OSQStart           = (void **)0;          /*      Initialize the queue                 */
+            pq->OSQEnd             = (void **)0;
+            pq->OSQIn              = (void **)0;
+            pq->OSQOut             = (void **)0;
+            pq->OSQSize            = size;
+            pq->OSQEntries         = 0;
+            pq->OSQMsgTbl          = start;
+            pq->OSQMsgFree         = start;
+            pq->OSQPrioGrp         = 0;
             pevent->OSEventType    = OS_EVENT_TYPE_Q;
             pevent->OSEventCnt     = 0;
             pevent->OSEventPtr     = pq;
@@ -158,14 +353,14 @@ OS_EVENT  *OSQCreate (void **start, INT16U size)
 #endif
             OS_EventWaitListInit(pevent);                 /*      Initalize the wait list              */
         } else {
-            pevent->OSEventPtr = (void *)OSEventFreeList; /* No,  Return event control block on error  */
-            OSEventFreeList    = pevent;
+            OS_EventFree(pevent);                         /* No,  Return event control block on error  */
             OS_EXIT_CRITICAL();
             pevent = (OS_EVENT *)0;
         }
     }
     return (pevent);
 }
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -251,12 +446,10 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
                  pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
                  pq                     = (OS_Q *)pevent->OSEventPtr;  /* Return OS_Q to free list     */
-                 pq->OSQPtr             = OSQFreeList;
-                 OSQFreeList            = pq;
+                 OS_QFree(pq);
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
-                 pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
                  pevent->OSEventCnt     = 0;
-                 OSEventFreeList        = pevent;          /* Get next free event control block        */
+                 OS_EventFree(pevent);                         /* Return Event Control Block to free list  */
                  OS_EXIT_CRITICAL();
                  *perr                  = OS_ERR_NONE;
                  pevent_return          = (OS_EVENT *)0;   /* Queue has been deleted                   */
@@ -276,12 +469,10 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
              pq                     = (OS_Q *)pevent->OSEventPtr;   /* Return OS_Q to free list        */
-             pq->OSQPtr             = OSQFreeList;
-             OSQFreeList            = pq;
+             OS_QFree(pq);
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
-             pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
              pevent->OSEventCnt     = 0;
-             OSEventFreeList        = pevent;              /* Get next free event control block        */
+             OS_EventFree(pevent);                     /* Return Event Control Block to free list  */
              OS_EXIT_CRITICAL();
              if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
                  OS_Sched();                               /* Find highest priority task ready to run  */
@@ -324,6 +515,9 @@ OS_EVENT  *OSQDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 INT8U  OSQFlush (OS_EVENT *pevent)
 {
     OS_Q      *pq;
+#if OS_Q_PRIO_EN > 0
+    INT8U      prio;
+#endif
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -340,6 +534,16 @@ INT8U  OSQFlush (OS_EVENT *pevent)
 #endif
     OS_ENTER_CRITICAL();
     pq             = (OS_Q *)pevent->OSEventPtr;      /* Point to queue storage structure              */
+#if OS_Q_PRIO_EN > 0
+    while (pq->OSQPrioGrp != 0) {                     /* Return the messages of each priority ...      */
+        prio                             = OS_CntLeadZeros(pq->OSQPrioGrp);
+        pq->OSQMsgTail[prio]->OSQMsgNext = pq->OSQMsgFree;    /* ... to the free list                  */
+        pq->OSQMsgFree                   = pq->OSQMsgHead[prio];
+        pq->OSQMsgHead[prio]             = (OS_Q_MSG *)0;
+        pq->OSQMsgTail[prio]             = (OS_Q_MSG *)0;
+        pq->OSQPrioGrp                  &= ~((INT32U)0x80000000L >> prio);
+    }
+#endif
     pq->OSQIn      = pq->OSQStart;
     pq->OSQOut     = pq->OSQStart;
     pq->OSQEntries = 0;
@@ -385,7 +589,7 @@ INT8U  OSQFlush (OS_EVENT *pevent)
 *********************************************************************************************************
 */
 
-void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  *OSQPend (OS_EVENT *pevent, OS_TICK timeout, INT8U *perr)
 {
     void      *pmsg;
     OS_Q      *pq;
@@ -419,18 +623,14 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OS_ENTER_CRITICAL();
     pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
     if (pq->OSQEntries > 0) {                    /* See if any messages in the queue                   */
-        pmsg = *pq->OSQOut++;                    /* Yes, extract oldest message from the queue         */
-        pq->OSQEntries--;                        /* Update the number of entries in the queue          */
-        if (pq->OSQOut == pq->OSQEnd) {          /* Wrap OUT pointer if we are at the end of the queue */
-            pq->OSQOut = pq->OSQStart;
-        }
+        pmsg = OSQ_Get(pq);                      /* Yes, extract next message from the queue           */
         OS_EXIT_CRITICAL();
         *perr = OS_ERR_NONE;
         return (pmsg);                           /* Return message received                            */
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+    OS_TickListInsert(OSTCBCur, timeout);        /* Load timeout into TCB and tick list                */
     OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
     OS_EXIT_CRITICAL();
     OS_Sched();                                  /* Find next highest priority task ready to run       */
@@ -547,6 +747,133 @@ INT8U  OSQPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PEND ON A QUEUE FOR SEVERAL MESSAGES
+*
+* Description: This function removes up to 'nbr' messages from a queue in a single call.  The calling
+*              task waits only if the queue is empty.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array where the messages received are stored, in the
+*                            order OSQPend() would have returned them.
+*
+*              nbr           is the number of entries in 'pmsgs', i.e. the most messages to receive.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message to arrive at the queue up to the amount of time
+*                            specified by this argument.  If you specify 0, however, your task will wait
+*                            forever at the specified queue or, until a message arrives.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received at
+*                                                least one message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait on the queue was aborted.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer or 'nbr' is 0
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR
+*                            OS_ERR_PEND_LOCKED  If you called this function with the scheduler is locked
+*
+* Returns    : The number of messages stored in 'pmsgs' (0 upon error).
+*
+* Note(s)    : 1) A task waking up with a message also takes the messages queued since then, up to 'nbr'.
+*
+*              2) Interrupts are disabled while the messages are copied, i.e. for a time proportional
+*                 to 'nbr'.
+*********************************************************************************************************
+*/
+
+#if OS_Q_MANY_EN > 0
+INT16U  OSQPendMany (OS_EVENT *pevent, void **pmsgs, INT16U nbr, OS_TICK timeout, INT8U *perr)
+{
+    INT16U     cnt;
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                    /* Validate 'perr'                                    */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {               /* Validate 'pevent'                                  */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if ((pmsgs == (void **)0) || (nbr == 0)) {   /* Validate 'pmsgs' and 'nbr'                         */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {/* Validate event block type                          */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    if (OSIntNesting > 0) {                      /* See if called from ISR ...                         */
+        *perr = OS_ERR_PEND_ISR;                 /* ... can't PEND from an ISR                         */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked ...            */
+        *perr = OS_ERR_PEND_LOCKED;              /* ... can't PEND when locked                         */
+        return (0);
+    }
+    cnt = 0;
+    OS_ENTER_CRITICAL();
+    pq = (OS_Q *)pevent->OSEventPtr;             /* Point at queue control block                       */
+    if (pq->OSQEntries == 0) {                   /* See if any messages in the queue                   */
+        OSTCBCur->OSTCBStat     |= OS_STAT_Q;    /* No,  task will have to pend for a message          */
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OS_TickListInsert(OSTCBCur, timeout);    /* Load timeout into TCB and tick list                */
+        OS_EventTaskWait(pevent);                /* Suspend task until event or timeout occurs         */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* Find next highest priority task ready to run       */
+        OS_ENTER_CRITICAL();
+        switch (OSTCBCur->OSTCBStatPend) {            /* See if we timed-out or aborted                */
+            case OS_STAT_PEND_OK:                     /* Extract message from TCB (Put there by QPost) */
+                 pmsgs[cnt++] =  OSTCBCur->OSTCBMsg;
+                *perr         =  OS_ERR_NONE;
+                 break;
+
+            case OS_STAT_PEND_ABORT:
+                *perr         =  OS_ERR_PEND_ABORT;   /* Indicate that we aborted                      */
+                 break;
+
+            case OS_STAT_PEND_TO:
+            default:
+                 OS_EventTaskRemove(OSTCBCur, pevent);
+                *perr         =  OS_ERR_TIMEOUT;      /* Indicate that we didn't get event within TO   */
+                 break;
+        }
+        OSTCBCur->OSTCBStat          =  OS_STAT_RDY;  /* Set   task  status to ready                   */
+        OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                        */
+        OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                      */
+#if (OS_EVENT_MULTI_EN > 0)
+        OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+        OSTCBCur->OSTCBMsg           = (void      *)0;    /* Clear  received message                   */
+        if (cnt == 0) {                          /* Timed out or aborted                               */
+            OS_EXIT_CRITICAL();
+            return (0);
+        }
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    while ((cnt < nbr) && (pq->OSQEntries > 0)) {/* Extract the next messages from the queue           */
+        pmsgs[cnt++] = OSQ_Get(pq);
+    }
+    OS_EXIT_CRITICAL();
+    return (cnt);                                /* Return number of messages received                 */
+}
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -562,6 +889,8 @@ INT8U  OSQPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are
+*                                    already deferred (see OS_IntQPost())
 *
 * Note(s)    : As of V2.60, this function allows you to send NULL pointer messages.
 *********************************************************************************************************
@@ -585,6 +914,11 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                            /* Let OS_TaskIntQ() post once ISRs are done    */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q, (void *)pevent, pmsg, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                     /* See if any task pending on queue             */
                                                        /* Ready highest priority task waiting on event */
@@ -598,11 +932,7 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
     }
-    *pq->OSQIn++ = pmsg;                               /* Insert message into queue                    */
-    pq->OSQEntries++;                                  /* Update the nbr of entries in the queue       */
-    if (pq->OSQIn == pq->OSQEnd) {                     /* Wrap IN ptr if we are at end of queue        */
-        pq->OSQIn = pq->OSQStart;
-    }
+    OSQ_Put(pq, pmsg, OS_Q_PRIO_LOWEST);               /* Insert message into queue                    */
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -624,6 +954,8 @@ INT8U  OSQPost (OS_EVENT *pevent, void *pmsg)
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are
+*                                    already deferred (see OS_IntQPost())
 *
 * Note(s)    : As of V2.60, this function allows you to send NULL pointer messages.
 *********************************************************************************************************
@@ -647,6 +979,11 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() post once ISRs are done     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q_FRONT, (void *)pevent, pmsg, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on queue              */
                                                       /* Ready highest priority task waiting on event  */
@@ -660,12 +997,7 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
         OS_EXIT_CRITICAL();
         return (OS_ERR_Q_FULL);
     }
-    if (pq->OSQOut == pq->OSQStart) {                 /* Wrap OUT ptr if we are at the 1st queue entry */
-        pq->OSQOut = pq->OSQEnd;
-    }
-    pq->OSQOut--;
-    *pq->OSQOut = pmsg;                               /* Insert message into queue                     */
-    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+    OSQ_PutFront(pq, pmsg);                           /* Insert message into queue                     */
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -673,6 +1005,107 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                    POST SEVERAL MESSAGES TO A QUEUE
+*
+* Description: This function sends up to 'nbr' messages to a queue in a single call, as if OSQPost() was
+*              called for each of them in turn, but rescheduling only once.  Tasks waiting on the queue
+*              get the first messages, one per task and highest priority first, and the others are
+*              queued.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsgs         is a pointer to an array of the messages to send, oldest first.
+*
+*              nbr           is the number of messages in 'pmsgs'.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         All the messages were sent.
+*                            OS_ERR_Q_FULL       The queue was filled up before all the messages were
+*                                                sent.
+*                            OS_ERR_EVENT_TYPE   You didn't pass a pointer to a queue.
+*                            OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer
+*                            OS_ERR_PDATA_NULL   If 'pmsgs' is a NULL pointer
+*                            OS_ERR_INT_Q_FULL   If called from an ISR while OS_INT_Q_SIZE posts are
+*                                                already deferred (see OS_IntQPost())
+*
+* Returns    : The number of messages sent, i.e. the first ones of 'pmsgs'.
+*
+* Note(s)    : 1) Interrupts are disabled while the messages are handed out, i.e. for a time proportional
+*                 to 'nbr'.
+*
+*              2) From an ISR with OS_ISR_POST_DEFERRED_EN, each message is deferred as by OSQPost().
+*********************************************************************************************************
+*/
+
+#if OS_Q_MANY_EN > 0
+INT16U  OSQPostMany (OS_EVENT *pevent, void **pmsgs, INT16U nbr, INT8U *perr)
+{
+    INT16U     cnt;
+    BOOLEAN    sched;
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                          /* Validate 'perr'                              */
+        return (0);
+    }
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (0);
+    }
+    if (pmsgs == (void **)0) {                         /* Validate 'pmsgs'                             */
+        *perr = OS_ERR_PDATA_NULL;
+        return (0);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (0);
+    }
+    cnt = 0;
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                            /* Let OS_TaskIntQ() post once ISRs are done    */
+        *perr = OS_ERR_NONE;
+        while ((cnt < nbr) && (*perr == OS_ERR_NONE)) {
+            *perr = OS_IntQPost(OS_INT_Q_TYPE_Q, (void *)pevent, pmsgs[cnt], 0, OS_POST_OPT_NONE);
+            if (*perr == OS_ERR_NONE) {
+                cnt++;
+            }
+        }
+        return (cnt);
+    }
+#endif
+    sched = OS_FALSE;
+    OS_ENTER_CRITICAL();
+    while ((cnt < nbr) && (pevent->OSEventGrp != 0)) { /* Ready the tasks pending on queue, HPT first  */
+        (void)OS_EventTaskRdy(pevent, pmsgs[cnt++], OS_STAT_Q, OS_STAT_PEND_OK);
+        sched = OS_TRUE;
+    }
+    pq = (OS_Q *)pevent->OSEventPtr;                   /* Point to queue control block                 */
+    while ((cnt < nbr) && (pq->OSQEntries < pq->OSQSize)) {   /* Queue the others while there is room  */
+        OSQ_Put(pq, pmsgs[cnt++], OS_Q_PRIO_LOWEST);   /* Insert message into queue                    */
+    }
+    OS_EXIT_CRITICAL();
+    if (cnt < nbr) {                                   /* See if the queue was full                    */
+        *perr = OS_ERR_Q_FULL;
+    } else {
+        *perr = OS_ERR_NONE;
+    }
+    if (sched == OS_TRUE) {
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+    }
+    return (cnt);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        POST MESSAGE TO A QUEUE
 *
 * Description: This function sends a message to a queue.  This call has been added to reduce code size
@@ -694,9 +1127,13 @@ INT8U  OSQPostFront (OS_EVENT *pevent, void *pmsg)
 *              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
 *              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
 *              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are
+*                                    already deferred (see OS_IntQPost())
 *
 * Warning    : Interrupts can be disabled for a long time if you do a 'broadcast'.  In fact, the
 *              interrupt disable time is proportional to the number of tasks waiting on the queue.
+*              With OS_ISR_POST_DEFERRED_EN, the waiting tasks are readied one at a time instead, with
+*              interrupts enabled in between and the scheduler locked.
 *********************************************************************************************************
 */
 
@@ -718,12 +1155,31 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
     if (pevent->OSEventType != OS_EVENT_TYPE_Q) {     /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() post once ISRs are done     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q_OPT, (void *)pevent, pmsg, 0, opt));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0x00) {                 /* See if any task pending on queue              */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
+#if OS_ISR_POST_DEFERRED_EN > 0
+            if (OSLockNesting < 255u) {               /* No task may pend while we post                */
+                OSLockNesting++;
+            }
+#endif
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on queue       */
                 (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+#if OS_ISR_POST_DEFERRED_EN > 0
+                OS_EXIT_CRITICAL();                   /* Let interrupts in between two waiters: the    */
+                OS_ENTER_CRITICAL();                  /* ... posts of ISRs are deferred                */
+#endif
+            }
+#if OS_ISR_POST_DEFERRED_EN > 0
+            if (OSLockNesting > 0) {                  /* Remove context switch lock                    */
+                OSLockNesting--;
             }
+#endif
         } else {                                      /* No,  Post to HPT waiting on queue             */
             (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
         }
@@ -739,18 +1195,84 @@ INT8U  OSQPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_Q_FULL);
     }
     if ((opt & OS_POST_OPT_FRONT) != 0x00) {          /* Do we post to the FRONT of the queue?         */
-        if (pq->OSQOut == pq->OSQStart) {             /* Yes, Post as LIFO, Wrap OUT pointer if we ... */
-            pq->OSQOut = pq->OSQEnd;                  /*      ... are at the 1st queue entry           */
-        }
-        pq->OSQOut--;
-        *pq->OSQOut = pmsg;                           /*      Insert message into queue                */
-    } else {                                          /* No,  Post as FIFO                             */
-        *pq->OSQIn++ = pmsg;                          /*      Insert message into queue                */
-        if (pq->OSQIn == pq->OSQEnd) {                /*      Wrap IN ptr if we are at end of queue    */
-            pq->OSQIn = pq->OSQStart;
-        }
+        OSQ_PutFront(pq, pmsg);                       /* Yes, Post as LIFO                             */
+    } else {
+        OSQ_Put(pq, pmsg, OS_Q_PRIO_LOWEST);          /* No,  Post as FIFO                             */
     }
-    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 POST MESSAGE WITH A PRIORITY TO A QUEUE
+*
+* Description: This function sends a message with a priority to a queue created by OSQCreatePrio().  The
+*              message is extracted after the messages of higher priority and the older messages of the
+*              same priority.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired queue
+*
+*              pmsg          is a pointer to the message to send.
+*
+*              prio          is the priority of the message, from 0 (the highest) to OS_Q_PRIO_LVLS - 1.
+*
+* Returns    : OS_ERR_NONE           The call was successful and the message was sent
+*              OS_ERR_Q_FULL         If the queue cannot accept any more messages because it is full.
+*              OS_ERR_EVENT_TYPE     If you didn't pass a pointer to a queue.
+*              OS_ERR_PEVENT_NULL    If 'pevent' is a NULL pointer
+*              OS_ERR_PRIO_INVALID   If 'prio' is OS_Q_PRIO_LVLS or higher
+*              OS_ERR_INT_Q_FULL     If called from an ISR while OS_INT_Q_SIZE posts are
+*                                    already deferred (see OS_IntQPost())
+*
+* Note(s)    : 1) A task waiting on the queue receives the message directly, whatever its priority.
+*
+*              2) On a queue created by OSQCreate(), 'prio' is ignored and the message is posted as by
+*                 OSQPost().
+*********************************************************************************************************
+*/
+
+#if OS_Q_PRIO_EN > 0
+INT8U  OSQPostPrio (OS_EVENT *pevent, void *pmsg, INT8U prio)
+{
+    OS_Q      *pq;
+#if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                     /* Validate 'pevent'                            */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (prio >= OS_Q_PRIO_LVLS) {                      /* Validate 'prio'                              */
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_Q) {      /* Validate event block type                    */
+        return (OS_ERR_EVENT_TYPE);
+    }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                            /* Let OS_TaskIntQ() post once ISRs are done    */
+        return (OS_IntQPost(OS_INT_Q_TYPE_Q_PRIO, (void *)pevent, pmsg, 0, prio));
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0) {                     /* See if any task pending on queue             */
+                                                       /* Ready highest priority task waiting on event */
+        (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_Q, OS_STAT_PEND_OK);
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                    /* Find highest priority task ready to run      */
+        return (OS_ERR_NONE);
+    }
+    pq = (OS_Q *)pevent->OSEventPtr;                   /* Point to queue control block                 */
+    if (pq->OSQEntries >= pq->OSQSize) {               /* Make sure queue is not full                  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_Q_FULL);
+    }
+    OSQ_Put(pq, pmsg, prio);                           /* Insert message into queue                    */
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -779,13 +1301,8 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 {
     OS_Q      *pq;
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    INT32U    *psrc;
+    INT32U    *pdest;
 #if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -811,10 +1328,14 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
         *pdest++ = *psrc++;
     }
     pq = (OS_Q *)pevent->OSEventPtr;
-    if (pq->OSQEntries > 0) {
-        p_q_data->OSMsg = *pq->OSQOut;                 /* Get next message to return if available      */
-    } else {
+    if (pq->OSQEntries == 0) {
         p_q_data->OSMsg = (void *)0;
+#if OS_Q_PRIO_EN > 0
+    } else if (pq->OSQMsgTbl != (OS_Q_MSG *)0) {       /* Oldest message of the highest priority       */
+        p_q_data->OSMsg = pq->OSQMsgHead[OS_CntLeadZeros(pq->OSQPrioGrp)]->OSQMsgPtr;
+#endif
+    } else {
+        p_q_data->OSMsg = *pq->OSQOut;                 /* Get next message to return if available      */
     }
     p_q_data->OSNMsgs = pq->OSQEntries;
     p_q_data->OSQSize = pq->OSQSize;
@@ -823,6 +1344,164 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 }
 #endif                                                 /* OS_Q_QUERY_EN                                */
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    INSERT AND EXTRACT QUEUE MESSAGES
+*
+* Description: OSQ_Get() extracts the next message of a queue: the oldest one or, in a priority-ordered
+*              queue, the oldest one of the highest priority.
+*              OSQ_Put() inserts a message after the others, or after the others of priority 'prio' in a
+*              priority-ordered queue.
+*              OSQ_PutFront() inserts a message before all the others.
+*
+* Arguments  : pq            is a pointer to the queue control block
+*
+*              pmsg          is the message to insert
+*
+*              prio          is the priority of the message, ignored unless the queue is priority-ordered
+*
+* Returns    : OSQ_Get() returns the message extracted.
+*
+* Note(s)    : These functions assume that interrupts are disabled and that the queue is not empty
+*              (OSQ_Get()) or not full (OSQ_Put() and OSQ_PutFront()).
+*********************************************************************************************************
+*/
+
+static  void  *OSQ_Get (OS_Q *pq)
+{
+    void      *pmsg;
+#if OS_Q_PRIO_EN > 0
+    OS_Q_MSG  *pentry;
+    INT8U      prio;
+#endif
+
+
+
+#if OS_Q_PRIO_EN > 0
+    if (pq->OSQMsgTbl != (OS_Q_MSG *)0) {            /* See if the queue is priority-ordered           */
+        prio                 = OS_CntLeadZeros(pq->OSQPrioGrp);  /* Highest priority with messages      */
+        pentry               = pq->OSQMsgHead[prio];  /* Take its oldest message                       */
+        pq->OSQMsgHead[prio] = pentry->OSQMsgNext;
+        if (pq->OSQMsgHead[prio] == (OS_Q_MSG *)0) {
+            pq->OSQMsgTail[prio]  = (OS_Q_MSG *)0;
+            pq->OSQPrioGrp       &= ~((INT32U)0x80000000L >> prio);
+        }
+        pmsg                 = pentry->OSQMsgPtr;
+        pentry->OSQMsgNext   = pq->OSQMsgFree;        /* Return the entry to the free list             */
+        pq->OSQMsgFree       = pentry;
+        pq->OSQEntries--;                             /* Update the number of entries in the queue     */
+        return (pmsg);
+    }
+#endif
+    pmsg = *pq->OSQOut++;                             /* Extract oldest message from the queue         */
+    pq->OSQEntries--;                                 /* Update the number of entries in the queue     */
+    if (pq->OSQOut == pq->OSQEnd) {                   /* Wrap OUT pointer if we are at the end of queue*/
+        pq->OSQOut = pq->OSQStart;
+    }
+    return (pmsg);
+}
+
+
+#if (OS_Q_POST_EN > 0) || (OS_Q_POST_OPT_EN > 0) || (OS_Q_MANY_EN > 0) || (OS_Q_PRIO_EN > 0)
+static  void  OSQ_Put (OS_Q *pq, void *pmsg, INT8U prio)
+{
+#if OS_Q_PRIO_EN > 0
+    OS_Q_MSG  *pentry;
+
+
+
+    if (pq->OSQMsgTbl != (OS_Q_MSG *)0) {            /* See if the queue is priority-ordered           */
+        pentry             = pq->OSQMsgFree;          /* Take a free entry                             */
+        pq->OSQMsgFree     = pentry->OSQMsgNext;
+        pentry->OSQMsgPtr  = pmsg;
+        pentry->OSQMsgNext = (OS_Q_MSG *)0;
+        if (pq->OSQMsgHead[prio] == (OS_Q_MSG *)0) {  /* Append it to the messages of its priority     */
+            pq->OSQMsgHead[prio]  = pentry;
+            pq->OSQPrioGrp       |= (INT32U)0x80000000L >> prio;
+        } else {
+            pq->OSQMsgTail[prio]->OSQMsgNext = pentry;
+        }
+        pq->OSQMsgTail[prio] = pentry;
+        pq->OSQEntries++;                             /* Update the nbr of entries in the queue        */
+        return;
+    }
+#else
+    (void)prio;                                       /* Prevent compiler warning for not using 'prio' */
+#endif
+    *pq->OSQIn++ = pmsg;                              /* Insert message into queue                     */
+    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+    if (pq->OSQIn == pq->OSQEnd) {                    /* Wrap IN ptr if we are at end of queue         */
+        pq->OSQIn = pq->OSQStart;
+    }
+}
+#endif
+
+
+#if (OS_Q_POST_FRONT_EN > 0) || (OS_Q_POST_OPT_EN > 0)
+static  void  OSQ_PutFront (OS_Q *pq, void *pmsg)
+{
+#if OS_Q_PRIO_EN > 0
+    OS_Q_MSG  *pentry;
+
+
+
+    if (pq->OSQMsgTbl != (OS_Q_MSG *)0) {            /* See if the queue is priority-ordered           */
+        pentry             = pq->OSQMsgFree;          /* Take a free entry                             */
+        pq->OSQMsgFree     = pentry->OSQMsgNext;
+        pentry->OSQMsgPtr  = pmsg;
+        pentry->OSQMsgNext = pq->OSQMsgHead[0];       /* Insert it before the highest priority ones    */
+        if (pq->OSQMsgHead[0] == (OS_Q_MSG *)0) {
+            pq->OSQMsgTail[0]  = pentry;
+            pq->OSQPrioGrp    |= (INT32U)0x80000000L;
+        }
+        pq->OSQMsgHead[0]  = pentry;
+        pq->OSQEntries++;                             /* Update the nbr of entries in the queue        */
+        return;
+    }
+#endif
+    if (pq->OSQOut == pq->OSQStart) {                 /* Wrap OUT ptr if we are at the 1st queue entry */
+        pq->OSQOut = pq->OSQEnd;
+    }
+    pq->OSQOut--;
+    *pq->OSQOut = pmsg;                               /* Insert message into queue                     */
+    pq->OSQEntries++;                                 /* Update the nbr of entries in the queue        */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               RETURN A QUEUE CONTROL BLOCK TO THE POOL
+*
+* Description : This function is called by OSQDel() to release the queue control block of a deleted
+*               queue.  Blocks supplied by the application through OSQCreateStatic() are not part of
+*               OSQTbl[] and are only marked as unused.
+*
+* Arguments   : pq      is a pointer to the queue control block to release.
+*
+* Returns     : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+
+void  OS_QFree (OS_Q *pq)
+{
+#if OS_MAX_QS > 0
+#if OS_OBJ_STATIC_EN > 0
+    if ((pq <  &OSQTbl[0]) ||                        /* See if the QCB is outside of the pool          */
+        (pq >= &OSQTbl[OS_MAX_QS])) {
+        pq->OSQPtr = (OS_Q *)0;
+        return;
+    }
+#endif
+    pq->OSQPtr  = OSQFreeList;                       /* Return queue control block to free list        */
+    OSQFreeList = pq;
+#else
+    pq->OSQPtr  = (OS_Q *)0;                         /* No pool, all QCBs belong to the application    */
+#endif
+}
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -0,0 +1,761 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                      READER-WRITER LOCK MANAGEMENT
+*
+*                              (c) Copyright 1992-2007, Micrium, Weston, FL
+*                                           All Rights Reserved
+*
+* File    : OS_RWLOCK.C
+* Version : V2.86
+*
+* LICENSING TERMS:
+* ---------------
+*   uC/OS-II is provided in source form for FREE evaluation, for educational use or for peaceful research.  
+* If you plan on using  uC/OS-II  in a commercial product you need to contact Micrim to properly license 
+* its use in your product. We provide ALL the source code for your convenience and to help you experience 
+* uC/OS-II.   The fact that the  source is provided does  NOT  mean that you can use it without  paying a 
+* licensing fee.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+
+#if OS_RWLOCK_EN > 0
+/*
+*********************************************************************************************************
+*                                            LOCAL CONSTANTS
+*
+* Note(s): The MOST significant bit of '.OSEventCnt' is set if the lock was created with
+*          OS_RWLOCK_OPT_WR_PREF and the other 15 bits hold the number of readers holding the lock.
+*          '.OSEventPtr' points to the OS_TCB of the writer holding the lock, if any.
+*********************************************************************************************************
+*/
+
+#define  OS_RWLOCK_WR_PREF       ((INT16U)0x8000u)
+#define  OS_RWLOCK_RD_CNT        ((INT16U)0x7FFFu)
+
+/*
+*********************************************************************************************************
+*                                           LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OSRWLock_Grant(OS_EVENT *pevent);
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       CREATE A READER-WRITER LOCK
+*
+* Description: This function creates a reader-writer lock.  Any number of tasks may hold the lock to read
+*              at the same time, while a task holding it to write excludes all the others.
+*
+* Arguments  : opt           determines which waiting tasks get the lock first:
+*                            OS_RWLOCK_OPT_NONE      In priority order: a reader gets the lock ahead of the
+*                                                    waiting writers if its priority is higher than theirs.
+*                            OS_RWLOCK_OPT_WR_PREF   Writer preference: no reader gets the lock while a
+*                                                    writer is waiting for it.
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a lock from an ISR
+*                               OS_ERR_INVALID_OPT  if 'opt' is not one of the options above
+*                               OS_ERR_PEVENT_NULL  No more event control blocks available.
+*
+* Returns    : != (void *)0  is a pointer to the event control clock (OS_EVENT) associated with the
+*                            created lock.
+*              == (void *)0  if an error is detected.
+*********************************************************************************************************
+*/
+
+#if OS_MAX_EVENTS > 0
+OS_EVENT  *OSRWLockCreate (INT8U opt, INT8U *perr)
+{
+    OS_EVENT  *pevent;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_EVENT *)0);
+    }
+    if (opt > OS_RWLOCK_OPT_WR_PREF) {                     /* Validate 'opt'                           */
+        *perr = OS_ERR_INVALID_OPT;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_EVENT *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pevent = OSEventFreeList;                              /* Get next free event control block        */
+    if (pevent == (OS_EVENT *)0) {                         /* See if an ECB was available              */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEVENT_NULL;                        /* No more event control blocks             */
+        return (pevent);
+    }
+    OSEventFreeList        = (OS_EVENT *)OSEventFreeList->OSEventPtr;   /* Adjust the free list        */
+    OS_EXIT_CRITICAL();
+    pevent->OSEventType    = OS_EVENT_TYPE_RWLOCK;
+    if (opt == OS_RWLOCK_OPT_WR_PREF) {                    /* No reader holds the lock                 */
+        pevent->OSEventCnt = OS_RWLOCK_WR_PREF;
+    } else {
+        pevent->OSEventCnt = 0;
+    }
+    pevent->OSEventPtr     = (void *)0;                    /* No writer holds the lock                 */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              CREATE A READER-WRITER LOCK IN APPLICATION STORAGE
+*
+* Description: This function creates a reader-writer lock using an event control block supplied by the
+*              application instead of taking one from the OSEventTbl[] pool.
+*
+* Arguments  : pevent        is a pointer to the event control block to use.
+*
+*              opt           determines which waiting tasks get the lock first (see OSRWLockCreate()).
+*
+*              perr          is a pointer to an error code which will be returned to your application:
+*                               OS_ERR_NONE         if the call was successful.
+*                               OS_ERR_CREATE_ISR   if you attempted to create a lock from an ISR
+*                               OS_ERR_INVALID_OPT  if 'opt' is not valid
+*                               OS_ERR_PEVENT_NULL  if 'pevent' is a NULL pointer.
+*
+* Returns    : != (void *)0  is 'pevent'
+*              == (void *)0  if an error is detected.
+*
+* Note(s)    : 1) 'pevent' MUST remain valid for as long as the lock is in use and MUST NOT already be in
+*                 use by another kernel object.
+*
+*              2) OSRWLockDel() does not return 'pevent' to the pool; the application may reuse it once
+*                 the lock has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT  *OSRWLockCreateStatic (OS_EVENT *pevent, INT8U opt, INT8U *perr)
+{
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return ((OS_EVENT *)0);
+    }
+    if (opt > OS_RWLOCK_OPT_WR_PREF) {                     /* Validate 'opt'                           */
+        *perr = OS_ERR_INVALID_OPT;
+        return ((OS_EVENT *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_CREATE_ISR;                         /* ... can't CREATE from an ISR             */
+        return ((OS_EVENT *)0);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return ((OS_EVENT *)0);
+    }
+    pevent->OSEventType    = OS_EVENT_TYPE_RWLOCK;
+    if (opt == OS_RWLOCK_OPT_WR_PREF) {                    /* No reader holds the lock                 */
+        pevent->OSEventCnt = OS_RWLOCK_WR_PREF;
+    } else {
+        pevent->OSEventCnt = 0;
+    }
+    pevent->OSEventPtr     = (void *)0;                    /* No writer holds the lock                 */
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);
+    *perr                  = OS_ERR_NONE;
+    return (pevent);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       DELETE A READER-WRITER LOCK
+*
+* Description: This function deletes a reader-writer lock and readies all tasks pending on it.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+*              opt           determines delete options as follows:
+*                            opt == OS_DEL_NO_PEND   Delete the lock ONLY if no task pending
+*                            opt == OS_DEL_ALWAYS    Deletes the lock even if tasks are waiting.
+*                                                    In this case, all the tasks pending will be readied
+*                                                    and get OS_ERR_PEND_ABORT.
+*
+*              perr          is a pointer to an error code that can contain one of the following values:
+*                            OS_ERR_NONE             The call was successful and the lock was deleted
+*                            OS_ERR_DEL_ISR          If you attempted to delete the lock from an ISR
+*                            OS_ERR_INVALID_OPT      An invalid option was specified
+*                            OS_ERR_TASK_WAITING     One or more tasks were waiting on the lock
+*                            OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a reader-writer lock
+*                            OS_ERR_PEVENT_NULL      If 'pevent' is a NULL pointer.
+*
+* Returns    : pevent        upon error
+*              (OS_EVENT *)0 if the lock was successfully deleted.
+*
+* Note(s)    : 1) This function must be used with care.  Tasks that would normally expect the presence of
+*                 the lock MUST check the return code of OSRWLockPendRd() and OSRWLockPendWr().
+*
+*              2) This call can potentially disable interrupts for a long time.  The interrupt disable
+*                 time is directly proportional to the number of tasks waiting on the lock.
+*
+*              3) The tasks holding the lock are not told that it was deleted.
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_DEL_EN > 0
+OS_EVENT  *OSRWLockDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
+{
+    BOOLEAN    tasks_waiting;
+    OS_EVENT  *pevent_return;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                              /* Validate 'perr'                          */
+        return (pevent);
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        *perr = OS_ERR_PEVENT_NULL;
+        return (pevent);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {     /* Validate event block type                */
+        *perr = OS_ERR_EVENT_TYPE;
+        return (pevent);
+    }
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        *perr = OS_ERR_DEL_ISR;                            /* ... can't DELETE from an ISR             */
+        return (pevent);
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventGrp != 0) {                         /* See if any tasks waiting on the lock     */
+        tasks_waiting = OS_TRUE;                           /* Yes                                      */
+    } else {
+        tasks_waiting = OS_FALSE;                          /* No                                       */
+    }
+    switch (opt) {
+        case OS_DEL_NO_PEND:                               /* Delete lock only if no task waiting      */
+             if (tasks_waiting == OS_FALSE) {
+#if OS_EVENT_NAME_SIZE > 1
+                 pevent->OSEventName[0] = '?';             /* Unknown name                             */
+                 pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+                 pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+                 pevent->OSEventCnt     = 0;
+                 OS_EventFree(pevent);                     /* Return Event Control Block to free list  */
+                 OS_EXIT_CRITICAL();
+                 *perr                  = OS_ERR_NONE;
+                 pevent_return          = (OS_EVENT *)0;   /* Lock has been deleted                    */
+             } else {
+                 OS_EXIT_CRITICAL();
+                 *perr                  = OS_ERR_TASK_WAITING;
+                 pevent_return          = pevent;
+             }
+             break;
+
+        case OS_DEL_ALWAYS:                                /* Always delete the lock                   */
+             while (pevent->OSEventGrp != 0) {             /* Ready ALL tasks waiting for the lock     */
+                 (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_RWLOCK_RD | OS_STAT_RWLOCK_WR,
+                                       OS_STAT_PEND_ABORT);
+             }
+#if OS_EVENT_NAME_SIZE > 1
+             pevent->OSEventName[0] = '?';                 /* Unknown name                             */
+             pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+             pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
+             pevent->OSEventCnt     = 0;
+             OS_EventFree(pevent);                         /* Return Event Control Block to free list  */
+             OS_EXIT_CRITICAL();
+             if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
+                 OS_Sched();                               /* Find highest priority task ready to run  */
+             }
+             *perr                  = OS_ERR_NONE;
+             pevent_return          = (OS_EVENT *)0;       /* Lock has been deleted                    */
+             break;
+
+        default:
+             OS_EXIT_CRITICAL();
+             *perr                  = OS_ERR_INVALID_OPT;
+             pevent_return          = pevent;
+             break;
+    }
+    return (pevent_return);
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PEND ON A READER-WRITER LOCK TO READ
+*
+* Description: This function waits until the calling task may read: no writer holds the lock and none
+*              must get it first.  The other readers holding the lock do not block the calling task.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the lock up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever for the lock.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*                               OS_ERR_NONE        The call was successful and your task holds the lock
+*                               OS_ERR_TIMEOUT     The lock was not available within the specified 'timeout'.
+*                               OS_ERR_PEND_ABORT  The lock was deleted while the task was waiting.
+*                               OS_ERR_EVENT_TYPE  If you didn't pass a pointer to a reader-writer lock
+*                               OS_ERR_PEVENT_NULL 'pevent' is a NULL pointer
+*                               OS_ERR_PEND_ISR    If you called this function from an ISR
+*                               OS_ERR_PEND_LOCKED If you called this function when the scheduler is locked
+*                               OS_ERR_RWLOCK_OVF  If 32767 readers already hold the lock
+*
+* Returns    : none
+*
+* Note(s)    : 1) Each successful call MUST be matched by a call to OSRWLockPostRd().
+*
+*              2) The task MUST NOT wait to read a lock it holds to write.
+*********************************************************************************************************
+*/
+
+void  OSRWLockPendRd (OS_EVENT *pevent, OS_TICK timeout, INT8U *perr)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return;
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if (pevent->OSEventPtr == (void *)0) {            /* No writer holds the lock, see if one waits    */
+        ptcb = OS_EventTaskFindStat(pevent, OS_STAT_RWLOCK_WR);
+        if ((ptcb == (OS_TCB *)0) ||                  /* Read unless a writer must go first            */
+            (((pevent->OSEventCnt & OS_RWLOCK_WR_PREF) == 0) && (OSTCBCur->OSTCBPrio < ptcb->OSTCBPrio))) {
+            if ((pevent->OSEventCnt & OS_RWLOCK_RD_CNT) == OS_RWLOCK_RD_CNT) {
+                OS_EXIT_CRITICAL();
+                *perr = OS_ERR_RWLOCK_OVF;            /* Too many readers                              */
+                return;
+            }
+            pevent->OSEventCnt++;                     /* One more reader                               */
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_NONE;
+            return;
+        }
+    }
+                                                      /* Otherwise, must wait until a writer is done   */
+    OSTCBCur->OSTCBStat     |= OS_STAT_RWLOCK_RD;     /* Lock not available, pend to read              */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
+    OS_EventTaskWait(pevent);                         /* Suspend task until granted or timeout occurs  */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Counted as a reader by OSRWLock_Grant()       */
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that the lock was deleted            */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get lock within TO    */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OS_EXIT_CRITICAL();
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PEND ON A READER-WRITER LOCK TO WRITE
+*
+* Description: This function waits until the calling task holds the lock alone.
+*
+* Arguments  : pevent        is a pointer to the event control block associated with the desired lock.
+*
+*              timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the lock up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever for the lock.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*                               OS_ERR_NONE        The call was successful and your task holds the lock
+*                               OS_ERR_TIMEOUT     The lock was not available within the specified 'timeout'.
+*                               OS_ERR_PEND_ABORT  The lock was deleted while the task was waiting.
+*                               OS_ERR_EVENT_TYPE  If you didn't pass a pointer to a reader-writer lock
+*                               OS_ERR_PEVENT_NULL 'pevent' is a NULL pointer
+*                               OS_ERR_PEND_ISR    If you called this function from an ISR
+*                               OS_ERR_PEND_LOCKED If you called this function when the scheduler is locked
+*
+* Returns    : none
+*
+* Note(s)    : 1) The task MUST NOT wait for a lock it already holds, to read or to write.
+*
+*              2) The priority of the writer holding the lock is not raised when a higher priority task
+*                 waits for it.  Keep the sections holding the lock short.
+*********************************************************************************************************
+*/
+
+void  OSRWLockPendWr (OS_EVENT *pevent, OS_TICK timeout, INT8U *perr)
+{
+    BOOLEAN    rdy;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        *perr = OS_ERR_PEVENT_NULL;
+        return;
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        *perr = OS_ERR_EVENT_TYPE;
+        return;
+    }
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return;
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if ((pevent->OSEventPtr == (void *)0) &&          /* Is the lock free?                             */
+        ((pevent->OSEventCnt & OS_RWLOCK_RD_CNT) == 0)) {
+        pevent->OSEventPtr = (void *)OSTCBCur;        /* Yes, current task holds it to write           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return;
+    }
+    OSTCBCur->OSTCBStat     |= OS_STAT_RWLOCK_WR;     /* No,  pend to write                            */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
+    OS_EventTaskWait(pevent);                         /* Suspend task until granted or timeout occurs  */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    rdy = OS_FALSE;
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* Made the writer by OSRWLock_Grant()           */
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that the lock was deleted            */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             OS_EventTaskRemove(OSTCBCur, pevent);
+             rdy  = OSRWLock_Grant(pevent);           /* Readers held back by this writer may go       */
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get lock within TO    */
+             break;
+    }
+    OSTCBCur->OSTCBStat          =  OS_STAT_RDY;      /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend      =  OS_STAT_PEND_OK;  /* Clear pend  status                            */
+    OSTCBCur->OSTCBEventPtr      = (OS_EVENT  *)0;    /* Clear event pointers                          */
+#if (OS_EVENT_MULTI_EN > 0)
+    OSTCBCur->OSTCBEventMultiPtr = (OS_EVENT **)0;
+#endif
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 RELEASE A READER-WRITER LOCK HELD TO READ
+*
+* Description: This function releases a lock obtained with OSRWLockPendRd().  When the last reader
+*              releases the lock, it is given to the waiting writer, if any.
+*
+* Arguments  : pevent              is a pointer to the event control block associated with the desired
+*                                  lock.
+*
+* Returns    : OS_ERR_NONE             The call was successful and the lock was released.
+*              OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a reader-writer lock
+*              OS_ERR_PEVENT_NULL      'pevent' is a NULL pointer
+*              OS_ERR_POST_ISR         Attempted to release the lock from an ISR
+*              OS_ERR_NOT_RWLOCK_OWNER No reader holds the lock.
+*********************************************************************************************************
+*/
+
+INT8U  OSRWLockPostRd (OS_EVENT *pevent)
+{
+    BOOLEAN    rdy;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        return (OS_ERR_POST_ISR);                     /* ... can't release a lock from an ISR          */
+    }
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if ((pevent->OSEventCnt & OS_RWLOCK_RD_CNT) == 0) {   /* See if a reader holds the lock            */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NOT_RWLOCK_OWNER);
+    }
+    pevent->OSEventCnt--;                             /* One reader less                               */
+    rdy = OS_FALSE;
+    if ((pevent->OSEventCnt & OS_RWLOCK_RD_CNT) == 0) {   /* Last reader gives the lock to a writer    */
+        rdy = OSRWLock_Grant(pevent);
+    }
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 RELEASE A READER-WRITER LOCK HELD TO WRITE
+*
+* Description: This function releases a lock obtained with OSRWLockPendWr().  The lock is given to the
+*              waiting tasks as selected when it was created (see OSRWLockCreate()): either to one writer
+*              or to all the readers allowed to go.
+*
+* Arguments  : pevent              is a pointer to the event control block associated with the desired
+*                                  lock.
+*
+* Returns    : OS_ERR_NONE             The call was successful and the lock was released.
+*              OS_ERR_EVENT_TYPE       If you didn't pass a pointer to a reader-writer lock
+*              OS_ERR_PEVENT_NULL      'pevent' is a NULL pointer
+*              OS_ERR_POST_ISR         Attempted to release the lock from an ISR
+*              OS_ERR_NOT_RWLOCK_OWNER The calling task does not hold the lock to write.
+*********************************************************************************************************
+*/
+
+INT8U  OSRWLockPostWr (OS_EVENT *pevent)
+{
+    BOOLEAN    rdy;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        return (OS_ERR_POST_ISR);                     /* ... can't release a lock from an ISR          */
+    }
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                    /* Validate 'pevent'                             */
+        return (OS_ERR_PEVENT_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {/* Validate event block type                     */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur != (OS_TCB *)pevent->OSEventPtr) {   /* See if calling task holds the lock to write   */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NOT_RWLOCK_OWNER);
+    }
+    pevent->OSEventPtr = (void *)0;                   /* Release the lock ...                          */
+    rdy                = OSRWLock_Grant(pevent);      /* ... and give it to the waiting task(s)        */
+    OS_EXIT_CRITICAL();
+    if (rdy == OS_TRUE) {
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+    }
+    return (OS_ERR_NONE);
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       QUERY A READER-WRITER LOCK
+*
+* Description: This function obtains information about a reader-writer lock.
+*
+* Arguments  : pevent          is a pointer to the event control block associated with the desired lock
+*
+*              p_rwlock_data   is a pointer to a structure that will contain information about the lock
+*
+* Returns    : OS_ERR_NONE          The call was successful
+*              OS_ERR_QUERY_ISR     If you called this function from an ISR
+*              OS_ERR_PEVENT_NULL   If 'pevent'        is a NULL pointer
+*              OS_ERR_PDATA_NULL    If 'p_rwlock_data' is a NULL pointer
+*              OS_ERR_EVENT_TYPE    If you are attempting to obtain data from a non reader-writer lock.
+*********************************************************************************************************
+*/
+
+#if OS_RWLOCK_QUERY_EN > 0
+INT8U  OSRWLockQuery (OS_EVENT *pevent, OS_RWLOCK_DATA *p_rwlock_data)
+{
+    INT8U      i;
+    INT32U    *psrc;
+    INT32U    *pdest;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        return (OS_ERR_QUERY_ISR);                         /* ... can't QUERY lock from an ISR         */
+    }
+#if OS_ARG_CHK_EN > 0
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        return (OS_ERR_PEVENT_NULL);
+    }
+    if (p_rwlock_data == (OS_RWLOCK_DATA *)0) {            /* Validate 'p_rwlock_data'                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (pevent->OSEventType != OS_EVENT_TYPE_RWLOCK) {     /* Validate event block type                */
+        return (OS_ERR_EVENT_TYPE);
+    }
+    OS_ENTER_CRITICAL();
+    p_rwlock_data->OSRdCnt = pevent->OSEventCnt & OS_RWLOCK_RD_CNT;
+    if (pevent->OSEventPtr != (void *)0) {                 /* Get priority of the writer, if any       */
+        p_rwlock_data->OSWrPrio = ((OS_TCB *)pevent->OSEventPtr)->OSTCBPrio;
+    } else {
+        p_rwlock_data->OSWrPrio = 0xFF;
+    }
+    if ((pevent->OSEventCnt & OS_RWLOCK_WR_PREF) != 0) {
+        p_rwlock_data->OSOpt = OS_RWLOCK_OPT_WR_PREF;
+    } else {
+        p_rwlock_data->OSOpt = OS_RWLOCK_OPT_NONE;
+    }
+    p_rwlock_data->OSEventGrp = pevent->OSEventGrp;        /* Copy wait list                           */
+    psrc                      = &pevent->OSEventTbl[0];
+    pdest                     = &p_rwlock_data->OSEventTbl[0];
+    for (i = 0; i < OS_EVENT_TBL_SIZE; i++) {
+        *pdest++ = *psrc++;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif                                                     /* OS_RWLOCK_QUERY_EN                       */
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      GIVE A FREED LOCK TO WAITING TASKS
+*
+* Description: This function is called when a writer released the lock, when the last reader released
+*              it or when a waiting writer timed out.  If no writer holds the lock, it readies the waiting
+*              readers allowed to go: all of them if no writer waits, none with OS_RWLOCK_OPT_WR_PREF, and
+*              otherwise those of a higher priority than the highest priority writer.  If none is readied
+*              and no reader holds the lock, the writer gets it.
+*
+* Arguments  : pevent          is a pointer to the event control block of the lock
+*
+* Returns    : OS_TRUE         if at least one task was readied
+*              OS_FALSE        otherwise
+*
+* Note(s)    : This function assumes that interrupts are disabled.
+*********************************************************************************************************
+*/
+
+static  BOOLEAN  OSRWLock_Grant (OS_EVENT *pevent)
+{
+    OS_TCB   *ptcb;
+    OS_TCB   *pwr;
+    INT8U     prio_max;
+    BOOLEAN   rdy;
+
+
+    if (pevent->OSEventPtr != (void *)0) {                 /* A writer still holds the lock            */
+        return (OS_FALSE);
+    }
+    pwr = OS_EventTaskFindStat(pevent, OS_STAT_RWLOCK_WR); /* Find highest priority writer waiting     */
+    if (pwr == (OS_TCB *)0) {
+        prio_max = OS_LOWEST_PRIO + 1;                     /* All readers may go                       */
+    } else if ((pevent->OSEventCnt & OS_RWLOCK_WR_PREF) != 0) {
+        prio_max = 0;                                      /* No reader may go before the writer       */
+    } else {
+        prio_max = pwr->OSTCBPrio;                         /* Readers of a higher priority may go      */
+    }
+    rdy  = OS_FALSE;
+    ptcb = OS_EventTaskFindStat(pevent, OS_STAT_RWLOCK_RD);
+    while ((ptcb != (OS_TCB *)0) && (ptcb->OSTCBPrio < prio_max)) {
+        OS_EventTaskRdyTCB(pevent, ptcb, (void *)0, OS_STAT_RWLOCK_RD, OS_STAT_PEND_OK);
+        pevent->OSEventCnt++;                              /* Reader now holds the lock                */
+        rdy  = OS_TRUE;
+        ptcb = OS_EventTaskFindStat(pevent, OS_STAT_RWLOCK_RD);
+    }
+    if ((rdy == OS_FALSE) && (pwr != (OS_TCB *)0) && ((pevent->OSEventCnt & OS_RWLOCK_RD_CNT) == 0)) {
+        OS_EventTaskRdyTCB(pevent, pwr, (void *)0, OS_STAT_RWLOCK_WR, OS_STAT_PEND_OK);
+        pevent->OSEventPtr = (void *)pwr;                  /* Writer now holds the lock                */
+        rdy                = OS_TRUE;
+    }
+    return (rdy);
+}
+
+#endif                                                     /* OS_RWLOCK_EN                             */
@@ -91,6 +91,7 @@ INT16U  OSSemAccept (OS_EVENT *pevent)
 *********************************************************************************************************
 */
 
+#if OS_MAX_EVENTS > 0
 OS_EVENT  *OSSemCreate (INT16U cnt)
 {
     OS_EVENT  *pevent;
@@ -121,6 +122,50 @@ OS_EVENT  *OSSemCreate (INT16U cnt)
     }
     return (pevent);
 }
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 CREATE A SEMAPHORE IN APPLICATION STORAGE
+*
+* Description: This function creates a semaphore using an event control block supplied by the
+*              application instead of taking one from the OSEventTbl[] pool.
+*
+* Arguments  : pevent        is a pointer to the event control block to use.
+*
+*              cnt           is the initial value for the semaphore (see OSSemCreate()).
+*
+* Returns    : != (void *)0  is 'pevent'
+*              == (void *)0  if 'pevent' is NULL or if called from an ISR
+*
+* Notes      : 1) 'pevent' MUST remain valid for as long as the semaphore is in use and MUST NOT already
+*                 be in use by another kernel object.
+*              2) OSSemDel() does not return 'pevent' to the pool; the application may reuse it once the
+*                 semaphore has been deleted.
+*********************************************************************************************************
+*/
+
+#if OS_OBJ_STATIC_EN > 0
+OS_EVENT  *OSSemCreateStatic (OS_EVENT *pevent, INT16U cnt)
+{
+    if (OSIntNesting > 0) {                                /* See if called from ISR ...               */
+        return ((OS_EVENT *)0);                            /* ... can't CREATE from an ISR             */
+    }
+    if (pevent == (OS_EVENT *)0) {                         /* Validate 'pevent'                        */
+        return ((OS_EVENT *)0);
+    }
+    pevent->OSEventType    = OS_EVENT_TYPE_SEM;
+    pevent->OSEventCnt     = cnt;                          /* Set semaphore value                      */
+    pevent->OSEventPtr     = (void *)0;
+#if OS_EVENT_NAME_SIZE > 1
+    pevent->OSEventName[0] = '?';                          /* Unknown name                             */
+    pevent->OSEventName[1] = OS_ASCII_NUL;
+#endif
+    OS_EventWaitListInit(pevent);                          /* Initialize to 'nobody waiting' on sem.   */
+    return (pevent);
+}
+#endif
 
 /*$PAGE*/
 /*
@@ -202,9 +247,8 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
                  pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
                  pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
-                 pevent->OSEventPtr     = OSEventFreeList; /* Return Event Control Block to free list  */
                  pevent->OSEventCnt     = 0;
-                 OSEventFreeList        = pevent;          /* Get next free event control block        */
+                 OS_EventFree(pevent);                     /* Return Event Control Block to free list  */
                  OS_EXIT_CRITICAL();
                  *perr                  = OS_ERR_NONE;
                  pevent_return          = (OS_EVENT *)0;   /* Semaphore has been deleted               */
@@ -224,9 +268,8 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
              pevent->OSEventName[1] = OS_ASCII_NUL;
 #endif
              pevent->OSEventType    = OS_EVENT_TYPE_UNUSED;
-             pevent->OSEventPtr     = OSEventFreeList;     /* Return Event Control Block to free list  */
              pevent->OSEventCnt     = 0;
-             OSEventFreeList        = pevent;              /* Get next free event control block        */
+             OS_EventFree(pevent);                         /* Return Event Control Block to free list  */
              OS_EXIT_CRITICAL();
              if (tasks_waiting == OS_TRUE) {               /* Reschedule only if task(s) were waiting  */
                  OS_Sched();                               /* Find highest priority task ready to run  */
@@ -278,7 +321,7 @@ OS_EVENT  *OSSemDel (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *********************************************************************************************************
 */
 /*$PAGE*/
-void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
+void  OSSemPend (OS_EVENT *pevent, OS_TICK timeout, INT8U *perr)
 {
 #if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
     OS_CPU_SR  cpu_sr = 0;
@@ -317,7 +360,7 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                                                       /* Otherwise, must wait until event occurs       */
     OSTCBCur->OSTCBStat     |= OS_STAT_SEM;           /* Resource not available, pend on semaphore     */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -447,6 +490,8 @@ INT8U  OSSemPendAbort (OS_EVENT *pevent, INT8U opt, INT8U *perr)
 *                                  OSSemAccept() or OSSemPend().
 *              OS_ERR_EVENT_TYPE   If you didn't pass a pointer to a semaphore
 *              OS_ERR_PEVENT_NULL  If 'pevent' is a NULL pointer.
+*              OS_ERR_INT_Q_FULL   If called from an ISR while OS_INT_Q_SIZE posts are
+*                                  already deferred (see OS_IntQPost())
 *********************************************************************************************************
 */
 
@@ -466,6 +511,11 @@ INT8U  OSSemPost (OS_EVENT *pevent)
     if (pevent->OSEventType != OS_EVENT_TYPE_SEM) {   /* Validate event block type                     */
         return (OS_ERR_EVENT_TYPE);
     }
+#if OS_ISR_POST_DEFERRED_EN > 0
+    if (OSIntNesting > 0) {                           /* Let OS_TaskIntQ() post once ISRs are done     */
+        return (OS_IntQPost(OS_INT_Q_TYPE_SEM, (void *)pevent, (void *)0, 0, OS_POST_OPT_NONE));
+    }
+#endif
     OS_ENTER_CRITICAL();
     if (pevent->OSEventGrp != 0) {                    /* See if any task waiting for semaphore         */
                                                       /* Ready HPT waiting on event                    */
@@ -506,13 +556,8 @@ INT8U  OSSemPost (OS_EVENT *pevent)
 #if OS_SEM_QUERY_EN > 0
 INT8U  OSSemQuery (OS_EVENT *pevent, OS_SEM_DATA *p_sem_data)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    INT32U    *psrc;
+    INT32U    *pdest;
     INT8U      i;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
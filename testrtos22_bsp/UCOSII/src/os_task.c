@@ -31,7 +31,10 @@
 *                                        CHANGE PRIORITY OF A TASK
 *
 * Description: This function allows you to change the priority of a task dynamically.  Note that the new
-*              priority MUST be available.
+*              priority MUST be available.  With OS_SCHED_RR_EN enabled the new priority may be shared with
+*              other tasks and the task joins them at the end of their turn.  With OS_MUTEX_PI_EN enabled,
+*              a task that inherited a higher priority from the mutexes it owns keeps it until they are
+*              released; the new priority only sets the priority it returns to.
 *
 * Arguments  : oldp     is the old priority
 *
@@ -50,27 +53,22 @@
 #if OS_TASK_CHANGE_PRIO_EN > 0
 INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
 {
+#if OS_SCHED_RR_EN == 0
 #if (OS_EVENT_EN)
     OS_EVENT  *pevent;
 #if (OS_EVENT_MULTI_EN > 0)
     OS_EVENT **pevents;
 #endif
 #endif
-    OS_TCB    *ptcb;
     INT8U      y_new;
     INT8U      x_new;
     INT8U      y_old;
-#if OS_LOWEST_PRIO <= 63
     INT8U      bity_new;
-    INT8U      bitx_new;
+    INT32U     bitx_new;
     INT8U      bity_old;
-    INT8U      bitx_old;
-#else
-    INT16U     bity_new;
-    INT16U     bitx_new;
-    INT16U     bity_old;
-    INT16U     bitx_old;
+    INT32U     bitx_old;
 #endif
+    OS_TCB    *ptcb;
 #if OS_CRITICAL_METHOD == 3
     OS_CPU_SR  cpu_sr = 0;                                  /* Storage for CPU status register         */
 #endif
@@ -88,14 +86,26 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     }
 #endif
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (OSTCBPrioTbl[newprio] == OS_TCB_RESERVED) {         /* New priority must not be reserved       */
+#else
     if (OSTCBPrioTbl[newprio] != (OS_TCB *)0) {             /* New priority must not already exist     */
+#endif
         OS_EXIT_CRITICAL();
         return (OS_ERR_PRIO_EXIST);
     }
+#if OS_SCHED_RR_EN > 0
+    if (oldprio == OS_PRIO_SELF) {                          /* See if changing self                    */
+        ptcb = OSTCBCur;                                    /* Yes, priority may be shared             */
+    } else {
+        ptcb = OSTCBPrioTbl[oldprio];
+    }
+#else
     if (oldprio == OS_PRIO_SELF) {                          /* See if changing self                    */
         oldprio = OSTCBCur->OSTCBPrio;                      /* Yes, get priority                       */
     }
     ptcb = OSTCBPrioTbl[oldprio];
+#endif
     if (ptcb == (OS_TCB *)0) {                              /* Does task to change exist?              */
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_PRIO);
@@ -104,17 +114,16 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_TASK_NOT_EXIST);
     }
-#if OS_LOWEST_PRIO <= 63
-    y_new                 = (INT8U)(newprio >> 3);          /* Yes, compute new TCB fields             */
-    x_new                 = (INT8U)(newprio & 0x07);
-    bity_new              = (INT8U)(1 << y_new);
-    bitx_new              = (INT8U)(1 << x_new);
+#if OS_MUTEX_PI_EN > 0
+    ptcb->OSTCBBasePrio = newprio;                          /* Keep any priority inherited from mutexes*/
+    OS_MutexPrioUpdate(ptcb);                               /* ... and pass the change on to owners    */
+#elif OS_SCHED_RR_EN > 0
+    OS_TCBPrioSet(ptcb, newprio);                           /* Move task, keeping its state            */
 #else
-    y_new                 = (INT8U)((newprio >> 4) & 0x0F);
-    x_new                 = (INT8U)( newprio & 0x0F);
-    bity_new              = (INT16U)(1 << y_new);
-    bitx_new              = (INT16U)(1 << x_new);
-#endif
+    y_new                 = (INT8U)(newprio >> 5);          /* Yes, compute new TCB fields             */
+    x_new                 = (INT8U)(newprio & 0x1F);
+    bity_new              = (INT8U)(0x80 >> y_new);
+    bitx_new              = (INT32U)0x80000000L >> x_new;
 
     OSTCBPrioTbl[oldprio] = (OS_TCB *)0;                    /* Remove TCB from old priority            */
     OSTCBPrioTbl[newprio] =  ptcb;                          /* Place pointer to TCB @ new priority     */
@@ -163,6 +172,7 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     ptcb->OSTCBX    = x_new;
     ptcb->OSTCBBitY = bity_new;
     ptcb->OSTCBBitX = bitx_new;
+#endif
     OS_EXIT_CRITICAL();
     if (OSRunning == OS_TRUE) {
         OS_Sched();                                         /* Find new highest priority task          */
@@ -200,7 +210,8 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
 *                       memory locations.
 *
 *              prio     is the task's priority.  A unique priority MUST be assigned to each task and the
-*                       lower the number, the higher the priority.
+*                       lower the number, the higher the priority.  With OS_SCHED_RR_EN enabled, tasks
+*                       may share a priority and are then time sliced in turn.
 *
 * Returns    : OS_ERR_NONE             if the function was successful.
 *              OS_PRIO_EXIT            if the task priority already exist
@@ -232,9 +243,17 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_SCHED_RR_EN > 0
+    if ((OSTCBPrioTbl[prio] == (OS_TCB *)0) ||           /* Priority must be free or shared with tasks */
+        ((OSTCBPrioTbl[prio] != OS_TCB_RESERVED) && (prio != OS_TASK_IDLE_PRIO))) {
+        if (OSTCBPrioTbl[prio] == (OS_TCB *)0) {
+            OSTCBPrioTbl[prio] = OS_TCB_RESERVED;        /* Reserve the priority until task is created */
+        }
+#else
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
+#endif
         OS_EXIT_CRITICAL();
         psp = OSTaskStkInit(task, p_arg, ptos, 0);              /* Initialize the task's stack         */
         err = OS_TCBInit(prio, psp, (OS_STK *)0, 0, 0, (void *)0, 0);
@@ -244,7 +263,13 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
             }
         } else {
             OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+            if (OSTCBPrioTbl[prio] == OS_TCB_RESERVED) {
+                OSTCBPrioTbl[prio] = (OS_TCB *)0;        /* Make this priority available to others     */
+            }
+#else
             OSTCBPrioTbl[prio] = (OS_TCB *)0;/* Make this priority available to others                 */
+#endif
             OS_EXIT_CRITICAL();
         }
         return (err);
@@ -284,7 +309,8 @@ INT8U  OSTaskCreate (void (*task)(void *p_arg), void *p_arg, OS_STK *ptos, INT8U
 *                        memory locations.  'ptos' MUST point to a valid 'free' data item.
 *
 *              prio      is the task's priority.  A unique priority MUST be assigned to each task and the
-*                        lower the number, the higher the priority.
+*                        lower the number, the higher the priority.  With OS_SCHED_RR_EN enabled, tasks
+*                        may share a priority and are then time sliced in turn.
 *
 *              id        is the task's ID (0..65535)
 *
@@ -353,9 +379,17 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_CREATE_ISR);
     }
+#if OS_SCHED_RR_EN > 0
+    if ((OSTCBPrioTbl[prio] == (OS_TCB *)0) ||           /* Priority must be free or shared with tasks */
+        ((OSTCBPrioTbl[prio] != OS_TCB_RESERVED) && (prio != OS_TASK_IDLE_PRIO))) {
+        if (OSTCBPrioTbl[prio] == (OS_TCB *)0) {
+            OSTCBPrioTbl[prio] = OS_TCB_RESERVED;        /* Reserve the priority until task is created */
+        }
+#else
     if (OSTCBPrioTbl[prio] == (OS_TCB *)0) { /* Make sure task doesn't already exist at this priority  */
         OSTCBPrioTbl[prio] = OS_TCB_RESERVED;/* Reserve the priority to prevent others from doing ...  */
                                              /* ... the same thing until task is created.              */
+#endif
         OS_EXIT_CRITICAL();
 
 #if (OS_TASK_STAT_STK_CHK_EN > 0)
@@ -370,7 +404,13 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
             }
         } else {
             OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+            if (OSTCBPrioTbl[prio] == OS_TCB_RESERVED) {
+                OSTCBPrioTbl[prio] = (OS_TCB *)0;              /* Make this priority avail. to others  */
+            }
+#else
             OSTCBPrioTbl[prio] = (OS_TCB *)0;                  /* Make this priority avail. to others  */
+#endif
             OS_EXIT_CRITICAL();
         }
         return (err);
@@ -419,7 +459,7 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 #if OS_TASK_DEL_EN > 0
 INT8U  OSTaskDel (INT8U prio)
 {
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
     OS_FLAG_NODE *pnode;
 #endif
     OS_TCB       *ptcb;
@@ -445,10 +485,18 @@ INT8U  OSTaskDel (INT8U prio)
 
 /*$PAGE*/
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (prio == OS_PRIO_SELF) {                         /* See if requesting to delete self            */
+        ptcb = OSTCBCur;                                /* Yes, priority may be shared                 */
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+#else
     if (prio == OS_PRIO_SELF) {                         /* See if requesting to delete self            */
         prio = OSTCBCur->OSTCBPrio;                     /* Set priority to delete to current           */
     }
     ptcb = OSTCBPrioTbl[prio];
+#endif
     if (ptcb == (OS_TCB *)0) {                          /* Task to delete must exist                   */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
@@ -458,14 +506,23 @@ INT8U  OSTaskDel (INT8U prio)
         return (OS_ERR_TASK_DEL);
     }
 
+#if OS_SCHED_RR_EN > 0
+    OS_RdyListRemove(ptcb);                             /* Make task not ready                         */
+#else
     OSRdyTbl[ptcb->OSTCBY] &= ~ptcb->OSTCBBitX;
     if (OSRdyTbl[ptcb->OSTCBY] == 0) {                  /* Make task not ready                         */
         OSRdyGrp           &= ~ptcb->OSTCBBitY;
     }
+#endif
     
 #if (OS_EVENT_EN)
     if (ptcb->OSTCBEventPtr != (OS_EVENT *)0) {
         OS_EventTaskRemove(ptcb, ptcb->OSTCBEventPtr);  /* Remove this task from any event   wait list */
+#if OS_MUTEX_PI_EN > 0
+        if (ptcb->OSTCBEventPtr->OSEventType == OS_EVENT_TYPE_MUTEX) {
+            OS_MutexPrioUpdate((OS_TCB *)ptcb->OSTCBEventPtr->OSEventPtr);  /* Owner may inherit less  */
+        }
+#endif
     }
 #if (OS_EVENT_MULTI_EN > 0)
     if (ptcb->OSTCBEventMultiPtr != (OS_EVENT **)0) {   /* Remove this task from any events' wait lists*/
@@ -474,14 +531,14 @@ INT8U  OSTaskDel (INT8U prio)
 #endif
 #endif
 
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0)
+#if (OS_FLAG_EN > 0) && ((OS_MAX_FLAGS > 0) || (OS_OBJ_STATIC_EN > 0))
     pnode = ptcb->OSTCBFlagNode;
     if (pnode != (OS_FLAG_NODE *)0) {                   /* If task is waiting on event flag            */
         OS_FlagUnlink(pnode);                           /* Remove from wait list                       */
     }
 #endif
 
-    ptcb->OSTCBDly      = 0;                            /* Prevent OSTimeTick() from updating          */
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from updating          */
     ptcb->OSTCBStat     = OS_STAT_RDY;                  /* Prevent task from being resumed             */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
     if (OSLockNesting < 255u) {                         /* Make sure we don't context switch           */
@@ -495,7 +552,11 @@ INT8U  OSTaskDel (INT8U prio)
     }
     OSTaskDelHook(ptcb);                                /* Call user defined hook                      */
     OSTaskCtr--;                                        /* One less task being managed                 */
+#if OS_SCHED_RR_EN > 0
+    OS_PrioListRemove(ptcb);                            /* Clear old priority entry                    */
+#else
     OSTCBPrioTbl[prio] = (OS_TCB *)0;                   /* Clear old priority entry                    */
+#endif
     if (ptcb->OSTCBPrev == (OS_TCB *)0) {               /* Remove from TCB chain                       */
         ptcb->OSTCBNext->OSTCBPrev = (OS_TCB *)0;
         OSTCBList                  = ptcb->OSTCBNext;
@@ -662,10 +723,18 @@ INT8U  OSTaskNameGet (INT8U prio, INT8U *pname, INT8U *perr)
         return (0);
     }
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (prio == OS_PRIO_SELF) {                          /* See if caller desires it's own name        */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+#else
     if (prio == OS_PRIO_SELF) {                          /* See if caller desires it's own name        */
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#endif
     if (ptcb == (OS_TCB *)0) {                           /* Does task exist?                           */
         OS_EXIT_CRITICAL();                              /* No                                         */
         *perr = OS_ERR_TASK_NOT_EXIST;
@@ -741,10 +810,18 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
         return;
     }
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (prio == OS_PRIO_SELF) {                      /* See if caller desires to set it's own name     */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+#else
     if (prio == OS_PRIO_SELF) {                      /* See if caller desires to set it's own name     */
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#endif
     if (ptcb == (OS_TCB *)0) {                       /* Does task exist?                               */
         OS_EXIT_CRITICAL();                          /* No                                             */
         *perr = OS_ERR_TASK_NOT_EXIST;
@@ -815,8 +892,12 @@ INT8U  OSTaskResume (INT8U prio)
         ptcb->OSTCBStat &= ~(INT8U)OS_STAT_SUSPEND;           /* Remove suspension                     */
         if (ptcb->OSTCBStat == OS_STAT_RDY) {                 /* See if task is now ready              */
             if (ptcb->OSTCBDly == 0) {
+#if OS_SCHED_RR_EN > 0
+                OS_RdyListInsert(ptcb);                       /* Yes, Make task ready to run           */
+#else
                 OSRdyGrp               |= ptcb->OSTCBBitY;    /* Yes, Make task ready to run           */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
                 OS_EXIT_CRITICAL();
                 if (OSRunning == OS_TRUE) {
                     OS_Sched();                               /* Find new highest priority task        */
@@ -879,10 +960,18 @@ INT8U  OSTaskStkChk (INT8U prio, OS_STK_DATA *p_stk_data)
     p_stk_data->OSFree = 0;                            /* Assume failure, set to 0 size                */
     p_stk_data->OSUsed = 0;
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (prio == OS_PRIO_SELF) {                        /* See if check for SELF                        */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+#else
     if (prio == OS_PRIO_SELF) {                        /* See if check for SELF                        */
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#endif
     if (ptcb == (OS_TCB *)0) {                         /* Make sure task exist                         */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
@@ -942,7 +1031,9 @@ INT8U  OSTaskSuspend (INT8U prio)
 {
     BOOLEAN    self;
     OS_TCB    *ptcb;
+#if OS_SCHED_RR_EN == 0
     INT8U      y;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -960,6 +1051,14 @@ INT8U  OSTaskSuspend (INT8U prio)
     }
 #endif
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (prio == OS_PRIO_SELF) {                                 /* See if suspend SELF                 */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    self = (BOOLEAN)(ptcb == OSTCBCur);                         /* Priority may be shared              */
+#else
     if (prio == OS_PRIO_SELF) {                                 /* See if suspend SELF                 */
         prio = OSTCBCur->OSTCBPrio;
         self = OS_TRUE;
@@ -969,6 +1068,7 @@ INT8U  OSTaskSuspend (INT8U prio)
         self = OS_FALSE;                                        /* No suspending another task          */
     }
     ptcb = OSTCBPrioTbl[prio];
+#endif
     if (ptcb == (OS_TCB *)0) {                                  /* Task to suspend must exist          */
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_SUSPEND_PRIO);
@@ -977,11 +1077,15 @@ INT8U  OSTaskSuspend (INT8U prio)
         OS_EXIT_CRITICAL();
         return (OS_ERR_TASK_NOT_EXIST);
     }
+#if OS_SCHED_RR_EN > 0
+    OS_RdyListRemove(ptcb);                                     /* Make task not ready                 */
+#else
     y            = ptcb->OSTCBY;
     OSRdyTbl[y] &= ~ptcb->OSTCBBitX;                            /* Make task not ready                 */
     if (OSRdyTbl[y] == 0) {
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
+#endif
     ptcb->OSTCBStat |= OS_STAT_SUSPEND;                         /* Status of task is 'SUSPENDED'       */
     OS_EXIT_CRITICAL();
     if (self == OS_TRUE) {                                      /* Context switch only if SELF         */
@@ -993,6 +1097,601 @@ INT8U  OSTaskSuspend (INT8U prio)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                        SET THE TIME SLICE OF A TASK
+*
+* Description: This function sets the number of clock ticks a task runs before the next ready task of the
+*              same priority gets the CPU.  The time slice only matters when other tasks share the
+*              priority of the task.
+*
+* Arguments  : prio         is the priority of the task.  Specify OS_PRIO_SELF to set the time slice of the
+*                           calling task.
+*
+*              quantum      is the time slice in clock ticks.  0 selects the default, OS_SCHED_RR_QUANTUM.
+*
+* Returns    : OS_ERR_NONE            if the call was successful
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if there is no task at this priority or it is assigned to a Mutex PIP
+*
+* Note(s)    : 1) When several tasks share 'prio', the time slice of the first one created is set.  A task
+*                 sets its own time slice with OS_PRIO_SELF.
+*              2) What is left of the current time slice is cut down to the new time slice.
+*********************************************************************************************************
+*/
+
+#if OS_SCHED_RR_EN > 0
+INT8U  OSTaskQuantumSet (INT8U prio, INT16U quantum)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                 /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    if (quantum == 0) {                          /* Use the default time slice                         */
+        quantum = OS_SCHED_RR_QUANTUM;
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if setting SELF                                */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    ptcb->OSTCBQuantum = quantum;
+    if (ptcb->OSTCBQuantumCtr > quantum) {       /* Current slice must not outlast the new one         */
+        ptcb->OSTCBQuantumCtr = quantum;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   SET THE PREEMPTION THRESHOLD OF A TASK
+*
+* Description: This function sets the preemption threshold of a task.  While the task runs, only tasks with
+*              a priority higher than the threshold (i.e. a lower number) can preempt it.  Tasks at or below
+*              the threshold wait until the task blocks, suspends itself or yields.  Giving a group of
+*              cooperating tasks the threshold of the highest priority task in the group stops them from
+*              preempting each other, which saves the context switches and lets them share a stack.
+*
+* Arguments  : prio         is the priority of the task.  Specify OS_PRIO_SELF to set the threshold of the
+*                           calling task.
+*
+*              thresh       is the new threshold.  It must not be lower than the priority of the task (i.e.
+*                           a larger number).  Setting it to the priority of the task turns the threshold
+*                           off, which is also the default when the task is created.
+*
+* Returns    : OS_ERR_NONE            if the call was successful
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_THRESH_INVALID  if 'thresh' is a lower priority than the task (i.e. a larger number)
+*              OS_ERR_TASK_NOT_EXIST  if there is no task at this priority or it is assigned to a Mutex PIP
+*
+* Note(s)    : 1) The threshold used is the higher of 'thresh' and the current priority of the task, so a
+*                 task whose priority was raised by a mutex can still be preempted as the mutex requires.
+*              2) A task with a threshold above its priority is not time sliced (see OS_SCHED_RR_EN).
+*              3) Lowering the threshold of the running task lets the tasks it was holding off run now.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PREEMPT_THRESH_EN > 0
+INT8U  OSTaskPreemptThreshSet (INT8U prio, INT8U thresh)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                 /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if setting SELF                                */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (thresh > ptcb->OSTCBPrio) {              /* Threshold can't be below the task's priority       */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_THRESH_INVALID);
+    }
+    ptcb->OSTCBPrioThresh = thresh;
+    OS_EXIT_CRITICAL();
+    if (OSRunning == OS_TRUE) {
+        OS_Sched();                              /* Held off tasks may now preempt the current task    */
+    }
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    PEND ON THE TASK'S OWN SEMAPHORE
+*
+* Description: This function waits for the calling task's own semaphore to be signaled by OSTaskSemPost().
+*              Each task has a counting semaphore in its OS_TCB, so no OS_EVENT is needed when only one task
+*              ever waits for the signal.
+*
+* Arguments  : timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for the signal up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever or, until the
+*                            semaphore is signaled.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and the semaphore was signaled.
+*                            OS_ERR_TIMEOUT      The semaphore was not signaled within the specified
+*                                                'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait was aborted by OSTaskSemPendAbort().
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : none
+*********************************************************************************************************
+*/
+
+#if OS_TASK_SEM_EN > 0
+void  OSTaskSemPend (OS_TICK timeout, INT8U *perr)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return;
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return;
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur->OSTCBSemCtr > 0) {                  /* Already signaled, consume one signal          */
+        OSTCBCur->OSTCBSemCtr--;
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return;
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return;
+    }
+    OS_TaskSigWait(OS_STAT_TASK | OS_STAT_SEM, timeout);  /* Wait for OSTaskSemPost() or timeout       */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready         */
+    OS_ENTER_CRITICAL();
+    switch (OSTCBCur->OSTCBStatPend) {                /* See if we timed-out or aborted                */
+        case OS_STAT_PEND_OK:                         /* The signal was handed over by OSTaskSemPost() */
+             *perr = OS_ERR_NONE;
+             break;
+
+        case OS_STAT_PEND_ABORT:
+             *perr = OS_ERR_PEND_ABORT;               /* Indicate that we aborted                      */
+             break;
+
+        case OS_STAT_PEND_TO:
+        default:
+             *perr = OS_ERR_TIMEOUT;                  /* Indicate that we didn't get signal within TO  */
+             break;
+    }
+    OSTCBCur->OSTCBStat     = OS_STAT_RDY;            /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend = OS_STAT_PEND_OK;        /* Clear pend  status                            */
+    OS_EXIT_CRITICAL();
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 ABORT WAITING ON A TASK'S OWN SEMAPHORE
+*
+* Description: This function aborts and readies a task waiting in OSTaskSemPend().  This function should
+*              be used to fault-abort the wait rather than to normally signal the semaphore via
+*              OSTaskSemPost().
+*
+* Arguments  : prio          is the priority of the task whose wait is to be aborted.
+*
+* Returns    : OS_ERR_PEND_ABORT      The task was waiting and was readied, OSTaskSemPend() returns
+*                                     OS_ERR_PEND_ABORT.
+*              OS_ERR_NONE            The task was not waiting in OSTaskSemPend().
+*              OS_ERR_PRIO_INVALID    If the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO).
+*              OS_ERR_TASK_NOT_EXIST  If there is no task at this priority or it is assigned to a Mutex PIP
+*********************************************************************************************************
+*/
+
+#if OS_TASK_SEM_EN > 0
+INT8U  OSTaskSemPendAbort (INT8U prio)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                      /* Task priority valid ?                         */
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if ((ptcb->OSTCBStat & (OS_STAT_TASK | OS_STAT_SEM)) == (OS_STAT_TASK | OS_STAT_SEM)) {
+        OS_TaskSigRdy(ptcb, OS_STAT_PEND_ABORT);      /* Task is waiting, ready it without a signal    */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find HPT ready to run                         */
+        return (OS_ERR_PEND_ABORT);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);                             /* Task not waiting on its semaphore             */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      SIGNAL A TASK'S OWN SEMAPHORE
+*
+* Description: This function signals the semaphore of a task.  If the task is waiting in OSTaskSemPend(),
+*              it is made ready to run; otherwise the count of its semaphore is incremented.  The work done
+*              does not depend on the number of tasks, so this function can be called from an ISR even when
+*              OS_ISR_POST_DEFERRED_EN is 1.
+*
+* Arguments  : prio          is the priority of the task to signal.
+*
+* Returns    : OS_ERR_NONE            The call was successful and the semaphore was signaled.
+*              OS_ERR_SEM_OVF         If the semaphore count exceeded its limit.
+*              OS_ERR_PRIO_INVALID    If the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO).
+*              OS_ERR_TASK_NOT_EXIST  If there is no task at this priority or it is assigned to a Mutex PIP
+*
+* Note(s)    : 1) When several tasks share 'prio' (see OS_SCHED_RR_EN), the first one created is signaled.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_SEM_EN > 0
+INT8U  OSTaskSemPost (INT8U prio)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                      /* Task priority valid ?                         */
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if ((ptcb->OSTCBStat & (OS_STAT_TASK | OS_STAT_SEM)) == (OS_STAT_TASK | OS_STAT_SEM)) {
+        OS_TaskSigRdy(ptcb, OS_STAT_PEND_OK);         /* Task is waiting, hand the signal over         */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find HPT ready to run                         */
+        return (OS_ERR_NONE);
+    }
+    if (ptcb->OSTCBSemCtr < 65535u) {                 /* Make sure semaphore will not overflow         */
+        ptcb->OSTCBSemCtr++;                          /* Increment semaphore count to register signal  */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+    OS_EXIT_CRITICAL();                               /* Semaphore value has reached its maximum       */
+    return (OS_ERR_SEM_OVF);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  PEND ON THE TASK'S OWN MESSAGE SLOT
+*
+* Description: This function waits for a message to be sent to the calling task with OSTaskMsgPost().  Each
+*              task has a single message slot in its OS_TCB, which behaves like a mailbox that only this
+*              task reads.
+*
+* Arguments  : timeout       is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                            wait for a message up to the amount of time specified by this argument.
+*                            If you specify 0, however, your task will wait forever or, until a message
+*                            arrives.
+*
+*              perr          is a pointer to where an error message will be deposited.  Possible error
+*                            messages are:
+*
+*                            OS_ERR_NONE         The call was successful and your task received a
+*                                                message.
+*                            OS_ERR_TIMEOUT      A message was not received within the specified 'timeout'.
+*                            OS_ERR_PEND_ABORT   The wait was aborted by OSTaskMsgPendAbort().
+*                            OS_ERR_PEND_ISR     If you called this function from an ISR and the result
+*                                                would lead to a suspension.
+*                            OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked
+*
+* Returns    : != (void *)0  is a pointer to the message received
+*              == (void *)0  if no message was received or,
+*                            if you didn't pass a proper pointer to the error code.
+*
+* Note(s)    : 1) The slot is emptied when the message is received, so another one can be posted.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_MSG_EN > 0
+void  *OSTaskMsgPend (OS_TICK timeout, INT8U *perr)
+{
+    void      *pmsg;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return ((void *)0);
+    }
+    OS_ENTER_CRITICAL();
+    pmsg = OSTCBCur->OSTCBMsgSlot;
+    if (pmsg != (void *)0) {                          /* See if there is already a message             */
+        OSTCBCur->OSTCBMsgSlot = (void *)0;           /* Yes, empty the slot                           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_NONE;
+        return (pmsg);                                /* Return the message received                   */
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return ((void *)0);
+    }
+    OS_TaskSigWait(OS_STAT_TASK | OS_STAT_MBOX, timeout); /* Wait for OSTaskMsgPost() or timeout       */
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                       /* Find next highest priority task ready to run  */
+    OS_ENTER_CRITICAL();
+    pmsg                   = OSTCBCur->OSTCBMsgSlot;  /* Message left by OSTaskMsgPost() or, posted    */
+    OSTCBCur->OSTCBMsgSlot = (void *)0;               /* ... after the timeout but before we ran       */
+    if (pmsg != (void *)0) {
+        *perr = OS_ERR_NONE;
+    } else if (OSTCBCur->OSTCBStatPend == OS_STAT_PEND_ABORT) {
+        *perr = OS_ERR_PEND_ABORT;                    /* Indicate that we aborted                      */
+    } else {
+        *perr = OS_ERR_TIMEOUT;                       /* Indicate that we didn't get msg within TO     */
+    }
+    OSTCBCur->OSTCBStat     = OS_STAT_RDY;            /* Set   task  status to ready                   */
+    OSTCBCur->OSTCBStatPend = OS_STAT_PEND_OK;        /* Clear pend  status                            */
+    OS_EXIT_CRITICAL();
+    return (pmsg);                                    /* Return received message                       */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                               ABORT WAITING ON A TASK'S OWN MESSAGE SLOT
+*
+* Description: This function aborts and readies a task waiting in OSTaskMsgPend().  This function should
+*              be used to fault-abort the wait rather than to normally send a message via
+*              OSTaskMsgPost().
+*
+* Arguments  : prio          is the priority of the task whose wait is to be aborted.
+*
+* Returns    : OS_ERR_PEND_ABORT      The task was waiting and was readied, OSTaskMsgPend() returns
+*                                     OS_ERR_PEND_ABORT.
+*              OS_ERR_NONE            The task was not waiting in OSTaskMsgPend().
+*              OS_ERR_PRIO_INVALID    If the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO).
+*              OS_ERR_TASK_NOT_EXIST  If there is no task at this priority or it is assigned to a Mutex PIP
+*********************************************************************************************************
+*/
+
+#if OS_TASK_MSG_EN > 0
+INT8U  OSTaskMsgPendAbort (INT8U prio)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                      /* Task priority valid ?                         */
+        return (OS_ERR_PRIO_INVALID);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if ((ptcb->OSTCBStat & (OS_STAT_TASK | OS_STAT_MBOX)) == (OS_STAT_TASK | OS_STAT_MBOX)) {
+        OS_TaskSigRdy(ptcb, OS_STAT_PEND_ABORT);      /* Task is waiting, ready it without a message   */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find HPT ready to run                         */
+        return (OS_ERR_PEND_ABORT);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);                             /* Task not waiting for a message                */
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       SEND A MESSAGE TO A TASK
+*
+* Description: This function puts a message in the message slot of a task.  If the task is waiting in
+*              OSTaskMsgPend(), it is made ready to run.  The work done does not depend on the number of
+*              tasks, so this function can be called from an ISR even when OS_ISR_POST_DEFERRED_EN is 1.
+*
+* Arguments  : prio          is the priority of the task to send the message to.
+*
+*              pmsg          is a pointer to the message to send.  You MUST NOT send a NULL pointer.
+*
+* Returns    : OS_ERR_NONE            The call was successful and the message was sent
+*              OS_ERR_MBOX_FULL       If the slot already holds a message the task has not received yet.
+*              OS_ERR_POST_NULL_PTR   If you are attempting to post a NULL pointer
+*              OS_ERR_PRIO_INVALID    If the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO).
+*              OS_ERR_TASK_NOT_EXIST  If there is no task at this priority or it is assigned to a Mutex PIP
+*
+* Note(s)    : 1) When several tasks share 'prio' (see OS_SCHED_RR_EN), the first one created gets the
+*                 message.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_MSG_EN > 0
+INT8U  OSTaskMsgPost (INT8U prio, void *pmsg)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                      /* Task priority valid ?                         */
+        return (OS_ERR_PRIO_INVALID);
+    }
+    if (pmsg == (void *)0) {                          /* Make sure we are not posting a NULL pointer   */
+        return (OS_ERR_POST_NULL_PTR);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    ptcb = OSTCBPrioTbl[prio];
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    if (ptcb->OSTCBMsgSlot != (void *)0) {            /* Make sure the slot doesn't already have a msg */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_MBOX_FULL);
+    }
+    ptcb->OSTCBMsgSlot = pmsg;                        /* Place message in the slot                     */
+    if ((ptcb->OSTCBStat & (OS_STAT_TASK | OS_STAT_MBOX)) == (OS_STAT_TASK | OS_STAT_MBOX)) {
+        OS_TaskSigRdy(ptcb, OS_STAT_PEND_OK);         /* Task is waiting, it takes the message         */
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find highest priority task ready to run       */
+        return (OS_ERR_NONE);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          PROFILE A TASK
+*
+* Description: This function returns how much of the CPU a task used, as measured at each context switch
+*              and ISR entry/exit with the timestamp counter of the port (see OSCPUTsGet()).
+*
+* Arguments  : prio            is the priority of the task to profile.  If you specify OS_PRIO_SELF, the
+*                              calling task is profiled.
+*
+*              p_profile_data  is a pointer to where the profiling data will be stored:
+*
+*                              OSCtxSwCtr     number of times the task was switched in
+*                              OSCyclesTot    timestamp counts the task ran for, in total
+*                              OSCyclesMax    longest time the task ran before being switched out
+*                              OSCPUUsage     CPU usage of the task, in 0.01 % units
+*                              OSIntCPUUsage  CPU usage of all ISRs, in 0.01 % units
+*                              OSTsFreq       frequency of the timestamp counter, in Hz
+*
+* Returns    : OS_ERR_NONE            if the call was successful
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_TASK_NOT_EXIST  if the desired task has not been created or is assigned to a Mutex PIP
+*              OS_ERR_PDATA_NULL      if 'p_profile_data' is a NULL pointer
+*
+* Note(s)    : 1) The CPU usages are computed by the statistic task over its last period.  They stay at 0
+*                 when OS_TASK_STAT_EN is 0.
+*              2) Time spent in ISRs is not charged to the interrupted task.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+INT8U  OSTaskProfileGet (INT8U prio, OS_PROFILE_DATA *p_profile_data)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                 /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_profile_data == (OS_PROFILE_DATA *)0) {    /* Validate 'p_profile_data'                      */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                  /* See if profiling SELF                              */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    p_profile_data->OSCtxSwCtr    = ptcb->OSTCBCtxSwCtr;
+    p_profile_data->OSCyclesTot   = ptcb->OSTCBCyclesTot;
+    p_profile_data->OSCyclesMax   = ptcb->OSTCBCyclesMax;
+    p_profile_data->OSCPUUsage    = ptcb->OSTCBCPUUsage;
+    p_profile_data->OSIntCPUUsage = OSIntCPUUsage;
+    OS_EXIT_CRITICAL();
+    p_profile_data->OSTsFreq      = OSCPUTsFreq();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            QUERY A TASK
 *
 * Description: This function is called to obtain a copy of the desired task's TCB.
@@ -1007,6 +1706,9 @@ INT8U  OSTaskSuspend (INT8U prio)
 *              OS_ERR_PRIO            if the desired task has not been created
 *              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP
 *              OS_ERR_PDATA_NULL      if 'p_task_data' is a NULL pointer
+*
+* Note(s)    : 1) The copy's OSTCBDly holds the ticks left before the delay or timeout expires.  The TCB
+*                 itself only records the delay it was started with, since the tick list times it.
 *********************************************************************************************************
 */
 
@@ -1031,10 +1733,18 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
     }
 #endif
     OS_ENTER_CRITICAL();
+#if OS_SCHED_RR_EN > 0
+    if (prio == OS_PRIO_SELF) {                  /* See if suspend SELF                                */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+#else
     if (prio == OS_PRIO_SELF) {                  /* See if suspend SELF                                */
         prio = OSTCBCur->OSTCBPrio;
     }
     ptcb = OSTCBPrioTbl[prio];
+#endif
     if (ptcb == (OS_TCB *)0) {                   /* Task to query must exist                           */
         OS_EXIT_CRITICAL();
         return (OS_ERR_PRIO);
@@ -1045,6 +1755,7 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
     }
                                                  /* Copy TCB into user storage area                    */
     OS_MemCopy((INT8U *)p_task_data, (INT8U *)ptcb, sizeof(OS_TCB));
+    p_task_data->OSTCBDly = OS_TickListRemain(ptcb);
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -1093,3 +1804,79 @@ void  OS_TaskStkClr (OS_STK *pbos, INT32U size, INT16U opt)
 }
 
 #endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 READY A TASK WAITING FOR ITS OWN SIGNAL
+*
+* Description: This function is called by the post and pend abort functions to ready a task waiting in
+*              OSTaskSemPend() or OSTaskMsgPend().  Unlike OS_EventTaskRdy(), there is no wait list to search.
+*
+* Arguments  : ptcb       is a pointer to the OS_TCB of the waiting task
+*
+*              pend_stat  is OS_STAT_PEND_OK for a post, or OS_STAT_PEND_ABORT
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+#if (OS_TASK_SEM_EN > 0) || (OS_TASK_MSG_EN > 0)
+void  OS_TaskSigRdy (OS_TCB *ptcb, INT8U pend_stat)
+{
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
+    ptcb->OSTCBStat      &= ~(INT8U)(OS_STAT_TASK | OS_STAT_SEM | OS_STAT_MBOX);
+    ptcb->OSTCBStatPend   =  pend_stat;                 /* Signal given or aborted                     */
+                                                        /* See if task is ready (could be susp'd)      */
+    if ((ptcb->OSTCBStat &   OS_STAT_SUSPEND) == OS_STAT_RDY) {
+#if (OS_SCHED_RR_EN > 0)
+        OS_RdyListInsert(ptcb);                         /* Put task in the ready to run list           */
+#else
+        OSRdyGrp               |= ptcb->OSTCBBitY;      /* Put task in the ready to run list           */
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              MAKE TASK WAIT FOR ITS OWN SIGNAL TO OCCUR
+*
+* Description: This function is called by OSTaskSemPend() and OSTaskMsgPend() to suspend the current task
+*              until OS_TaskSigRdy() readies it or, the timeout expires.
+*
+* Arguments  : stat     is OS_STAT_TASK together with OS_STAT_SEM or OS_STAT_MBOX, telling which post
+*                       function the task waits for
+*
+*              timeout  is the timeout in clock ticks (0 to wait forever)
+*
+* Returns    : none
+*
+* Note       : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.
+*********************************************************************************************************
+*/
+#if (OS_TASK_SEM_EN > 0) || (OS_TASK_MSG_EN > 0)
+void  OS_TaskSigWait (INT8U stat, OS_TICK timeout)
+{
+#if (OS_SCHED_RR_EN == 0)
+    INT8U  y;
+#endif
+
+
+    OSTCBCur->OSTCBStat     |= stat;                  /* Signal not available, pend on it              */
+    OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB and tick list       */
+#if (OS_SCHED_RR_EN > 0)
+    OS_RdyListRemove(OSTCBCur);                       /* Task no longer ready                          */
+#else
+    y             =  OSTCBCur->OSTCBY;                /* Task no longer ready                          */
+    OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
+    if (OSRdyTbl[y] == 0) {
+        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+    }
+#endif
+}
+#endif
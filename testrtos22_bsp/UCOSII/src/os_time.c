@@ -27,7 +27,15 @@
 
 /*
 *********************************************************************************************************
-*                                DELAY TASK 'n' TICKS   (n from 0 to 65535)
+*                                           LOCAL PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeDlyCur (OS_TICK ticks);
+
+/*
+*********************************************************************************************************
+*                      DELAY TASK 'n' TICKS   (n from 0 to 65535, or 4294967295 if 32-bit)
 *
 * Description: This function is called to delay execution of the currently running task until the
 *              specified number of system ticks expires.  This, of course, directly equates to delaying
@@ -36,14 +44,14 @@
 *
 * Arguments  : ticks     is the time delay that the task will be suspended in number of clock 'ticks'.
 *                        Note that by specifying 0, the task will not be delayed.
+*                        The range of 'ticks' is set by OS_TICK_NBITS.
 *
 * Returns    : none
 *********************************************************************************************************
 */
 
-void  OSTimeDly (INT16U ticks)
+void  OSTimeDly (OS_TICK ticks)
 {
-    INT8U      y;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -55,12 +63,7 @@ void  OSTimeDly (INT16U ticks)
     }
     if (ticks > 0) {                             /* 0 means no delay!                                  */
         OS_ENTER_CRITICAL();
-        y            =  OSTCBCur->OSTCBY;        /* Delay current task                                 */
-        OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
-        if (OSRdyTbl[y] == 0) {
-            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
-        }
-        OSTCBCur->OSTCBDly = ticks;              /* Load ticks in TCB                                  */
+        OS_TimeDlyCur(ticks);                    /* Delay current task                                 */
         OS_EXIT_CRITICAL();
         OS_Sched();                              /* Find next task to run!                             */
     }
@@ -96,7 +99,9 @@ void  OSTimeDly (INT16U ticks)
 INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 {
     INT32U ticks;
+#if OS_TICK_NBITS < 32
     INT16U loops;
+#endif
 
 
     if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
@@ -126,14 +131,18 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
                                                  /* .. (rounded to the nearest tick)                   */
     ticks = ((INT32U)hours * 3600L + (INT32U)minutes * 60L + (INT32U)seconds) * OS_TICKS_PER_SEC
           + OS_TICKS_PER_SEC * ((INT32U)ms + 500L / OS_TICKS_PER_SEC) / 1000L;
+#if OS_TICK_NBITS < 32
     loops = (INT16U)(ticks >> 16);               /* Compute the integral number of 65536 tick delays   */
     ticks = ticks & 0xFFFFL;                     /* Obtain  the fractional number of ticks             */
-    OSTimeDly((INT16U)ticks);
+    OSTimeDly((OS_TICK)ticks);
     while (loops > 0) {
-        OSTimeDly((INT16U)32768u);
-        OSTimeDly((INT16U)32768u);
+        OSTimeDly((OS_TICK)32768u);
+        OSTimeDly((OS_TICK)32768u);
         loops--;
     }
+#else
+    OSTimeDly((OS_TICK)ticks);                   /* The whole delay fits in one call                   */
+#endif
     return (OS_ERR_NONE);
 }
 #endif
@@ -147,9 +156,10 @@ INT8U  OSTimeDlyHMSM (INT8U hours, INT8U minutes, INT8U seconds, INT16U ms)
 *              task that is waiting for an event with timeout.  This would make the task look
 *              like a timeout occurred.
 *
-*              Also, you cannot resume a task that has called OSTimeDlyHMSM() with a combined time that
-*              exceeds 65535 clock ticks.  In other words, if the clock tick runs at 100 Hz then, you will
-*              not be able to resume a delayed task that called OSTimeDlyHMSM(0, 10, 55, 350) or higher:
+*              Also, when OS_TICK_NBITS is 16, you cannot resume a task that has called OSTimeDlyHMSM()
+*              with a combined time that exceeds 65535 clock ticks.  In other words, if the clock tick runs
+*              at 100 Hz then, you will not be able to resume a delayed task that called
+*              OSTimeDlyHMSM(0, 10, 55, 350) or higher:
 *
 *                  (10 Minutes * 60 + 55 Seconds + 0.35) * 100 ticks/second.
 *
@@ -191,7 +201,7 @@ INT8U  OSTimeDlyResume (INT8U prio)
         return (OS_ERR_TIME_NOT_DLY);                          /* Indicate that task was not delayed   */
     }
 
-    ptcb->OSTCBDly = 0;                                        /* Clear the time delay                 */
+    OS_TickListRemove(ptcb);                                   /* Clear the time delay                 */
     if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
         ptcb->OSTCBStat     &= ~OS_STAT_PEND_ANY;              /* Yes, Clear status flag               */
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_TO;               /* Indicate PEND timeout                */
@@ -199,8 +209,12 @@ INT8U  OSTimeDlyResume (INT8U prio)
         ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
     }
     if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                   */
+#if OS_SCHED_RR_EN > 0
+        OS_RdyListInsert(ptcb);                                /* No,  Make ready                      */
+#else
         OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                      */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#endif
         OS_EXIT_CRITICAL();
         OS_Sched();                                            /* See if this is new highest priority  */
     } else {
@@ -266,3 +280,205 @@ void  OSTimeSet (INT32U ticks)
     OS_EXIT_CRITICAL();
 }
 #endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     DELAY TASK UNTIL AN ABSOLUTE TIME
+*
+* Description: This function is called to delay execution of the currently running task until OSTime
+*              reaches 'time'.  Unlike OSTimeDly(), the wake-up does not depend on when the call is
+*              made, so a task can run at a fixed rate whatever the time spent between two calls.
+*
+* Arguments  : time      is the value of OSTime at which the task is to be made ready.  It must be less
+*                        than 2^31 ticks in the future; comparisons are done modulo 2^32 so OSTime may
+*                        wrap around in between.
+*
+* Returns    : OS_ERR_NONE          the task was delayed until 'time'
+*              OS_ERR_TIME_PAST     'time' has already been reached, the task was not delayed
+*              OS_ERR_TIME_DLY_ISR  if called from an ISR
+*
+* Note(s)    : 1) OSTimeSet() moves the deadline along with OSTime.
+*              2) When OS_TICK_NBITS is 16, a delay of more than 65535 ticks is made of several delays,
+*                 and OSTimeDlyResume() only ends the current one.
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT8U  OSTimeDlyUntil (INT32U time)
+{
+    INT32S     dly;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    OS_ENTER_CRITICAL();                         /* Read OSTime and delay atomically, so that a tick   */
+    dly = (INT32S)(time - OSTime);               /* ... can't expire the deadline in between           */
+    if (dly <= 0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TIME_PAST);
+    }
+#if OS_TICK_NBITS < 32
+    while (dly > 65535L) {                       /* Wait in steps that fit in an OS_TICK               */
+        OS_TimeDlyCur((OS_TICK)65535u);
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+        OS_ENTER_CRITICAL();
+        dly = (INT32S)(time - OSTime);
+    }
+    if (dly <= 0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_NONE);
+    }
+#endif
+    OS_TimeDlyCur((OS_TICK)dly);
+    OS_EXIT_CRITICAL();
+    OS_Sched();                                  /* Find next task to run!                             */
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       INITIALIZE A PERIODIC ACTIVATION
+*
+* Description: This function is called by a periodic task, before its loop, to set up the OS_PERIOD used
+*              by OSTimePeriodWait().  The first activation is 'ticks' ticks after this call.
+*
+* Arguments  : pperiod   is a pointer to the OS_PERIOD to initialize, usually a local of the task.
+*
+*              ticks     is the period, in ticks.
+*
+* Returns    : OS_ERR_NONE          if the call was successful
+*              OS_ERR_PDATA_NULL    if 'pperiod' is a NULL pointer
+*              OS_ERR_TIME_ZERO_DLY if 'ticks' is 0
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT8U  OSTimePeriodInit (OS_PERIOD *pperiod, INT32U ticks)
+{
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pperiod == (OS_PERIOD *)0) {             /* Validate 'pperiod'                                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+    if (ticks == 0) {
+        return (OS_ERR_TIME_ZERO_DLY);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    pperiod->OSPeriodNext     = OSTime + ticks;
+    OS_EXIT_CRITICAL();
+    pperiod->OSPeriodTicks    = ticks;
+    pperiod->OSPeriodOverruns = 0;
+    pperiod->OSPeriodMissed   = 0;
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      WAIT FOR THE NEXT PERIODIC ACTIVATION
+*
+* Description: This function is called at the end of each iteration of a periodic task to wait for its
+*              next activation.  Activations are at fixed multiples of the period from the one set by
+*              OSTimePeriodInit(), so the rate does not drift with the time spent in the task.
+*
+*              If the task calls this function after its next activation is due (an overrun), it is not
+*              delayed and runs the latest activation due right away.  The activations that were due
+*              before that one are skipped and counted in '.OSPeriodMissed'.
+*
+* Arguments  : pperiod   is a pointer to the OS_PERIOD set up by OSTimePeriodInit().
+*
+* Returns    : OS_ERR_NONE          the task was delayed until its next activation
+*              OS_ERR_TIME_OVERRUN  the activation was already due, '.OSPeriodOverruns' was incremented
+*              OS_ERR_PDATA_NULL    if 'pperiod' is a NULL pointer
+*              OS_ERR_TIME_DLY_ISR  if called from an ISR
+*********************************************************************************************************
+*/
+
+#if OS_TIME_DLY_UNTIL_EN > 0
+INT8U  OSTimePeriodWait (OS_PERIOD *pperiod)
+{
+    INT32U     next;
+    INT32U     missed;
+    INT32S     late;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pperiod == (OS_PERIOD *)0) {             /* Validate 'pperiod'                                 */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    OS_ENTER_CRITICAL();
+    next = pperiod->OSPeriodNext;
+    late = (INT32S)(OSTime - next);
+    if (late <= 0) {                             /* On time, wait for the activation                   */
+        pperiod->OSPeriodNext = next + pperiod->OSPeriodTicks;
+        OS_EXIT_CRITICAL();
+        err = OSTimeDlyUntil(next);
+        if (err == OS_ERR_TIME_PAST) {           /* Reached in between, no need to wait                */
+            err = OS_ERR_NONE;
+        }
+        return (err);
+    }
+    missed                    = (INT32U)late / pperiod->OSPeriodTicks;
+    pperiod->OSPeriodNext     = next + (missed + 1) * pperiod->OSPeriodTicks;
+    pperiod->OSPeriodOverruns++;
+    pperiod->OSPeriodMissed  += missed;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_TIME_OVERRUN);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        DELAY THE CURRENT TASK
+*
+* Description: This function removes the current task from the ready list and places it in the tick list
+*              for 'ticks' ticks.
+*
+* Arguments  : ticks     is the number of ticks to wait (must not be 0).
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are assumed to be disabled when this function is called.  The caller must
+*                 call OS_Sched() once interrupts are enabled again.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeDlyCur (OS_TICK ticks)
+{
+#if OS_SCHED_RR_EN == 0
+    INT8U  y;
+
+
+    y            =  OSTCBCur->OSTCBY;
+    OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
+    if (OSRdyTbl[y] == 0) {
+        OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+    }
+#else
+    OS_RdyListRemove(OSTCBCur);
+#endif
+    OS_TickListInsert(OSTCBCur, ticks);          /* Load ticks in TCB and insert in tick list          */
+}
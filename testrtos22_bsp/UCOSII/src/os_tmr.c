@@ -33,7 +33,12 @@
 *    OS_TASK_TMR_PRIO          The priority of the Timer management task
 *    OS_TASK_TMR_STK_SIZE      The size     of the Timer management task's stack
 *
-* 2) You must call OSTmrSignal() to notify the Timer management task that it's time to update the timers.
+* 2) The Timer management task is signaled every OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC ticks by a node of the
+*    port's tick list, OSTmrTickNode, which shares the list with the task delays (and on Nios II with the HAL alarms).
+*    The node only runs while a timer is running, so it doesn't keep a tickless system awake.
+*    OS_TMR_CFG_TICKS_PER_SEC == OS_TICKS_PER_SEC gives the timers the resolution of the kernel tick; the timer wheel
+*    keeps the cost of each update to the timers that expire.  The application must no longer call OSTmrSignal() from
+*    OSTimeTickHook().
 ************************************************************************************************************************
 */
 
@@ -45,6 +50,39 @@
 
 #define  OS_TMR_LINK_DLY       0
 #define  OS_TMR_LINK_PERIODIC  1
+#define  OS_TMR_LINK_CASCADE   2
+
+#define  OS_TMR_ALARM_TICKS    (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)  /* Kernel ticks per timer tick           */
+
+#if OS_TMR_EN > 0
+#if   OS_TMR_CFG_WHEEL_SIZE ==    2                     /* Number of bits of OSTmrTime indexing each wheel level     */
+#define  OS_TMR_WHEEL_BITS     1
+#elif OS_TMR_CFG_WHEEL_SIZE ==    4
+#define  OS_TMR_WHEEL_BITS     2
+#elif OS_TMR_CFG_WHEEL_SIZE ==    8
+#define  OS_TMR_WHEEL_BITS     3
+#elif OS_TMR_CFG_WHEEL_SIZE ==   16
+#define  OS_TMR_WHEEL_BITS     4
+#elif OS_TMR_CFG_WHEEL_SIZE ==   32
+#define  OS_TMR_WHEEL_BITS     5
+#elif OS_TMR_CFG_WHEEL_SIZE ==   64
+#define  OS_TMR_WHEEL_BITS     6
+#elif OS_TMR_CFG_WHEEL_SIZE ==  128
+#define  OS_TMR_WHEEL_BITS     7
+#elif OS_TMR_CFG_WHEEL_SIZE ==  256
+#define  OS_TMR_WHEEL_BITS     8
+#elif OS_TMR_CFG_WHEEL_SIZE ==  512
+#define  OS_TMR_WHEEL_BITS     9
+#else
+#define  OS_TMR_WHEEL_BITS    10
+#endif
+
+#define  OS_TMR_WHEEL_MASK    ((INT32U)OS_TMR_CFG_WHEEL_SIZE - 1)
+
+#if (OS_TMR_WHEEL_BITS * (OS_TMR_CFG_WHEEL_LVLS - 1)) > 31
+#error  "OS_CFG.H, OS_TMR_CFG_WHEEL_LVLS is too large: the levels above 0 would index past the 32 bits of OSTmrTime"
+#endif
+#endif
 
 /*
 ************************************************************************************************************************
@@ -53,14 +91,24 @@
 */
 
 #if OS_TMR_EN > 0
+#if OS_TMR_CFG_MAX > 0
 static  OS_TMR  *OSTmr_Alloc         (void);
+#endif
 static  void     OSTmr_Free          (OS_TMR *ptmr);
 static  void     OSTmr_InitTask      (void);
 static  void     OSTmr_Link          (OS_TMR *ptmr, INT8U type);
 static  void     OSTmr_Unlink        (OS_TMR *ptmr);
+static  void     OSTmr_Cascade       (OS_TMR_WHEEL *pspoke);
 static  void     OSTmr_Lock          (void);
 static  void     OSTmr_Unlock        (void);
 static  void     OSTmr_Task          (void   *p_arg);
+static  INT32U  OSTmr_TickExpire    (void   *p_arg);
+#if OS_TMR_CFG_CB_TASK_EN > 0
+static  void     OSTmr_InitCbTask    (void);
+static  void     OSTmr_CbPut         (OS_TMR *ptmr);
+static  void     OSTmr_CbRemove      (OS_TMR *ptmr);
+static  void     OSTmr_CbTask        (void   *p_arg);
+#endif
 #endif
 
 /*$PAGE*/
@@ -109,7 +157,7 @@ static  void     OSTmr_Task          (void   *p_arg);
 ************************************************************************************************************************
 */
 
-#if OS_TMR_EN > 0
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
 OS_TMR  *OSTmrCreate (INT32U           dly,
                       INT32U           period,
                       INT8U            opt,
@@ -187,6 +235,132 @@ OS_TMR  *OSTmrCreate (INT32U           dly,
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                          CREATE A TIMER IN APPLICATION STORAGE
+*
+* Description: This function is called by your application code to create a timer in an OS_TMR that it supplies
+*              instead of taking one from the OSTmrTbl[] pool.
+*
+* Arguments  : ptmr          Is a pointer to the OS_TMR to initialize.
+*
+*              dly, period, opt, callback, callback_arg and pname are as for OSTmrCreate().
+*
+*              perr          Is a pointer to an error code.  '*perr' will contain one of the following:
+*                               OS_ERR_NONE
+*                               OS_ERR_TMR_INVALID         'ptmr' is a NULL pointer
+*                               OS_ERR_TMR_INVALID_DLY     you specified an invalid delay
+*                               OS_ERR_TMR_INVALID_PERIOD  you specified an invalid period
+*                               OS_ERR_TMR_INVALID_OPT     you specified an invalid option
+*                               OS_ERR_TMR_ISR             if the call was made from an ISR
+*                               OS_ERR_TMR_NAME_TOO_LONG   if the timer name is too long to fit
+*
+* Returns    : 'ptmr', or a NULL pointer if an error was detected.
+*
+* Note(s)    : 1) 'ptmr' MUST remain valid for as long as the timer is in use and MUST NOT be a timer that is
+*                 already in use.
+*              2) OSTmrDel() does not return 'ptmr' to the pool; the application may reuse it once the timer has
+*                 been deleted.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_OBJ_STATIC_EN > 0)
+OS_TMR  *OSTmrCreateStatic (OS_TMR          *ptmr,
+                            INT32U           dly,
+                            INT32U           period,
+                            INT8U            opt,
+                            OS_TMR_CALLBACK  callback,
+                            void            *callback_arg,
+                            INT8U           *pname,
+                            INT8U           *perr)
+{
+#if OS_TMR_CFG_NAME_SIZE > 0
+    INT8U     len;
+#endif
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                               /* Validate arguments                                     */
+        return ((OS_TMR *)0);
+    }
+    if (ptmr == (OS_TMR *)0) {
+        *perr = OS_ERR_TMR_INVALID;
+        return ((OS_TMR *)0);
+    }
+    switch (opt) {
+        case OS_TMR_OPT_PERIODIC:
+             if (period == 0) {
+                 *perr = OS_ERR_TMR_INVALID_PERIOD;
+                 return ((OS_TMR *)0);
+             }
+             break;
+
+        case OS_TMR_OPT_ONE_SHOT:
+             if (dly == 0) {
+                 *perr = OS_ERR_TMR_INVALID_DLY;
+                 return ((OS_TMR *)0);
+             }
+             break;
+
+        default:
+             *perr = OS_ERR_TMR_INVALID_OPT;
+             return ((OS_TMR *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                                 /* See if trying to call from an ISR                      */
+        *perr  = OS_ERR_TMR_ISR;
+        return ((OS_TMR *)0);
+    }
+    OSTmr_Lock();
+    ptmr->OSTmrType        = OS_TMR_TYPE;
+    ptmr->OSTmrNext        = (OS_TCB *)0;
+    ptmr->OSTmrPrev        = (OS_TCB *)0;
+    ptmr->OSTmrSpoke       = (void *)0;
+    ptmr->OSTmrMatch       = 0;
+#if OS_TMR_CFG_CB_TASK_EN > 0
+    ptmr->OSTmrCbNext      = (void *)0;
+    ptmr->OSTmrCbPend      = OS_FALSE;
+    ptmr->OSTmrCbOvr       = 0;
+    ptmr->OSTmrCbLate      = 0;
+    ptmr->OSTmrCbLateMax   = 0;
+#if OS_TASK_PROFILE_EN > 0
+    ptmr->OSTmrCbCycles    = 0;
+    ptmr->OSTmrCbCyclesMax = 0;
+#endif
+#endif
+    ptmr->OSTmrState       = OS_TMR_STATE_STOPPED;          /* Indicate that timer is not running yet                 */
+    ptmr->OSTmrDly         = dly;
+    ptmr->OSTmrPeriod      = period;
+    ptmr->OSTmrOpt         = opt;
+    ptmr->OSTmrCallback    = callback;
+    ptmr->OSTmrCallbackArg = callback_arg;
+#if OS_TMR_CFG_NAME_SIZE > 1
+    ptmr->OSTmrName[0]     = '?';                           /* Unknown name                                           */
+    ptmr->OSTmrName[1]     = OS_ASCII_NUL;
+#endif
+#if OS_TMR_CFG_NAME_SIZE > 0
+    if (pname !=(INT8U *)0) {
+        len = OS_StrLen(pname);                             /* Copy timer name                                        */
+        if (len < OS_TMR_CFG_NAME_SIZE) {
+            (void)OS_StrCopy(ptmr->OSTmrName, pname);
+        } else {
+#if OS_TMR_CFG_NAME_SIZE > 1
+            ptmr->OSTmrName[0] = '#';                       /* Invalid size specified                                 */
+            ptmr->OSTmrName[1] = OS_ASCII_NUL;
+#endif
+            *perr              = OS_ERR_TMR_NAME_TOO_LONG;
+            OSTmr_Unlock();
+            return (ptmr);
+        }
+    }
+#endif
+    OSTmr_Unlock();
+    *perr = OS_ERR_NONE;
+    return (ptmr);
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -638,6 +812,9 @@ BOOLEAN  OSTmrStop (OS_TMR  *ptmr,
     switch (ptmr->OSTmrState) {
         case OS_TMR_STATE_RUNNING:
              OSTmr_Unlink(ptmr);                                  /* Remove from current wheel spoke                  */
+#if OS_TMR_CFG_CB_TASK_EN > 0
+             OSTmr_CbRemove(ptmr);                                /* Don't run a callback that is still queued        */
+#endif
              *perr = OS_ERR_NONE;
              switch (opt) {
                  case OS_TMR_OPT_CALLBACK:
@@ -692,8 +869,8 @@ BOOLEAN  OSTmrStop (OS_TMR  *ptmr,
 ************************************************************************************************************************
 *                                      SIGNAL THAT IT'S TIME TO UPDATE THE TIMERS
 *
-* Description: This function is typically called by the ISR that occurs at the timer tick rate and is used to signal to
-*              OSTmr_Task() that it's time to update the timers.
+* Description: This function is called by OSTmrTickNode at the timer tick rate and is used to signal to OSTmr_Task() that
+*              it's time to update the timers.
 *
 * Arguments  : none
 *
@@ -718,6 +895,33 @@ INT8U  OSTmrSignal (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                          SIGNAL THE TIMER TASK FROM THE TICK
+*
+* Description: This function is the callback of OSTmrTickNode.  It is called by the port, from the tick ISR, every
+*              OS_TMR_ALARM_TICKS ticks while a timer is running.
+*
+* Arguments  : p_arg         is not used.
+*
+* Returns    : the number of ticks until the next timer tick, or 0 to stop the node once no timer is running.
+*              OSTmr_Link() starts it again.
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0
+static  INT32U  OSTmr_TickExpire (void *p_arg)
+{
+    (void)p_arg;
+    (void)OSTmrSignal();                                 /* Signal even if the count just dropped, the timer task  */
+    if (OSTmrRunning == 0) {                             /* ... may be moving the timers down the wheel            */
+        return (0);
+    }
+    return (OS_TMR_ALARM_TICKS);
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -731,7 +935,7 @@ INT8U  OSTmrSignal (void)
 ************************************************************************************************************************
 */
 
-#if OS_TMR_EN > 0
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
 static  OS_TMR  *OSTmr_Alloc (void)
 {
     OS_TMR *ptmr;
@@ -756,6 +960,7 @@ static  OS_TMR  *OSTmr_Alloc (void)
 *                                             RETURN A TIMER TO THE FREE LIST
 *
 * Description: This function is called to return a timer object to the free list of timers.
+*              Timers created by OSTmrCreateStatic() are not part of OSTmrTbl[] and are only marked as unused.
 *
 * Arguments  : ptmr     is a pointer to the timer to free
 *
@@ -777,12 +982,32 @@ static  void  OSTmr_Free (OS_TMR *ptmr)
     ptmr->OSTmrName[1]     = OS_ASCII_NUL;
 #endif
 
-    ptmr->OSTmrPrev        = (OS_TCB *)0;              /* Chain timer to free list                                    */
-    ptmr->OSTmrNext        = OSTmrFreeList;
+    ptmr->OSTmrPrev        = (OS_TCB *)0;
+    ptmr->OSTmrNext        = (OS_TCB *)0;
+    ptmr->OSTmrSpoke       = (void *)0;
+#if OS_TMR_CFG_CB_TASK_EN > 0
+    OSTmr_CbRemove(ptmr);                              /* Don't run a callback that is still queued                   */
+    ptmr->OSTmrCbOvr       = 0;
+    ptmr->OSTmrCbLate      = 0;
+    ptmr->OSTmrCbLateMax   = 0;
+#if OS_TASK_PROFILE_EN > 0
+    ptmr->OSTmrCbCycles    = 0;
+    ptmr->OSTmrCbCyclesMax = 0;
+#endif
+#endif
+#if OS_TMR_CFG_MAX > 0
+#if OS_OBJ_STATIC_EN > 0
+    if ((ptmr <  &OSTmrTbl[0]) ||                      /* See if the timer is outside of the pool                     */
+        (ptmr >= &OSTmrTbl[OS_TMR_CFG_MAX])) {
+        return;
+    }
+#endif
+    ptmr->OSTmrNext        = OSTmrFreeList;            /* Chain timer to free list                                    */
     OSTmrFreeList          = ptmr;
 
     OSTmrUsed--;                                       /* Update timer object statistics                              */
     OSTmrFree++;
+#endif
 }
 #endif
 
@@ -806,13 +1031,16 @@ void  OSTmr_Init (void)
 #if OS_EVENT_NAME_SIZE > 10
     INT8U    err;
 #endif
+#if OS_TMR_CFG_MAX > 0
     INT16U   i;
     OS_TMR  *ptmr1;
     OS_TMR  *ptmr2;
+#endif
 
 
-    OS_MemClr((INT8U *)&OSTmrTbl[0],      sizeof(OSTmrTbl));            /* Clear all the TMRs                         */
     OS_MemClr((INT8U *)&OSTmrWheelTbl[0], sizeof(OSTmrWheelTbl));       /* Clear the timer wheel                      */
+#if OS_TMR_CFG_MAX > 0
+    OS_MemClr((INT8U *)&OSTmrTbl[0],      sizeof(OSTmrTbl));            /* Clear all the TMRs                         */
 
     ptmr1 = &OSTmrTbl[0];
     ptmr2 = &OSTmrTbl[1];
@@ -833,13 +1061,21 @@ void  OSTmr_Init (void)
 #if OS_TMR_CFG_NAME_SIZE > 1
     ptmr1->OSTmrName[0] = '?';                                          /* Unknown name                               */
     ptmr1->OSTmrName[1] = OS_ASCII_NUL;
+#endif
+    OSTmrFreeList       = &OSTmrTbl[0];
 #endif
     OSTmrTime           = 0;
+    OSTmrRunning        = 0;
     OSTmrUsed           = 0;
     OSTmrFree           = OS_TMR_CFG_MAX;
-    OSTmrFreeList       = &OSTmrTbl[0];
+    OS_CPU_TICK_NODE_INIT(&OSTmrTickNode, OSTmr_TickExpire, (void *)0); /* Stopped until a timer is started          */
+#if OS_OBJ_STATIC_EN > 0
+    OSTmrSem            = OSSemCreateStatic(&OSTmrSemECB,       1);     /* Keep the pool of ECBs for the application  */
+    OSTmrSemSignal      = OSSemCreateStatic(&OSTmrSemSignalECB, 0);
+#else
     OSTmrSem            = OSSemCreate(1);
     OSTmrSemSignal      = OSSemCreate(0);
+#endif
 
 #if OS_EVENT_NAME_SIZE > 18
     OSEventNameSet(OSTmrSem,       (INT8U *)"uC/OS-II TmrLock",   &err);/* Assign names to semaphores                 */
@@ -857,7 +1093,28 @@ void  OSTmr_Init (void)
 #endif
 #endif
 
+
+#if OS_TMR_CFG_CB_TASK_EN > 0
+    OSTmrCbHead         = (OS_TMR *)0;
+    OSTmrCbTail         = (OS_TMR *)0;
+#if OS_OBJ_STATIC_EN > 0
+    OSTmrSemCb          = OSSemCreateStatic(&OSTmrSemCbECB, 0);
+#else
+    OSTmrSemCb          = OSSemCreate(0);
+#endif
+#if OS_EVENT_NAME_SIZE > 18
+    OSEventNameSet(OSTmrSemCb,     (INT8U *)"uC/OS-II TmrCB",     &err);
+#else
+#if OS_EVENT_NAME_SIZE > 10
+    OSEventNameSet(OSTmrSemCb,     (INT8U *)"OS-TmrCB",           &err);
+#endif
+#endif
+#endif
+
     OSTmr_InitTask();
+#if OS_TMR_CFG_CB_TASK_EN > 0
+    OSTmr_InitCbTask();
+#endif
 }
 #endif
 
@@ -928,19 +1185,94 @@ static  void  OSTmr_InitTask (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                     INITIALIZE THE TIMER CALLBACK TASK
+*
+* Description: This function is called by OSTmrInit() to create the task that runs the callbacks of expired timers.
+*
+* Arguments  : none
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_CB_TASK_EN > 0)
+static  void  OSTmr_InitCbTask (void)
+{
+#if OS_TASK_NAME_SIZE > 8
+    INT8U  err;
+#endif
+
+
+#if OS_TASK_CREATE_EXT_EN > 0
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreateExt(OSTmr_CbTask,
+                          (void *)0,                                       /* No arguments passed to OSTmr_CbTask()   */
+                          &OSTmrCbTaskStk[OS_TASK_TMR_CB_STK_SIZE - 1],    /* Set Top-Of-Stack                        */
+                          OS_TASK_TMR_CB_PRIO,
+                          OS_TASK_TMR_CB_ID,
+                          &OSTmrCbTaskStk[0],                              /* Set Bottom-Of-Stack                     */
+                          OS_TASK_TMR_CB_STK_SIZE,
+                          (void *)0,                                       /* No TCB extension                        */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack     */
+    #else
+    (void)OSTaskCreateExt(OSTmr_CbTask,
+                          (void *)0,                                       /* No arguments passed to OSTmr_CbTask()   */
+                          &OSTmrCbTaskStk[0],                              /* Set Top-Of-Stack                        */
+                          OS_TASK_TMR_CB_PRIO,
+                          OS_TASK_TMR_CB_ID,
+                          &OSTmrCbTaskStk[OS_TASK_TMR_CB_STK_SIZE - 1],    /* Set Bottom-Of-Stack                     */
+                          OS_TASK_TMR_CB_STK_SIZE,
+                          (void *)0,                                       /* No TCB extension                        */
+                          OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);      /* Enable stack checking + clear stack     */
+    #endif
+#else
+    #if OS_STK_GROWTH == 1
+    (void)OSTaskCreate(OSTmr_CbTask,
+                       (void *)0,
+                       &OSTmrCbTaskStk[OS_TASK_TMR_CB_STK_SIZE - 1],
+                       OS_TASK_TMR_CB_PRIO);
+    #else
+    (void)OSTaskCreate(OSTmr_CbTask,
+                       (void *)0,
+                       &OSTmrCbTaskStk[0],
+                       OS_TASK_TMR_CB_PRIO);
+    #endif
+#endif
+
+#if OS_TASK_NAME_SIZE > 14
+    OSTaskNameSet(OS_TASK_TMR_CB_PRIO, (INT8U *)"uC/OS-II TmrCB", &err);
+#else
+#if OS_TASK_NAME_SIZE > 8
+    OSTaskNameSet(OS_TASK_TMR_CB_PRIO, (INT8U *)"OS-TmrCB", &err);
+#endif
+#endif
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
 *                                         INSERT A TIMER INTO THE TIMER WHEEL
 *
 * Description: This function is called to insert the timer into the timer wheel.  The timer is always inserted at the
-*              beginning of the list.
+*              beginning of the list of its spoke.
+*
+*              Level 0 of the wheel has one spoke per tick of the timer task, and each level above it has spokes
+*              OS_TMR_CFG_WHEEL_SIZE times as long.  A timer is linked into the lowest level whose range covers the
+*              time left before it expires, and is moved down a level each time its spoke is reached (see
+*              OSTmr_Cascade()), so it is only handled a few times whatever its delay.  A timer that expires
+*              beyond the range of the top level is parked in the top level spoke that is reached last and linked
+*              again from there.
 *
 * Arguments  : ptmr          Is a pointer to the timer to insert.
 *
 *              type          Is either:
 *                               OS_TMR_LINK_PERIODIC    Means to re-insert the timer after a period expired
 *                               OS_TMR_LINK_DLY         Means to insert    the timer the first time
+*                               OS_TMR_LINK_CASCADE     Means to re-insert the timer from a higher level spoke
 *
 * Returns    : none
 ************************************************************************************************************************
@@ -951,21 +1283,38 @@ static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
 {
     OS_TMR       *ptmr1;
     OS_TMR_WHEEL *pspoke;
-    INT16U        spoke;
+    INT32U        remain;
+    INT32U        spoke;
+    INT8U         lvl;
+    INT8U         shift;
+#if OS_CRITICAL_METHOD == 3                                        /* Allocate storage for CPU status register        */
+    OS_CPU_SR     cpu_sr = 0;
+#endif
 
 
     ptmr->OSTmrState = OS_TMR_STATE_RUNNING;
     if (type == OS_TMR_LINK_PERIODIC) {                            /* Determine when timer will expire                */
         ptmr->OSTmrMatch = ptmr->OSTmrPeriod + OSTmrTime;
-    } else {
+    } else if (type == OS_TMR_LINK_DLY) {
         if (ptmr->OSTmrDly == 0) {
             ptmr->OSTmrMatch = ptmr->OSTmrPeriod + OSTmrTime;
         } else {
             ptmr->OSTmrMatch = ptmr->OSTmrDly    + OSTmrTime;
         }
     }
-    spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
-    pspoke = &OSTmrWheelTbl[spoke];
+    remain = ptmr->OSTmrMatch - OSTmrTime;                         /* Find the lowest level covering the time left    */
+    lvl    = 0;
+    shift  = 0;
+    while ((lvl < (OS_TMR_CFG_WHEEL_LVLS - 1)) && ((remain >> shift) > OS_TMR_WHEEL_MASK)) {
+        lvl++;
+        shift += OS_TMR_WHEEL_BITS;
+    }
+    if ((remain >> shift) > OS_TMR_WHEEL_MASK) {                   /* Beyond the top level, park the timer in the ... */
+        spoke = (OSTmrTime >> shift) + OS_TMR_WHEEL_MASK;          /* ... spoke reached last                          */
+    } else {
+        spoke = ptmr->OSTmrMatch >> shift;
+    }
+    pspoke = &OSTmrWheelTbl[lvl][spoke & OS_TMR_WHEEL_MASK];
 
     if (pspoke->OSTmrFirst == (OS_TMR *)0) {                       /* Link into timer wheel                           */
         pspoke->OSTmrFirst   = ptmr;
@@ -978,7 +1327,16 @@ static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
         ptmr1->OSTmrPrev     = (void *)ptmr;
         pspoke->OSTmrEntries++;
     }
-    ptmr->OSTmrPrev = (void *)0;                                   /* Timer always inserted as first node in list     */
+    ptmr->OSTmrPrev  = (void *)0;                                  /* Timer always inserted as first node in list     */
+    ptmr->OSTmrSpoke = (void *)pspoke;                             /* Remember the spoke so unlinking takes no search */
+    OSTmrRunning++;
+    if (OSTmrRunning == 1) {                                       /* Start signaling the timer task, unless the      */
+        OS_ENTER_CRITICAL();                                       /* ... node didn't stop since the last timer ran   */
+        if (!OS_CPU_TICK_NODE_LINKED(&OSTmrTickNode)) {
+            OS_CPU_TICK_NODE_INSERT(&OSTmrTickNode, OS_TMR_ALARM_TICKS);
+        }
+        OS_EXIT_CRITICAL();
+    }
 }
 #endif
 
@@ -1001,11 +1359,9 @@ static  void  OSTmr_Unlink (OS_TMR *ptmr)
     OS_TMR        *ptmr1;
     OS_TMR        *ptmr2;
     OS_TMR_WHEEL  *pspoke;
-    INT16U         spoke;
 
 
-    spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
-    pspoke = &OSTmrWheelTbl[spoke];
+    pspoke = (OS_TMR_WHEEL *)ptmr->OSTmrSpoke;              /* Spoke the timer was linked into                        */
 
     if (pspoke->OSTmrFirst == ptmr) {                       /* See if timer to remove is at the beginning of list     */
         ptmr1              = (OS_TMR *)ptmr->OSTmrNext;
@@ -1024,7 +1380,42 @@ static  void  OSTmr_Unlink (OS_TMR *ptmr)
     ptmr->OSTmrState = OS_TMR_STATE_STOPPED;
     ptmr->OSTmrNext  = (void *)0;
     ptmr->OSTmrPrev  = (void *)0;
+    ptmr->OSTmrSpoke = (void *)0;
     pspoke->OSTmrEntries--;
+    OSTmrRunning--;
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                       MOVE THE TIMERS OF A SPOKE DOWN THE TIMER WHEEL
+*
+* Description: This function is called by the timer task when the spoke of a level above 0 is reached, to link each of
+*              its timers again into the level that covers the time it has left.
+*
+* Arguments  : pspoke        Is a pointer to the spoke to empty.
+*
+* Returns    : none
+************************************************************************************************************************
+*/
+
+#if OS_TMR_EN > 0
+static  void  OSTmr_Cascade (OS_TMR_WHEEL *pspoke)
+{
+    OS_TMR  *ptmr;
+    OS_TMR  *ptmr_next;
+
+
+    ptmr                 = pspoke->OSTmrFirst;              /* Take the whole list off the spoke                      */
+    OSTmrRunning        -= pspoke->OSTmrEntries;
+    pspoke->OSTmrFirst   = (OS_TMR *)0;
+    pspoke->OSTmrEntries = 0;
+    while (ptmr != (OS_TMR *)0) {
+        ptmr_next = (OS_TMR *)ptmr->OSTmrNext;
+        OSTmr_Link(ptmr, OS_TMR_LINK_CASCADE);
+        ptmr      = ptmr_next;
+    }
 }
 #endif
 
@@ -1061,12 +1452,179 @@ static  void  OSTmr_Unlock (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                    QUEUE THE CALLBACK OF AN EXPIRED TIMER
+*
+* Description: This function is called by the timer task to hand the callback of a timer that just expired to the
+*              callback task.  A timer is queued at most once: if it expires again before its callback has run, the
+*              expiry is only counted in OSTmrCbOvr.
+*
+* Arguments  : ptmr          Is a pointer to the timer that expired.
+*
+* Returns    : none
+*
+* Note(s)    : 1) The timer manager must be locked (see OSTmr_Lock()).
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_CB_TASK_EN > 0)
+static  void  OSTmr_CbPut (OS_TMR *ptmr)
+{
+    if (ptmr->OSTmrCbPend == OS_TRUE) {                     /* Callback of the previous expiry has not run yet        */
+        ptmr->OSTmrCbOvr++;
+        return;
+    }
+    ptmr->OSTmrCbPend  = OS_TRUE;
+    ptmr->OSTmrCbMatch = ptmr->OSTmrMatch;                  /* Remember when it was due, to measure its lateness      */
+    ptmr->OSTmrCbNext  = (void *)0;
+    if (OSTmrCbTail == (OS_TMR *)0) {                       /* Append to the FIFO of callbacks to run                 */
+        OSTmrCbHead = ptmr;
+    } else {
+        OSTmrCbTail->OSTmrCbNext = (void *)ptmr;
+    }
+    OSTmrCbTail = ptmr;
+    (void)OSSemPost(OSTmrSemCb);
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                  REMOVE A TIMER FROM THE QUEUE OF CALLBACKS TO RUN
+*
+* Description: This function is called when a timer is stopped or deleted so that a callback queued for it, and which
+*              has not started yet, is not run.
+*
+* Arguments  : ptmr          Is a pointer to the timer.
+*
+* Returns    : none
+*
+* Note(s)    : 1) The timer manager must be locked (see OSTmr_Lock()).
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_CB_TASK_EN > 0)
+static  void  OSTmr_CbRemove (OS_TMR *ptmr)
+{
+    OS_TMR  *pprev;
+    OS_TMR  *pcur;
+
+
+    if (ptmr->OSTmrCbPend == OS_FALSE) {
+        return;
+    }
+    pprev = (OS_TMR *)0;
+    pcur  = OSTmrCbHead;
+    while (pcur != ptmr) {                                  /* Find the timer in the queue                            */
+        pprev = pcur;
+        pcur  = (OS_TMR *)pcur->OSTmrCbNext;
+    }
+    if (pprev == (OS_TMR *)0) {
+        OSTmrCbHead = (OS_TMR *)ptmr->OSTmrCbNext;
+    } else {
+        pprev->OSTmrCbNext = ptmr->OSTmrCbNext;
+    }
+    if (OSTmrCbTail == ptmr) {
+        OSTmrCbTail = pprev;
+    }
+    ptmr->OSTmrCbNext = (void *)0;
+    ptmr->OSTmrCbPend = OS_FALSE;                           /* The callback task skips the extra semaphore count      */
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                                TIMER CALLBACK TASK
+*
+* Description: This task is created by OSTmrInit() when OS_TMR_CFG_CB_TASK_EN is enabled.  It runs the callbacks that
+*              the timer task queued, in the order the timers expired, without holding the timer manager lock: a slow
+*              callback thus delays neither the expiry of the other timers nor OSTmrStart() and OSTmrStop(), and a
+*              callback may itself start, stop or delete timers.
+*
+*              For each callback the task records in the timer:
+*
+*                  OSTmrCbLate       the number of timer ticks from OSTmrMatch to the start of the callback
+*                  OSTmrCbLateMax    ... and its peak
+*                  OSTmrCbCycles     the duration of the callback, in OSCPUTsGet() counts (needs OS_TASK_PROFILE_EN)
+*                  OSTmrCbCyclesMax  ... and its peak
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) A callback that has started still completes when its timer is stopped or deleted.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TMR_CFG_CB_TASK_EN > 0)
+static  void  OSTmr_CbTask (void *p_arg)
+{
+    INT8U            err;
+    OS_TMR          *ptmr;
+    OS_TMR_CALLBACK  pfnct;
+    void            *parg;
+    INT32U           late;
+#if OS_TASK_PROFILE_EN > 0
+    INT32U           cycles;
+#endif
+
+
+    (void)p_arg;                                                 /* Not using 'p_arg', prevent compiler warning       */
+    for (;;) {
+        OSSemPend(OSTmrSemCb, 0, &err);                          /* Wait for a callback to run                        */
+        OSTmr_Lock();
+        ptmr = OSTmrCbHead;
+        if (ptmr == (OS_TMR *)0) {                               /* Callback was removed by OSTmrStop() or OSTmrDel() */
+            OSTmr_Unlock();
+            continue;
+        }
+        OSTmrCbHead = (OS_TMR *)ptmr->OSTmrCbNext;               /* Take the first callback off the queue             */
+        if (OSTmrCbHead == (OS_TMR *)0) {
+            OSTmrCbTail = (OS_TMR *)0;
+        }
+        ptmr->OSTmrCbNext = (void *)0;
+        ptmr->OSTmrCbPend = OS_FALSE;
+        late              = OSTmrTime - ptmr->OSTmrCbMatch;      /* Timer ticks the callback starts late              */
+        ptmr->OSTmrCbLate = late;
+        if (late > ptmr->OSTmrCbLateMax) {
+            ptmr->OSTmrCbLateMax = late;
+        }
+        pfnct = ptmr->OSTmrCallback;
+        parg  = ptmr->OSTmrCallbackArg;
+        OSTmr_Unlock();
+
+        if (pfnct != (OS_TMR_CALLBACK)0) {
+#if OS_TASK_PROFILE_EN > 0
+            cycles = OSCPUTsGet();
+            (*pfnct)((void *)ptmr, parg);                        /* Run the callback outside of the lock              */
+            cycles = OSCPUTsGet() - cycles;
+            OSTmr_Lock();
+            if (ptmr->OSTmrState != OS_TMR_STATE_UNUSED) {       /* Timer may have been deleted by its callback       */
+                ptmr->OSTmrCbCycles = cycles;
+                if (cycles > ptmr->OSTmrCbCyclesMax) {
+                    ptmr->OSTmrCbCyclesMax = cycles;
+                }
+            }
+            OSTmr_Unlock();
+#else
+            (*pfnct)((void *)ptmr, parg);                        /* Run the callback outside of the lock              */
+#endif
+        }
+    }
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
 *                                                 TIMER MANAGEMENT TASK
 *
-* Description: This task is created by OSTmrInit().
+* Description: This task is created by OSTmrInit().  At each signal it moves the timers of the higher level spokes that
+*              are reached down the wheel, then expires all the timers of the current level 0 spoke.  Its work is thus
+*              proportional to the number of timers that expire, not to the number of timers running.
 *
 * Arguments  : none
 *
@@ -1080,9 +1638,11 @@ static  void  OSTmr_Task (void *p_arg)
     INT8U            err;
     OS_TMR          *ptmr;
     OS_TMR          *ptmr_next;
+#if OS_TMR_CFG_CB_TASK_EN == 0
     OS_TMR_CALLBACK  pfnct;
-    OS_TMR_WHEEL    *pspoke;
-    INT16U           spoke;
+#endif
+    INT8U            lvl;
+    INT8U            shift;
 
 
     (void)p_arg;                                                 /* Not using 'p_arg', prevent compiler warning       */
@@ -1090,17 +1650,33 @@ static  void  OSTmr_Task (void *p_arg)
         OSSemPend(OSTmrSemSignal, 0, &err);                      /* Wait for signal indicating time to update timers  */
         OSTmr_Lock();
         OSTmrTime++;                                             /* Increment the current time                        */
-        spoke  = (INT16U)(OSTmrTime % OS_TMR_CFG_WHEEL_SIZE);    /* Position on current timer wheel entry             */
-        pspoke = &OSTmrWheelTbl[spoke];
-        ptmr   = pspoke->OSTmrFirst;
+        lvl   = 0;
+        shift = 0;
+                                                                 /* Each time a level wraps, cascade the spoke ...    */
+        while ((lvl < (OS_TMR_CFG_WHEEL_LVLS - 1)) &&            /* ... reached on the level above                    */
+               (((OSTmrTime >> shift) & OS_TMR_WHEEL_MASK) == 0)) {
+            lvl++;
+            shift += OS_TMR_WHEEL_BITS;
+            OSTmr_Cascade(&OSTmrWheelTbl[lvl][(OSTmrTime >> shift) & OS_TMR_WHEEL_MASK]);
+        }
+        ptmr = OSTmrWheelTbl[0][OSTmrTime & OS_TMR_WHEEL_MASK].OSTmrFirst;
         while (ptmr != (OS_TMR *)0) {
             ptmr_next = (OS_TMR *)ptmr->OSTmrNext;               /* Point to next timer to update because current ... */
-                                                                 /* ... timer could get unlinked from the wheel.      */
-            if (OSTmrTime == ptmr->OSTmrMatch) {                 /* Process each timer that expires                   */
+                                                                 /* ... timer gets unlinked from the wheel.           */
+            if (OSTmrTime != ptmr->OSTmrMatch) {                 /* Only a timer parked beyond the range of a wheel   */
+                OSTmr_Unlink(ptmr);                              /* ... of one level is not due yet                   */
+                OSTmr_Link(ptmr, OS_TMR_LINK_CASCADE);
+            } else {
+#if OS_TMR_CFG_CB_TASK_EN > 0
+                if (ptmr->OSTmrCallback != (OS_TMR_CALLBACK)0) { /* Hand the callback to the callback task            */
+                    OSTmr_CbPut(ptmr);
+                }
+#else
                 pfnct = ptmr->OSTmrCallback;                     /* Execute callback function if available            */
                 if (pfnct != (OS_TMR_CALLBACK)0) {
                     (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
                 }
+#endif
                 OSTmr_Unlink(ptmr);                              /* Remove from current wheel spoke                   */
                 if (ptmr->OSTmrOpt == OS_TMR_OPT_PERIODIC) {
                     OSTmr_Link(ptmr, OS_TMR_LINK_PERIODIC);      /* Recalculate new position of timer in wheel        */
@@ -51,17 +51,20 @@ extern "C"
 #define ALT_SYS_CLK_COUNTER_SIZE _ALT_COUNTER_SIZE(ALT_SYS_CLK)
 #define ALT_TIMESTAMP_COUNTER_SIZE _ALT_COUNTER_SIZE(ALT_TIMESTAMP_CLK)
 
+#define __ALT_FIXED_PERIOD(name) name##_FIXED_PERIOD
+#define _ALT_FIXED_PERIOD(name) __ALT_FIXED_PERIOD(name)
+#define __ALT_SNAPSHOT(name) name##_SNAPSHOT
+#define _ALT_SNAPSHOT(name) __ALT_SNAPSHOT(name)
+
+#define ALT_SYS_CLK_FIXED_PERIOD _ALT_FIXED_PERIOD(ALT_SYS_CLK)
+#define ALT_SYS_CLK_SNAPSHOT _ALT_SNAPSHOT(ALT_SYS_CLK)
+
 #if (ALT_SYS_CLK_COUNTER_SIZE == 64)
 #define alt_sysclk_type alt_u64
 #else
 #define alt_sysclk_type alt_u32
 #endif
 
-#if (ALT_TIMESTAMP_COUNTER_SIZE == 64)
-#define alt_timestamp_type alt_u64
-#else
-#define alt_timestamp_type alt_u32
-#endif
 
 /*
  * The function alt_avalon_timer_sc_init() is the initialisation function for 
@@ -72,6 +75,20 @@ extern "C"
 extern void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id, 
                                       alt_u32 irq, alt_u32 freq);
 
+/*
+ * alt_avalon_timer_sc_stretch() and alt_avalon_timer_sc_resume() allow an
+ * idle system to skip ticks. The first programs the system clock so that its
+ * next interrupt occurs "nticks" tick periods after the last one, and returns
+ * the number of ticks actually programmed (0 if the period is left alone). 
+ * The second ends a stretched period early: the elapsed ticks are credited 
+ * through alt_tick_credit() and the next interrupt is moved back to the next
+ * tick boundary. Both must be called with interrupts disabled, and require 
+ * a timer with writeable period and readable snapshot registers.
+ */
+
+extern alt_u32 alt_avalon_timer_sc_stretch (alt_u32 nticks);
+extern void    alt_avalon_timer_sc_resume (void);
+
 /*
  * Variables used to store the timestamp parameters, when the device is to be
  * accessed using the high resolution timestamp driver.
@@ -124,6 +141,25 @@ extern alt_u32 altera_avalon_timer_ts_freq;
 
 #define none_BASE 0xffffffff
 
+/*
+ * If there is no timestamp device, the system clock driver provides the 
+ * timestamp facility instead, from the 64 bit count of timer clock cycles it
+ * keeps for the system clock. This requires the snapshot register of the
+ * system clock timer. ALT_TIMESTAMP_SYS_CLK is set to 1 in this case.
+ */
+
+#if (ALT_TIMESTAMP_CLK_BASE == none_BASE) && (ALT_SYS_CLK_BASE != none_BASE) && ALT_SYS_CLK_SNAPSHOT
+#define ALT_TIMESTAMP_SYS_CLK 1
+#else
+#define ALT_TIMESTAMP_SYS_CLK 0
+#endif
+
+#if (ALT_TIMESTAMP_COUNTER_SIZE == 64) || ALT_TIMESTAMP_SYS_CLK
+#define alt_timestamp_type alt_u64
+#else
+#define alt_timestamp_type alt_u32
+#endif
+
 /*
  * ALTERA_AVALON_TIMER_INIT is the macro used by alt_sys_init() to provide
  * the run time initialisation of the device. In this case this translates to
@@ -32,8 +32,11 @@
 
 #include <string.h>
 
+#include "system.h"
 #include "sys/alt_alarm.h"
+#include "sys/alt_hrtimer.h"
 #include "sys/alt_irq.h"
+#include "sys/alt_timestamp.h"
 
 #include "altera_avalon_timer.h"
 #include "altera_avalon_timer_regs.h"
@@ -41,6 +44,228 @@
 #include "alt_types.h"
 #include "sys/alt_log_printf.h"
 
+/*
+ * High resolution timers and tickless idle reprogram the period of the timer,
+ * which is only possible with a writeable period and a snapshot register.
+ */
+
+#if (ALT_SYS_CLK_BASE != none_BASE) && !ALT_SYS_CLK_FIXED_PERIOD && ALT_SYS_CLK_SNAPSHOT
+#define ALT_SC_HRTIMER 1
+#else
+#define ALT_SC_HRTIMER 0
+#endif
+
+/*
+ * The driver keeps the time in timer clock cycles since the system clock was
+ * started, so that the period can be changed without losing track of the 
+ * tick boundaries:
+ *
+ * "alt_sc_period" is the number of timer clock cycles in one tick.
+ * "alt_sc_freq" is the number of timer clock cycles per second.
+ * "alt_sc_start" is the time at which the counter was last loaded, either by
+ *    writing the period or by reloading when it timed out.
+ * "alt_sc_load" is the number of cycles from that load to the next timeout.
+ * "alt_sc_tick" is the time of the next tick boundary, i.e. of the next call
+ *    to alt_tick().
+ * "alt_sc_ticks" is the number of ticks spanned by a stretched period while 
+ *    the system is idle, zero otherwise.
+ *
+ * The period is only written when the next timeout must differ from the one 
+ * the counter is heading for, so the timer runs untouched while there is 
+ * neither a stretched period nor a high resolution timer.
+ */
+
+static void*   alt_sc_base   = NULL;
+static alt_u32 alt_sc_period = 0;
+static alt_u32 alt_sc_freq   = 0;
+static alt_u64 alt_sc_start  = 0;
+static alt_u32 alt_sc_load   = 0;
+static alt_u64 alt_sc_tick   = 0;
+static alt_u32 alt_sc_ticks  = 0;
+
+/*
+ * The high resolution timers which have not expired yet, in the order in 
+ * which they expire.
+ */
+
+static ALT_LLIST_HEAD(alt_hrtimer_list);
+
+/*
+ * Minimum number of timer clock cycles left before a timeout for the timer to
+ * be reprogrammed, and minimum period programmed. This leaves time to 
+ * reprogram the timer before the timeout is reached.
+ */
+
+#define ALT_SC_MARGIN 256
+
+/*
+ * alt_avalon_timer_sc_count() returns the current value of the down counter,
+ * i.e. the number of timer clock cycles, minus one, before the next timeout.
+ */
+
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_avalon_timer_sc_count (void* base)
+{
+  IOWR_ALTERA_AVALON_TIMER_SNAPL (base, 0);
+
+  return (IORD_ALTERA_AVALON_TIMER_SNAPL (base) & ALTERA_AVALON_TIMER_SNAPL_MSK) |
+         ((IORD_ALTERA_AVALON_TIMER_SNAPH (base) & ALTERA_AVALON_TIMER_SNAPH_MSK) << 16);
+}
+
+/*
+ * alt_avalon_timer_sc_pending() returns non-zero if the counter has timed out
+ * and the interrupt handler has not run yet.
+ */
+
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_avalon_timer_sc_pending (void* base)
+{
+  return IORD_ALTERA_AVALON_TIMER_STATUS (base) & ALTERA_AVALON_TIMER_STATUS_TO_MSK;
+}
+
+/*
+ * alt_avalon_timer_sc_period() loads a new period and restarts the counter
+ * from it. The timer counts "period" + 1 cycles before the next timeout.
+ */
+
+static ALT_INLINE void ALT_ALWAYS_INLINE alt_avalon_timer_sc_period (void* base, 
+                                                                     alt_u32 period)
+{
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (base, period & ALTERA_AVALON_TIMER_PERIODL_MSK);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (base, (period >> 16) & ALTERA_AVALON_TIMER_PERIODH_MSK);
+
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (base, 
+            ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+            ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+            ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+}
+
+/*
+ * alt_avalon_timer_sc_now() returns the current time. It is called with 
+ * interrupts disabled. The counter may have timed out, and reloaded, without
+ * the interrupt having been handled yet: the timeout status is read on both
+ * sides of the snapshot, and the snapshot is taken again if the timeout 
+ * occurred in between, so that the count is known to follow the reload.
+ *
+ * The status only records one timeout: if the interrupt is held off for more
+ * than a whole period, that period is not seen and the time runs late by it.
+ * This can only happen with the short periods programmed for high resolution
+ * timers, and then costs at most the interrupt latency.
+ */
+
+static alt_u64 alt_avalon_timer_sc_now (void* base)
+{
+  alt_u64 start = alt_sc_start;
+  alt_u32 count;
+
+  if (alt_avalon_timer_sc_pending (base))
+  {
+    count  = alt_avalon_timer_sc_count (base);
+    start += alt_sc_load;
+  }
+  else
+  {
+    count = alt_avalon_timer_sc_count (base);
+    if (alt_avalon_timer_sc_pending (base))
+    {
+      count  = alt_avalon_timer_sc_count (base);
+      start += alt_sc_load;
+    }
+  }
+
+  return start + (alt_sc_load - 1 - count);
+}
+
+/*
+ * alt_avalon_timer_sc_program() is called with interrupts disabled, at time
+ * "now", to have the next timeout occur on the next event: the next tick 
+ * boundary, or the end of the stretched period, or the expiry of the first 
+ * high resolution timer if it comes first. 
+ *
+ * "realign" is set by the interrupt handler when the timeout it handles was
+ * on a tick boundary. If the counter is not heading for the next tick 
+ * boundary, the boundaries are then moved to one period from now, so that
+ * the timer gets back its normal period and runs untouched again. This moves
+ * the following tick boundaries by the interrupt latency; the number of ticks
+ * is unaffected. A timeout between two boundaries, for a high resolution 
+ * timer, leaves them where they are. The few cycles between reading the time
+ * and writing the period are not counted, so the time runs slightly slow 
+ * while the timer is reprogrammed often, but never goes backwards.
+ */
+
+static void alt_avalon_timer_sc_program (void* base, alt_u64 now, int realign)
+{
+  alt_u64      next;
+  alt_u32      load;
+  alt_hrtimer* timer;
+
+  next = alt_sc_tick;
+  if (alt_sc_ticks)
+  {
+    next += (alt_u64) (alt_sc_ticks - 1) * alt_sc_period;
+  }
+  else if (realign && (alt_sc_start + alt_sc_load != next))
+  {
+    alt_sc_tick = now + alt_sc_period;
+    next        = alt_sc_tick;
+  }
+
+  if (alt_hrtimer_list.next != &alt_hrtimer_list)
+  {
+    timer = (alt_hrtimer*) alt_hrtimer_list.next;
+    if (timer->expiry < next)
+    {
+      next = timer->expiry;
+    }
+  }
+
+  /* leave the counter alone if it already times out on the next event */
+
+  if (alt_sc_start + alt_sc_load == next)
+  {
+    return;
+  }
+
+  if (next < now + ALT_SC_MARGIN)
+  {
+    next = now + ALT_SC_MARGIN;
+  }
+  load = (alt_u32) (next - now);
+
+  alt_avalon_timer_sc_period (base, load - 1);
+
+  /* a timeout of the previous period is already accounted for in "now" */
+
+  IOWR_ALTERA_AVALON_TIMER_STATUS (base, 0);
+
+  alt_sc_start = now;
+  alt_sc_load  = load;
+}
+
+/*
+ * alt_avalon_timer_sc_update() is called with interrupts disabled, outside of
+ * the interrupt handler, once the next event has changed. The timer is left 
+ * alone while a timeout is pending or about to occur, since the interrupt 
+ * handler then reprograms it. 
+ */
+
+static void alt_avalon_timer_sc_update (void* base)
+{
+  alt_u64 now;
+
+  if (alt_avalon_timer_sc_pending (base))
+  {
+    return;
+  }
+
+  now = alt_avalon_timer_sc_now (base);
+
+  if ((alt_64) (alt_sc_start + alt_sc_load - now) < ALT_SC_MARGIN)
+  {
+    return;
+  }
+
+  alt_avalon_timer_sc_program (base, now, 0);
+}
+
 /* 
  * alt_avalon_timer_sc_irq() is the interrupt handler used for the system 
  * clock. This is called periodically when a timer interrupt occurs. The 
@@ -49,6 +274,10 @@
  *
  * alt_tick() increments the system tick count, and updates any registered 
  * alarms, see alt_tick.c for further details.
+ *
+ * The interrupt may also end a stretched period, in which case the ticks 
+ * which elapsed without an interrupt are credited, or be for a high 
+ * resolution timer, between two ticks.
  */
 #ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
 static void alt_avalon_timer_sc_irq (void* base)
@@ -57,6 +286,12 @@ static void alt_avalon_timer_sc_irq (void* base, alt_u32 id)
 #endif
 {
   alt_irq_context cpu_sr;
+  alt_u32         nticks  = 0;
+#if ALT_SC_HRTIMER
+  int             expired = 0;
+#endif
+  alt_u64         now;
+  alt_hrtimer*    timer;
   
   /* clear the interrupt */
   IOWR_ALTERA_AVALON_TIMER_STATUS (base, 0);
@@ -76,10 +311,358 @@ static void alt_avalon_timer_sc_irq (void* base, alt_u32 id)
    * during this time to safely support ISR preemption
    */
   cpu_sr = alt_irq_disable_all();
-  alt_tick ();
+
+  /* the counter reloaded when it timed out */
+
+  alt_sc_start += alt_sc_load;
+
+#if ALT_SC_HRTIMER
+  now = alt_avalon_timer_sc_now (base);
+#else
+  now = alt_sc_start;
+#endif
+
+  /* 
+   * count the tick boundaries reached; any interrupt ends a stretched period.
+   * A single tick, the usual case, needs no division.
+   */
+
+  alt_sc_ticks = 0;
+  if (now >= alt_sc_tick)
+  {
+    if (now - alt_sc_tick < alt_sc_period)
+    {
+      nticks       = 1;
+      alt_sc_tick += alt_sc_period;
+    }
+    else
+    {
+      nticks       = (alt_u32) (now - alt_sc_tick) / alt_sc_period + 1;
+      alt_sc_tick += (alt_u64) nticks * alt_sc_period;
+    }
+  }
+
+  /* 
+   * call the high resolution timers which have expired, and read the time 
+   * again after them since they may take a while
+   */
+
+  while (alt_hrtimer_list.next != &alt_hrtimer_list)
+  {
+    timer = (alt_hrtimer*) alt_hrtimer_list.next;
+    if (timer->expiry > now)
+    {
+      break;
+    }
+    alt_llist_remove (&timer->llist);
+    timer->callback (timer->context);
+#if ALT_SC_HRTIMER
+    expired = 1;
+#endif
+  }
+
+#if ALT_SC_HRTIMER
+  if (expired)
+  {
+    now = alt_avalon_timer_sc_now (base);
+  }
+
+  /* 
+   * with no high resolution timer, the counter is left alone while it
+   * already times out on the next tick boundary, as a periodic tick does
+   */
+
+  if ((alt_hrtimer_list.next != &alt_hrtimer_list) ||
+      (alt_sc_start + alt_sc_load != alt_sc_tick))
+  {
+    alt_avalon_timer_sc_program (base, now, 
+                                 (nticks != 0) && 
+                                 (alt_sc_start + alt_sc_period == alt_sc_tick));
+  }
+#endif
+
+  if (nticks > 1)
+  {
+    alt_tick_credit (nticks - 1);
+  }
+  if (nticks)
+  {
+    alt_tick ();
+  }
   alt_irq_enable_all(cpu_sr);
 }
 
+/*
+ * alt_avalon_timer_sc_stretch() is called with interrupts disabled by an 
+ * idle system, to have the next interrupt occur "nticks" tick periods after
+ * the last one. The timer keeps counting from the current position within 
+ * the tick, so the tick boundaries are preserved. Nothing is done if a 
+ * timeout is already pending, or if too little of the current tick is left
+ * to reprogram the timer safely. A high resolution timer which expires 
+ * earlier still interrupts the stretched period.
+ */
+
+alt_u32 alt_avalon_timer_sc_stretch (alt_u32 nticks)
+{
+  alt_u64 now;
+  alt_u32 max_ticks;
+
+  if (!ALT_SC_HRTIMER || (alt_sc_base == NULL) || alt_sc_ticks || (nticks <= 1))
+  {
+    return 0;
+  }
+
+  /* the period register is 32 bits wide */
+
+  max_ticks = 0xffffffff / alt_sc_period;
+  if (nticks > max_ticks)
+  {
+    nticks = max_ticks;
+  }
+
+  if (alt_avalon_timer_sc_pending (alt_sc_base))
+  {
+    return 0;
+  }
+
+  now = alt_avalon_timer_sc_now (alt_sc_base);
+
+  if ((alt_64) (alt_sc_start + alt_sc_load - now) < ALT_SC_MARGIN)
+  {
+    return 0;
+  }
+
+  alt_sc_ticks = nticks;
+  alt_avalon_timer_sc_program (alt_sc_base, now, 0);
+
+  return nticks;
+}
+
+/*
+ * alt_avalon_timer_sc_resume() is called with interrupts disabled to end a
+ * stretched period before it expires, e.g. because an interrupt made a task
+ * ready. The whole ticks which have elapsed are credited, and the timer is
+ * programmed to interrupt at the next tick boundary; the interrupt handler
+ * then restores the normal period.
+ */
+
+void alt_avalon_timer_sc_resume (void)
+{
+  alt_u64 now;
+  alt_u32 nticks = 0;
+
+  /* if the period has just expired, the interrupt handler accounts for it */
+
+  if ((alt_sc_ticks == 0) || alt_avalon_timer_sc_pending (alt_sc_base))
+  {
+    return;
+  }
+
+  now          = alt_avalon_timer_sc_now (alt_sc_base);
+  alt_sc_ticks = 0;
+
+  if (now >= alt_sc_tick)
+  {
+    nticks       = (alt_u32) (now - alt_sc_tick) / alt_sc_period + 1;
+    alt_sc_tick += (alt_u64) nticks * alt_sc_period;
+  }
+
+  if ((alt_64) (alt_sc_start + alt_sc_load - now) >= ALT_SC_MARGIN)
+  {
+    alt_avalon_timer_sc_program (alt_sc_base, now, 0);
+  }
+
+  alt_tick_credit (nticks);
+}
+
+/*
+ * alt_hrtimer_start_at() adds "timer" to the list of high resolution timers,
+ * after those which expire before it or at the same time, and reprograms the
+ * system clock timer if it has become the first.
+ */
+
+int alt_hrtimer_start_at (alt_hrtimer* timer, 
+                          alt_u64      expiry,
+                          void         (*callback) (void* context),
+                          void*        context)
+{
+  alt_irq_context irq_context;
+  alt_llist*      entry;
+
+  if (!ALT_SC_HRTIMER || (alt_sc_base == NULL))
+  {
+    return -1;
+  }
+
+  timer->expiry   = expiry;
+  timer->callback = callback;
+  timer->context  = context;
+
+  irq_context = alt_irq_disable_all ();
+
+  for (entry = alt_hrtimer_list.next; 
+       entry != &alt_hrtimer_list; 
+       entry = entry->next)
+  {
+    if (((alt_hrtimer*) entry)->expiry > expiry)
+    {
+      break;
+    }
+  }
+  alt_llist_insert (entry->previous, &timer->llist);
+
+  if (alt_hrtimer_list.next == &timer->llist)
+  {
+    alt_avalon_timer_sc_update (alt_sc_base);
+  }
+
+  alt_irq_enable_all (irq_context);
+
+  return 0;
+}
+
+/*
+ * alt_hrtimer_start() converts "usec" to timer clock cycles from now. The
+ * conversion rounds up, so the callback is never early.
+ */
+
+int alt_hrtimer_start (alt_hrtimer* timer, 
+                       alt_u32      usec,
+                       void         (*callback) (void* context),
+                       void*        context)
+{
+  alt_u64 cycles;
+
+  if (!ALT_SC_HRTIMER || (alt_sc_base == NULL))
+  {
+    return -1;
+  }
+
+  cycles = ((alt_u64) usec * alt_sc_freq + 999999) / 1000000;
+
+  return alt_hrtimer_start_at (timer, alt_hrtimer_now () + cycles, 
+                               callback, context);
+}
+
+/*
+ * alt_hrtimer_stop() removes a timer from the list. The system clock timer is
+ * not reprogrammed: should it interrupt for this timer, the interrupt handler
+ * finds nothing to do and moves on to the next event.
+ */
+
+void alt_hrtimer_stop (alt_hrtimer* timer)
+{
+  alt_irq_context irq_context;
+
+  irq_context = alt_irq_disable_all ();
+  alt_llist_remove (&timer->llist);
+  alt_irq_enable_all (irq_context);
+}
+
+/*
+ * alt_hrtimer_now() returns the time in timer clock cycles.
+ */
+
+alt_u64 alt_hrtimer_now (void)
+{
+  alt_irq_context irq_context;
+  alt_u64         now;
+
+  if (!ALT_SC_HRTIMER || (alt_sc_base == NULL))
+  {
+    return 0;
+  }
+
+  irq_context = alt_irq_disable_all ();
+  now         = alt_avalon_timer_sc_now (alt_sc_base);
+  alt_irq_enable_all (irq_context);
+
+  return now;
+}
+
+/*
+ * alt_hrtimer_freq() returns the number of timer clock cycles per second, or
+ * zero if high resolution timers are not available.
+ */
+
+alt_u32 alt_hrtimer_freq (void)
+{
+  return ALT_SC_HRTIMER ? alt_sc_freq : 0;
+}
+
+#if ALT_TIMESTAMP_SYS_CLK
+
+/*
+ * When the system has no timestamp device, the timestamp facility counts 
+ * the timer clock cycles of the system clock, from the time kept by this
+ * driver. It only needs the snapshot register, so it also works with a fixed
+ * period. The count is read with interrupts disabled, and allows for a 
+ * timeout which has not been handled yet, so it is consistent whether read
+ * from a task or an interrupt handler, and never goes backwards. At 50 MHz, 
+ * 64 bits don't roll over for thousands of years.
+ *
+ * "alt_sc_ts_start" is the time of the last call to alt_timestamp_start().
+ */
+
+static alt_u64 alt_sc_ts_start = 0;
+
+/*
+ * alt_timestamp_start() restarts the timestamp count from zero. It returns 
+ * -1 if the system clock has not been initialised yet, and 0 otherwise. The
+ * system clock itself is not affected.
+ */
+
+int alt_timestamp_start (void)
+{
+  alt_irq_context irq_context;
+
+  if (alt_sc_base == NULL)
+  {
+    return -1;
+  }
+
+  irq_context     = alt_irq_disable_all ();
+  alt_sc_ts_start = alt_avalon_timer_sc_now (alt_sc_base);
+  alt_irq_enable_all (irq_context);
+
+  return 0;
+}
+
+/*
+ * alt_timestamp() returns the number of timer clock cycles since the last
+ * call to alt_timestamp_start(), or since the system clock was initialised.
+ * It returns 0 until then.
+ */
+
+alt_timestamp_type alt_timestamp (void)
+{
+  alt_irq_context irq_context;
+  alt_u64         now;
+
+  if (alt_sc_base == NULL)
+  {
+    return 0;
+  }
+
+  irq_context = alt_irq_disable_all ();
+  now         = alt_avalon_timer_sc_now (alt_sc_base) - alt_sc_ts_start;
+  alt_irq_enable_all (irq_context);
+
+  return now;
+}
+
+/*
+ * alt_timestamp_freq() returns the number of timer clock cycles per second,
+ * or 0 if the system clock has not been initialised yet.
+ */
+
+alt_u32 alt_timestamp_freq (void)
+{
+  return alt_sc_freq;
+}
+
+#endif /* ALT_TIMESTAMP_SYS_CLK */
+
 /*
  * alt_avalon_timer_sc_init() is called to initialise the timer that will be 
  * used to provide the periodic system clock. This is called from the 
@@ -92,6 +675,21 @@ void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
   /* set the system clock frequency */
   
   alt_sysclk_init (freq);
+
+  /* 
+   * record the tick period, in case the period is changed for tickless idle
+   * or high resolution timers 
+   */
+
+  alt_sc_base   = base;
+  alt_sc_period = ((IORD_ALTERA_AVALON_TIMER_PERIODL (base) & 
+                    ALTERA_AVALON_TIMER_PERIODL_MSK) |
+                   ((IORD_ALTERA_AVALON_TIMER_PERIODH (base) & 
+                     ALTERA_AVALON_TIMER_PERIODH_MSK) << 16)) + 1;
+  alt_sc_freq   = alt_sc_period * freq;
+  alt_sc_start  = 0;
+  alt_sc_load   = alt_sc_period;
+  alt_sc_tick   = alt_sc_period;
   
   /* set to free running mode */
   
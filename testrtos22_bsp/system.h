@@ -343,7 +343,7 @@
 #define OS_CPU_HOOKS_EN 1
 #define OS_DEBUG_EN 1
 #define OS_EVENT_NAME_SIZE 32
-#define OS_FLAGS_NBITS 16
+#define OS_FLAGS_NBITS 32
 #define OS_FLAG_ACCEPT_EN 1
 #define OS_FLAG_DEL_EN 1
 #define OS_FLAG_EN 1
@@ -408,7 +408,7 @@
 #define OS_TMR_CFG_MAX 16
 #define OS_TMR_CFG_NAME_SIZE 16
 #define OS_TMR_CFG_TICKS_PER_SEC 10
-#define OS_TMR_CFG_WHEEL_SIZE 2
+#define OS_TMR_CFG_WHEEL_SIZE 32
 #define OS_TMR_EN 0
 
 #endif /* __SYSTEM_H_ */
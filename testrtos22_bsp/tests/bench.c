@@ -0,0 +1,27 @@
+/*
+ * Host build of the demo's kernel benchmarks, testrtos22/bench_ucosii.c.
+ * They are run by "make bench" rather than "make check": they only print 
+ * their measurements, which on the host are in nanoseconds.
+ */
+
+#include "host.h"
+
+#include "bench_ucosii.h"
+
+static OS_STK bench_task_stk[HOST_STK_SIZE];
+
+static void bench_task (void* pdata)
+{
+  (void) pdata;
+  bench_run ();
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  CHECK (OSTaskCreate (bench_task, NULL, &bench_task_stk[HOST_STK_SIZE - 1],
+                       BENCH_PRIO) == OS_ERR_NONE);
+  OSStart ();
+  return 0;
+}
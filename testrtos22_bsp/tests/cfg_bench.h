@@ -0,0 +1,16 @@
+/*
+ * Settings of bench: enough tasks and priorities for the largest benchmark
+ * of testrtos22/bench_ucosii.c, and stacks the host can run on.
+ */
+
+#undef  OS_MAX_TASKS
+#define OS_MAX_TASKS    64
+#undef  OS_LOWEST_PRIO
+#define OS_LOWEST_PRIO  70
+
+#define BENCH_STK_SIZE  HOST_STK_SIZE
+
+#define ALT_IRQ_PROFILE
+
+#undef  OS_TASK_PREEMPT_THRESH_EN
+#define OS_TASK_PREEMPT_THRESH_EN 1
@@ -0,0 +1,9 @@
+/*
+ * Settings of bench_defer: those of bench, with the posts made by ISRs
+ * deferred to a task.
+ */
+
+#include "cfg_bench.h"
+
+#undef  OS_ISR_POST_DEFERRED_EN
+#define OS_ISR_POST_DEFERRED_EN 1
@@ -0,0 +1,6 @@
+/*
+ * Settings of test_flags_defer: posts from ISRs deferred to OS_TaskIntQ().
+ */
+
+#undef  OS_ISR_POST_DEFERRED_EN
+#define OS_ISR_POST_DEFERRED_EN 1
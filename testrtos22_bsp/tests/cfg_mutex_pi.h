@@ -0,0 +1,9 @@
+/*
+ * Settings of test_mutex_pi: priority inheritance, which needs round-robin
+ * scheduling.
+ */
+
+#undef  OS_SCHED_RR_EN
+#define OS_SCHED_RR_EN 1
+#undef  OS_MUTEX_PI_EN
+#define OS_MUTEX_PI_EN 1
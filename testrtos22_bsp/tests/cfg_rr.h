@@ -0,0 +1,6 @@
+/*
+ * Settings of test_rr: round-robin scheduling.
+ */
+
+#undef  OS_SCHED_RR_EN
+#define OS_SCHED_RR_EN 1
@@ -0,0 +1,7 @@
+/*
+ * Settings of test_sched_wide: more priorities than fit in one word of the 
+ * ready and event tables.
+ */
+
+#undef  OS_LOWEST_PRIO
+#define OS_LOWEST_PRIO 200
@@ -0,0 +1,6 @@
+/*
+ * Settings of test_stat: CPU usage measured from the profiling timestamps.
+ */
+
+#undef  OS_TASK_STAT_TS_EN
+#define OS_TASK_STAT_TS_EN 1
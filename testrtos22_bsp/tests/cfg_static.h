@@ -0,0 +1,19 @@
+/*
+ * Settings of test_static: no pool of any kind of object, so that every
+ * object comes from the application through ...CreateStatic(), and OS
+ * timers, whose task creates its semaphores that way too.
+ */
+
+#undef  OS_MAX_EVENTS
+#define OS_MAX_EVENTS   0
+#undef  OS_MAX_QS
+#define OS_MAX_QS       0
+#undef  OS_MAX_FLAGS
+#define OS_MAX_FLAGS    0
+#undef  OS_MAX_MEM_PART
+#define OS_MAX_MEM_PART 0
+#undef  OS_TMR_CFG_MAX
+#define OS_TMR_CFG_MAX  0
+
+#undef  OS_TMR_EN
+#define OS_TMR_EN 1
@@ -0,0 +1,14 @@
+/*
+ * Settings of test_tickless: the tickless idle, on the model of the system
+ * clock timer, and no statistic task, which would wake up every tick.
+ */
+
+#define HOST_TIMER_MODEL
+
+#undef  OS_TICKLESS_EN
+#define OS_TICKLESS_EN 1
+
+#undef  OS_TASK_STAT_EN
+#define OS_TASK_STAT_EN 0
+#undef  OS_TASK_STAT_STK_CHK_EN
+#define OS_TASK_STAT_STK_CHK_EN 0
@@ -0,0 +1,12 @@
+/*
+ * Settings of test_time: OS timers, and no statistic task, which would keep
+ * a delay of its own in the tick list.
+ */
+
+#undef  OS_TMR_EN
+#define OS_TMR_EN 1
+
+#undef  OS_TASK_STAT_EN
+#define OS_TASK_STAT_EN 0
+#undef  OS_TASK_STAT_STK_CHK_EN
+#define OS_TASK_STAT_STK_CHK_EN 0
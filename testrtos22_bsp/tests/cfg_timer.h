@@ -0,0 +1,5 @@
+/*
+ * Settings of test_timer: the model of the system clock timer.
+ */
+
+#define HOST_TIMER_MODEL
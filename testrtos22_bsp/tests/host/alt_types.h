@@ -0,0 +1,26 @@
+#ifndef __ALT_TYPES_H__
+#define __ALT_TYPES_H__
+
+/*
+ * The HAL types for the host tests. HAL/inc/alt_types.h uses long for the 
+ * 32-bit types, which is 64 bits wide on the host; this file takes its place
+ * (it shares its include guard) so that alt_u32 and INT32U are 32 bits wide
+ * as on Nios II.
+ */
+
+#ifndef ALT_ASM_SRC
+typedef signed char  alt_8;
+typedef unsigned char  alt_u8;
+typedef signed short alt_16;
+typedef unsigned short alt_u16;
+typedef signed int alt_32;
+typedef unsigned int alt_u32;
+typedef long long alt_64;
+typedef unsigned long long alt_u64;
+#endif
+
+#define ALT_INLINE        __inline__
+#define ALT_ALWAYS_INLINE __attribute__ ((always_inline))
+#define ALT_WEAK          __attribute__((weak))
+
+#endif /* __ALT_TYPES_H__ */
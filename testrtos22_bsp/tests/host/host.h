@@ -0,0 +1,49 @@
+#ifndef __HOST_H__
+#define __HOST_H__
+
+/*
+ * Support for the host tests, implemented by host/os_cpu_c.c.
+ *
+ * A test's main() calls host_init(), creates its tasks and calls OSStart().
+ * Interrupts only occur when host_isr() is called, by a task or by the idle
+ * task: each time round its loop the idle task calls host_idle, which by 
+ * default delivers one system clock tick with host_tick(). The test ends 
+ * with host_pass(), or with host_fail() when a CHECK() does not hold. A test
+ * which hangs is stopped after HOST_TIME_LIMIT seconds.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "includes.h"
+
+#define HOST_TIME_LIMIT 60
+
+#define CHECK(cond)                                  \
+  do                                                 \
+  {                                                  \
+    if (!(cond))                                     \
+    {                                                \
+      host_fail (__FILE__, __LINE__, #cond);         \
+    }                                                \
+  } while (0)
+
+/*
+ * host_idle is called by the idle task. host_time_tick, if set, is called by
+ * OSTimeTickHook(). host_irq_enable, if set, is called each time interrupts
+ * are enabled, e.g. at the end of a critical section, and may take an 
+ * interrupt there with host_isr().
+ */
+
+extern void (*host_idle) (void);
+extern void (*host_time_tick) (void);
+extern void (*host_irq_enable) (void);
+
+extern void host_init (void);
+extern void host_isr (void (*isr) (void*), void* context);
+extern void host_tick (void);
+extern void host_pass (void);
+extern void host_fail (const char* file, int line, const char* what);
+
+#endif /* __HOST_H__ */
@@ -0,0 +1,14 @@
+#ifndef __INCLUDES_H__
+#define __INCLUDES_H__
+
+/*
+ * The uC/OS-II master include file for the host tests. HAL/inc/includes.h 
+ * would take the Nios II os_cpu.h from its own directory rather than the 
+ * one in this directory.
+ */
+
+#include    "os_cpu.h"
+#include    "os_cfg.h"
+#include    "ucos_ii.h"
+
+#endif /* __INCLUDES_H__ */
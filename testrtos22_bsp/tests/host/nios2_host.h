@@ -0,0 +1,23 @@
+#ifndef __NIOS2_HOST_H__
+#define __NIOS2_HOST_H__
+
+/*
+ * Included ahead of every source file of the host tests (-include). 
+ *
+ * It declares the Nios II builtins used by nios2.h and io.h, so that the HAL
+ * headers are used unchanged: host/os_cpu_c.c implements the status and 
+ * ipending control registers, and a test which accesses a device links a
+ * model of its registers. It also makes sure that the alt_types.h and the 
+ * kernel configuration of the host tests are the ones seen first.
+ */
+
+#include "alt_types.h"
+
+unsigned int __builtin_rdctl (int reg);
+void         __builtin_wrctl (int reg, unsigned int val);
+int          __builtin_ldwio (volatile const void* addr);
+void         __builtin_stwio (volatile void* addr, int val);
+
+#include "os_cfg.h"
+
+#endif /* __NIOS2_HOST_H__ */
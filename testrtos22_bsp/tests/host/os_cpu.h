@@ -0,0 +1,109 @@
+#ifndef __OS_CPU_H__
+#define __OS_CPU_H__
+
+/*
+*********************************************************************************************************
+*                                               uC/OS-II
+*                                        The Real-Time Kernel
+*
+*                                    Host port for the BSP's tests
+*
+* File         : OS_CPU.H
+*
+* This is the Nios II os_cpu.h of HAL/inc, with the 32-bit types changed to int so that they stay 32 
+* bits wide on a 64-bit host. Tasks are switched by host/os_cpu_c.c; interrupts are disabled and 
+* enabled through the emulated status register, with the functions of sys/alt_irq.h as on the target.
+*********************************************************************************************************
+*/
+
+#include "sys/alt_irq.h"
+
+#ifdef  OS_CPU_GLOBALS
+#define OS_CPU_EXT
+#else
+#define OS_CPU_EXT  extern
+#endif
+
+/*****************************************************************************************
+/                                              DATA TYPES
+*****************************************************************************************/
+
+typedef unsigned char  BOOLEAN;
+typedef unsigned char  INT8U;                    /* Unsigned  8 bit quantity                           */
+typedef signed   char  INT8S;                    /* Signed    8 bit quantity                           */
+typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity                           */
+typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
+typedef unsigned int   INT32U;                   /* Unsigned 32 bit quantity                           */
+typedef signed   int   INT32S;                   /* Signed   32 bit quantity                           */
+typedef float          FP32;                     /* Single precision floating point                    */
+typedef double         FP64;                     /* Double precision floating point                    */
+
+typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits                        */
+
+/****************************************************************************
+*                           Miscellaneous defines
+****************************************************************************/
+
+#define  OS_STK_GROWTH        1        /* Stack grows from HIGH to LOW memory */
+
+#define  OS_TASK_SW           OSCtxSw  
+
+/*
+ * Tick list. uC/OS-II times each task delay or pend timeout, and the signal
+ * of its timer task, with a tick node that the port keeps in a list sorted
+ * by expiry. Here a node is a HAL alarm, so the kernel shares alt_alarm_list
+ * with the other alarms and the system clock driver sees a single queue.
+ *
+ * OS_CPU_TICK_NODE_INIT() sets up an unlinked node. Its callback is made 
+ * from the tick ISR 'ticks' ticks after OS_CPU_TICK_NODE_INSERT(), once the
+ * node is unlinked; a non-zero return value links it again that many ticks
+ * later. OS_CPU_TICK_NODE_REMAIN() returns the ticks left before a linked 
+ * node's callback, and OS_CPU_TICK_NEXT_DUE() those before the first 
+ * callback of any node (0xffffffff if none). All are used with interrupts
+ * disabled.
+ */
+
+#include "sys/alt_alarm.h"
+
+typedef  alt_alarm  OS_CPU_TICK_NODE;
+
+#define  OS_CPU_TICK_NODE_INIT(pnode, fnct, parg)         \
+         do {                                             \
+             (pnode)->llist.next     = &(pnode)->llist;   \
+             (pnode)->llist.previous = &(pnode)->llist;   \
+             (pnode)->delta          = 0;                 \
+             (pnode)->callback       = (fnct);            \
+             (pnode)->context        = (parg);            \
+         } while (0)
+#define  OS_CPU_TICK_NODE_INSERT(pnode, ticks) \
+         alt_alarm_insert ((pnode), (alt_u32)(ticks))
+#define  OS_CPU_TICK_NODE_REMOVE(pnode) \
+         alt_alarm_remove (pnode)
+#define  OS_CPU_TICK_NODE_LINKED(pnode) \
+         ((pnode)->llist.next != &(pnode)->llist)
+#define  OS_CPU_TICK_NODE_REMAIN(pnode) \
+         ((INT32U)alt_alarm_remain (pnode))
+#define  OS_CPU_TICK_NEXT_DUE() \
+         ((INT32U)alt_alarm_next_due ())
+
+/******************************************************************************************
+ *                Disable and Enable Interrupts
+ *****************************************************************************************/
+
+#define  OS_CRITICAL_METHOD    3    
+
+#define  OS_CPU_SR alt_irq_context  
+
+#define  OS_ENTER_CRITICAL() \
+         cpu_sr = alt_irq_disable_all ()
+
+#define  OS_EXIT_CRITICAL() \
+         alt_irq_enable_all (cpu_sr);
+
+/* Prototypes */
+
+void OSStartHighRdy(void); 
+void OSCtxSw(void); 
+void OSIntCtxSw(void);
+
+#endif /* __OS_CPU_H__ */
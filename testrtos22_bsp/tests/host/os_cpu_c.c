@@ -0,0 +1,249 @@
+/*
+ * Host port of uC/OS-II, for the tests in the parent directory.
+ *
+ * The kernel runs in a single host thread. Each task is a ucontext kept at
+ * the top of its uC/OS-II stack, and the context switch functions of 
+ * HAL/src/os_cpu_a.S are replaced by the C functions below, which do the 
+ * same with swapcontext(). The Nios II status register is a variable read 
+ * and written through __builtin_rdctl() and __builtin_wrctl(), so 
+ * sys/alt_irq.h and the kernel critical sections work as on the target.
+ *
+ * The Nios II port in HAL/src/os_cpu_c.c is built as part of this file, so
+ * that its hooks (context switch profiling, OSCPUTsGet(), tickless idle) are
+ * the ones tested. Only OSTaskStkInit() and OSTaskIdleHook() are replaced.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <ucontext.h>
+
+#define OSTaskStkInit  OSTaskStkInit_nios
+#define OSTaskIdleHook OSTaskIdleHook_nios
+
+#include "../../HAL/src/os_cpu_c.c"
+
+#undef OSTaskStkInit
+#undef OSTaskIdleHook
+
+#include "host.h"
+
+/*
+ * The context of a task, at the top of its stack. OSTCBStkPtr points to it.
+ */
+
+typedef struct host_frame
+{
+  ucontext_t context;
+  void       (*task) (void* pdata);
+  void*      pdata;
+} HOST_FRAME;
+
+/*
+ * The control registers: status and ipending. 
+ */
+
+static alt_u32 host_ctl[32];
+
+void (*host_idle) (void)       = host_tick;
+void (*host_time_tick) (void)  = NULL;
+void (*host_irq_enable) (void) = NULL;
+
+alt_u32 OSStartTsk;
+
+unsigned int __builtin_rdctl (int reg)
+{
+  return host_ctl[reg];
+}
+
+/*
+ * Writing the status register calls host_irq_enable when it enables 
+ * interrupts, but not while a previous call has not returned.
+ */
+
+void __builtin_wrctl (int reg, unsigned int val)
+{
+  static int in_hook = 0;
+  alt_u32    old     = host_ctl[reg];
+
+  host_ctl[reg] = val;
+  if ((reg == 0) && !(old & NIOS2_STATUS_PIE_MSK) && 
+      (val & NIOS2_STATUS_PIE_MSK) && (host_irq_enable != NULL) && !in_hook)
+  {
+    in_hook = 1;
+    host_irq_enable ();
+    in_hook = 0;
+  }
+}
+
+/*
+ * host_task_start() is the entry point of all tasks. Like OSStartTsk on the 
+ * target, it enables interrupts and calls the task.
+ */
+
+static void host_task_start (void)
+{
+  HOST_FRAME* frame = (HOST_FRAME*) OSTCBCur->OSTCBStkPtr;
+
+  NIOS2_WRITE_STATUS (NIOS2_STATUS_PIE_MSK);
+  frame->task (frame->pdata);
+  host_fail (__FILE__, __LINE__, "task returned");
+}
+
+/*
+ * OSTaskStkInit() places the context of the new task at the top of its 
+ * stack. The tasks of the tests have stacks of HOST_STK_SIZE entries.
+ */
+
+OS_STK* OSTaskStkInit (void (*task) (void* pd), void* pdata, OS_STK* ptos, 
+                       INT16U opt)
+{
+  HOST_FRAME* frame;
+  size_t      size;
+
+  frame = (HOST_FRAME*) (((uintptr_t) (ptos + 1) - sizeof (HOST_FRAME)) & 
+                         ~(uintptr_t) 15);
+  size  = HOST_STK_SIZE * sizeof (OS_STK) - sizeof (HOST_FRAME) - 16;
+
+  getcontext (&frame->context);
+  frame->context.uc_stack.ss_sp   = (char*) frame - size;
+  frame->context.uc_stack.ss_size = size;
+  frame->context.uc_link          = NULL;
+  makecontext (&frame->context, host_task_start, 0);
+  frame->task  = task;
+  frame->pdata = pdata;
+
+  (void) opt;
+  return (OS_STK*) frame;
+}
+
+void OSTaskIdleHook (void)
+{
+  host_idle ();
+}
+
+#if OS_TIME_TICK_HOOK_EN > 0
+void OSTimeTickHook (void)
+{
+  if (host_time_tick != NULL)
+  {
+    host_time_tick ();
+  }
+}
+#endif
+
+/*
+ * The context switches of os_cpu_a.S: the switch hook is called, the new 
+ * task is made current, and its context resumed. OSCtxSw() is only called 
+ * with interrupts disabled, which the task switched in restores (or enables,
+ * if it is new). OSIntCtxSw() is called by OSIntExit() from host_isr(), and
+ * the task switched out resumes there.
+ */
+
+void OSCtxSw (void)
+{
+  HOST_FRAME* from = (HOST_FRAME*) OSTCBCur->OSTCBStkPtr;
+
+  OSTaskSwHook ();
+  OSTCBCur  = OSTCBHighRdy;
+  OSPrioCur = OSPrioHighRdy;
+  swapcontext (&from->context, &((HOST_FRAME*) OSTCBCur->OSTCBStkPtr)->context);
+}
+
+void OSIntCtxSw (void)
+{
+  OSCtxSw ();
+}
+
+void OSStartHighRdy (void)
+{
+  OSTaskSwHook ();
+  OSRunning = OS_TRUE;
+  setcontext (&((HOST_FRAME*) OSTCBHighRdy->OSTCBStkPtr)->context);
+  host_fail (__FILE__, __LINE__, "setcontext");
+}
+
+#if !defined(HOST_TIMER_MODEL)
+
+/*
+ * Without a model of the system clock timer, the timestamps come from the 
+ * host clock, in nanoseconds.
+ */
+
+int alt_timestamp_start (void)
+{
+  return 0;
+}
+
+alt_timestamp_type alt_timestamp (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (alt_timestamp_type) ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+alt_u32 alt_timestamp_freq (void)
+{
+  return 1000000000u;
+}
+
+#endif /* HOST_TIMER_MODEL */
+
+/*
+ * host_isr() calls "isr" as the HAL interrupt handler would: with interrupts
+ * disabled, between OSIntEnter() and OSIntExit(). Interrupts must be enabled.
+ */
+
+void host_isr (void (*isr) (void*), void* context)
+{
+  alt_u32 status;
+
+  NIOS2_READ_STATUS (status);
+  if (!(status & NIOS2_STATUS_PIE_MSK))
+  {
+    host_fail (__FILE__, __LINE__, "interrupt with interrupts disabled");
+  }
+  NIOS2_WRITE_STATUS (status & ~NIOS2_STATUS_PIE_MSK);
+
+  OSIntEnter ();
+  isr (context);
+  OSIntExit ();
+
+  NIOS2_WRITE_STATUS (status);
+}
+
+static void host_tick_isr (void* context)
+{
+  (void) context;
+  alt_tick ();
+}
+
+void host_tick (void)
+{
+  host_isr (host_tick_isr, NULL);
+}
+
+void host_init (void)
+{
+  alarm (HOST_TIME_LIMIT);
+  NIOS2_WRITE_STATUS (NIOS2_STATUS_PIE_MSK);
+  alt_sysclk_init (OS_TICKS_PER_SEC);
+  OSInit ();
+}
+
+void host_pass (void)
+{
+  printf ("%s: pass\n", program_invocation_short_name);
+  exit (0);
+}
+
+void host_fail (const char* file, int line, const char* what)
+{
+  printf ("%s: FAIL %s:%d: %s\n", program_invocation_short_name, file, line,
+          what);
+  exit (1);
+}
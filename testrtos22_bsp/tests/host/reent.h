@@ -0,0 +1,10 @@
+#ifndef __HOST_REENT_H__
+#define __HOST_REENT_H__
+
+/*
+ * HAL/src/os_cpu_c.c includes the newlib <reent.h>. The host tests build it
+ * with OS_THREAD_SAFE_NEWLIB set to 0 (see system.h), so nothing from it is
+ * needed.
+ */
+
+#endif /* __HOST_REENT_H__ */
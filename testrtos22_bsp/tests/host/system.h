@@ -0,0 +1,37 @@
+#ifndef __HOST_SYSTEM_H__
+#define __HOST_SYSTEM_H__
+
+/*
+ * The BSP's system.h, with the changes the host tests need, followed by the
+ * settings of the test being built: the Makefile defines HOST_CFG to the 
+ * name of its cfg_*.h file, if it has one. 
+ */
+
+#include "../../system.h"
+
+/*
+ * There is no newlib on the host, and tasks run the host C library on their
+ * uC/OS-II stacks, which thus need to be larger than on the target.
+ */
+
+#undef  OS_THREAD_SAFE_NEWLIB
+#define OS_THREAD_SAFE_NEWLIB   0
+
+#undef  OS_TASK_IDLE_STK_SIZE
+#define OS_TASK_IDLE_STK_SIZE   HOST_STK_SIZE
+#undef  OS_TASK_STAT_STK_SIZE
+#define OS_TASK_STAT_STK_SIZE   HOST_STK_SIZE
+#undef  OS_TASK_TMR_STK_SIZE
+#define OS_TASK_TMR_STK_SIZE    HOST_STK_SIZE
+#undef  OS_TASK_INT_Q_STK_SIZE
+#define OS_TASK_INT_Q_STK_SIZE  HOST_STK_SIZE
+#undef  OS_TASK_TMR_CB_STK_SIZE
+#define OS_TASK_TMR_CB_STK_SIZE HOST_STK_SIZE
+
+#define HOST_STK_SIZE           4096
+
+#ifdef HOST_CFG
+#include HOST_CFG
+#endif
+
+#endif /* __HOST_SYSTEM_H__ */
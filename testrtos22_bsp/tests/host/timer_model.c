@@ -0,0 +1,167 @@
+/*
+ * Model of the registers of the system clock timer, see host/timer_model.h.
+ *
+ * As on the altera_avalon_timer, the counter counts down from the period to
+ * zero and reloads the period on the next cycle, which sets the timeout
+ * status; it then stops unless the control register has CONT set. Writing
+ * either period register stops the counter and loads it with the new period.
+ * Writing the control register starts or stops the counter (START, STOP),
+ * writing the status register clears the timeout, and writing either
+ * snapshot register copies the counter to the snapshot registers.
+ */
+
+#include "host.h"
+#include "timer_model.h"
+
+#include "altera_avalon_timer_regs.h"
+
+alt_u64 host_timer_cycles        = 0;
+alt_u32 host_timer_period_writes = 0;
+
+static alt_u32 period   = SYS_CLK_TIMER_LOAD_VALUE;
+static alt_u32 count    = SYS_CLK_TIMER_LOAD_VALUE;
+static alt_u32 snap     = 0;
+static alt_u32 control  = 0;
+static int     running  = 0;
+static int     timeout  = 0;
+
+static alt_u32 rand_state = 1;
+
+static alt_isr_func isr;
+static void*        isr_context;
+
+void host_timer_run (alt_u64 ncycles)
+{
+  host_timer_cycles += ncycles;
+
+  if (!running || (ncycles <= count))
+  {
+    count -= running ? ncycles : 0;
+    return;
+  }
+
+  ncycles -= count + 1;
+  count    = period;
+  timeout  = 1;
+
+  if (!(control & ALTERA_AVALON_TIMER_CONTROL_CONT_MSK))
+  {
+    running = 0;
+    return;
+  }
+  count -= ncycles % ((alt_u64) period + 1);
+}
+
+alt_u64 host_timer_timeout (void)
+{
+  return running ? (alt_u64) count + 1 : 0;
+}
+
+int host_timer_pending (void)
+{
+  return timeout && (control & ALTERA_AVALON_TIMER_CONTROL_ITO_MSK);
+}
+
+int host_timer_irq (void)
+{
+  if (!host_timer_pending ())
+  {
+    return 0;
+  }
+  host_isr (isr, isr_context);
+  return 1;
+}
+
+void host_timer_sleep (void)
+{
+  CHECK (running);
+  if (!timeout)
+  {
+    host_timer_run (host_timer_timeout ());
+  }
+  host_timer_irq ();
+}
+
+/* Each register access takes from 1 to 8 cycles. */
+
+static int host_timer_reg (volatile const void* addr)
+{
+  uintptr_t offset = (uintptr_t) addr - (uintptr_t) SYS_CLK_TIMER_BASE;
+
+  if ((offset >= SYS_CLK_TIMER_SPAN) || (offset & 3))
+  {
+    host_fail (__FILE__, __LINE__, "access outside the timer");
+  }
+
+  rand_state = rand_state * 1103515245 + 12345;
+  host_timer_run (1 + ((rand_state >> 16) & 7));
+
+  return offset / 4;
+}
+
+int __builtin_ldwio (volatile const void* addr)
+{
+  switch (host_timer_reg (addr))
+  {
+  case ALTERA_AVALON_TIMER_STATUS_REG:
+    return (timeout ? ALTERA_AVALON_TIMER_STATUS_TO_MSK : 0) |
+           (running ? ALTERA_AVALON_TIMER_STATUS_RUN_MSK : 0);
+  case ALTERA_AVALON_TIMER_CONTROL_REG:
+    return control;
+  case ALTERA_AVALON_TIMER_PERIODL_REG:
+    return period & 0xffff;
+  case ALTERA_AVALON_TIMER_PERIODH_REG:
+    return period >> 16;
+  case ALTERA_AVALON_TIMER_SNAPL_REG:
+    return snap & 0xffff;
+  default:
+    return snap >> 16;
+  }
+}
+
+void __builtin_stwio (volatile void* addr, int val)
+{
+  switch (host_timer_reg (addr))
+  {
+  case ALTERA_AVALON_TIMER_STATUS_REG:
+    timeout = 0;
+    break;
+  case ALTERA_AVALON_TIMER_CONTROL_REG:
+    control = val & (ALTERA_AVALON_TIMER_CONTROL_ITO_MSK |
+                     ALTERA_AVALON_TIMER_CONTROL_CONT_MSK);
+    if (val & ALTERA_AVALON_TIMER_CONTROL_START_MSK)
+    {
+      running = 1;
+    }
+    if (val & ALTERA_AVALON_TIMER_CONTROL_STOP_MSK)
+    {
+      running = 0;
+    }
+    break;
+  case ALTERA_AVALON_TIMER_PERIODL_REG:
+    period  = (period & 0xffff0000) | (val & 0xffff);
+    count   = period;
+    running = 0;
+    host_timer_period_writes++;
+    break;
+  case ALTERA_AVALON_TIMER_PERIODH_REG:
+    period  = (period & 0xffff) | ((alt_u32) (val & 0xffff) << 16);
+    count   = period;
+    running = 0;
+    host_timer_period_writes++;
+    break;
+  default:
+    snap = count;
+    break;
+  }
+}
+
+int alt_ic_isr_register (alt_u32 ic_id, alt_u32 irq, alt_isr_func handler,
+                         void* context, void* flags)
+{
+  CHECK ((ic_id == SYS_CLK_TIMER_IRQ_INTERRUPT_CONTROLLER_ID) &&
+         (irq == SYS_CLK_TIMER_IRQ));
+  isr         = handler;
+  isr_context = context;
+  return 0;
+}
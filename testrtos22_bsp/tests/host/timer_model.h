@@ -0,0 +1,59 @@
+#ifndef __TIMER_MODEL_H__
+#define __TIMER_MODEL_H__
+
+/*
+ * Model of the registers of the system clock timer (altera_avalon_timer at
+ * SYS_CLK_TIMER_BASE), implemented by host/timer_model.c. Tests which link it
+ * define HOST_TIMER_MODEL in their cfg_*.h, and link the system clock driver
+ * drivers/src/altera_avalon_timer_sc.c.
+ *
+ * Time is counted in timer clock cycles. It only passes when the test says
+ * so, and when the driver accesses a register: each access takes a few
+ * cycles, so the counter may time out between two accesses of the driver.
+ * The interrupt is only taken when the test calls host_timer_irq().
+ */
+
+#include "alt_types.h"
+
+/*
+ * host_timer_cycles is the time since reset, and host_timer_period_writes the
+ * number of writes to the period registers.
+ */
+
+extern alt_u64 host_timer_cycles;
+extern alt_u32 host_timer_period_writes;
+
+/* host_timer_run() lets "ncycles" timer clock cycles pass. */
+
+extern void    host_timer_run (alt_u64 ncycles);
+
+/*
+ * host_timer_timeout() returns the number of cycles until the counter next
+ * times out, or 0 if it is stopped.
+ */
+
+extern alt_u64 host_timer_timeout (void);
+
+/*
+ * host_timer_pending() returns non-zero if the counter has timed out and the
+ * interrupt is enabled, i.e. if the interrupt is pending.
+ */
+
+extern int     host_timer_pending (void);
+
+/*
+ * host_timer_irq() calls the interrupt handler, with host_isr(), if the
+ * counter has timed out and the interrupt is enabled. It returns non-zero if
+ * it did.
+ */
+
+extern int     host_timer_irq (void);
+
+/*
+ * host_timer_sleep() lets time pass until the counter times out, and takes the
+ * interrupt: this is what an idle CPU sees.
+ */
+
+extern void    host_timer_sleep (void);
+
+#endif /* __TIMER_MODEL_H__ */
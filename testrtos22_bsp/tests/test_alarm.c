@@ -0,0 +1,241 @@
+/*
+ * Alarm list test. A random sequence of alarm starts and stops, ticks and
+ * credited ticks is checked against a model which keeps the tick on which
+ * each alarm is due. The callbacks restart, stop and start alarms, and the
+ * tick counter wraps around during the test.
+ *
+ * The alarm list is driven directly from main(): the kernel is initialised
+ * but not started, so that it starts no alarm of its own.
+ */
+
+#include "host.h"
+
+#include "sys/alt_alarm.h"
+
+#define NALARMS      8
+#define MAX_TICKS    40
+#define NOPS         50000
+
+static alt_alarm alarms[NALARMS];
+
+/*
+ * The model: for each alarm whether it is started, the value of the tick
+ * counter on which its callback is due, and the order in which it was
+ * started. Alarms due on the same tick are called in the order in which they
+ * were started, and alarms left overdue by alt_tick_credit() in the order in
+ * which they fell due.
+ */
+
+static int       active[NALARMS];
+static alt_u32   due[NALARMS];
+static alt_u32   started[NALARMS];
+static alt_u32   nstarted;
+static alt_u32   now;
+static alt_u32   ncallbacks;
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+/* The number of ticks before alarm "i" is due, <= 0 if it is overdue. */
+
+static alt_32 model_left (int i)
+{
+  return (alt_32) (due[i] - now);
+}
+
+static void model_start (int i, alt_u32 nticks)
+{
+  active[i]  = 1;
+  due[i]     = now + nticks;
+  started[i] = nstarted++;
+}
+
+/* The alarm whose callback is made next on the current tick, or -1. */
+
+static int model_next (void)
+{
+  int next = -1;
+  int i;
+
+  for (i = 0; i < NALARMS; i++)
+  {
+    if (active[i] && (model_left (i) <= 0) &&
+        ((next < 0) ||
+         (model_left (i) < model_left (next)) ||
+         ((model_left (i) == model_left (next)) &&
+          (started[i] < started[next]))))
+    {
+      next = i;
+    }
+  }
+  return next;
+}
+
+static alt_u32 model_next_due (void)
+{
+  alt_u32 next = 0xffffffff;
+  alt_u32 left;
+  int     i;
+
+  for (i = 0; i < NALARMS; i++)
+  {
+    if (active[i])
+    {
+      left = (model_left (i) <= 0) ? 1 : model_left (i);
+      if (left < next)
+      {
+        next = left;
+      }
+    }
+  }
+  return next;
+}
+
+static alt_u32 callback (void* context);
+
+/* Start an alarm which is not started, as the driver's callers do. */
+
+static void start_any (void)
+{
+  alt_u32 nticks = rand_next (MAX_TICKS);
+  int     i      = rand_next (NALARMS);
+
+  if (!active[i])
+  {
+    CHECK (alt_alarm_start (&alarms[i], nticks, callback,
+                            (void*) (intptr_t) i) == 0);
+    model_start (i, nticks + 1);
+  }
+}
+
+static alt_u32 callback (void* context)
+{
+  int     i = (int) (intptr_t) context;
+  int     j;
+  alt_u32 nticks;
+
+  CHECK (i == model_next ());
+  CHECK (alt_alarm_remain (&alarms[i]) == 0);
+  active[i] = 0;
+  ncallbacks++;
+
+  switch (rand_next (6))
+  {
+  case 0:
+  case 1:
+    return 0;
+  case 2:
+    nticks = 1 + rand_next (MAX_TICKS);
+    model_start (i, nticks);
+    return nticks;
+  case 3:
+    /* restarting the alarm overrides the return value */
+    nticks = rand_next (MAX_TICKS);
+    CHECK (alt_alarm_start (&alarms[i], nticks, callback, context) == 0);
+    model_start (i, nticks + 1);
+    return 1 + rand_next (MAX_TICKS);
+  case 4:
+    /* stop another alarm, which may be due on this tick too */
+    j = rand_next (NALARMS);
+    alt_alarm_stop (&alarms[j]);
+    active[j] = 0;
+    return 0;
+  default:
+    start_any ();
+    return 0;
+  }
+}
+
+static void check_all (void)
+{
+  int i;
+
+  CHECK (alt_nticks () == now);
+  CHECK (alt_alarm_next_due () == model_next_due ());
+  for (i = 0; i < NALARMS; i++)
+  {
+    if (active[i])
+    {
+      CHECK (alt_alarm_remain (&alarms[i]) ==
+             ((model_left (i) <= 0) ? 1 : model_left (i)));
+    }
+    else
+    {
+      CHECK (alt_alarm_remain (&alarms[i]) == 0);
+    }
+  }
+}
+
+int main (void)
+{
+  alt_irq_context context;
+  alt_u32         nticks;
+  int             op;
+  int             i;
+
+  host_init ();
+  CHECK (alt_alarm_list.next == &alt_alarm_list);
+
+  for (i = 0; i < NALARMS; i++)
+  {
+    alarms[i].llist.next     = &alarms[i].llist;
+    alarms[i].llist.previous = &alarms[i].llist;
+  }
+
+  /* start close to the wrap-around of the tick counter */
+
+  _alt_nticks = now = 0xffffffff - 1000;
+
+  for (i = 0; i < NOPS; i++)
+  {
+    op = rand_next (8);
+    switch (op)
+    {
+    case 0:
+    case 1:
+      start_any ();
+      break;
+    case 2:
+      /* stopping an alarm which is not started does nothing */
+      op = rand_next (NALARMS);
+      alt_alarm_stop (&alarms[op]);
+      active[op] = 0;
+      break;
+    case 3:
+    case 4:
+    case 5:
+      now++;
+      host_tick ();
+      CHECK (model_next () < 0);
+      break;
+    default:
+      /*
+       * A tickless period as the system clock driver runs it: it never
+       * credits the tick on which the first alarm is due, but an alarm
+       * started meanwhile may fall due and be left overdue.
+       */
+      context = alt_irq_disable_all ();
+      nticks  = alt_alarm_next_due ();
+      if (rand_next (4) == 0)
+      {
+        start_any ();
+      }
+      nticks = rand_next ((nticks > MAX_TICKS) ? MAX_TICKS : nticks);
+      alt_tick_credit (nticks);
+      now += nticks;
+      alt_irq_enable_all (context);
+      break;
+    }
+    check_all ();
+  }
+
+  CHECK (now < 0xffffffff - 1000);
+  CHECK (ncallbacks > NOPS / 10);
+  host_pass ();
+  return 0;
+}
@@ -0,0 +1,422 @@
+/*
+ * Byte-stream buffer test. The root task first reserves, commits, gets
+ * and releases random records on its own, checking their contents and
+ * order against a model as the ring wraps around, with records committed
+ * shorter than reserved and released out of order. Then worker tasks
+ * block in OSBufReserve() and OSBufGet(): a reservation larger than the
+ * free room waits for releases, and producers get room in priority order;
+ * pends time out, a commit made by an ISR readies a consumer, and
+ * OSBufDel() aborts the pends of the tasks still waiting.
+ */
+
+#include <string.h>
+
+#include "host.h"
+
+#define WORKER_PRIO 4
+#define NWORKERS    3
+#define ROOT_PRIO   (WORKER_PRIO + NWORKERS)
+#define BUF_SIZE    256
+#define MAX_LEN     60
+#define MAX_TAKEN   3
+#define NOPS        20000
+
+#define REC_SIZE(len) (4 + (((len) + 3) & ~3))
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    worker_stk[NWORKERS][HOST_STK_SIZE];
+static INT32U    storage[BUF_SIZE / 4];
+static OS_BUF    buf;
+static OS_EVENT* bufev;
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+/*
+ * A worker makes one OSBufReserve() or OSBufGet() call each time its "go"
+ * semaphore is posted. The workers have a higher priority than the root
+ * task, so they have blocked or returned when OSSemPost() returns.
+ */
+
+#define OP_RESERVE 0
+#define OP_GET     1
+
+typedef struct
+{
+  OS_EVENT* go;
+  int       op;
+  INT16U    len;        /* in: length to reserve, out: length got */
+  OS_TICK   timeout;
+  int       waiting;
+  void*     data;
+  INT8U     err;
+  INT32U    done_at;    /* OSTimeGet() when the call returned */
+} WORKER;
+
+static WORKER workers[NWORKERS];
+
+static void worker (void* pdata)
+{
+  WORKER* w = pdata;
+  INT8U   err;
+
+  for (;;)
+  {
+    OSSemPend (w->go, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    if (w->op == OP_RESERVE)
+    {
+      w->data = OSBufReserve (bufev, w->len, w->timeout, &w->err);
+    }
+    else
+    {
+      w->data = OSBufGet (bufev, &w->len, w->timeout, &w->err);
+    }
+    w->done_at = OSTimeGet ();
+    w->waiting = 0;
+  }
+}
+
+static void start (WORKER* w, int op, INT16U len, OS_TICK timeout)
+{
+  w->op      = op;
+  w->len     = len;
+  w->timeout = timeout;
+  w->waiting = 1;
+  CHECK (OSSemPost (w->go) == OS_ERR_NONE);
+}
+
+static INT32U used (void)
+{
+  OS_BUF_DATA data;
+
+  CHECK (OSBufQuery (bufev, &data) == OS_ERR_NONE);
+  CHECK (data.OSSize == BUF_SIZE);
+  return data.OSUsed;
+}
+
+/* Fill a record with bytes derived from its sequence number, and check it */
+
+static void fill (void* data, INT16U len, alt_u32 seq)
+{
+  INT8U* p = data;
+  INT16U i;
+
+  for (i = 0; i < len; i++)
+  {
+    p[i] = (INT8U) (seq * 7 + i);
+  }
+}
+
+static int filled (void* data, INT16U len, alt_u32 seq)
+{
+  INT8U* p = data;
+  INT16U i;
+
+  for (i = 0; i < len; i++)
+  {
+    if (p[i] != (INT8U) (seq * 7 + i))
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* The commit made by isr_commit() */
+
+static void*  isr_data;
+static INT16U isr_len;
+static INT8U  isr_err;
+
+static void isr_commit (void* context)
+{
+  (void) context;
+  isr_err = OSBufCommit (bufev, isr_data, isr_len);
+}
+
+/*
+ * The model of the first part: the lengths of the records committed and
+ * not yet got, oldest first, and the records got and not yet released.
+ */
+
+static INT16U  lens[BUF_SIZE / 4];
+static int     nlens;
+static alt_u32 seq_in;
+static alt_u32 seq_out;
+static void*   taken[MAX_TAKEN];
+static int     ntaken;
+
+/*
+ * Reserve one or two records, and commit them in the reverse order, each
+ * with a random length up to the one reserved.
+ */
+
+static void*   prev;
+static int     wraps;
+
+static void produce (INT16U len, INT16U len2)
+{
+  void*   data[2];
+  INT16U  l[2];
+  INT8U   err;
+  int     n = (len2 != 0) ? 2 : 1;
+  int     k;
+
+  l[0] = len;
+  l[1] = len2;
+  for (k = 0; k < n; k++)
+  {
+    data[k] = OSBufReserve (bufev, l[k], 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    CHECK (((INT32U) data[k] & 3) == 0);
+    CHECK (((INT8U*) data[k] > (INT8U*) storage) &&
+           ((INT8U*) data[k] + l[k] <= (INT8U*) storage + BUF_SIZE));
+    if ((prev != NULL) && (data[k] < prev))
+    {
+      wraps++;
+    }
+    prev = data[k];
+  }
+  for (k = n - 1; k >= 0; k--)
+  {
+    l[k] = rand_next (2) ? l[k] : rand_next (l[k] + 1);
+    fill (data[k], l[k], seq_in + k);
+    CHECK (OSBufCommit (bufev, data[k], l[k]) == OS_ERR_NONE);
+    CHECK (OSBufCommit (bufev, data[k], l[k]) == OS_ERR_BUF_PTR);
+  }
+  for (k = 0; k < n; k++)
+  {
+    lens[nlens++] = l[k];
+  }
+  seq_in += n;
+}
+
+static void wraparound (void)
+{
+  void*   data;
+  void*   other;
+  INT16U  len;
+  INT16U  len2;
+  INT16U  got;
+  INT8U   err;
+  int     i;
+  int     j;
+
+  for (i = 0; i < NOPS; i++)
+  {
+    len  = 1 + rand_next (MAX_LEN);
+    len2 = rand_next (2) ? 1 + rand_next (MAX_LEN) : 0;
+    j    = rand_next (3);
+    if ((j == 0) && 
+        (used () + 2 * (REC_SIZE (len) + REC_SIZE (len2)) <= BUF_SIZE))
+    {
+      /* there is room whether the records fit at the end or wrap */
+
+      produce (len, len2);
+    }
+    else if ((j == 1) && (nlens > 0) && (ntaken < MAX_TAKEN))
+    {
+      data = OSBufGet (bufev, &got, 0, &err);
+      CHECK (err == OS_ERR_NONE);
+      CHECK (got == lens[0]);
+      CHECK (filled (data, got, seq_out++));
+      memmove (&lens[0], &lens[1], --nlens * sizeof (lens[0]));
+      taken[ntaken++] = data;
+    }
+    else if (ntaken > 0)
+    {
+      j = rand_next (ntaken);
+      CHECK (OSBufRelease (bufev, taken[j]) == OS_ERR_NONE);
+      CHECK (OSBufRelease (bufev, taken[j]) == OS_ERR_BUF_PTR);
+      taken[j] = taken[--ntaken];
+    }
+  }
+  CHECK (wraps > NOPS / 100);
+
+  /* a record reserved first and committed last holds back the others */
+
+  while (nlens > 0)
+  {
+    data = OSBufGet (bufev, &got, 0, &err);
+    CHECK (filled (data, got, seq_out++));
+    memmove (&lens[0], &lens[1], --nlens * sizeof (lens[0]));
+    CHECK (OSBufRelease (bufev, data) == OS_ERR_NONE);
+  }
+  while (ntaken > 0)
+  {
+    CHECK (OSBufRelease (bufev, taken[--ntaken]) == OS_ERR_NONE);
+  }
+  CHECK (used () == 0);
+
+  data  = OSBufReserve (bufev, 8, 0, &err);
+  other = OSBufReserve (bufev, 8, 0, &err);
+  CHECK (OSBufCommit (bufev, other, 8) == OS_ERR_NONE);
+  CHECK (OSBufGet (bufev, &got, 1, &err) == NULL);
+  CHECK (err == OS_ERR_TIMEOUT);
+  CHECK (OSBufCommit (bufev, data, 4) == OS_ERR_NONE);
+  CHECK (OSBufGet (bufev, &got, 1, &err) == data);
+  CHECK (got == 4);
+  CHECK (OSBufGet (bufev, &got, 1, &err) == other);
+  CHECK (got == 8);
+  CHECK (OSBufRelease (bufev, other) == OS_ERR_NONE);
+  CHECK (used () != 0);
+  CHECK (OSBufRelease (bufev, data) == OS_ERR_NONE);
+  CHECK (used () == 0);
+}
+
+static void root (void* pdata)
+{
+  WORKER* big   = &workers[0];
+  WORKER* small = &workers[1];
+  WORKER* cons  = &workers[2];
+  void*   recs[4];
+  INT16U  got;
+  INT32U  t;
+  INT8U   err;
+  int     i;
+
+  bufev = OSBufCreate (&buf, storage, BUF_SIZE, &err);
+  CHECK (err == OS_ERR_NONE);
+  CHECK (OSBufReserve (bufev, BUF_SIZE, 0, &err) == NULL);
+  CHECK (err == OS_ERR_BUF_SIZE);
+
+  for (i = 0; i < NWORKERS; i++)
+  {
+    workers[i].go = OSSemCreate (0);
+    CHECK (OSTaskCreateExt (worker, &workers[i],
+                            &worker_stk[i][HOST_STK_SIZE - 1],
+                            WORKER_PRIO + i, WORKER_PRIO + i,
+                            &worker_stk[i][0], HOST_STK_SIZE, NULL, 0)
+           == OS_ERR_NONE);
+  }
+
+  wraparound ();
+
+  /*
+   * Fill the buffer with 4 records of 60 bytes. A reservation of 100 bytes
+   * waits until 2 are released, the first one leaving only 64 bytes free
+   * before the records in use.
+   */
+
+  for (i = 0; i < 4; i++)
+  {
+    recs[i] = OSBufReserve (bufev, 60, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    CHECK (OSBufCommit (bufev, recs[i], 60) == OS_ERR_NONE);
+  }
+  CHECK (used () == BUF_SIZE);
+  start (big, OP_RESERVE, 100, 0);
+  CHECK (big->waiting);
+  for (i = 0; i < 2; i++)
+  {
+    CHECK (OSBufGet (bufev, &got, 0, &err) == recs[i]);
+    CHECK (big->waiting);
+    CHECK (OSBufRelease (bufev, recs[i]) == OS_ERR_NONE);
+  }
+  CHECK (!big->waiting);
+  CHECK (big->err == OS_ERR_NONE);
+  CHECK (big->data == recs[0]);
+
+  /*
+   * The room freed by a release goes to the waiting producers in priority
+   * order: the small record waits behind the big one until it times out.
+   * 88 bytes are then free after the big record.
+   */
+
+  CHECK (OSBufCommit (bufev, big->data, 100) == OS_ERR_NONE);
+  start (big, OP_RESERVE, 100, 5);
+  t = OSTimeGet ();
+  start (small, OP_RESERVE, 40, 0);
+  CHECK (big->waiting && small->waiting);
+  CHECK (OSBufGet (bufev, &got, 0, &err) == recs[2]);
+  CHECK (OSBufRelease (bufev, recs[2]) == OS_ERR_NONE);
+  CHECK (big->waiting && small->waiting);
+  while (big->waiting)
+  {
+    OSTimeDly (1);
+  }
+  CHECK (big->err == OS_ERR_TIMEOUT);
+  CHECK (big->data == NULL);
+  CHECK (big->done_at == t + 5);
+  CHECK (!small->waiting);
+  CHECK (small->err == OS_ERR_NONE);
+  CHECK (small->done_at == big->done_at);
+  CHECK (small->data == (INT8U*) recs[0] + REC_SIZE (100));
+
+  /*
+   * Empty the buffer; a consumer then times out, and is readied by a
+   * commit made from an ISR.
+   */
+
+  CHECK (OSBufGet (bufev, &got, 0, &err) == recs[3]);
+  CHECK (OSBufRelease (bufev, recs[3]) == OS_ERR_NONE);
+  CHECK (OSBufGet (bufev, &got, 0, &err) == recs[0]);
+  CHECK (got == 100);
+  CHECK (OSBufRelease (bufev, recs[0]) == OS_ERR_NONE);
+  CHECK (OSBufCommit (bufev, small->data, 0) == OS_ERR_NONE);
+  CHECK (OSBufGet (bufev, &got, 0, &err) == small->data);
+  CHECK (got == 0);
+  CHECK (OSBufRelease (bufev, small->data) == OS_ERR_NONE);
+  CHECK (used () == 0);
+
+  t = OSTimeGet ();
+  start (cons, OP_GET, 0, 3);
+  CHECK (cons->waiting);
+  OSTimeDly (3);
+  CHECK (!cons->waiting);
+  CHECK (cons->err == OS_ERR_TIMEOUT);
+  CHECK (cons->data == NULL);
+  CHECK (cons->done_at == t + 3);
+
+  start (cons, OP_GET, 0, 0);
+  isr_data = OSBufReserve (bufev, 12, 0, &err);
+  fill (isr_data, 12, 1);
+  isr_len = 12;
+  host_isr (isr_commit, NULL);
+  CHECK (isr_err == OS_ERR_NONE);
+  CHECK (!cons->waiting);
+  CHECK (cons->err == OS_ERR_NONE);
+  CHECK (cons->data == isr_data);
+  CHECK ((cons->len == 12) && filled (cons->data, 12, 1));
+  CHECK (OSBufRelease (bufev, cons->data) == OS_ERR_NONE);
+
+  /*
+   * A record being written holds back the consumer while the buffer is
+   * full: both producers and the consumer wait, until OSBufDel().
+   */
+
+  recs[0] = OSBufReserve (bufev, BUF_SIZE - 4, 0, &err);
+  CHECK (err == OS_ERR_NONE);
+  start (big, OP_RESERVE, 100, 0);
+  start (small, OP_RESERVE, 4, 0);
+  start (cons, OP_GET, 0, 0);
+  CHECK (big->waiting && small->waiting && cons->waiting);
+  CHECK (OSBufDel (bufev, OS_DEL_NO_PEND, &err) == bufev);
+  CHECK (err == OS_ERR_TASK_WAITING);
+  CHECK (OSBufDel (bufev, OS_DEL_ALWAYS, &err) == NULL);
+  CHECK (err == OS_ERR_NONE);
+  for (i = 0; i < NWORKERS; i++)
+  {
+    CHECK (!workers[i].waiting);
+    CHECK (workers[i].err == OS_ERR_PEND_ABORT);
+    CHECK (workers[i].data == NULL);
+  }
+  CHECK (OSBufCommit (bufev, recs[0], 0) == OS_ERR_EVENT_TYPE);
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
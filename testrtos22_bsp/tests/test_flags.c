@@ -0,0 +1,295 @@
+/*
+ * Event flag test. A random sequence of waits and posts on a group of 32 
+ * flags is checked against a model: after each post, exactly the waiting 
+ * tasks whose condition holds are readied, with the flags that made them 
+ * ready, and consume those flags (clear them, or set them for a wait for
+ * cleared flags). The flags the group records as awaited
+ * always cover those of its waiting tasks.
+ *
+ * The waiters run at a higher priority than the root task, so each one has
+ * either blocked or returned from OSFlagPend() when a call of the root task
+ * returns. Half of the posts are made from an interrupt: test_flags_defer 
+ * runs the test with OS_ISR_POST_DEFERRED_EN, where OS_TaskIntQ() applies 
+ * them before the root task resumes. Interrupts are also taken at random 
+ * when a critical section ends, including between two waiters of a post 
+ * in test_flags_defer; they post a semaphore of their own, which must count
+ * each of them.
+ */
+
+#include <string.h>
+
+#include "host.h"
+
+#define ROOT_PRIO  12
+#define NWAITERS   6
+#define NOPS       20000
+
+typedef struct waiter
+{
+  OS_EVENT* go;
+  OS_FLAGS  mask;
+  INT8U     type;
+  INT8U     consume;
+  int       waiting;
+  OS_FLAGS  flags;
+  INT8U     err;
+  OS_STK    stk[HOST_STK_SIZE];
+} WAITER;
+
+static OS_STK       root_stk[HOST_STK_SIZE];
+static WAITER       waiters[NWAITERS];
+static OS_FLAG_GRP* grp;
+
+/* The post made by isr_post() */
+
+static OS_FLAGS     isr_flags;
+static INT8U        isr_opt;
+static INT8U        isr_err;
+
+/* The semaphore posted by the interrupts of irq_enable() */
+
+static OS_EVENT*    irq_sem;
+static alt_u32      irq_posts;
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+/* one to three of the 32 flags */
+
+static OS_FLAGS rand_flags (void)
+{
+  OS_FLAGS flags = 0;
+  int      n     = 1 + rand_next (3);
+
+  while (n--)
+  {
+    flags |= (OS_FLAGS) 1 << rand_next (32);
+  }
+  return flags;
+}
+
+static void waiter (void* pdata)
+{
+  WAITER* w = pdata;
+  INT8U   err;
+
+  for (;;)
+  {
+    OSSemPend (w->go, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    w->flags   = OSFlagPend (grp, w->mask, w->type + w->consume, 0, &w->err);
+    w->waiting = 0;
+  }
+}
+
+static void isr_post (void* context)
+{
+  (void) context;
+  OSFlagPost (grp, isr_flags, isr_opt, &isr_err);
+}
+
+static void irq_post (void* context)
+{
+  (void) context;
+  if (OSSemPost (irq_sem) == OS_ERR_NONE)
+  {
+    irq_posts++;
+  }
+}
+
+static void irq_enable (void)
+{
+  if (rand_next (16) == 0)
+  {
+    host_isr (irq_post, NULL);
+  }
+}
+
+/*
+ * The model: "flags" are the flags of the group. ready() returns the flags 
+ * which satisfy the wait of "w", or 0.
+ */
+
+static OS_FLAGS flags;
+
+static OS_FLAGS ready (WAITER* w)
+{
+  OS_FLAGS rdy;
+
+  switch (w->type)
+  {
+  case OS_FLAG_WAIT_SET_ALL:
+    rdy = flags & w->mask;
+    return (rdy == w->mask) ? rdy : 0;
+  case OS_FLAG_WAIT_SET_ANY:
+    return flags & w->mask;
+  case OS_FLAG_WAIT_CLR_ALL:
+    rdy = ~flags & w->mask;
+    return (rdy == w->mask) ? rdy : 0;
+  default:
+    return ~flags & w->mask;
+  }
+}
+
+static int is_set_wait (WAITER* w)
+{
+  return (w->type == OS_FLAG_WAIT_SET_ALL) || (w->type == OS_FLAG_WAIT_SET_ANY);
+}
+
+/*
+ * check_all() checks the kernel against the model, given the flags "rdy" 
+ * each waiter should have returned with, or 0 if it should still wait.
+ */
+
+static void check_all (OS_FLAGS* rdy)
+{
+  WAITER*  w;
+  INT8U    err;
+  int      i;
+
+  for (i = 0; i < NWAITERS; i++)
+  {
+    w = &waiters[i];
+    if (rdy[i])
+    {
+      CHECK (!w->waiting);
+      CHECK (w->err == OS_ERR_NONE);
+      CHECK (w->flags == rdy[i]);
+      if (w->consume && is_set_wait (w))
+      {
+        flags &= ~rdy[i];
+      }
+      else if (w->consume)
+      {
+        flags |= rdy[i];
+      }
+    }
+    else if (w->waiting)
+    {
+      CHECK (is_set_wait (w) ? ((grp->OSFlagWaitSet & w->mask) == w->mask) 
+                             : ((grp->OSFlagWaitClr & w->mask) == w->mask));
+    }
+  }
+  CHECK (OSFlagQuery (grp, &err) == flags);
+  CHECK (err == OS_ERR_NONE);
+}
+
+static void root (void* pdata)
+{
+  static const INT8U types[] = { OS_FLAG_WAIT_SET_ALL, OS_FLAG_WAIT_SET_ANY,
+                                 OS_FLAG_WAIT_CLR_ALL, OS_FLAG_WAIT_CLR_ANY };
+  OS_FLAGS rdy[NWAITERS];
+  OS_FLAGS post;
+  WAITER*  w;
+  INT8U    opt;
+  INT8U    err;
+  int      i;
+  int      j;
+
+  grp = OSFlagCreate (0, &err);
+  CHECK (err == OS_ERR_NONE);
+  irq_sem = OSSemCreate (0);
+  CHECK (irq_sem != NULL);
+
+  for (i = 0; i < NWAITERS; i++)
+  {
+    w     = &waiters[i];
+    w->go = OSSemCreate (0);
+    CHECK (OSTaskCreateExt (waiter, w, &w->stk[HOST_STK_SIZE - 1], 6 + i,
+                            6 + i, &w->stk[0], HOST_STK_SIZE, NULL, 0) 
+           == OS_ERR_NONE);
+  }
+
+  /* the last of the 32 flags */
+
+  w          = &waiters[0];
+  w->mask    = 0x80000001;
+  w->type    = OS_FLAG_WAIT_SET_ALL;
+  w->consume = OS_FLAG_CONSUME;
+  w->waiting = 1;
+  CHECK (OSSemPost (w->go) == OS_ERR_NONE);
+  CHECK (w->waiting);
+  OSFlagPost (grp, 0x00000001, OS_FLAG_SET, &err);
+  CHECK (w->waiting);
+  CHECK (OSFlagPost (grp, 0x80000000, OS_FLAG_SET, &err) == 0);
+  CHECK (!w->waiting && (w->flags == 0x80000001));
+
+  /* random waits and posts */
+
+  host_irq_enable = irq_enable;
+  for (i = 0; i < NOPS; i++)
+  {
+    memset (rdy, 0, sizeof (rdy));
+    j = rand_next (2 * NWAITERS);
+
+    if ((j < NWAITERS) && !waiters[j].waiting)
+    {
+      w          = &waiters[j];
+      w->mask    = rand_flags ();
+      w->type    = types[rand_next (4)];
+      w->consume = rand_next (2) ? OS_FLAG_CONSUME : 0;
+      w->waiting = 1;
+      rdy[j]     = ready (w);
+      CHECK (OSSemPost (w->go) == OS_ERR_NONE);
+    }
+    else
+    {
+      post = rand_flags ();
+      opt  = rand_next (2) ? OS_FLAG_SET : OS_FLAG_CLR;
+      if (opt == OS_FLAG_SET)
+      {
+        flags |= post;
+      }
+      else
+      {
+        flags &= ~post;
+      }
+      for (j = 0; j < NWAITERS; j++)
+      {
+        if (waiters[j].waiting)
+        {
+          rdy[j] = ready (&waiters[j]);
+        }
+      }
+      if (rand_next (2))
+      {
+        OSFlagPost (grp, post, opt, &err);
+      }
+      else
+      {
+        isr_flags = post;
+        isr_opt   = opt;
+        host_isr (isr_post, NULL);
+        err       = isr_err;
+      }
+      CHECK (err == OS_ERR_NONE);
+    }
+    check_all (rdy);
+  }
+
+  /* let the last deferred posts be applied, then count the posts */
+
+  host_irq_enable = NULL;
+  OSTimeDly (1);
+  CHECK (irq_posts > NOPS / 16);
+  for (i = 0; OSSemAccept (irq_sem) > 0; i++)
+  {
+  }
+  CHECK ((alt_u32) i == irq_posts);
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
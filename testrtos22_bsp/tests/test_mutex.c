@@ -0,0 +1,204 @@
+/*
+ * Mutex test. The owner of a mutex is raised while a higher priority task 
+ * waits for it, and dropped back when it releases it.
+ *
+ * The test is built twice: as test_mutex, where the owner is raised to the
+ * priority reserved by the mutex, and as test_mutex_pi with OS_MUTEX_PI_EN, 
+ * where it inherits the priority of its highest waiter, through chains of 
+ * mutexes.
+ *
+ * The root task runs at the highest priority. It makes the low (L), medium
+ * (M) and high (H) priority tasks take their next step, and checks the 
+ * result once they have all blocked again and the idle task has delivered 
+ * a tick.
+ */
+
+#include "host.h"
+
+#define ROOT_PRIO  4
+#define H_PRIO     8
+#define M_PRIO     12
+#define L_PRIO     15
+#define PIP1       2
+#define PIP2       3
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    l_stk[HOST_STK_SIZE];
+static OS_STK    m_stk[HOST_STK_SIZE];
+static OS_STK    h_stk[HOST_STK_SIZE];
+
+static OS_TCB*   l_tcb;
+static OS_TCB*   m_tcb;
+static OS_TCB*   h_tcb;
+
+static OS_EVENT* l_go;
+static OS_EVENT* m_go;
+static OS_EVENT* h_go;
+static OS_EVENT* m1;
+static OS_EVENT* m2;
+
+static INT8U     h_err;
+static int       m_owns;
+
+static void step (OS_EVENT* go)
+{
+  CHECK (OSSemPost (go) == OS_ERR_NONE);
+  OSTimeDly (1);
+}
+
+static void wait (OS_EVENT* go)
+{
+  INT8U err;
+
+  OSSemPend (go, 0, &err);
+  CHECK (err == OS_ERR_NONE);
+}
+
+static void l_task (void* pdata)
+{
+  INT8U err;
+
+  l_tcb = OSTCBCur;
+
+  wait (l_go);
+  OSMutexPend (m1, 0, &err);
+  CHECK (err == OS_ERR_NONE);
+
+  wait (l_go);
+  CHECK (OSMutexPost (m1) == OS_ERR_NONE);
+
+  wait (l_go);
+}
+
+static void m_task (void* pdata)
+{
+  INT8U err;
+
+  m_tcb = OSTCBCur;
+
+  wait (m_go);
+#if OS_MUTEX_PI_EN > 0
+  OSMutexPend (m2, 0, &err);
+  CHECK (err == OS_ERR_NONE);
+#endif
+  OSMutexPend (m1, 0, &err);
+  CHECK (err == OS_ERR_NONE);
+  m_owns = 1;
+  CHECK (OSMutexPost (m1) == OS_ERR_NONE);
+#if OS_MUTEX_PI_EN > 0
+  CHECK (OSMutexPost (m2) == OS_ERR_NONE);
+#endif
+
+  wait (m_go);
+}
+
+static void h_task (void* pdata)
+{
+  h_tcb = OSTCBCur;
+
+  wait (h_go);
+  OSMutexPend (OS_MUTEX_PI_EN ? m2 : m1, 5, &h_err);
+
+  wait (h_go);
+}
+
+static void root (void* pdata)
+{
+  OS_MUTEX_DATA data;
+  INT8U         err;
+
+  m1 = OSMutexCreate (PIP1, &err);
+  CHECK (err == OS_ERR_NONE);
+  m2 = OSMutexCreate (PIP2, &err);
+  CHECK (err == OS_ERR_NONE);
+  l_go = OSSemCreate (0);
+  m_go = OSSemCreate (0);
+  h_go = OSSemCreate (0);
+
+  CHECK (OSTaskCreateExt (l_task, NULL, &l_stk[HOST_STK_SIZE - 1], L_PRIO,
+                          L_PRIO, &l_stk[0], HOST_STK_SIZE, NULL, 0) 
+         == OS_ERR_NONE);
+  CHECK (OSTaskCreateExt (m_task, NULL, &m_stk[HOST_STK_SIZE - 1], M_PRIO,
+                          M_PRIO, &m_stk[0], HOST_STK_SIZE, NULL, 0) 
+         == OS_ERR_NONE);
+  CHECK (OSTaskCreateExt (h_task, NULL, &h_stk[HOST_STK_SIZE - 1], H_PRIO,
+                          H_PRIO, &h_stk[0], HOST_STK_SIZE, NULL, 0) 
+         == OS_ERR_NONE);
+  OSTimeDly (1);
+
+  /* L takes m1; nobody waits, so it keeps its priority */
+
+  step (l_go);
+  CHECK (l_tcb->OSTCBPrio == L_PRIO);
+
+#if OS_MUTEX_PI_EN > 0
+
+  /* M takes m2 and waits for m1: L inherits M's priority */
+
+  step (m_go);
+  CHECK (l_tcb->OSTCBPrio == M_PRIO);
+  CHECK (m_tcb->OSTCBPrio == M_PRIO);
+
+  /* H waits for m2: M inherits H's priority, and so does L through m1 */
+
+  step (h_go);
+  CHECK (h_tcb->OSTCBPrio == H_PRIO);
+  CHECK (m_tcb->OSTCBPrio == H_PRIO);
+  CHECK (l_tcb->OSTCBPrio == H_PRIO);
+  CHECK (l_tcb->OSTCBBasePrio == L_PRIO);
+
+  /* H gives up: M and L are dropped back to M's priority */
+
+  OSTimeDly (10);
+  CHECK (h_err == OS_ERR_TIMEOUT);
+  CHECK (m_tcb->OSTCBPrio == M_PRIO);
+  CHECK (l_tcb->OSTCBPrio == M_PRIO);
+
+  /* A change of M's own priority is passed on to L */
+
+  CHECK (OSTaskChangePrio (M_PRIO, M_PRIO - 1) == OS_ERR_NONE);
+  CHECK (l_tcb->OSTCBPrio == M_PRIO - 1);
+  CHECK (OSTaskChangePrio (M_PRIO - 1, M_PRIO) == OS_ERR_NONE);
+  CHECK (l_tcb->OSTCBPrio == M_PRIO);
+
+#else
+
+  /* M waits for m1: L is raised to the priority reserved by m1 */
+
+  step (m_go);
+  CHECK (l_tcb->OSTCBPrio == PIP1);
+  CHECK (m_tcb->OSTCBPrio == M_PRIO);
+
+  /* H waits for m1 too, and gives up; L keeps the reserved priority */
+
+  step (h_go);
+  OSTimeDly (10);
+  CHECK (h_err == OS_ERR_TIMEOUT);
+  CHECK (l_tcb->OSTCBPrio == PIP1);
+
+#endif
+
+  /* L releases m1: it drops back to its own priority and M takes it */
+
+  CHECK (!m_owns);
+  step (l_go);
+  CHECK (m_owns);
+  CHECK (l_tcb->OSTCBPrio == L_PRIO);
+  CHECK (m_tcb->OSTCBPrio == M_PRIO);
+
+  CHECK (OSMutexQuery (m1, &data) == OS_ERR_NONE);
+  CHECK (data.OSValue == OS_TRUE);
+  CHECK (OSMutexQuery (m2, &data) == OS_ERR_NONE);
+  CHECK (data.OSValue == OS_TRUE);
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
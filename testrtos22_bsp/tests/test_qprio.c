@@ -0,0 +1,197 @@
+/*
+ * Priority-ordered message queue test. Messages come out highest priority 
+ * first and oldest first within a priority; OSQPost() posts at the lowest 
+ * priority and OSQPostFront() ahead of all the others. A random sequence of
+ * posts and receives is checked against a model of the queue.
+ */
+
+#include "host.h"
+
+#define ROOT_PRIO    5
+#define RX_PRIO      4
+#define QSIZE        16
+#define NOPS         20000
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    rx_stk[HOST_STK_SIZE];
+
+static OS_Q_MSG  storage[QSIZE];
+static void*     fifo_storage[QSIZE];
+static OS_EVENT* q;
+static void*     rx_msg;
+
+/*
+ * The model: the messages of each priority in order, the front ones being
+ * at the head of priority 0.
+ */
+
+static void*     model[OS_Q_PRIO_LVLS][QSIZE];
+static int       model_cnt[OS_Q_PRIO_LVLS];
+static int       model_total;
+
+static void model_post (INT8U prio, void* msg)
+{
+  model[prio][model_cnt[prio]++] = msg;
+  model_total++;
+}
+
+static void model_post_front (void* msg)
+{
+  int i;
+
+  for (i = model_cnt[0]; i > 0; i--)
+  {
+    model[0][i] = model[0][i - 1];
+  }
+  model[0][0] = msg;
+  model_cnt[0]++;
+  model_total++;
+}
+
+static void* model_get (void)
+{
+  void* msg;
+  int   prio;
+  int   i;
+
+  for (prio = 0; model_cnt[prio] == 0; prio++)
+  {
+  }
+  msg = model[prio][0];
+  for (i = 1; i < model_cnt[prio]; i++)
+  {
+    model[prio][i - 1] = model[prio][i];
+  }
+  model_cnt[prio]--;
+  model_total--;
+  return msg;
+}
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+static void rx (void* pdata)
+{
+  INT8U err;
+
+  for (;;)
+  {
+    rx_msg = OSQPend (q, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+  }
+}
+
+static void root (void* pdata)
+{
+  void*     msgs[4];
+  void*     msg;
+  OS_Q_DATA data;
+  OS_EVENT* fifo;
+  INT8U     err;
+  INT16U    n;
+  int       seq = 0;
+  int       op;
+  int       cnt;
+  int       i;
+  int       j;
+
+  q = OSQCreatePrio (storage, QSIZE);
+  CHECK (q != NULL);
+
+  /* a waiting task gets the message at once, whatever its priority */
+
+  CHECK (OSTaskCreateExt (rx, NULL, &rx_stk[HOST_STK_SIZE - 1], RX_PRIO,
+                          RX_PRIO, &rx_stk[0], HOST_STK_SIZE, NULL, 0) 
+         == OS_ERR_NONE);
+  CHECK (OSQPostPrio (q, (void*) 1, OS_Q_PRIO_LVLS - 1) == OS_ERR_NONE);
+  CHECK (rx_msg == (void*) 1);
+  CHECK (OSQQuery (q, &data) == OS_ERR_NONE);
+  CHECK (data.OSNMsgs == 0);
+  CHECK (OSTaskDel (RX_PRIO) == OS_ERR_NONE);
+
+  /* invalid priorities are refused, and ignored by FIFO queues */
+
+  CHECK (OSQPostPrio (q, (void*) 1, OS_Q_PRIO_LVLS) == OS_ERR_PRIO_INVALID);
+
+  fifo = OSQCreate (fifo_storage, QSIZE);
+  CHECK (fifo != NULL);
+  CHECK (OSQPostPrio (fifo, (void*) 1, 3) == OS_ERR_NONE);
+  CHECK (OSQPostPrio (fifo, (void*) 2, 0) == OS_ERR_NONE);
+  CHECK (OSQAccept (fifo, &err) == (void*) 1);
+  CHECK (OSQAccept (fifo, &err) == (void*) 2);
+
+  /* random posts and receives, against the model */
+
+  for (i = 0; i < NOPS; i++)
+  {
+    op  = rand_next (6);
+    msg = (void*) (intptr_t) ++seq;
+
+    if ((op <= 3) && (model_total == QSIZE))
+    {
+      CHECK (OSQPostPrio (q, msg, 0) == OS_ERR_Q_FULL);
+      continue;
+    }
+
+    switch (op)
+    {
+    case 0:
+    case 1:
+      n = rand_next (OS_Q_PRIO_LVLS);
+      CHECK (OSQPostPrio (q, msg, n) == OS_ERR_NONE);
+      model_post (n, msg);
+      break;
+    case 2:
+      CHECK (OSQPost (q, msg) == OS_ERR_NONE);
+      model_post (OS_Q_PRIO_LVLS - 1, msg);
+      break;
+    case 3:
+      CHECK (OSQPostFront (q, msg) == OS_ERR_NONE);
+      model_post_front (msg);
+      break;
+    case 4:
+      msg = OSQAccept (q, &err);
+      if (model_total == 0)
+      {
+        CHECK ((msg == NULL) && (err == OS_ERR_Q_EMPTY));
+      }
+      else
+      {
+        CHECK ((err == OS_ERR_NONE) && (msg == model_get ()));
+      }
+      break;
+    case 5:
+      if (model_total != 0)
+      {
+        cnt = 1 + rand_next (4);
+        n   = OSQPendMany (q, msgs, cnt, 0, &err);
+        CHECK (err == OS_ERR_NONE);
+        CHECK (n == ((cnt < model_total) ? cnt : model_total));
+        for (j = 0; j < n; j++)
+        {
+          CHECK (msgs[j] == model_get ());
+        }
+      }
+      break;
+    }
+
+    CHECK (OSQQuery (q, &data) == OS_ERR_NONE);
+    CHECK (data.OSNMsgs == model_total);
+  }
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
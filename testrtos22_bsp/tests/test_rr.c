@@ -0,0 +1,113 @@
+/*
+ * Round-robin test. Tasks which share a priority take turns, each for its
+ * own time slice, and give up the rest of their slice with OSSchedYield().
+ *
+ * The workers deliver the clock ticks themselves, one each time round their
+ * loop, as if the timer interrupted them; each records its name before. The
+ * root task, at a higher priority, sleeps while they run and then checks the
+ * record.
+ */
+
+#include <string.h>
+
+#include "host.h"
+
+#define ROOT_PRIO    5
+#define WORKER_PRIO  10
+#define NWORKERS     3
+
+enum { TICK, YIELD };
+
+static OS_STK   root_stk[HOST_STK_SIZE];
+static OS_STK   worker_stk[NWORKERS][HOST_STK_SIZE];
+
+static const INT16U quantum[NWORKERS] = { 2, 3, 4 };
+
+static int      mode;
+static char     record[64];
+static int      nrecord;
+
+static void worker (void* pdata)
+{
+  int id = (int) (intptr_t) pdata;
+
+  CHECK (OSTaskQuantumSet (OS_PRIO_SELF, quantum[id]) == OS_ERR_NONE);
+  for (;;)
+  {
+    if (nrecord < sizeof (record) - 1)
+    {
+      record[nrecord++] = 'A' + id;
+    }
+    host_tick ();
+    if (mode == YIELD)
+    {
+      CHECK (OSSchedYield () == OS_ERR_NONE);
+    }
+  }
+}
+
+/*
+ * run() lets the workers run for "ticks" ticks in "mode", and checks what 
+ * they recorded.
+ */
+
+static void run (int new_mode, INT32U ticks, const char* expect)
+{
+  memset (record, 0, sizeof (record));
+  nrecord = 0;
+  mode    = new_mode;
+  OSTimeDly (ticks);
+  if (strcmp (record, expect))
+  {
+    printf ("recorded %s, expected %s\n", record, expect);
+    CHECK (0);
+  }
+}
+
+static void root (void* pdata)
+{
+  int i;
+
+  CHECK (OSSchedYield () == OS_ERR_YIELD_NONE);
+
+  for (i = 0; i < NWORKERS; i++)
+  {
+    CHECK (OSTaskCreateExt (worker, (void*) (intptr_t) i, 
+                            &worker_stk[i][HOST_STK_SIZE - 1], WORKER_PRIO, 
+                            WORKER_PRIO + i, &worker_stk[i][0], HOST_STK_SIZE,
+                            NULL, 0) == OS_ERR_NONE);
+  }
+
+  /* each worker runs for its time slice, in the order they were created */
+
+  run (TICK, 27, "AABBBCCCCAABBBCCCCAABBBCCCC");
+
+  /* a yield passes the turn on before the time slice is up */
+
+  run (YIELD, 6, "ABCABC");
+
+  /* 
+   * A suspended worker loses its turns. OSTaskSuspend() with the shared 
+   * priority suspends the first worker created. C was interrupted on its 
+   * first tick of the last round, and finishes its slice first.
+   */
+
+  CHECK (OSTaskSuspend (WORKER_PRIO) == OS_ERR_NONE);
+  run (TICK, 14, "CCCBBBCCCCBBBC");
+
+  /* and gets them back once resumed, at the end of the round */
+
+  CHECK (OSTaskResume (WORKER_PRIO) == OS_ERR_NONE);
+  run (TICK, 12, "CCCBBBAACCCC");
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
@@ -0,0 +1,219 @@
+/*
+ * Reader-writer lock test. Readers share the lock, a writer holds it alone,
+ * and waiting tasks are granted it in priority order, or writers first with
+ * OS_RWLOCK_OPT_WR_PREF.
+ *
+ * Each actor task carries out one call on the lock when the root task, at 
+ * the highest priority, tells it to. The root task checks the outcome once
+ * all the actors have blocked again and the idle task has delivered a tick.
+ */
+
+#include "host.h"
+
+#define ROOT_PRIO  4
+
+enum { PEND_RD, PEND_WR, POST_RD, POST_WR };
+
+typedef struct actor
+{
+  INT8U     prio;
+  OS_EVENT* go;
+  int       cmd;
+  OS_EVENT* lock;
+  OS_TICK   timeout;
+  int       done;
+  INT8U     err;
+  OS_STK    stk[HOST_STK_SIZE];
+} ACTOR;
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+
+static ACTOR     w1 = { 9 };
+static ACTOR     r1 = { 10 };
+static ACTOR     r2 = { 11 };
+static ACTOR     w2 = { 13 };
+static ACTOR     r3 = { 14 };
+
+static void actor (void* pdata)
+{
+  ACTOR* a = pdata;
+  INT8U  err;
+
+  for (;;)
+  {
+    OSSemPend (a->go, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    switch (a->cmd)
+    {
+    case PEND_RD:
+      OSRWLockPendRd (a->lock, a->timeout, &a->err);
+      break;
+    case PEND_WR:
+      OSRWLockPendWr (a->lock, a->timeout, &a->err);
+      break;
+    case POST_RD:
+      a->err = OSRWLockPostRd (a->lock);
+      break;
+    case POST_WR:
+      a->err = OSRWLockPostWr (a->lock);
+      break;
+    }
+    a->done = 1;
+  }
+}
+
+/*
+ * act() has "a" make the call "cmd" on "lock", and returns when it and any
+ * task it readied have run.
+ */
+
+static void act (ACTOR* a, int cmd, OS_EVENT* lock, OS_TICK timeout)
+{
+  a->cmd     = cmd;
+  a->lock    = lock;
+  a->timeout = timeout;
+  a->done    = 0;
+  a->err     = 0xff;
+  CHECK (OSSemPost (a->go) == OS_ERR_NONE);
+  OSTimeDly (1);
+}
+
+static void start (ACTOR* a)
+{
+  a->go = OSSemCreate (0);
+  CHECK (a->go != NULL);
+  CHECK (OSTaskCreateExt (actor, a, &a->stk[HOST_STK_SIZE - 1], a->prio,
+                          a->prio, &a->stk[0], HOST_STK_SIZE, NULL, 0) 
+         == OS_ERR_NONE);
+}
+
+static void check_state (OS_EVENT* lock, INT16U readers, INT8U writer)
+{
+  OS_RWLOCK_DATA data;
+
+  CHECK (OSRWLockQuery (lock, &data) == OS_ERR_NONE);
+  CHECK (data.OSRdCnt == readers);
+  CHECK (data.OSWrPrio == writer);
+}
+
+#define GRANTED(a) ((a).done && ((a).err == OS_ERR_NONE))
+
+static void root (void* pdata)
+{
+  OS_EVENT* lock;
+  INT8U     err;
+
+  start (&w1);
+  start (&r1);
+  start (&r2);
+  start (&w2);
+  start (&r3);
+  OSTimeDly (1);
+
+  lock = OSRWLockCreate (OS_RWLOCK_OPT_NONE, &err);
+  CHECK (err == OS_ERR_NONE);
+
+  /* readers share the lock */
+
+  act (&r1, PEND_RD, lock, 0);
+  act (&r2, PEND_RD, lock, 0);
+  CHECK (GRANTED (r1) && GRANTED (r2));
+  check_state (lock, 2, 0xff);
+
+  /* 
+   * A writer waits for the readers, and holds back the readers of lower
+   * priority, but not those of higher priority.
+   */
+
+  act (&w2, PEND_WR, lock, 0);
+  act (&r3, PEND_RD, lock, 0);
+  CHECK (!w2.done && !r3.done);
+  act (&r1, POST_RD, lock, 0);
+  act (&r1, PEND_RD, lock, 0);
+  CHECK (GRANTED (r1));
+  check_state (lock, 2, 0xff);
+
+  /* a task which holds no write lock can't release it */
+
+  act (&r1, POST_WR, lock, 0);
+  CHECK (r1.err == OS_ERR_NOT_RWLOCK_OWNER);
+
+  /* 
+   * Once the readers are gone, the waiting tasks get the lock in priority
+   * order: W1 and W2 write in turn, then R3 reads.
+   */
+
+  act (&w1, PEND_WR, lock, 0);
+  CHECK (!w1.done);
+  act (&r1, POST_RD, lock, 0);
+  CHECK (!w1.done);
+  act (&r2, POST_RD, lock, 0);
+  CHECK (GRANTED (w1) && !w2.done && !r3.done);
+  check_state (lock, 0, w1.prio);
+
+  act (&w1, POST_WR, lock, 0);
+  CHECK (w1.err == OS_ERR_NONE);
+  CHECK (GRANTED (w2) && !r3.done);
+  check_state (lock, 0, w2.prio);
+
+  act (&w2, POST_WR, lock, 0);
+  CHECK (GRANTED (r3));
+  check_state (lock, 1, 0xff);
+
+  /* a writer which gives up does not keep the lock */
+
+  act (&w1, PEND_WR, lock, 3);
+  CHECK (!w1.done);
+  OSTimeDly (5);
+  CHECK (w1.done && (w1.err == OS_ERR_TIMEOUT));
+  act (&r3, POST_RD, lock, 0);
+  check_state (lock, 0, 0xff);
+
+  OSRWLockDel (lock, OS_DEL_NO_PEND, &err);
+  CHECK (err == OS_ERR_NONE);
+
+  /* 
+   * With OS_RWLOCK_OPT_WR_PREF, a waiting writer holds back all the new
+   * readers, until it gets the lock or gives up.
+   */
+
+  lock = OSRWLockCreate (OS_RWLOCK_OPT_WR_PREF, &err);
+  CHECK (err == OS_ERR_NONE);
+
+  act (&r3, PEND_RD, lock, 0);
+  act (&w2, PEND_WR, lock, 3);
+  act (&r1, PEND_RD, lock, 0);
+  CHECK (GRANTED (r3) && !w2.done && !r1.done);
+  OSTimeDly (5);
+  CHECK (w2.done && (w2.err == OS_ERR_TIMEOUT));
+  CHECK (GRANTED (r1));
+  check_state (lock, 2, 0xff);
+
+  act (&w2, PEND_WR, lock, 0);
+  act (&r2, PEND_RD, lock, 0);
+  act (&r1, POST_RD, lock, 0);
+  act (&r3, POST_RD, lock, 0);
+  CHECK (GRANTED (w2) && !r2.done);
+  act (&w2, POST_WR, lock, 0);
+  CHECK (GRANTED (r2));
+
+  /* deleting the lock aborts the waits */
+
+  act (&w1, PEND_WR, lock, 0);
+  CHECK (!w1.done);
+  OSRWLockDel (lock, OS_DEL_ALWAYS, &err);
+  CHECK (err == OS_ERR_NONE);
+  OSTimeDly (1);
+  CHECK (w1.done && (w1.err == OS_ERR_PEND_ABORT));
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
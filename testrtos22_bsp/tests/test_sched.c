@@ -0,0 +1,157 @@
+/*
+ * Scheduler test. The highest priority ready task, and the highest priority
+ * task waiting for an event, are found by counting the leading zeros of the
+ * words of the ready and event tables.
+ *
+ * The test is built twice: as test_sched with the BSP's OS_LOWEST_PRIO, so 
+ * that all the priorities fit in one word, and as test_sched_wide with more
+ * priorities, so that the group of the table is used as well.
+ */
+
+#include "host.h"
+
+#define NTASKS     (OS_MAX_TASKS - 1)
+#define ROOT_PRIO  (OS_LOWEST_PRIO - 2)
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    task_stk[NTASKS][HOST_STK_SIZE];
+
+static INT8U     task_prio[NTASKS];
+static INT8U     order[NTASKS];
+static int       norder;
+static OS_EVENT* sem;
+
+static void task (void* pdata)
+{
+  INT8U err;
+
+  for (;;)
+  {
+    order[norder++] = OSTCBCur->OSTCBPrio;
+    OSSemPend (sem, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    order[norder++] = OSTCBCur->OSTCBPrio;
+    CHECK (OSTaskSuspend (OS_PRIO_SELF) == OS_ERR_NONE);
+  }
+}
+
+/*
+ * check_order() checks that the tasks recorded themselves from the highest
+ * priority (first = 0) to the lowest, after the one which had "first". 
+ */
+
+static void check_order (INT8U first)
+{
+  int i;
+
+  CHECK (norder == NTASKS);
+  CHECK (order[0] == first);
+  for (i = 2; i < NTASKS; i++)
+  {
+    CHECK (order[i - 1] < order[i]);
+  }
+  norder = 0;
+}
+
+static void root (void* pdata)
+{
+  INT8U  err;
+  INT8U  lowest;
+  int    i;
+  int    j;
+
+  /* count leading zeros, of a single bit and with the lower bits set */
+
+  for (i = 0; i < 32; i++)
+  {
+    CHECK (OS_CntLeadZeros ((INT32U) 1 << i) == 31 - i);
+    CHECK (OS_CntLeadZeros (0xffffffffu >> (31 - i)) == 31 - i);
+    CHECK (OS_CntLeadZeros (((INT32U) 1 << i) | 1) == 31 - i);
+  }
+
+  /* 
+   * Tasks created with the scheduler locked run from the highest priority
+   * to the lowest once it is unlocked. They are created out of order.
+   */
+
+  sem = OSSemCreate (0);
+  CHECK (sem != NULL);
+
+  OSSchedLock ();
+  for (i = 0; i < NTASKS; i++)
+  {
+    j = (i * 5) % NTASKS;
+    CHECK (OSTaskCreateExt (task, NULL, &task_stk[j][HOST_STK_SIZE - 1], 
+                            task_prio[j], task_prio[j], &task_stk[j][0], 
+                            HOST_STK_SIZE, NULL, 0) == OS_ERR_NONE);
+  }
+  CHECK (norder == 0);
+  OSSchedUnlock ();
+  check_order (task_prio[0]);
+
+  /* Each post readies the highest priority task waiting */
+
+  for (i = 0; i < NTASKS; i++)
+  {
+    CHECK (sem->OSEventGrp != 0);
+    CHECK (OSSemPost (sem) == OS_ERR_NONE);
+  }
+  CHECK (sem->OSEventGrp == 0);
+  check_order (task_prio[0]);
+
+  /* 
+   * The lowest priority task moved to the highest priority runs first, and 
+   * the others after it in order.
+   */
+
+  lowest = task_prio[NTASKS - 1];
+  OSSchedLock ();
+  for (i = 0; i < NTASKS; i++)
+  {
+    CHECK (OSTaskResume (task_prio[i]) == OS_ERR_NONE);
+  }
+  CHECK (OSTaskChangePrio (lowest, 0) == OS_ERR_NONE);
+  OSSchedUnlock ();
+  CHECK (norder == NTASKS);
+  CHECK (order[0] == 0);
+  for (i = 1; i < NTASKS; i++)
+  {
+    CHECK (order[i] == task_prio[i - 1]);
+  }
+  norder = 0;
+
+  /* and it keeps its new priority while waiting */
+
+  CHECK (OSSemPost (sem) == OS_ERR_NONE);
+  CHECK (norder == 1);
+  CHECK (order[0] == 0);
+
+  /* the lowest priority is reached with a higher one ready but suspended */
+
+  OSSemDel (sem, OS_DEL_ALWAYS, &err);
+  CHECK (err == OS_ERR_NONE);
+  CHECK (OSTCBCur->OSTCBPrio == ROOT_PRIO);
+
+  host_pass ();
+}
+
+int main (void)
+{
+  int i;
+
+  /* 
+   * Priorities from 1 to below ROOT_PRIO, spread over all the words of the
+   * ready table.
+   */
+
+  for (i = 0; i < NTASKS; i++)
+  {
+    task_prio[i] = 1 + i * (ROOT_PRIO - 2) / (NTASKS - 1);
+  }
+
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
@@ -0,0 +1,100 @@
+/*
+ * CPU usage test, with OS_TASK_STAT_TS_EN. The idle task is kept busy: its
+ * hook spins for IDLE_NS before it delivers each tick, as an idle hook which
+ * does work would. A load task spins for a given time after each tick, and
+ * OSCPUUsage must report the share of the time it took, the idle hook's work
+ * not counting as busy. Before the first statistics period has ended, 
+ * OSCPUUsage must stay 0.
+ *
+ * The spins are timed with OSCPUTsGet(), which also gives the profiling
+ * timestamps, so the shares hold however fast the host runs.
+ */
+
+#include "host.h"
+
+#define ROOT_PRIO   5
+#define LOAD_PRIO   10
+
+#define IDLE_NS     200000
+#define STAT_TICKS  (OS_TICKS_PER_SEC / 10)
+
+static OS_STK  root_stk[HOST_STK_SIZE];
+static OS_STK  load_stk[HOST_STK_SIZE];
+
+static alt_u32 load_ns;
+
+static void spin (alt_u32 ns)
+{
+  INT32U start = OSCPUTsGet ();
+
+  while (OSCPUTsGet () - start < ns)
+  {
+  }
+}
+
+static void idle (void)
+{
+  spin (IDLE_NS);
+  host_tick ();
+}
+
+static void load (void* pdata)
+{
+  for (;;)
+  {
+    spin (load_ns);
+    OSTimeDly (1);
+  }
+}
+
+/*
+ * measure() runs the load for three statistics periods and returns the CPU
+ * usage reported for the last.
+ */
+
+static INT8U measure (alt_u32 ns)
+{
+  load_ns = ns;
+  OSTimeDly (3 * STAT_TICKS);
+  return OSCPUUsage;
+}
+
+static void root (void* pdata)
+{
+  INT8U usage;
+  int   i;
+
+  /* nothing is reported before the first period is over */
+
+  OSStatInit ();
+  for (i = 0; i < STAT_TICKS - 2; i++)
+  {
+    OSTimeDly (1);
+    CHECK (OSCPUUsage == 0);
+  }
+
+  CHECK (OSTaskCreateExt (load, NULL, &load_stk[HOST_STK_SIZE - 1], LOAD_PRIO,
+                          LOAD_PRIO, &load_stk[0], HOST_STK_SIZE, NULL, 0) 
+         == OS_ERR_NONE);
+
+  /* no load, half and three quarters of the time */
+
+  usage = measure (0);
+  CHECK (usage <= 10);
+  usage = measure (IDLE_NS);
+  CHECK ((usage >= 40) && (usage <= 60));
+  usage = measure (3 * IDLE_NS);
+  CHECK ((usage >= 65) && (usage <= 85));
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  host_idle = idle;
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
@@ -0,0 +1,218 @@
+/*
+ * Objects from caller storage. The kernel is built without any pool of
+ * events, queues, flag groups, memory partitions or timers (see
+ * cfg_static.h), so each kind of object is created with its
+ * ...CreateStatic() function. Each one is used, deleted while a task
+ * waits on it where it can be waited on, and created again in the same
+ * storage; memory partitions have no delete and are only used.
+ */
+
+#include "host.h"
+
+#define WAITER_PRIO 4
+#define ROOT_PRIO   (WAITER_PRIO + 1)
+
+#define TMR_TICKS   (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    waiter_stk[HOST_STK_SIZE];
+
+/*
+ * The waiter pends once on "pevent" each time "go" is posted. It has a
+ * higher priority than the root task, so it has blocked or returned when
+ * OSSemPost() returns.
+ */
+
+static OS_EVENT  go_ev;
+static OS_EVENT* go;
+static OS_EVENT* pevent;
+static int       waiting;
+static INT8U     waiter_err;
+
+static void waiter (void* pdata)
+{
+  INT16U len;
+  INT8U  err;
+
+  for (;;)
+  {
+    OSSemPend (go, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    switch (pevent->OSEventType)
+    {
+    case OS_EVENT_TYPE_SEM:
+      OSSemPend (pevent, 0, &waiter_err);
+      break;
+    case OS_EVENT_TYPE_MUTEX:
+      OSMutexPend (pevent, 0, &waiter_err);
+      break;
+    case OS_EVENT_TYPE_MBOX:
+      (void) OSMboxPend (pevent, 0, &waiter_err);
+      break;
+    case OS_EVENT_TYPE_Q:
+      (void) OSQPend (pevent, 0, &waiter_err);
+      break;
+    case OS_EVENT_TYPE_RWLOCK:
+      OSRWLockPendWr (pevent, 0, &waiter_err);
+      break;
+    default:
+      (void) OSBufGet (pevent, &len, 0, &waiter_err);
+      break;
+    }
+    waiting = 0;
+  }
+}
+
+/*
+ * Have the waiter pend on "ev", and check that deleting "ev" readies it
+ * with "err_del": like their stock ...Del(), the services of uC/OS-II
+ * return OS_ERR_NONE, the newer ones OS_ERR_PEND_ABORT.
+ */
+
+static void wait_and_delete (OS_EVENT* ev,
+                             OS_EVENT* (*del) (OS_EVENT*, INT8U, INT8U*),
+                             INT8U err_del)
+{
+  INT8U err;
+
+  pevent  = ev;
+  waiting = 1;
+  CHECK (OSSemPost (go) == OS_ERR_NONE);
+  CHECK (waiting);
+  CHECK (del (ev, OS_DEL_NO_PEND, &err) == ev);
+  CHECK (err == OS_ERR_TASK_WAITING);
+  CHECK (del (ev, OS_DEL_ALWAYS, &err) == NULL);
+  CHECK (err == OS_ERR_NONE);
+  CHECK (!waiting);
+  CHECK (waiter_err == err_del);
+  CHECK (ev->OSEventType == OS_EVENT_TYPE_UNUSED);
+}
+
+static int tmr_calls;
+
+static void tmr_callback (void* ptmr, void* parg)
+{
+  tmr_calls++;
+}
+
+static void root (void* pdata)
+{
+  static OS_EVENT    ev;
+  static OS_FLAG_GRP grp;
+  static OS_Q        q;
+  static void*       q_msgs[4];
+  static OS_BUF      buf;
+  static INT32U      buf_storage[16];
+  static OS_MEM      mem;
+  static INT32U      blks[4][4];
+  static OS_TMR      tmr;
+  void*              blk[4];
+  INT16U             len;
+  INT8U              err;
+  int                i;
+
+  go = OSSemCreateStatic (&go_ev, 0);
+  CHECK (go == &go_ev);
+  CHECK (OSTaskCreateExt (waiter, NULL, &waiter_stk[HOST_STK_SIZE - 1],
+                          WAITER_PRIO, WAITER_PRIO, &waiter_stk[0],
+                          HOST_STK_SIZE, NULL, 0) == OS_ERR_NONE);
+
+  /* each event in turn in the same storage, twice */
+
+  for (i = 0; i < 2; i++)
+  {
+    CHECK (OSSemCreateStatic (&ev, 1) == &ev);
+    CHECK (OSSemAccept (&ev) == 1);
+    wait_and_delete (&ev, OSSemDel, OS_ERR_NONE);
+
+    CHECK (OSMutexCreateStatic (&ev, 2, &err) == &ev);
+    CHECK (err == OS_ERR_NONE);
+    CHECK (OSMutexAccept (&ev, &err) == OS_TRUE);
+    wait_and_delete (&ev, OSMutexDel, OS_ERR_NONE);
+    CHECK (OSTCBPrioTbl[2] == NULL);
+
+    CHECK (OSMboxCreateStatic (&ev, &blks[0]) == &ev);
+    CHECK (OSMboxAccept (&ev) == &blks[0]);
+    wait_and_delete (&ev, OSMboxDel, OS_ERR_NONE);
+
+    CHECK (OSQCreateStatic (&ev, &q, q_msgs, 4) == &ev);
+    CHECK (OSQPost (&ev, &blks[1]) == OS_ERR_NONE);
+    CHECK (OSQAccept (&ev, &err) == &blks[1]);
+    wait_and_delete (&ev, OSQDel, OS_ERR_NONE);
+
+    CHECK (OSRWLockCreateStatic (&ev, OS_RWLOCK_OPT_NONE, &err) == &ev);
+    CHECK (err == OS_ERR_NONE);
+    OSRWLockPendRd (&ev, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    wait_and_delete (&ev, OSRWLockDel, OS_ERR_PEND_ABORT);
+
+    CHECK (OSBufCreateStatic (&ev, &buf, buf_storage, sizeof (buf_storage),
+                              &err) == &ev);
+    CHECK (err == OS_ERR_NONE);
+    blk[0] = OSBufReserve (&ev, 8, 0, &err);
+    CHECK (OSBufCommit (&ev, blk[0], 8) == OS_ERR_NONE);
+    CHECK (OSBufGet (&ev, &len, 0, &err) == blk[0]);
+    CHECK (OSBufRelease (&ev, blk[0]) == OS_ERR_NONE);
+    wait_and_delete (&ev, OSBufDel, OS_ERR_PEND_ABORT);
+  }
+
+  /* the flag group */
+
+  for (i = 0; i < 2; i++)
+  {
+    CHECK (OSFlagCreateStatic (&grp, 0x0f, &err) == &grp);
+    CHECK (err == OS_ERR_NONE);
+    CHECK (OSFlagAccept (&grp, 0x03, OS_FLAG_WAIT_SET_ALL + OS_FLAG_CONSUME,
+                         &err) == 0x03);
+    CHECK (OSFlagQuery (&grp, &err) == 0x0c);
+    CHECK (OSFlagDel (&grp, OS_DEL_NO_PEND, &err) == NULL);
+    CHECK (err == OS_ERR_NONE);
+    CHECK (grp.OSFlagType == OS_EVENT_TYPE_UNUSED);
+  }
+
+  /* the memory partition */
+
+  CHECK (OSMemCreateStatic (&mem, blks, 4, sizeof (blks[0]), &err) == &mem);
+  CHECK (err == OS_ERR_NONE);
+  for (i = 0; i < 4; i++)
+  {
+    blk[i] = OSMemGet (&mem, &err);
+    CHECK (err == OS_ERR_NONE);
+  }
+  CHECK (OSMemGet (&mem, &err) == NULL);
+  CHECK (err == OS_ERR_MEM_NO_FREE_BLKS);
+  for (i = 0; i < 4; i++)
+  {
+    CHECK (OSMemPut (&mem, blk[i]) == OS_ERR_NONE);
+  }
+  CHECK (OSMemPut (&mem, blk[0]) == OS_ERR_MEM_FULL);
+
+  /* the timer, which runs once, then is deleted while it runs */
+
+  for (i = 0; i < 2; i++)
+  {
+    CHECK (OSTmrCreateStatic (&tmr, 2, 0, OS_TMR_OPT_ONE_SHOT, tmr_callback,
+                              NULL, (INT8U*) "static", &err) == &tmr);
+    CHECK (err == OS_ERR_NONE);
+    CHECK (OSTmrStart (&tmr, &err) == OS_TRUE);
+    OSTimeDly (3 * TMR_TICKS);
+    CHECK (tmr_calls == i + 1);
+    CHECK (OSTmrStateGet (&tmr, &err) == OS_TMR_STATE_COMPLETED);
+    CHECK (OSTmrStart (&tmr, &err) == OS_TRUE);
+    CHECK (OSTmrDel (&tmr, &err) == OS_TRUE);
+    CHECK (err == OS_ERR_NONE);
+    OSTimeDly (3 * TMR_TICKS);
+    CHECK (tmr_calls == i + 1);
+  }
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
@@ -0,0 +1,321 @@
+/*
+ * Task semaphore and message slot test. A worker task pends on its own
+ * semaphore with OSTaskSemPend() or on its message slot with
+ * OSTaskMsgPend() when the root task tells it to. Posts made before a
+ * pend are counted, or kept in the slot, which refuses a second message;
+ * pends time out, are aborted, and are readied by posts made by the root
+ * task or by an ISR. A random sequence of these is then checked against a
+ * model of the count and the slot.
+ */
+
+#include "host.h"
+
+#define WORKER_PRIO 4
+#define ROOT_PRIO   (WORKER_PRIO + 1)
+#define NOPS        20000
+
+#define OP_SEM      0
+#define OP_MSG      1
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    worker_stk[HOST_STK_SIZE];
+
+/*
+ * The worker makes one call each time "go" is posted. It has a higher
+ * priority than the root task, so it has blocked or returned when
+ * OSSemPost() returns.
+ */
+
+static struct
+{
+  OS_EVENT* go;
+  int       op;
+  OS_TICK   timeout;
+  int       waiting;
+  void*     msg;
+  INT8U     err;
+  INT32U    done_at;    /* OSTimeGet() when the call returned */
+} w;
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+static void worker (void* pdata)
+{
+  INT8U err;
+
+  for (;;)
+  {
+    OSSemPend (w.go, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    if (w.op == OP_SEM)
+    {
+      OSTaskSemPend (w.timeout, &w.err);
+      w.msg = NULL;
+    }
+    else
+    {
+      w.msg = OSTaskMsgPend (w.timeout, &w.err);
+    }
+    w.done_at = OSTimeGet ();
+    w.waiting = 0;
+  }
+}
+
+static void start (int op, OS_TICK timeout)
+{
+  w.op      = op;
+  w.timeout = timeout;
+  w.waiting = 1;
+  CHECK (OSSemPost (w.go) == OS_ERR_NONE);
+}
+
+/* The posts made by isr_post() */
+
+static int   isr_op;
+static void* isr_msg;
+static INT8U isr_err;
+
+static void isr_post (void* context)
+{
+  (void) context;
+  if (isr_op == OP_SEM)
+  {
+    isr_err = OSTaskSemPost (WORKER_PRIO);
+  }
+  else
+  {
+    isr_err = OSTaskMsgPost (WORKER_PRIO, isr_msg);
+  }
+}
+
+static INT8U post (int op, void* msg, int from_isr)
+{
+  if (from_isr)
+  {
+    isr_op  = op;
+    isr_msg = msg;
+    host_isr (isr_post, NULL);
+    return isr_err;
+  }
+  return (op == OP_SEM) ? OSTaskSemPost (WORKER_PRIO)
+                        : OSTaskMsgPost (WORKER_PRIO, msg);
+}
+
+static int msgs[2];
+
+static void cases (void)
+{
+  INT32U t;
+  int    i;
+
+  CHECK (OSTaskSemPost (OS_LOWEST_PRIO + 1) == OS_ERR_PRIO_INVALID);
+  CHECK (OSTaskSemPost (ROOT_PRIO + 1) == OS_ERR_TASK_NOT_EXIST);
+  CHECK (OSTaskMsgPost (ROOT_PRIO + 1, &msgs[0]) == OS_ERR_TASK_NOT_EXIST);
+  CHECK (OSTaskMsgPost (WORKER_PRIO, NULL) == OS_ERR_POST_NULL_PTR);
+
+  /* posts made before the pends are counted, the last pend blocks */
+
+  for (i = 0; i < 3; i++)
+  {
+    CHECK (post (OP_SEM, NULL, i == 1) == OS_ERR_NONE);
+  }
+  t = OSTimeGet ();
+  for (i = 0; i < 3; i++)
+  {
+    start (OP_SEM, 0);
+    CHECK (!w.waiting);
+    CHECK (w.err == OS_ERR_NONE);
+  }
+  CHECK (OSTimeGet () == t);
+  start (OP_SEM, 0);
+  CHECK (w.waiting);
+  CHECK (OSTaskSemPost (WORKER_PRIO) == OS_ERR_NONE);
+  CHECK (!w.waiting);
+  CHECK (w.err == OS_ERR_NONE);
+
+  /* timeout, abort, and a post from an ISR */
+
+  start (OP_SEM, 5);
+  t = OSTimeGet ();
+  OSTimeDly (5);
+  CHECK (!w.waiting);
+  CHECK (w.err == OS_ERR_TIMEOUT);
+  CHECK (w.done_at == t + 5);
+
+  CHECK (OSTaskSemPendAbort (WORKER_PRIO) == OS_ERR_NONE);
+  start (OP_SEM, 5);
+  CHECK (OSTaskSemPendAbort (WORKER_PRIO) == OS_ERR_PEND_ABORT);
+  CHECK (!w.waiting);
+  CHECK (w.err == OS_ERR_PEND_ABORT);
+
+  start (OP_SEM, 0);
+  CHECK (post (OP_SEM, NULL, 1) == OS_ERR_NONE);
+  CHECK (!w.waiting);
+  CHECK (w.err == OS_ERR_NONE);
+
+  /* the count saturates */
+
+  for (i = 0; i < 65535; i++)
+  {
+    CHECK (OSTaskSemPost (WORKER_PRIO) == OS_ERR_NONE);
+  }
+  CHECK (OSTaskSemPost (WORKER_PRIO) == OS_ERR_SEM_OVF);
+  for (i = 0; i < 65535; i++)
+  {
+    start (OP_SEM, 1);
+    CHECK (w.err == OS_ERR_NONE);
+  }
+  start (OP_SEM, 1);
+  OSTimeDly (1);
+  CHECK (w.err == OS_ERR_TIMEOUT);
+
+  /* the slot keeps a message posted before the pend, and refuses a second */
+
+  CHECK (post (OP_MSG, &msgs[0], 0) == OS_ERR_NONE);
+  CHECK (post (OP_MSG, &msgs[1], 0) == OS_ERR_MBOX_FULL);
+  CHECK (post (OP_MSG, &msgs[1], 1) == OS_ERR_MBOX_FULL);
+  start (OP_MSG, 0);
+  CHECK (!w.waiting);
+  CHECK ((w.err == OS_ERR_NONE) && (w.msg == &msgs[0]));
+  start (OP_MSG, 0);
+  CHECK (w.waiting);
+  CHECK (post (OP_MSG, &msgs[1], 1) == OS_ERR_NONE);
+  CHECK (!w.waiting);
+  CHECK ((w.err == OS_ERR_NONE) && (w.msg == &msgs[1]));
+
+  start (OP_MSG, 3);
+  t = OSTimeGet ();
+  OSTimeDly (3);
+  CHECK (!w.waiting);
+  CHECK ((w.err == OS_ERR_TIMEOUT) && (w.msg == NULL));
+  CHECK (w.done_at == t + 3);
+
+  CHECK (OSTaskMsgPendAbort (WORKER_PRIO) == OS_ERR_NONE);
+  start (OP_MSG, 0);
+  CHECK (OSTaskMsgPendAbort (WORKER_PRIO) == OS_ERR_PEND_ABORT);
+  CHECK (!w.waiting);
+  CHECK ((w.err == OS_ERR_PEND_ABORT) && (w.msg == NULL));
+
+  /* a post of the other kind leaves the pend alone */
+
+  start (OP_MSG, 0);
+  CHECK (OSTaskSemPost (WORKER_PRIO) == OS_ERR_NONE);
+  CHECK (OSTaskSemPendAbort (WORKER_PRIO) == OS_ERR_NONE);
+  CHECK (w.waiting);
+  CHECK (OSTaskMsgPost (WORKER_PRIO, &msgs[0]) == OS_ERR_NONE);
+  CHECK (!w.waiting);
+  start (OP_SEM, 0);
+  CHECK (!w.waiting);
+  CHECK (w.err == OS_ERR_NONE);
+}
+
+/*
+ * The model: "count" is the count of the semaphore, and "slot" the message
+ * in the slot while the worker doesn't wait.
+ */
+
+static void random_ops (void)
+{
+  alt_u32 count = 0;
+  void*   slot  = NULL;
+  void*   msg;
+  INT32U  t;
+  INT8U   err;
+  int     op;
+  int     i;
+
+  for (i = 0; i < NOPS; i++)
+  {
+    op  = rand_next (2);
+    msg = &msgs[rand_next (2)];
+    switch (rand_next (3))
+    {
+    case 0:
+      err = post (op, msg, rand_next (2));
+      if (op == OP_SEM)
+      {
+        CHECK (err == OS_ERR_NONE);
+        count++;
+      }
+      else
+      {
+        CHECK (err == ((slot == NULL) ? OS_ERR_NONE : OS_ERR_MBOX_FULL));
+        slot = (slot == NULL) ? msg : slot;
+      }
+      break;
+
+    case 1:
+      start (op, 1 + rand_next (3));
+      if ((op == OP_SEM) ? (count > 0) : (slot != NULL))
+      {
+        CHECK (!w.waiting);
+        CHECK (w.err == OS_ERR_NONE);
+        CHECK (w.msg == ((op == OP_SEM) ? NULL : slot));
+        if (op == OP_SEM)
+        {
+          count--;
+        }
+        slot = (op == OP_SEM) ? slot : NULL;
+        break;
+      }
+      CHECK (w.waiting);
+      t = OSTimeGet ();
+      switch (rand_next (3))
+      {
+      case 0:
+        OSTimeDly (w.timeout);
+        CHECK (!w.waiting);
+        CHECK (w.err == OS_ERR_TIMEOUT);
+        CHECK (w.done_at == t + w.timeout);
+        break;
+      case 1:
+        CHECK (((op == OP_SEM) ? OSTaskSemPendAbort (WORKER_PRIO)
+                               : OSTaskMsgPendAbort (WORKER_PRIO))
+               == OS_ERR_PEND_ABORT);
+        CHECK (!w.waiting);
+        CHECK (w.err == OS_ERR_PEND_ABORT);
+        break;
+      default:
+        CHECK (post (op, msg, rand_next (2)) == OS_ERR_NONE);
+        CHECK (!w.waiting);
+        CHECK (w.err == OS_ERR_NONE);
+        CHECK (w.msg == ((op == OP_SEM) ? NULL : msg));
+        break;
+      }
+      break;
+
+    default:
+      OSTimeDly (1);
+      break;
+    }
+  }
+}
+
+static void root (void* pdata)
+{
+  w.go = OSSemCreate (0);
+  CHECK (w.go != NULL);
+  CHECK (OSTaskCreateExt (worker, NULL, &worker_stk[HOST_STK_SIZE - 1],
+                          WORKER_PRIO, WORKER_PRIO, &worker_stk[0],
+                          HOST_STK_SIZE, NULL, 0) == OS_ERR_NONE);
+
+  cases ();
+  random_ops ();
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
@@ -0,0 +1,263 @@
+/*
+ * Tickless idle test, on the model of the system clock timer in 
+ * host/timer_model.c. Tasks sleep for random delays and a HAL alarm is 
+ * restarted for random periods, so that the idle task stretches the tick
+ * period over the ticks where nothing is due; a high resolution timer posts
+ * a semaphore at random times, and so does the interrupt of another 
+ * device, which end some stretched periods early.
+ *
+ * OSTimeGet() must stay equal to alt_nticks() and to the number of tick 
+ * boundaries elapsed in real time, delays and alarms must expire on the 
+ * tick they are due, and OSTimeTickHook() must only be called for the 
+ * ticks which are processed, not for the credited ones.
+ */
+
+#include "host.h"
+#include "timer_model.h"
+
+#include "sys/alt_alarm.h"
+#include "sys/alt_hrtimer.h"
+#include "altera_avalon_timer.h"
+
+#define PERIOD       ((alt_u64) SYS_CLK_TIMER_LOAD_VALUE + 1)
+
+/*
+ * How much further each timer interrupt may move the tick boundaries behind
+ * real time: the interrupt which restores the normal period realigns them
+ * on the time it reads, a few register accesses after the timeout.
+ */
+
+#define SLACK        256
+
+#define NSLEEPERS    4
+#define SLEEPER_PRIO 4
+#define POSTED_PRIO  (SLEEPER_PRIO + NSLEEPERS)
+#define DEVICE_PRIO  (POSTED_PRIO + 1)
+#define MAX_DLY      200
+#define NWAKES       2000
+
+static OS_STK    sleeper_stk[NSLEEPERS][HOST_STK_SIZE];
+static OS_STK    posted_stk[HOST_STK_SIZE];
+static OS_STK    device_stk[HOST_STK_SIZE];
+
+static OS_EVENT*   sem;
+static OS_EVENT*   device_sem;
+static alt_hrtimer timer;
+static alt_alarm   tick_alarm;
+static alt_u32     alarm_due;
+static int         nalarms;
+static int         nwakes;
+static int         nposts;
+static int         ndevice;
+
+/* The calls of OSTimeTickHook(), and the interrupts which woke up the CPU */
+
+static alt_u32     nhooks;
+static alt_u32     nirqs;
+
+/* The model's time when the driver started the timer: its time zero */
+
+static alt_u64 zero;
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+/*
+ * check_tick() is called on a tick boundary, when a delay or an alarm has 
+ * expired. Real time is ahead of the ticks by "lag", the position of the
+ * tick boundaries, and by the time taken to get here, up to SLACK. The 
+ * boundaries only move later, by up to SLACK for each interrupt since the
+ * last check: a tick lost or counted twice would move them by a period.
+ */
+
+static alt_u64 lag;
+static alt_u32 lag_irqs;
+
+static void check_tick (void)
+{
+  alt_u64 real = host_timer_cycles - zero;
+  alt_u64 ticks_time = (alt_u64) alt_nticks () * PERIOD;
+
+  CHECK (real + SLACK >= ticks_time + lag);
+  CHECK (real <= ticks_time + lag + SLACK * (nirqs - lag_irqs + 1));
+  if (real > ticks_time + lag)
+  {
+    lag = real - ticks_time;
+  }
+  lag_irqs = nirqs;
+}
+
+/*
+ * check_between() is called between two tick boundaries, after the high 
+ * resolution timer's or the device's interrupt.
+ */
+
+static void check_between (void)
+{
+  alt_u64 real = host_timer_cycles - zero;
+  alt_u64 ticks_time = (alt_u64) OSTimeGet () * PERIOD;
+
+  CHECK (OSTimeGet () == alt_nticks ());
+  CHECK (real + SLACK >= ticks_time + lag);
+  CHECK (real < ticks_time + lag + SLACK * (nirqs - lag_irqs + 1) + PERIOD);
+}
+
+static void time_tick (void)
+{
+  nhooks++;
+}
+
+static void device_isr (void* context)
+{
+  (void) context;
+  CHECK (OSSemPost (device_sem) == OS_ERR_NONE);
+}
+
+/*
+ * The idle CPU sleeps until the timer interrupt, or is woken up earlier by 
+ * the device's interrupt, which makes the port resume the normal tick.
+ */
+
+static void idle (void)
+{
+  alt_u64 left = host_timer_timeout ();
+
+  nirqs++;
+  if ((rand_next (4) == 0) && (left > SLACK))
+  {
+    host_timer_run (rand_next (left - SLACK));
+    host_isr (device_isr, NULL);
+  }
+  else
+  {
+    host_timer_sleep ();
+  }
+}
+
+static void finish (void)
+{
+  /* most ticks were credited, without a call of the tick hook */
+
+  CHECK (nhooks <= nirqs);
+  CHECK (nhooks < OSTimeGet () / 4);
+  CHECK (nalarms > NWAKES / 10);
+  CHECK (nposts > NWAKES / 10);
+  CHECK (ndevice > NWAKES / 10);
+  host_pass ();
+}
+
+static alt_u32 alarm_callback (void* context)
+{
+  alt_u32 nticks = 1 + rand_next (MAX_DLY);
+
+  /* OSTimeTick() is called after the alarm callbacks of the tick */
+
+  (void) context;
+  CHECK (alt_nticks () == alarm_due);
+  CHECK (OSTimeGet () + 1 == alarm_due);
+  check_tick ();
+  nalarms++;
+  alarm_due += nticks;
+  return nticks;
+}
+
+static void timer_callback (void* context)
+{
+  (void) context;
+  CHECK (OSSemPost (sem) == OS_ERR_NONE);
+}
+
+static void sleeper (void* pdata)
+{
+  INT32U start;
+  INT32U dly;
+
+  (void) pdata;
+  for (;;)
+  {
+    start = OSTimeGet ();
+    dly   = 1 + rand_next (MAX_DLY);
+    OSTimeDly (dly);
+    CHECK (OSTimeGet () == start + dly);
+    CHECK (alt_nticks () == start + dly);
+    check_tick ();
+    if (++nwakes == NWAKES)
+    {
+      finish ();
+    }
+  }
+}
+
+/* 
+ * The posted task starts the high resolution timer at a random time, up to 
+ * ten periods ahead, and waits for its post.
+ */
+
+static void posted (void* pdata)
+{
+  INT8U err;
+
+  (void) pdata;
+  for (;;)
+  {
+    CHECK (alt_hrtimer_start (&timer, 
+                              1 + rand_next (10000000 / OS_TICKS_PER_SEC), 
+                              timer_callback, NULL) == 0);
+    OSSemPend (sem, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    check_between ();
+    nposts++;
+  }
+}
+
+static void device (void* pdata)
+{
+  INT8U err;
+
+  (void) pdata;
+  for (;;)
+  {
+    OSSemPend (device_sem, 0, &err);
+    CHECK (err == OS_ERR_NONE);
+    check_between ();
+    ndevice++;
+  }
+}
+
+int main (void)
+{
+  int i;
+
+  host_init ();
+  alt_avalon_timer_sc_init ((void*) SYS_CLK_TIMER_BASE,
+                            SYS_CLK_TIMER_IRQ_INTERRUPT_CONTROLLER_ID,
+                            SYS_CLK_TIMER_IRQ, SYS_CLK_TIMER_TICKS_PER_SEC);
+  zero           = host_timer_cycles;
+  host_idle      = idle;
+  host_time_tick = time_tick;
+
+  sem        = OSSemCreate (0);
+  device_sem = OSSemCreate (0);
+  CHECK ((sem != NULL) && (device_sem != NULL));
+
+  alarm_due = alt_nticks () + 1 + 50;
+  CHECK (alt_alarm_start (&tick_alarm, 50, alarm_callback, NULL) == 0);
+
+  for (i = 0; i < NSLEEPERS; i++)
+  {
+    CHECK (OSTaskCreate (sleeper, NULL, &sleeper_stk[i][HOST_STK_SIZE - 1],
+                         SLEEPER_PRIO + i) == OS_ERR_NONE);
+  }
+  CHECK (OSTaskCreate (posted, NULL, &posted_stk[HOST_STK_SIZE - 1],
+                       POSTED_PRIO) == OS_ERR_NONE);
+  CHECK (OSTaskCreate (device, NULL, &device_stk[HOST_STK_SIZE - 1],
+                       DEVICE_PRIO) == OS_ERR_NONE);
+
+  OSStart ();
+  return 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * Tick list test. Task delays, pend timeouts and the timer task share the
+ * port's tick list (the HAL alarm list). Tasks sleep for random delays, 
+ * with OSTimeDly() or a pend timeout, and must wake up exactly on time 
+ * unless they are resumed or posted first; OSTaskQuery() must report the
+ * ticks they have left. Then one-shot and periodic OS timers must call
+ * back on the timer tick they are due, and the timer task's node must 
+ * leave the list once no timer runs. Last, OSTimeDlyUntil() must wake up
+ * on the absolute tick it is given, and a periodic task must keep to its
+ * grid of activations across random work and overruns.
+ */
+
+#include "host.h"
+
+#define NSLEEPERS    6
+#define SLEEPER_PRIO 4
+#define ROOT_PRIO    (SLEEPER_PRIO + NSLEEPERS)
+#define MAX_DLY      50
+#define NOPS         3000
+#define PERIOD       7
+#define NPERIODS     500
+
+#define TMR_TICKS    (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)
+
+static OS_STK    root_stk[HOST_STK_SIZE];
+static OS_STK    sleeper_stk[NSLEEPERS][HOST_STK_SIZE];
+
+/*
+ * How a sleeper was woken up: by its timeout, by OSTimeDlyResume() or by a
+ * post of its semaphore.
+ */
+
+#define WOKEN_TIMEOUT 0
+#define WOKEN_RESUMED 1
+#define WOKEN_POSTED  2
+
+typedef struct
+{
+  OS_EVENT* sem;         /* NULL to sleep with OSTimeDly() */
+  INT32U    start;       /* OSTimeGet() when it went to sleep */
+  INT16U    dly;         /* Its delay or timeout */
+  int       woken;       /* How it is to be woken up */
+  INT32U    woken_at;    /* OSTimeGet() when resumed or posted */
+  int       nwakes;
+} SLEEPER;
+
+static SLEEPER sleepers[NSLEEPERS];
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+static void sleeper (void* pdata)
+{
+  SLEEPER* s = (SLEEPER*) pdata;
+  INT8U    err = OS_ERR_TIMEOUT;
+
+  for (;;)
+  {
+    s->start = OSTimeGet ();
+    s->dly   = 1 + rand_next (MAX_DLY);
+    s->woken = WOKEN_TIMEOUT;
+    if (s->sem == NULL)
+    {
+      OSTimeDly (s->dly);
+    }
+    else
+    {
+      OSSemPend (s->sem, s->dly, &err);
+    }
+
+    switch (s->woken)
+    {
+    case WOKEN_TIMEOUT:
+      CHECK (OSTimeGet () == s->start + s->dly);
+      CHECK (err == OS_ERR_TIMEOUT);
+      break;
+    case WOKEN_RESUMED:
+      CHECK (OSTimeGet () == s->woken_at);
+      CHECK (err == OS_ERR_TIMEOUT);
+      break;
+    default:
+      CHECK (OSTimeGet () == s->woken_at);
+      CHECK (err == OS_ERR_NONE);
+      err = OS_ERR_TIMEOUT;
+      break;
+    }
+    s->nwakes++;
+  }
+}
+
+/*
+ * The timer callbacks record the timer tick and the kernel tick they are
+ * made on.
+ */
+
+typedef struct
+{
+  int    ncalls;
+  INT32U tmr_time;
+  INT32U time;
+} CALLS;
+
+static void tmr_callback (void* ptmr, void* parg)
+{
+  CALLS* calls = (CALLS*) parg;
+
+  calls->ncalls++;
+  calls->tmr_time = OSTmrTime;
+  calls->time     = OSTimeGet ();
+}
+
+static INT32U next_due (void)
+{
+  INT32U ticks;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR  cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL ();
+  ticks = OS_CPU_TICK_NEXT_DUE ();
+  OS_EXIT_CRITICAL ();
+  return ticks;
+}
+
+/* Delay the root task until calls->ncalls reaches "ncalls". */
+
+static void wait_calls (CALLS* calls, int ncalls)
+{
+  while (calls->ncalls < ncalls)
+  {
+    OSTimeDly (1);
+  }
+}
+
+static INT8U isr_err;
+
+static void isr_dly_until (void* context)
+{
+  isr_err = OSTimeDlyUntil (OSTimeGet () + 1);
+}
+
+static void until (void)
+{
+  OS_PERIOD period;
+  INT32U    start;
+  INT32U    t;
+  int       i;
+
+  /* each delay ends on the tick it is given, whatever the work before it */
+
+  t = OSTimeGet ();
+  for (i = 0; i < NOPS; i++)
+  {
+    t += 1 + rand_next (MAX_DLY);
+    OSTimeDly (rand_next (t - OSTimeGet ()));
+    CHECK (OSTimeDlyUntil (t) == OS_ERR_NONE);
+    CHECK (OSTimeGet () == t);
+  }
+
+  /* a tick which is reached or past doesn't delay */
+
+  CHECK (OSTimeDlyUntil (t) == OS_ERR_TIME_PAST);
+  CHECK (OSTimeDlyUntil (t - 5) == OS_ERR_TIME_PAST);
+  CHECK (OSTimeGet () == t);
+  host_isr (isr_dly_until, NULL);
+  CHECK (isr_err == OS_ERR_TIME_DLY_ISR);
+
+  CHECK (OSTimePeriodInit (NULL, PERIOD) == OS_ERR_PDATA_NULL);
+  CHECK (OSTimePeriodInit (&period, 0) == OS_ERR_TIME_ZERO_DLY);
+  CHECK (OSTimePeriodWait (NULL) == OS_ERR_PDATA_NULL);
+
+  /* 
+   * Up to a whole period of work: the activations stay PERIOD ticks apart
+   * from the first one, without drift.
+   */
+
+  CHECK (OSTimePeriodInit (&period, PERIOD) == OS_ERR_NONE);
+  start = OSTimeGet ();
+  for (i = 1; i <= NPERIODS; i++)
+  {
+    OSTimeDly (rand_next (PERIOD + 1));
+    CHECK (OSTimePeriodWait (&period) == OS_ERR_NONE);
+    CHECK (OSTimeGet () == start + i * PERIOD);
+  }
+  CHECK (period.OSPeriodOverruns == 0);
+  CHECK (period.OSPeriodMissed == 0);
+
+  /* 
+   * Overruns: the task runs late at once, the activations due before the 
+   * latest are counted as missed, and the next one is back on the grid.
+   */
+
+  t = OSTimeGet ();
+  OSTimeDly (3 * PERIOD + 2);
+  CHECK (OSTimePeriodWait (&period) == OS_ERR_TIME_OVERRUN);
+  CHECK (OSTimeGet () == t + 3 * PERIOD + 2);
+  CHECK (period.OSPeriodOverruns == 1);
+  CHECK (period.OSPeriodMissed == 2);
+  CHECK (OSTimePeriodWait (&period) == OS_ERR_NONE);
+  CHECK (OSTimeGet () == t + 4 * PERIOD);
+
+  OSTimeDly (PERIOD + 1);
+  CHECK (OSTimePeriodWait (&period) == OS_ERR_TIME_OVERRUN);
+  CHECK (period.OSPeriodOverruns == 2);
+  CHECK (period.OSPeriodMissed == 2);
+  CHECK (OSTimePeriodWait (&period) == OS_ERR_NONE);
+  CHECK (OSTimeGet () == t + 6 * PERIOD);
+  CHECK (next_due () == 0xffffffff);
+}
+
+static void root (void* pdata)
+{
+  OS_TCB   data;
+  SLEEPER* s;
+  OS_TMR*  one;
+  OS_TMR*  far;
+  OS_TMR*  periodic;
+  CALLS    one_calls      = { 0 };
+  CALLS    far_calls      = { 0 };
+  CALLS    periodic_calls = { 0 };
+  INT32U   start;
+  INT32U   tmr_start;
+  INT8U    err;
+  int      i;
+
+  for (i = 0; i < NSLEEPERS; i++)
+  {
+    if (i & 1)
+    {
+      sleepers[i].sem = OSSemCreate (0);
+      CHECK (sleepers[i].sem != NULL);
+    }
+    CHECK (OSTaskCreateExt (sleeper, &sleepers[i],
+                            &sleeper_stk[i][HOST_STK_SIZE - 1],
+                            SLEEPER_PRIO + i, SLEEPER_PRIO + i,
+                            &sleeper_stk[i][0], HOST_STK_SIZE, NULL, 0)
+           == OS_ERR_NONE);
+  }
+
+  /* 
+   * The sleepers have a higher priority: whenever the root task runs they
+   * are all asleep, and a sleeper which is resumed or posted runs at once.
+   */
+
+  for (i = 0; i < NOPS; i++)
+  {
+    s = &sleepers[rand_next (NSLEEPERS)];
+
+    switch (rand_next (4))
+    {
+    case 0:
+      OSTimeDly (1 + rand_next (5));
+      break;
+    case 1:
+      CHECK (OSTaskQuery (SLEEPER_PRIO + (s - sleepers), &data) 
+             == OS_ERR_NONE);
+      CHECK (data.OSTCBDly == s->start + s->dly - OSTimeGet ());
+      CHECK (data.OSTCBDly != 0);
+      break;
+    case 2:
+      s->woken    = WOKEN_RESUMED;
+      s->woken_at = OSTimeGet ();
+      CHECK (OSTimeDlyResume (SLEEPER_PRIO + (s - sleepers)) == OS_ERR_NONE);
+      CHECK (s->woken == WOKEN_TIMEOUT);
+      break;
+    default:
+      if (s->sem != NULL)
+      {
+        s->woken    = WOKEN_POSTED;
+        s->woken_at = OSTimeGet ();
+        CHECK (OSSemPost (s->sem) == OS_ERR_NONE);
+        CHECK (s->woken == WOKEN_TIMEOUT);
+      }
+      else
+      {
+        CHECK (OSTimeDlyResume (ROOT_PRIO) == OS_ERR_TIME_NOT_DLY);
+      }
+      break;
+    }
+    CHECK (OSTimeGet () == alt_nticks ());
+  }
+
+  for (i = 0; i < NSLEEPERS; i++)
+  {
+    CHECK (sleepers[i].nwakes > NOPS / (4 * NSLEEPERS));
+    CHECK (OSTaskDel (SLEEPER_PRIO + i) == OS_ERR_NONE);
+  }
+  CHECK (next_due () == 0xffffffff);
+
+  /* 
+   * A one-shot timer. Starting the first timer links the timer task's 
+   * node, so that its timer ticks fall TMR_TICKS kernel ticks apart from
+   * now on.
+   */
+
+  one = OSTmrCreate (3, 0, OS_TMR_OPT_ONE_SHOT, tmr_callback, &one_calls,
+                     (INT8U*) "one", &err);
+  CHECK (err == OS_ERR_NONE);
+  tmr_start = OSTmrTime;
+  start     = OSTimeGet ();
+  CHECK (OSTmrStart (one, &err) == OS_TRUE);
+  CHECK (OSTmrRemainGet (one, &err) == 3);
+  CHECK (next_due () == TMR_TICKS);
+
+  /* 
+   * A periodic timer, started while the other runs, and a one-shot timer
+   * beyond the first level of the timer wheel.
+   */
+
+  OSTimeDly (TMR_TICKS);
+  periodic = OSTmrCreate (2, 5, OS_TMR_OPT_PERIODIC, tmr_callback, 
+                          &periodic_calls, (INT8U*) "periodic", &err);
+  CHECK (err == OS_ERR_NONE);
+  CHECK (OSTmrStart (periodic, &err) == OS_TRUE);
+  far = OSTmrCreate (OS_TMR_CFG_WHEEL_SIZE + 8, 0, OS_TMR_OPT_ONE_SHOT,
+                     tmr_callback, &far_calls, (INT8U*) "far", &err);
+  CHECK (err == OS_ERR_NONE);
+  CHECK (OSTmrStart (far, &err) == OS_TRUE);
+
+  wait_calls (&one_calls, 1);
+  CHECK (one_calls.tmr_time == tmr_start + 3);
+  CHECK (one_calls.time == start + 3 * TMR_TICKS);
+  CHECK (OSTmrStateGet (one, &err) == OS_TMR_STATE_COMPLETED);
+
+  wait_calls (&periodic_calls, 1);
+  CHECK (periodic_calls.tmr_time == tmr_start + 1 + 2);
+  CHECK (periodic_calls.time == start + 3 * TMR_TICKS);
+  for (i = 2; i <= 4; i++)
+  {
+    wait_calls (&periodic_calls, i);
+    CHECK (periodic_calls.tmr_time == tmr_start + 3 + 5 * (i - 1));
+    CHECK (periodic_calls.time == start + (3 + 5 * (i - 1)) * TMR_TICKS);
+  }
+  CHECK (OSTmrStop (periodic, OS_TMR_OPT_NONE, NULL, &err) == OS_TRUE);
+
+  wait_calls (&far_calls, 1);
+  CHECK (far_calls.tmr_time == tmr_start + 1 + OS_TMR_CFG_WHEEL_SIZE + 8);
+  CHECK (far_calls.time == 
+         start + (1 + OS_TMR_CFG_WHEEL_SIZE + 8) * TMR_TICKS);
+  CHECK (periodic_calls.ncalls == 4);
+
+  /* no timer runs: the node leaves the list on its next timer tick */
+
+  OSTimeDly (TMR_TICKS);
+  CHECK (next_due () == 0xffffffff);
+  CHECK (OSTimeGet () == alt_nticks ());
+
+  until ();
+
+  host_pass ();
+}
+
+int main (void)
+{
+  host_init ();
+  OSTaskCreateExt (root, NULL, &root_stk[HOST_STK_SIZE - 1], ROOT_PRIO,
+                   ROOT_PRIO, &root_stk[0], HOST_STK_SIZE, NULL, 0);
+  OSStart ();
+  return 1;
+}
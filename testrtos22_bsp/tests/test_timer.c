@@ -0,0 +1,415 @@
+/*
+ * System clock driver test, on the model of the timer registers in
+ * host/timer_model.c. The driver must count the ticks exactly while it
+ * leaves the timer alone, keep a timestamp which never goes backwards,
+ * including when the counter reloads between two register accesses or the
+ * interrupt is held off, call high resolution timers on time, and skip the
+ * ticks of a stretched period without losing any. Finally a random sequence
+ * of all of these is run with random interrupt latencies.
+ *
+ * The driver is driven directly from main(): the kernel is initialised but
+ * not started.
+ */
+
+#include "host.h"
+#include "timer_model.h"
+
+#include "sys/alt_alarm.h"
+#include "sys/alt_hrtimer.h"
+#include "sys/alt_timestamp.h"
+#include "altera_avalon_timer.h"
+
+#define PERIOD       ((alt_u64) SYS_CLK_TIMER_LOAD_VALUE + 1)
+
+/*
+ * The driver reads the time with up to five register accesses of up to 8
+ * cycles each; its time may be behind the model's by that much, plus the
+ * few cycles it does not count when it reprograms the timer.
+ */
+
+#define SLACK        64
+
+/* Margin the driver leaves before a timeout to reprogram the timer */
+
+#define MARGIN       256
+
+#define NTIMERS      8
+#define MAX_LATENCY  2000
+#define NOPS         200000
+
+/* The model's time when the driver started the timer: its time zero */
+
+static alt_u64 zero;
+
+static alt_u64 real (void)
+{
+  return host_timer_cycles - zero;
+}
+
+static alt_u32 rand_state = 1;
+
+static alt_u32 rand_next (alt_u32 range)
+{
+  rand_state = rand_state * 1103515245 + 12345;
+  return (rand_state >> 16) % range;
+}
+
+/* run_until() lets time pass until "t", taking the interrupts at once. */
+
+static void run_until (alt_u64 t)
+{
+  alt_u64 left;
+
+  while (real () < t)
+  {
+    left = host_timer_timeout ();
+    if ((left == 0) || (left > t - real ()))
+    {
+      left = t - real ();
+    }
+    host_timer_run (left);
+    host_timer_irq ();
+  }
+}
+
+/*
+ * run_late() lets "ncycles" pass, taking each interrupt after a random 
+ * latency of up to MAX_LATENCY cycles, but early enough for the handler to
+ * clear the timeout before the counter times out again. An interrupt 
+ * already pending is taken first.
+ */
+
+static void run_late (alt_u64 ncycles)
+{
+  alt_u64 left;
+  alt_u64 latency;
+
+  for (;;)
+  {
+    if (host_timer_pending ())
+    {
+      latency = rand_next (MAX_LATENCY);
+      if (latency + SLACK > host_timer_timeout ())
+      {
+        latency = (host_timer_timeout () > SLACK) ? 
+                  host_timer_timeout () - SLACK : 0;
+      }
+      host_timer_run (latency);
+      host_timer_irq ();
+    }
+    if (ncycles == 0)
+    {
+      break;
+    }
+
+    left = host_timer_timeout ();
+    if ((left == 0) || (left > ncycles))
+    {
+      left = ncycles;
+    }
+    host_timer_run (left);
+    ncycles -= left;
+  }
+}
+
+/* The time within the current tick period, from the tick count. */
+
+static alt_u64 in_tick (void)
+{
+  return real () - (alt_u64) alt_nticks () * PERIOD;
+}
+
+/*
+ * The high resolution timers record the model's time, and the driver's, when
+ * they are called back.
+ */
+
+typedef struct
+{
+  alt_hrtimer timer;
+  int         started;
+  int         ncalls;
+  alt_u64     at;
+  alt_u64     now;
+} TIMER;
+
+static TIMER   timers[NTIMERS];
+static int     order[NTIMERS];
+static int     norder;
+
+static void callback (void* context)
+{
+  TIMER* t = (TIMER*) context;
+
+  CHECK (t->started);
+  t->started = 0;
+  t->ncalls++;
+  t->at  = real ();
+  t->now = alt_hrtimer_now ();
+  CHECK (t->at >= t->timer.expiry);
+  CHECK (t->now >= t->timer.expiry);
+  if (norder < NTIMERS)
+  {
+    order[norder++] = t - timers;
+  }
+}
+
+static void start_at (TIMER* t, alt_u64 expiry)
+{
+  t->started = 1;
+  CHECK (alt_hrtimer_start_at (&t->timer, expiry, callback, t) == 0);
+}
+
+/*
+ * check_time() reads the timestamp and the high resolution time, which must
+ * not be ahead of the model's time, nor behind the previous reading. It
+ * returns how much further the driver's time has fallen behind the model's
+ * since the last call: up to SLACK from the accesses of the reading, and a
+ * few cycles each time the timer is reprogrammed.
+ */
+
+static alt_u64 last_now;
+static alt_u64 last_lag;
+
+static alt_u64 check_time (void)
+{
+  alt_u64 ts  = alt_timestamp ();
+  alt_u64 now = alt_hrtimer_now ();
+  alt_u64 lag;
+  alt_u64 more;
+
+  CHECK (ts <= now);
+  CHECK (ts >= last_now);
+  CHECK (now <= real ());
+
+  lag      = real () - now;
+  more     = (lag > last_lag) ? lag - last_lag : 0;
+  last_now = now;
+  last_lag = lag;
+  return more;
+}
+
+static void check_ticks (void)
+{
+  CHECK (alt_nticks () == real () / PERIOD);
+}
+
+int main (void)
+{
+  alt_irq_context context;
+  alt_u32         writes;
+  alt_u32         nticks;
+  alt_u64         t;
+  TIMER*          timer;
+  int             i;
+
+  host_init ();
+  alt_avalon_timer_sc_init ((void*) SYS_CLK_TIMER_BASE,
+                            SYS_CLK_TIMER_IRQ_INTERRUPT_CONTROLLER_ID,
+                            SYS_CLK_TIMER_IRQ, SYS_CLK_TIMER_TICKS_PER_SEC);
+  zero = host_timer_cycles;
+
+  CHECK (alt_hrtimer_freq () == SYS_CLK_TIMER_FREQ);
+  CHECK (alt_timestamp_freq () == SYS_CLK_TIMER_FREQ);
+  CHECK (host_timer_timeout () == PERIOD);
+
+  /* the periodic tick: the period is never written */
+
+  run_until (10 * PERIOD + PERIOD / 2);
+  CHECK (alt_nticks () == 10);
+  CHECK (check_time () <= SLACK);
+
+  /*
+   * The counter reloads just before, or while, the time is read, and the
+   * interrupt is taken late, up to most of a period late. The time is exact
+   * all the same, and no tick is lost.
+   */
+
+  for (i = 0; i < 1000; i++)
+  {
+    host_timer_run (host_timer_timeout () - rand_next (48));
+    CHECK (check_time () <= SLACK);
+    CHECK (check_time () <= SLACK);
+    if (rand_next (2))
+    {
+      host_timer_run (rand_next (PERIOD - 2 * SLACK));
+    }
+    CHECK (check_time () <= SLACK);
+    CHECK (host_timer_irq ());
+    CHECK (check_time () <= SLACK);
+    check_ticks ();
+  }
+  CHECK (host_timer_period_writes == 0);
+
+  /*
+   * High resolution timers: in the middle of a tick, within the margin, in
+   * the past, and two at the same time, called in the order they were
+   * started. One is stopped before it expires. The normal period is back
+   * after the next tick.
+   */
+
+  run_until (real () - in_tick () + PERIOD / 3);
+  start_at (&timers[0], alt_hrtimer_now () + PERIOD / 2);
+  start_at (&timers[1], timers[0].timer.expiry - PERIOD / 4);
+  start_at (&timers[2], timers[1].timer.expiry);
+  t = alt_hrtimer_now ();
+  start_at (&timers[3], t + 10);
+  start_at (&timers[4], t - 10);
+  start_at (&timers[5], t + PERIOD / 8);
+  timers[5].started = 0;
+  alt_hrtimer_stop (&timers[5].timer);
+  timers[6].started = 1;
+  CHECK (alt_hrtimer_start (&timers[6].timer, 100, callback, &timers[6]) 
+         == 0);
+  CHECK (timers[6].timer.expiry >= t + SYS_CLK_TIMER_FREQ / 10000);
+
+  run_until (timers[0].timer.expiry + MARGIN);
+  CHECK (norder == 6);
+  CHECK ((order[0] == 4) && (order[1] == 3) && (order[2] == 6) &&
+         (order[3] == 1) && (order[4] == 2) && (order[5] == 0));
+  CHECK (timers[3].now <= t + MARGIN + 4 * SLACK);
+  CHECK (timers[4].now <= t + MARGIN + 4 * SLACK);
+  CHECK (timers[0].now - timers[0].timer.expiry <= 2 * SLACK);
+  CHECK (timers[1].now - timers[1].timer.expiry <= 2 * SLACK);
+  CHECK (timers[6].now - timers[6].timer.expiry <= 2 * SLACK);
+  CHECK (timers[5].ncalls == 0);
+  CHECK (check_time () <= 8 * SLACK);
+
+  run_until (real () - in_tick () + PERIOD + PERIOD / 2);
+  writes = host_timer_period_writes;
+  nticks = alt_nticks ();
+  run_until (real () + 10 * PERIOD);
+  CHECK (host_timer_period_writes == writes);
+  CHECK (alt_nticks () == nticks + 10);
+  CHECK (check_time () <= SLACK);
+
+  /*
+   * A stretched period, from the middle of a tick. The interrupt comes on 
+   * the tick boundary, and the ticks are counted as if the period had not
+   * been stretched.
+   */
+
+  context = alt_irq_disable_all ();
+  CHECK (alt_avalon_timer_sc_stretch (1) == 0);
+  CHECK (alt_avalon_timer_sc_stretch (10) == 10);
+  alt_irq_enable_all (context);
+  CHECK (host_timer_timeout () > 9 * PERIOD + PERIOD / 4);
+  CHECK (host_timer_timeout () < 9 * PERIOD + 3 * PERIOD / 4);
+  host_timer_sleep ();
+  CHECK (alt_nticks () == nticks + 20);
+  CHECK (host_timer_timeout () > PERIOD - 2 * SLACK);
+  host_timer_sleep ();
+  CHECK (alt_nticks () == nticks + 21);
+
+  /* 
+   * A high resolution timer ends a stretched period early, between two 
+   * ticks: the next tick stays on its boundary.
+   */
+
+  run_until (real () + PERIOD / 2);
+  start_at (&timers[0], alt_hrtimer_now () + 3 * PERIOD);
+  context = alt_irq_disable_all ();
+  CHECK (alt_avalon_timer_sc_stretch (10) == 10);
+  alt_irq_enable_all (context);
+  host_timer_sleep ();
+  CHECK (timers[0].ncalls == 2);
+  CHECK (alt_nticks () == nticks + 24);
+  CHECK (host_timer_timeout () > PERIOD / 4);
+  CHECK (host_timer_timeout () < 3 * PERIOD / 4);
+  host_timer_sleep ();
+  CHECK (alt_nticks () == nticks + 25);
+
+  /* a stretched period is resumed before it ends */
+
+  run_until (real () + PERIOD / 2);
+  context = alt_irq_disable_all ();
+  CHECK (alt_avalon_timer_sc_stretch (20) == 20);
+  alt_irq_enable_all (context);
+  host_timer_run (5 * PERIOD);
+  CHECK (!host_timer_irq ());
+  context = alt_irq_disable_all ();
+  alt_avalon_timer_sc_resume ();
+  alt_irq_enable_all (context);
+  CHECK (alt_nticks () == nticks + 30);
+  CHECK (host_timer_timeout () > PERIOD / 4);
+  CHECK (host_timer_timeout () < 3 * PERIOD / 4);
+  host_timer_sleep ();
+  CHECK (alt_nticks () == nticks + 31);
+  host_timer_sleep ();
+  CHECK (alt_nticks () == nticks + 32);
+
+  /* it is not stretched when too little of the tick is left */
+
+  host_timer_run (host_timer_timeout () - MARGIN / 2);
+  context = alt_irq_disable_all ();
+  CHECK (alt_avalon_timer_sc_stretch (10) == 0);
+  alt_irq_enable_all (context);
+  host_timer_sleep ();
+  CHECK (alt_nticks () == nticks + 33);
+  CHECK (check_time () <= 16 * SLACK);
+
+  /*
+   * Random timers, stretches and resumes. The interrupt is taken after a
+   * random latency, within the programmed period: a longer one would lose
+   * the period (see alt_avalon_timer_sc_now()). Each tick boundary may
+   * now be moved by the latency of the interrupt which restores the normal
+   * period, so the ticks are only checked not to run ahead. A timer must not
+   * be called late by more than the latency.
+   */
+
+  for (i = 0; i < NTIMERS; i++)
+  {
+    timers[i].started = 0;
+  }
+  for (i = 0; i < NOPS; i++)
+  {
+    timer = &timers[rand_next (NTIMERS)];
+
+    switch (rand_next (10))
+    {
+    case 0:
+      if (!timer->started)
+      {
+        start_at (timer, alt_hrtimer_now () + 1 + rand_next (3 * PERIOD));
+      }
+      break;
+    case 1:
+      if (timer->started)
+      {
+        timer->started = 0;
+        alt_hrtimer_stop (&timer->timer);
+      }
+      break;
+    case 2:
+      context = alt_irq_disable_all ();
+      alt_avalon_timer_sc_stretch (2 + rand_next (60));
+      alt_irq_enable_all (context);
+      break;
+    case 3:
+      context = alt_irq_disable_all ();
+      alt_avalon_timer_sc_resume ();
+      alt_irq_enable_all (context);
+      break;
+    default:
+      run_late (rand_next (PERIOD / 8));
+      break;
+    }
+    run_late (0);
+
+    CHECK (check_time () <= 8 * SLACK);
+    CHECK (alt_nticks () <= real () / PERIOD);
+    for (t = 0; t < NTIMERS; t++)
+    {
+      CHECK (!timers[t].started ||
+             (last_now <= 
+              timers[t].timer.expiry + MAX_LATENCY + MARGIN + 2 * SLACK));
+    }
+
+    /* take the interrupt which may have come while the time was read */
+
+    run_late (0);
+  }
+
+  host_pass ();
+  return 0;
+}